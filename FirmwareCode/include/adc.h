@@ -0,0 +1,181 @@
+/**
+ * @file adc.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the ADC acquisition. This is the
+ * header file for the definition of the interface for sampling a scan
+ * sequence of ADC1 into a circular DMA buffer. The buffer is used as two
+ * halves: each half is passed to the application, averaged and decimated
+ * if a filter is set, while the DMA fills the other one, so the CPU only
+ * runs once per half.
+ *
+ * With APB2 at 84 MHz, ADC_PRESCALER_DIV_4 and ADC_SAMPLE_TIME_3, a 12-bit
+ * conversion takes 15 ADC clock cycles, i.e. 1.4 Msamples/s in continuous
+ * mode.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef ADC_H_
+#define ADC_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <assert.h>
+#include "dma.h"        /*For the DMA stream transfers*/
+#include "filter.h"     /*For the decimation of each half*/
+#include "stm32f4xx.h"  /*Microcontroller family header*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the maximum number of channels of a scan sequence.
+*/
+#define ADC_SEQUENCE_MAX 16U
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the ADC input channels.
+*/
+typedef enum
+{
+    ADC_CHANNEL_0,      /**< PA0 */
+    ADC_CHANNEL_1,      /**< PA1 */
+    ADC_CHANNEL_2,      /**< PA2 */
+    ADC_CHANNEL_3,      /**< PA3 */
+    ADC_CHANNEL_4,      /**< PA4 */
+    ADC_CHANNEL_5,      /**< PA5 */
+    ADC_CHANNEL_6,      /**< PA6 */
+    ADC_CHANNEL_7,      /**< PA7 */
+    ADC_CHANNEL_8,      /**< PB0 */
+    ADC_CHANNEL_9,      /**< PB1 */
+    ADC_CHANNEL_10,     /**< PC0 */
+    ADC_CHANNEL_11,     /**< PC1 */
+    ADC_CHANNEL_12,     /**< PC2 */
+    ADC_CHANNEL_13,     /**< PC3 */
+    ADC_CHANNEL_14,     /**< PC4 */
+    ADC_CHANNEL_15,     /**< PC5 */
+    ADC_CHANNEL_16,     /**< Temperature sensor */
+    ADC_CHANNEL_17,     /**< Internal reference voltage */
+    ADC_CHANNEL_18,     /**< Battery voltage */
+    ADC_CHANNEL_MAX     /**< Defines the maximum ADC channel */
+}AdcChannel_t;
+
+/**
+ * Defines the sampling time of the channels, in ADC clock cycles. The
+ * settings are the encodings of the SMPx fields.
+*/
+typedef enum
+{
+    ADC_SAMPLE_TIME_3,      /**< 3 cycles */
+    ADC_SAMPLE_TIME_15,     /**< 15 cycles */
+    ADC_SAMPLE_TIME_28,     /**< 28 cycles */
+    ADC_SAMPLE_TIME_56,     /**< 56 cycles */
+    ADC_SAMPLE_TIME_84,     /**< 84 cycles */
+    ADC_SAMPLE_TIME_112,    /**< 112 cycles */
+    ADC_SAMPLE_TIME_144,    /**< 144 cycles */
+    ADC_SAMPLE_TIME_480,    /**< 480 cycles */
+    ADC_SAMPLE_TIME_MAX     /**< Defines the maximum sampling time */
+}AdcSampleTime_t;
+
+/**
+ * Defines the divider of the APB2 clock that gives the ADC clock (36 MHz
+ * maximum). The settings are the encodings of the ADCPRE field.
+*/
+typedef enum
+{
+    ADC_PRESCALER_DIV_2,    /**< APB2 clock / 2 */
+    ADC_PRESCALER_DIV_4,    /**< APB2 clock / 4 */
+    ADC_PRESCALER_DIV_6,    /**< APB2 clock / 6 */
+    ADC_PRESCALER_DIV_8,    /**< APB2 clock / 8 */
+    ADC_PRESCALER_MAX       /**< Defines the maximum prescaler */
+}AdcPrescaler_t;
+
+/**
+ * Defines what starts each scan of the sequence.
+*/
+typedef enum
+{
+    ADC_TRIGGER_CONTINUOUS, /**< A scan starts when the previous one ends */
+    ADC_TRIGGER_TIMER,      /**< A scan starts on every TIM5 period */
+    ADC_TRIGGER_MAX         /**< Defines the maximum trigger */
+}AdcTrigger_t;
+
+/**
+ * Defines the state of the acquisition.
+*/
+typedef enum
+{
+    ADC_IDLE,           /**< No acquisition is running */
+    ADC_RUNNING,        /**< The sequence is being sampled */
+    ADC_OVERRUN,        /**< A sample was lost, the acquisition stopped */
+    ADC_STATE_MAX       /**< Defines the maximum acquisition state */
+}AdcState_t;
+
+/**
+ * Defines the function called with each half of the buffer: the samples,
+ * or the averages if the acquisition has a decimation filter.
+*/
+typedef void (*AdcCallback_t)(const uint16_t * const data, uint32_t count);
+
+/**
+ * Defines the data needed to sample a scan sequence. The samples of the
+ * channels are interleaved in the order of the sequence. The stream moves
+ * two samples per memory word, so the buffers are aligned on 4 bytes. With
+ * a second buffer, the stream fills buffer and buffer2 in turn (length
+ * samples each) instead of the halves of buffer.
+*/
+typedef struct
+{
+    const AdcChannel_t *Channels;       /**< Scan sequence, in order */
+    uint8_t channelCount;               /**< Channels of the sequence */
+    AdcSampleTime_t SampleTime;         /**< Sampling time of each channel */
+    AdcPrescaler_t Prescaler;           /**< Divider of the APB2 clock */
+    AdcTrigger_t Trigger;               /**< Continuous or timer scans */
+    uint32_t scanPeriod;                /**< TIM5 clock cycles per scan */
+    DmaStream_t Stream;                 /**< DMA2_STREAM_0 or DMA2_STREAM_4 */
+    uint16_t *buffer;                   /**< Buffer of both halves */
+    uint32_t length;                    /**< Samples of the buffer */
+    const FilterDecimation_t *Decimation; /**< Filter of a half (or NULL) */
+    uint16_t *output;                   /**< Averages of a half */
+    AdcCallback_t Callback;             /**< Called with each half */
+    uint16_t *buffer2;                  /**< Second buffer (or NULL) */
+}AdcAcquisitionConfig_t;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void ADC_start(const AdcAcquisitionConfig_t * const Config);
+void ADC_stop(void);
+AdcState_t ADC_stateGet(void);
+void ADC_irqHandler(void);
+void ADC_bufferNextSet(uint16_t * const buffer);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*ADC_H_*/
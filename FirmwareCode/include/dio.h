@@ -44,6 +44,18 @@ typedef struct
     DioPin_t Pin;               /**< The I/O pin */
 }DioPinConfig_t;
 
+/**
+ * Defines the set/reset words of a pin. Each word drives the pin with a
+ * single store to the bit set/reset register of the port, without 
+ * disturbing the other pins, even from an interrupt.
+*/
+typedef struct
+{
+    uint32_t volatile * bsrr;   /**< Bit set/reset register of the port */
+    uint32_t set;               /**< Word that sets the pin high */
+    uint32_t reset;             /**< Word that sets the pin low */
+}DioPinSetReset_t;
+
 /*****************************************************************************
 * Variables
 *****************************************************************************/
@@ -56,9 +68,14 @@ extern "C"{
 #endif
 
 void DIO_init(const DioConfig_t * const Config, size_t configSize);
+void DIO_imageCompose(const DioConfig_t * const Config, size_t configSize,
+DioPortImage_t * const Image);
+void DIO_imageInit(const DioPortImage_t * const Image, size_t imageSize);
 DioPinState_t DIO_pinRead(const DioPinConfig_t * const PinConfig);
 void DIO_pinWrite(const DioPinConfig_t * const PinConfig, DioPinState_t State);
 void DIO_pinToggle(const DioPinConfig_t * const PinConfig);
+void DIO_pinSetResetGet(const DioPinConfig_t * const PinConfig, 
+DioPinSetReset_t * const SetReset);
 void DIO_registerWrite(uint32_t address, uint32_t value);
 uint32_t DIO_registerRead(uint32_t address);
 
@@ -0,0 +1,216 @@
+/**
+ * @file dio.hpp
+ * @author Jose Luis Figueroa
+ * @brief The C++17 template interface for the DIO. A pin is a type
+ * (DioPin<Port::A, 5>) and its configuration is built with DioConfigBuilder,
+ * so the pin operations compile to single stores on the port registers.
+ * The bit set/reset register is used to write and toggle the pin, so no
+ * read-modify-write of the output data register is needed.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef DIO_HPP_
+#define DIO_HPP_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include "hal.hpp"      /*For the common template definitions*/
+#include "dio.h"        /*For the C interface definitions*/
+
+namespace hal
+{
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the GPIO ports by their base address.
+*/
+enum class Port : uintptr_t
+{
+    A = GPIOA_BASE,     /**< Port A */
+    B = GPIOB_BASE,     /**< Port B */
+    C = GPIOC_BASE,     /**< Port C */
+    D = GPIOD_BASE,     /**< Port D */
+    H = GPIOH_BASE      /**< Port H */
+};
+
+/**
+ * Returns the port of the C interface of a port.
+*/
+constexpr DioPort_t dioPort(const Port port)
+{
+    return (port == Port::A) ? DIO_PA :
+           (port == Port::B) ? DIO_PB :
+           (port == Port::C) ? DIO_PC :
+           (port == Port::D) ? DIO_PD : DIO_PH;
+}
+
+/**
+ * Builds the configuration of a pin at compile time. The default
+ * configuration is the reset state of a pin (input, push-pull, low speed,
+ * no resistor, AF0).
+ *
+ * \b Example:
+ * @code
+ * constexpr auto Led = hal::DioConfigBuilder().mode(DIO_OUTPUT)
+ *                                             .speed(DIO_HIGH_SPEED);
+ * @endcode
+*/
+class DioConfigBuilder
+{
+public:
+    constexpr DioConfigBuilder() :
+        Mode(DIO_INPUT), Type(DIO_PUSH_PULL), Speed(DIO_LOW_SPEED),
+        Resistor(DIO_NO_RESISTOR), Function(DIO_AF0)
+    {
+    }
+
+    constexpr DioConfigBuilder mode(const DioMode_t value) const
+    {
+        DioConfigBuilder builder = *this;
+        builder.Mode = value;
+        return builder;
+    }
+
+    constexpr DioConfigBuilder type(const DioType_t value) const
+    {
+        DioConfigBuilder builder = *this;
+        builder.Type = value;
+        return builder;
+    }
+
+    constexpr DioConfigBuilder speed(const DioSpeed_t value) const
+    {
+        DioConfigBuilder builder = *this;
+        builder.Speed = value;
+        return builder;
+    }
+
+    constexpr DioConfigBuilder resistor(const DioResistor_t value) const
+    {
+        DioConfigBuilder builder = *this;
+        builder.Resistor = value;
+        return builder;
+    }
+
+    constexpr DioConfigBuilder function(const DioFunction_t value) const
+    {
+        DioConfigBuilder builder = *this;
+        builder.Function = value;
+        return builder;
+    }
+
+    /**
+     * Returns the row of the C configuration table of the pin.
+    */
+    constexpr DioConfig_t build(const DioPort_t port, const DioPin_t pin) const
+    {
+        return DioConfig_t{port, pin, Mode, Type, Speed, Resistor, Function};
+    }
+
+    DioMode_t Mode;             /**< Input, Output, Function, or Analog */
+    DioType_t Type;             /**< Push-pull or Open-drain */
+    DioSpeed_t Speed;           /**< Low, Medium, High, very */
+    DioResistor_t Resistor;     /**< Enabled or Disabled */
+    DioFunction_t Function;     /**< Mux Function */
+};
+
+/**
+ * Defines a pin of a GPIO port. Every function is inlined and works on a
+ * register address and a mask known at compile time.
+ *
+ * @tparam  PORT is the GPIO port of the pin.
+ * @tparam  PIN is the pin number within the port (0 to 15).
+ *
+ * \b Example:
+ * @code
+ * using UserLed = hal::DioPin<hal::Port::A, 5>;
+ *
+ * UserLed::init(hal::DioConfigBuilder().mode(DIO_OUTPUT));
+ * UserLed::toggle();
+ * DIO_pinToggle(&UserLed::pinConfig);   //Same pin through the C interface
+ * @endcode
+*/
+template <Port PORT, uint8_t PIN>
+struct DioPin
+{
+    static_assert(PIN < DIO_MAX_PIN, "The pin is out of the port");
+
+    /** Defines the mask of the pin on the one bit per pin registers */
+    static constexpr uint32_t mask = (1UL<<PIN);
+
+    /** Defines the pin for the C interface */
+    static constexpr DioPinConfig_t pinConfig =
+        {dioPort(PORT), static_cast<DioPin_t>(PIN)};
+
+    /**
+     * Returns the register block of the port.
+    */
+    static HAL_INLINE GPIO_TypeDef * port()
+    {
+        return registerBlock<GPIO_TypeDef>(static_cast<uintptr_t>(PORT));
+    }
+
+    /**
+     * Sets up the pin. Each register is accessed with one read-modify-write
+     * of the bits of the pin. The mode is written last, so the pin enters
+     * its mode with the rest of the settings already selected.
+    */
+    static HAL_INLINE void init(const DioConfigBuilder & config)
+    {
+        constexpr uint32_t shift2 = PIN*2U;
+        constexpr uint32_t afr = PIN/8U;
+        constexpr uint32_t shift4 = (PIN%8U)*4U;
+
+        port()->OTYPER = (port()->OTYPER & ~mask) |
+            (static_cast<uint32_t>(config.Type)<<PIN);
+        port()->OSPEEDR = (port()->OSPEEDR & ~(0x3UL<<shift2)) |
+            (static_cast<uint32_t>(config.Speed)<<shift2);
+        port()->PUPDR = (port()->PUPDR & ~(0x3UL<<shift2)) |
+            (static_cast<uint32_t>(config.Resistor)<<shift2);
+        port()->AFR[afr] = (port()->AFR[afr] & ~(0xFUL<<shift4)) |
+            (static_cast<uint32_t>(config.Function)<<shift4);
+        port()->MODER = (port()->MODER & ~(0x3UL<<shift2)) |
+            (static_cast<uint32_t>(config.Mode)<<shift2);
+    }
+
+    /** Drives the pin high with a single store. */
+    static HAL_INLINE void set()
+    {
+        port()->BSRR = mask;
+    }
+
+    /** Drives the pin low with a single store. */
+    static HAL_INLINE void reset()
+    {
+        port()->BSRR = (mask<<16U);
+    }
+
+    /** Drives the pin to a state with a single store. */
+    static HAL_INLINE void write(const DioPinState_t state)
+    {
+        port()->BSRR = (state == DIO_HIGH) ? mask : (mask<<16U);
+    }
+
+    /** Toggles the pin. The other pins of the port are not written. */
+    static HAL_INLINE void toggle()
+    {
+        const uint32_t output = port()->ODR;
+        port()->BSRR = ((output & mask)<<16U) | (~output & mask);
+    }
+
+    /** Reads the state of the pin. */
+    static HAL_INLINE DioPinState_t read()
+    {
+        return (port()->IDR & mask) ? DIO_HIGH : DIO_LOW;
+    }
+};
+
+} // namespace hal
+
+#endif /*DIO_HPP_*/
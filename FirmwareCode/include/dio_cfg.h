@@ -17,6 +17,7 @@
 * Includes
 *****************************************************************************/
 #include <stdio.h>
+#include <stdint.h>
 
 /*****************************************************************************
 * Preprocessor Constants
@@ -199,6 +200,32 @@ typedef struct
     DioFunction_t Function;     /**< Mux Function - Dio_Peri_Select */
 }DioConfig_t;
 
+/**
+ * Defines the image of a GPIO register. The mask contains the bits owned by
+ * the configuration table and the value contains the state of those bits.
+ */
+typedef struct
+{
+    uint32_t mask;              /**< Bits of the register to be written */
+    uint32_t value;             /**< Value of the bits to be written */
+}DioRegisterImage_t;
+
+/**
+ * Defines the register images of a GPIO port. It is composed from all the 
+ * rows of the configuration table that belong to the port, so each register
+ * of the port is written once by Dio_Init.
+ */
+typedef struct
+{
+    DioPort_t Port;             /**< The I/O port */
+    uint16_t pins;              /**< Pins of the port on the table */
+    DioRegisterImage_t Moder;   /**< Port mode register */
+    DioRegisterImage_t Otyper;  /**< Port output type register */
+    DioRegisterImage_t Ospeedr; /**< Port output speed register */
+    DioRegisterImage_t Pupdr;   /**< Port pull-up/pull-down register */
+    DioRegisterImage_t Afr[2];  /**< Alternate function low/high registers */
+}DioPortImage_t;
+
 
 /*****************************************************************************
 * Function Prototypes
@@ -209,6 +236,8 @@ extern "C"{
 
 const DioConfig_t * const DIO_configGet(void);
 size_t DIO_configSizeGet(void);
+const DioPortImage_t * const DIO_imageGet(void);
+size_t DIO_imageSizeGet(void);
 
 #ifdef __cplusplus
 } //extern "C"
@@ -36,6 +36,52 @@
 /*****************************************************************************
 * Typedefs
 *****************************************************************************/
+/**
+ * Defines the state of a DMA stream.
+*/
+typedef enum
+{
+    DMA_STREAM_DISABLED,    /**< The stream is disabled (idle) */
+    DMA_STREAM_ENABLED,     /**< The stream is enabled (transfer ongoing) */
+    DMA_STREAM_STATE_MAX    /**< Defines the maximum stream state */
+}DmaStreamState_t;
+
+/**
+ * Defines the interrupts of a DMA stream.
+*/
+typedef enum
+{
+    DMA_INTERRUPT_TRANSFER_ERROR,       /**< Transfer error interrupt */
+    DMA_INTERRUPT_HALF_TRANSFER,        /**< Half transfer interrupt */
+    DMA_INTERRUPT_TRANSFER_COMPLETE,    /**< Transfer complete interrupt */
+    DMA_INTERRUPT_MAX                   /**< Defines the maximum interrupt */
+}DmaInterrupt_t;
+
+/**
+ * Defines the status returned by the DMA operations that can be refused.
+*/
+typedef enum
+{
+    DMA_OK,                 /**< The operation was performed */
+    DMA_BUSY,               /**< The stream is owned by another user */
+    DMA_TIMEOUT,            /**< The timeout elapsed first */
+    DMA_STATUS_MAX          /**< Defines the maximum DMA status */
+}DmaStatus_t;
+
+/**
+ * Defines the errors of a DMA stream. The values are the event flags of the
+ * stream, so several errors can be combined in a mask.
+*/
+typedef enum
+{
+    DMA_ERROR_NONE          = 0x00U,  /**< No error */
+    DMA_ERROR_FIFO          = 0x01U,  /**< FIFO overrun or underrun (FEIF) */
+    DMA_ERROR_DIRECT_MODE   = 0x04U,  /**< Direct mode error (DMEIF) */
+    DMA_ERROR_TRANSFER      = 0x08U,  /**< Bus error (TEIF) */
+    DMA_ERROR_STALL         = 0x40U,  /**< No progress with pending data */
+    DMA_ERROR_MAX           = 0x80U   /**< Defines the maximum error mask */
+}DmaError_t;
+
 typedef struct
 {   
     DmaStream_t Stream;                 /**< DMA stream */
@@ -44,6 +90,37 @@ typedef struct
     uint32_t length;                    /**< Number of data to transfer */
 }DmaTransferConfig_t;
 
+/**
+ * Defines the recovery policy of a stream. After an error stops the stream,
+ * the transfer is restarted where it stopped once the backoff delay has 
+ * elapsed; the delay doubles on each error without progress in between, up
+ * to backoffMax. The watchdog flags a stall when the peripheral has pending
+ * data (pendingMask set on pendingRegister) and the number of data has not
+ * changed for stallTimeout.
+*/
+typedef struct
+{
+    DmaTransferConfig_t Transfer;       /**< Transfer to restart */
+    uint32_t backoff;                   /**< First restart delay (us) */
+    uint32_t backoffMax;                /**< Maximum restart delay (us) */
+    uint32_t stallTimeout;              /**< Stall time (us), 0 disables it */
+    volatile uint32_t * pendingRegister;/**< Status of the peripheral */
+    uint32_t pendingMask;               /**< Bits set while data is pending */
+}DmaRecoveryConfig_t;
+
+/**
+ * Defines the error record of a stream with a recovery policy.
+*/
+typedef struct
+{
+    uint32_t fifoErrors;                /**< FIFO errors */
+    uint32_t directModeErrors;          /**< Direct mode errors */
+    uint32_t transferErrors;            /**< Transfer (bus) errors */
+    uint32_t stalls;                    /**< Stalls found by the watchdog */
+    uint32_t restarts;                  /**< Transfers restarted */
+    uint8_t lastError;                  /**< DmaError_t mask of the last one */
+}DmaRecoveryStats_t;
+
 /*****************************************************************************
 * Variables
 *****************************************************************************/
@@ -56,7 +133,40 @@ extern "C"{
 #endif
 
 void DMA_init(const DmaConfig_t * const Config, size_t configSize);
+void DMA_imageInit(const DmaStreamImage_t * const Image, size_t imageSize);
+void DMA_imageCompose(const DmaConfig_t * const Config, 
+DmaStreamImage_t * const Image);
+DmaStatus_t DMA_reconfigure(const DmaConfig_t * const Config);
 void DMA_transferConfig(const DmaTransferConfig_t * const TransferConfig);
+void DMA_transferStop(const DmaStream_t Stream);
+DmaStatus_t DMA_transferStopTimeout(const DmaStream_t Stream, 
+const uint32_t timeout);
+DmaStreamState_t DMA_streamStateGet(const DmaStream_t Stream);
+void DMA_transferWait(const DmaStream_t Stream);
+DmaStatus_t DMA_transferWaitTimeout(const DmaStream_t Stream, 
+const uint32_t timeout);
+uint32_t DMA_transferRemainingGet(const DmaStream_t Stream);
+void DMA_transferRearm(const DmaStream_t Stream, uint32_t * const memory,
+const uint32_t length);
+void DMA_interruptEnable(const DmaStream_t Stream, 
+const DmaInterrupt_t Interrupt);
+void DMA_interruptDisable(const DmaStream_t Stream, 
+const DmaInterrupt_t Interrupt);
+void DMA_memoryIncrementSet(const DmaStream_t Stream, 
+const DmaMemoryIncrement_t MemoryIncrement);
+uint8_t DMA_eventClear(const DmaStream_t Stream, 
+const DmaInterrupt_t Interrupt);
+void DMA_doubleBufferSet(const DmaStream_t Stream, uint32_t * const memory1);
+uint32_t * DMA_memoryIdleGet(const DmaStream_t Stream);
+void DMA_memoryIdleSet(const DmaStream_t Stream, uint32_t * const memory);
+DmaStatus_t DMA_streamClaim(const DmaStream_t Stream);
+void DMA_streamRelease(const DmaStream_t Stream);
+void DMA_recoveryEnable(const DmaRecoveryConfig_t * const Config);
+void DMA_recoveryDisable(const DmaStream_t Stream);
+void DMA_irqHandler(const DmaStream_t Stream);
+void DMA_recoveryPoll(void);
+void DMA_recoveryStatsGet(const DmaStream_t Stream, 
+DmaRecoveryStats_t * const Stats);
 
 #ifdef __cplusplus
 } // extern C
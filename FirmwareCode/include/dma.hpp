@@ -0,0 +1,422 @@
+/**
+ * @file dma.hpp
+ * @author Jose Luis Figueroa
+ * @brief The C++17 template interface for the Direct Memory Access (DMA). A
+ * stream is a type (DmaStream<Dma2, 7>) and its configuration is built with
+ * DmaConfigBuilder, so the control register values are folded at compile
+ * time and each operation compiles to stores on the stream registers.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef DMA_HPP_
+#define DMA_HPP_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include "hal.hpp"      /*For the common template definitions*/
+#include "dma.h"        /*For the C interface definitions*/
+
+namespace hal
+{
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the DMA1 controller.
+*/
+struct Dma1
+{
+    static constexpr uintptr_t base = DMA1_BASE;    /**< Register base */
+    static constexpr uint8_t index = 0U;            /**< Controller number */
+};
+
+/**
+ * Defines the DMA2 controller.
+*/
+struct Dma2
+{
+    static constexpr uintptr_t base = DMA2_BASE;    /**< Register base */
+    static constexpr uint8_t index = 1U;            /**< Controller number */
+};
+
+/**
+ * Builds the configuration of a stream at compile time. The default
+ * configuration is a peripheral to memory transfer of bytes on channel 0,
+ * with memory increment, FIFO direct mode, and normal mode.
+ *
+ * \b Example:
+ * @code
+ * constexpr auto UartTx = hal::DmaConfigBuilder()
+ *                             .channel(DMA_CHANNEL_4)
+ *                             .direction(DMA_MEMORY_TO_PERIPHERAL);
+ * @endcode
+*/
+class DmaConfigBuilder
+{
+public:
+    constexpr DmaConfigBuilder() :
+        Channel(DMA_CHANNEL_0), Direction(DMA_PERIPHERAL_TO_MEMORY),
+        MemorySize(DMA_MEMORY_SIZE_8), PeripheralSize(DMA_PERIPHERAL_SIZE_8),
+        MemoryIncrement(DMA_MEMORY_INCREMENT_ENABLED),
+        PeripheralIncrement(DMA_PERIPHERAL_INCREMENT_DISABLED),
+        FifoMode(DMA_FIFO_DIRECT_MODE_ENABLED),
+        FifoThreshold(DMA_FIFO_THRESHOLD_1_4),
+        CircularMode(DMA_CIRCULAR_MODE_DISABLED)
+    {
+    }
+
+    constexpr DmaConfigBuilder channel(const DmaChannel_t value) const
+    {
+        DmaConfigBuilder builder = *this;
+        builder.Channel = value;
+        return builder;
+    }
+
+    constexpr DmaConfigBuilder direction(const DmaDirection_t value) const
+    {
+        DmaConfigBuilder builder = *this;
+        builder.Direction = value;
+        return builder;
+    }
+
+    constexpr DmaConfigBuilder memorySize(const DmaMemorySize_t value) const
+    {
+        DmaConfigBuilder builder = *this;
+        builder.MemorySize = value;
+        return builder;
+    }
+
+    constexpr DmaConfigBuilder peripheralSize(
+        const DmaPeripheralSize_t value) const
+    {
+        DmaConfigBuilder builder = *this;
+        builder.PeripheralSize = value;
+        return builder;
+    }
+
+    constexpr DmaConfigBuilder memoryIncrement(
+        const DmaMemoryIncrement_t value) const
+    {
+        DmaConfigBuilder builder = *this;
+        builder.MemoryIncrement = value;
+        return builder;
+    }
+
+    constexpr DmaConfigBuilder peripheralIncrement(
+        const DmaPeripheralIncrement_t value) const
+    {
+        DmaConfigBuilder builder = *this;
+        builder.PeripheralIncrement = value;
+        return builder;
+    }
+
+    constexpr DmaConfigBuilder fifoMode(const DmaFifoMode_t value) const
+    {
+        DmaConfigBuilder builder = *this;
+        builder.FifoMode = value;
+        return builder;
+    }
+
+    constexpr DmaConfigBuilder fifoThreshold(
+        const DmaFifoThreshold_t value) const
+    {
+        DmaConfigBuilder builder = *this;
+        builder.FifoThreshold = value;
+        return builder;
+    }
+
+    constexpr DmaConfigBuilder circularMode(
+        const DmaCircularMode_t value) const
+    {
+        DmaConfigBuilder builder = *this;
+        builder.CircularMode = value;
+        return builder;
+    }
+
+    /**
+     * Returns the value of the stream control register. The enumerations
+     * of the configuration match the encoding of the register fields.
+    */
+    constexpr uint32_t cr() const
+    {
+        return (static_cast<uint32_t>(Channel)<<DMA_SxCR_CHSEL_Pos) |
+               (static_cast<uint32_t>(MemorySize)<<DMA_SxCR_MSIZE_Pos) |
+               (static_cast<uint32_t>(PeripheralSize)<<DMA_SxCR_PSIZE_Pos) |
+               (static_cast<uint32_t>(Direction)<<DMA_SxCR_DIR_Pos) |
+               ((MemoryIncrement == DMA_MEMORY_INCREMENT_ENABLED) ?
+                    DMA_SxCR_MINC : 0UL) |
+               ((PeripheralIncrement == DMA_PERIPHERAL_INCREMENT_ENABLED) ?
+                    DMA_SxCR_PINC : 0UL) |
+               ((CircularMode == DMA_CIRCULAR_MODE_ENABLED) ?
+                    DMA_SxCR_CIRC : 0UL);
+    }
+
+    /**
+     * Returns the value of the stream FIFO control register.
+    */
+    constexpr uint32_t fcr() const
+    {
+        return (static_cast<uint32_t>(FifoThreshold)<<DMA_SxFCR_FTH_Pos) |
+               ((FifoMode == DMA_FIFO_DIRECT_MODE_DISABLED) ?
+                    DMA_SxFCR_DMDIS : 0UL);
+    }
+
+    /**
+     * Returns the row of the C configuration table of the stream.
+    */
+    constexpr DmaConfig_t build(const DmaStream_t stream) const
+    {
+        return DmaConfig_t{stream, Channel, Direction, MemorySize,
+            PeripheralSize, MemoryIncrement, PeripheralIncrement, FifoMode,
+            FifoThreshold, CircularMode};
+    }
+
+    DmaChannel_t Channel;                       /**< DMA channel */
+    DmaDirection_t Direction;                   /**< DMA transfer direction */
+    DmaMemorySize_t MemorySize;                 /**< DMA memory data size */
+    DmaPeripheralSize_t PeripheralSize;         /**< DMA peripheral data size */
+    DmaMemoryIncrement_t MemoryIncrement;       /**< DMA memory increment */
+    DmaPeripheralIncrement_t PeripheralIncrement; /**< DMA peripheral increment */
+    DmaFifoMode_t FifoMode;                     /**< DMA FIFO direct mode */
+    DmaFifoThreshold_t FifoThreshold;           /**< DMA FIFO threshold level */
+    DmaCircularMode_t CircularMode;             /**< DMA circular mode */
+};
+
+/**
+ * Defines a stream of a DMA controller. Every function is inlined and works
+ * on the register addresses of the stream, which are known at compile time.
+ *
+ * @tparam  CONTROLLER is the DMA controller (Dma1 or Dma2).
+ * @tparam  STREAM is the stream number within the controller (0 to 7).
+ *
+ * \b Example:
+ * @code
+ * using UartTx = hal::DmaStream<hal::Dma1, 6>;
+ *
+ * UartTx::init(hal::DmaConfigBuilder().channel(DMA_CHANNEL_4)
+ *                                     .direction(DMA_MEMORY_TO_PERIPHERAL));
+ * UartTx::start(&USART2->DR, buffer, sizeof(buffer));
+ * DMA_transferStop(UartTx::id);    //Same stream through the C interface
+ * @endcode
+*/
+template <typename CONTROLLER, uint8_t STREAM>
+struct DmaStream
+{
+    static_assert(STREAM < 8U, "The controller has eight streams");
+
+    /** Defines the stream for the C interface */
+    static constexpr DmaStream_t id =
+        static_cast<DmaStream_t>((CONTROLLER::index*8U) + STREAM);
+
+    /** Defines the address of the stream registers */
+    static constexpr uintptr_t address =
+        CONTROLLER::base + 0x10U + (0x18U*STREAM);
+
+    /** Defines the event flags of the stream on its flag clear register */
+    static constexpr uint32_t flags =
+        (0x3DUL<<(((STREAM%4U)*6U) + (((STREAM%4U)/2U)*4U)));
+
+    /**
+     * Returns the register block of the stream.
+    */
+    static HAL_INLINE DMA_Stream_TypeDef * stream()
+    {
+        return registerBlock<DMA_Stream_TypeDef>(address);
+    }
+
+    /**
+     * Returns the flag clear register of the stream (LIFCR or HIFCR).
+    */
+    static HAL_INLINE volatile uint32_t * flagClear()
+    {
+        return (STREAM < 4U) ? &registerBlock<DMA_TypeDef>(CONTROLLER::base)->LIFCR
+                             : &registerBlock<DMA_TypeDef>(CONTROLLER::base)->HIFCR;
+    }
+
+    /**
+     * Sets up the stream. The control and FIFO registers are written as a
+     * whole, so the stream must be disabled and the bits that are not part
+     * of the configuration are left at their reset value.
+    */
+    static HAL_INLINE void init(const DmaConfigBuilder & config)
+    {
+        stream()->CR = config.cr();
+        stream()->FCR = config.fcr();
+    }
+
+    /**
+     * Starts a transfer. The event flags of the previous transfer are
+     * cleared before the stream is enabled.
+    */
+    static HAL_INLINE void start(volatile uint32_t * const peripheral,
+        const void * const memory, const uint32_t length)
+    {
+        stream()->PAR = reinterpret_cast<uintptr_t>(peripheral);
+        stream()->M0AR = reinterpret_cast<uintptr_t>(memory);
+        stream()->NDTR = length;
+        *flagClear() = flags;
+        stream()->CR |= DMA_SxCR_EN;
+    }
+
+    /**
+     * Starts a new transfer to the peripheral of the last transfer. This is
+     * the path used to resume a stream after each completed transfer.
+    */
+    static HAL_INLINE void rearm(const void * const memory,
+        const uint32_t length)
+    {
+        stream()->M0AR = reinterpret_cast<uintptr_t>(memory);
+        stream()->NDTR = length;
+        *flagClear() = flags;
+        stream()->CR |= DMA_SxCR_EN;
+    }
+
+    /**
+     * Stops the transfer and waits until the hardware disables the stream.
+    */
+    static HAL_INLINE void stop()
+    {
+        stream()->CR &= ~DMA_SxCR_EN;
+        while(stream()->CR & DMA_SxCR_EN)
+        {
+        }
+        *flagClear() = flags;
+    }
+
+    /** Returns the state of the stream. */
+    static HAL_INLINE DmaStreamState_t state()
+    {
+        return (stream()->CR & DMA_SxCR_EN) ?
+            DMA_STREAM_ENABLED : DMA_STREAM_DISABLED;
+    }
+
+    /** Returns the number of data items left to transfer. */
+    static HAL_INLINE uint32_t remaining()
+    {
+        return stream()->NDTR;
+    }
+};
+
+/**
+ * Defines the ownership of a stream for the duration of a transfer. The
+ * handle claims the stream when the transfer is started and, when the handle
+ * is destroyed, stops the transfer if it is still running and releases the
+ * stream. The handle can be moved but not copied, so a stream has a single
+ * owner at a time.
+ *
+ * The handle must be declared after the buffer of the transfer. The objects
+ * of a scope are destroyed in reverse order, so the transfer is stopped
+ * before the buffer goes out of scope.
+ *
+ * @tparam  STREAM is the stream of the transfer (a DmaStream type).
+ *
+ * \b Example:
+ * @code
+ * using UartTx = hal::DmaStream<hal::Dma1, 6>;
+ *
+ * uint8_t message[] = "Hello";
+ * auto Transfer = hal::DmaTransfer<UartTx>::start(&USART2->DR, message,
+ *                                                 sizeof(message));
+ * if(Transfer.valid())
+ * {
+ *     Transfer.wait();
+ * }
+ * @endcode
+*/
+template <typename STREAM>
+class DmaTransfer
+{
+public:
+    /**
+     * Claims the stream and starts a transfer on it. The returned handle is
+     * not valid if the stream is owned by another user.
+    */
+    static HAL_INLINE DmaTransfer start(volatile uint32_t * const peripheral,
+        const void * const memory, const uint32_t length)
+    {
+        DmaTransfer Transfer;
+
+        if(DMA_streamClaim(STREAM::id) == DMA_OK)
+        {
+            Transfer.owned = true;
+            STREAM::start(peripheral, memory, length);
+        }
+
+        return Transfer;
+    }
+
+    DmaTransfer(const DmaTransfer &) = delete;
+    DmaTransfer & operator=(const DmaTransfer &) = delete;
+
+    HAL_INLINE DmaTransfer(DmaTransfer && other) : owned(other.owned)
+    {
+        other.owned = false;
+    }
+
+    HAL_INLINE DmaTransfer & operator=(DmaTransfer && other)
+    {
+        if(this != &other)
+        {
+            release();
+            owned = other.owned;
+            other.owned = false;
+        }
+        return *this;
+    }
+
+    HAL_INLINE ~DmaTransfer()
+    {
+        release();
+    }
+
+    /** Returns true if the handle owns the stream. */
+    HAL_INLINE bool valid() const
+    {
+        return owned;
+    }
+
+    /** Returns true once the transfer is finished (or was not started). */
+    HAL_INLINE bool poll() const
+    {
+        return (!owned) || (STREAM::state() == DMA_STREAM_DISABLED);
+    }
+
+    /** Waits in sleep mode until the transfer is finished. */
+    HAL_INLINE void wait() const
+    {
+        if(owned)
+        {
+            DMA_transferWait(STREAM::id);
+        }
+    }
+
+    /**
+     * Stops the transfer if it is still running and releases the stream
+     * before the handle is destroyed.
+    */
+    HAL_INLINE void release()
+    {
+        if(owned)
+        {
+            STREAM::stop();
+            DMA_streamRelease(STREAM::id);
+            owned = false;
+        }
+    }
+
+private:
+    HAL_INLINE DmaTransfer() : owned(false)
+    {
+    }
+
+    bool owned;     /**< True while the handle owns the stream */
+};
+
+} // namespace hal
+
+#endif /*DMA_HPP_*/
@@ -17,6 +17,7 @@
  * Includes
  *****************************************************************************/
 #include <stdio.h>
+#include <stdint.h>
 
 /*****************************************************************************
  * Preprocessor Constants
@@ -145,6 +146,16 @@ typedef enum
     DMA_FIFO_THRESHOLD_MAX    /**< Defines the maximum FIFO threshold */
 }DmaFifoThreshold_t;
 
+/**
+ * Defines the DMA circular mode.
+*/
+typedef enum
+{
+    DMA_CIRCULAR_MODE_DISABLED,  /**< Defines the circular mode disabled */
+    DMA_CIRCULAR_MODE_ENABLED,   /**< Defines the circular mode enabled */
+    DMA_CIRCULAR_MODE_MAX        /**< Defines the maximum circular mode */
+}DmaCircularMode_t;
+
 /**
  * Defines the Direct Memory Access configuration table. This table is used to
  * configure the DMA peripheral in the DMA_Init function. 
@@ -160,8 +171,21 @@ typedef struct
     DmaPeripheralIncrement_t PeripheralIncrement; /**< DMA peripheral increment mode */
     DmaFifoMode_t           FifoMode;             /**< DMA FIFO direct mode */
     DmaFifoThreshold_t      FifoThreshold;        /**< DMA FIFO threshold level */
+    DmaCircularMode_t       CircularMode;         /**< DMA circular mode */
 }DmaConfig_t;
 
+/**
+ * Defines the register images of a DMA stream. They are generated with the
+ * configuration table by scripts/cfg_generate.py, so DMA_imageInit writes
+ * the stream with plain stores instead of translating the table at boot.
+*/
+typedef struct
+{
+    DmaStream_t Stream;         /**< DMA stream */
+    uint32_t cr;                /**< Stream configuration register */
+    uint32_t fcr;               /**< Stream FIFO control register */
+}DmaStreamImage_t;
+
 /*****************************************************************************
  * Function Prototypes
 *****************************************************************************/
@@ -170,6 +194,9 @@ extern "C"{
 #endif
 
 const DmaConfig_t * const DMA_configGet(void);
+size_t DMA_configSizeGet(void);
+const DmaStreamImage_t * const DMA_imageGet(void);
+size_t DMA_imageSizeGet(void);
 
 #ifdef __cplusplus
 } // extern C
@@ -0,0 +1,86 @@
+/**
+ * @file filter.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the decimation filter. This is the
+ * header file for the definition of the interface for averaging the samples
+ * of an ADC scan sequence and reducing their rate. The samples of the
+ * channels are interleaved in the order of the sequence; each output is the
+ * rounded average of factor consecutive samples of a channel.
+ *
+ * The filter does not depend on the microcontroller: on the Cortex-M4 the
+ * samples are added two at a time with the SIMD instructions, and any other
+ * target (e.g. a host build) adds them one at a time. Both paths add the
+ * same integers, so their results are identical.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef FILTER_H_
+#define FILTER_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <assert.h>
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the maximum number of channels of a scan sequence.
+*/
+#define FILTER_CHANNELS_MAX 16U
+
+/**
+ * Defines the maximum value of a sample (12-bit, right aligned).
+*/
+#define FILTER_SAMPLE_MAX 0x0FFFU
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/**
+ * Returns the number of outputs of count samples.
+*/
+#define FILTER_OUTPUT_SIZE(count, channels, factor) \
+    (((count) / ((channels) * (factor))) * (channels))
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the decimation of a scan sequence.
+*/
+typedef struct
+{
+    uint8_t channels;           /**< Channels of the sequence (interleaved)*/
+    uint16_t factor;            /**< Samples of a channel per output*/
+}FilterDecimation_t;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+uint32_t FILTER_decimate(const FilterDecimation_t * const Decimation,
+const uint16_t * const samples, uint32_t count, uint16_t * const output);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*FILTER_H_*/
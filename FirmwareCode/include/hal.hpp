@@ -0,0 +1,62 @@
+/**
+ * @file hal.hpp
+ * @author Jose Luis Figueroa
+ * @brief The common definitions of the C++17 template interface of the
+ * drivers. In this interface each peripheral instance (DMA stream, USART
+ * port, DIO pin) is a type, and its configuration is built with constexpr
+ * builders. The register addresses and the register values are then known
+ * at compile time, so each operation compiles to direct stores on immediate
+ * addresses instead of loads through the register tables of the C drivers.
+ * The interface is header-only and uses the types of the C interface
+ * (DmaConfig_t, UsartConfig_t, DioConfig_t, ...), so both can be mixed.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef HAL_HPP_
+#define HAL_HPP_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include "stm32f4xx.h"  /*Microcontroller family header*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/**
+ * Forces the inlining of the interface functions, so the constant arguments
+ * of the call are folded into the register values.
+*/
+#define HAL_INLINE __attribute__((always_inline)) inline
+
+namespace hal
+{
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/**
+ * Returns a peripheral register block from its base address.
+ *
+ * @tparam      T is the register block type (e.g. GPIO_TypeDef).
+ * @param[in]   address is the base address of the register block.
+ *
+ * @return A pointer to the register block.
+*/
+template <typename T>
+HAL_INLINE T * registerBlock(const uintptr_t address)
+{
+    return reinterpret_cast<T *>(address);
+}
+
+} // namespace hal
+
+#endif /*HAL_HPP_*/
@@ -0,0 +1,126 @@
+/**
+ * @file i2c.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the Inter-Integrated Circuit. This is
+ * the header file for the definition of the interface for an I2C bus
+ * master on a standard microcontroller. The data of a transfer is moved by
+ * the DMA streams of the port, so a whole register block of a device is
+ * read or written in one transaction.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef I2C_H_
+#define I2C_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <assert.h>
+#include "i2c_cfg.h"    /*For I2C configuration*/
+#include "dma.h"        /*For the DMA streams of the transfers*/
+#include "dio.h"        /*For the bus recovery*/
+#include "stm32f4xx.h"  /*Microcontroller family header*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the number of SCL pulses sent by the bus recovery, enough for a
+ * device to complete the byte it was sending.
+*/
+#define I2C_RECOVERY_CLOCKS 9U
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the status returned by the I2C transfers.
+*/
+typedef enum
+{
+    I2C_OK,                 /**< The transfer was completed*/
+    I2C_NACK,               /**< The device did not acknowledge*/
+    I2C_TIMEOUT,            /**< The timeout elapsed first*/
+    I2C_BUS_ERROR,          /**< Bus error or arbitration lost*/
+    I2C_STATUS_MAX          /**< Defines the maximum I2C status*/
+}I2cStatus_t;
+
+/**
+ * Defines an I2C bus: the port, its DMA streams, and its pins as they are
+ * configured on the DIO table. The pins are used by the bus recovery; a
+ * bus without pins (NULL) is not recovered.
+*/
+typedef struct
+{
+    I2cPort_t Port;                     /**< I2C port*/
+    DmaStream_t TxStream;               /**< DMA stream of the I2C TX*/
+    DmaStream_t RxStream;               /**< DMA stream of the I2C RX*/
+    const DioConfig_t *Scl;             /**< SCL pin (or NULL)*/
+    const DioConfig_t *Sda;             /**< SDA pin (or NULL)*/
+}I2cBus_t;
+
+/**
+ * Defines a device on a bus.
+*/
+typedef struct
+{
+    const I2cBus_t *Bus;                /**< Bus of the device*/
+    uint8_t address;                    /**< 7-bit address*/
+}I2cDevice_t;
+
+/**
+ * Defines a transfer with a device: the data is written first, then read
+ * after a repeated start. A transfer without data to write only reads,
+ * and a transfer without data at all checks that the device answers.
+*/
+typedef struct
+{
+    const uint8_t *txData;              /**< Data to write (or NULL)*/
+    uint32_t txLength;                  /**< Number of bytes to write*/
+    uint8_t *rxData;                    /**< Data to read (or NULL)*/
+    uint32_t rxLength;                  /**< Number of bytes to read*/
+}I2cTransfer_t;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void I2C_init(const I2cConfig_t * const Config, size_t configSize,
+const uint32_t peripheralClock);
+I2cStatus_t I2C_transfer(const I2cDevice_t * const Device,
+const I2cTransfer_t * const Transfer, const uint32_t timeout);
+I2cStatus_t I2C_burstRead(const I2cDevice_t * const Device,
+const uint8_t reg, uint8_t * const data, const uint32_t length,
+const uint32_t timeout);
+I2cStatus_t I2C_burstWrite(const I2cDevice_t * const Device,
+const uint8_t reg, const uint8_t * const data, const uint32_t length,
+const uint32_t timeout);
+I2cStatus_t I2C_busRecover(const I2cBus_t * const Bus);
+void I2C_registerWrite(const uint32_t address, const uint32_t value);
+uint32_t I2C_registerRead(const uint32_t address);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*I2C_H_*/
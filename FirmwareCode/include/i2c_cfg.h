@@ -0,0 +1,106 @@
+/**
+ * @file i2c_cfg.h
+ * @author Jose Luis Figueroa
+ * @brief This module contains interface definitions for the I2C
+ * configuration. This is the header file for the definition of the
+ * interface for retrieving the Inter-Integrated Circuit configuration
+ * table.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef I2C_CFG_H_
+#define I2C_CFG_H_
+
+/*****************************************************************************
+ * Includes
+******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * Preprocessor Constants
+******************************************************************************/
+/**
+ * Defines the number of I2C peripherals on the processor.
+*/
+#define I2C_PORTS_NUMBER 3U
+
+/*****************************************************************************
+ * Typedefs
+******************************************************************************/
+/**
+ * Defines the I2C ports contained on the MCU device. It is used to specify
+ * the specific I2C peripheral to configure the register map.
+*/
+typedef enum
+{
+    I2C_PORT_1,         /**< I2C1 */
+    I2C_PORT_2,         /**< I2C2 */
+    I2C_PORT_3,         /**< I2C3 */
+    I2C_PORT_MAX        /**< Defines the maximum I2C port*/
+}I2cPort_t;
+
+/**
+ * Defines the I2C bus speed. The peripheral clock (APB1) must be at least
+ * 2 MHz in standard mode and 4 MHz in fast mode.
+*/
+typedef enum
+{
+    I2C_SPEED_STANDARD,     /**< Defines the standard mode (100 kHz)*/
+    I2C_SPEED_FAST,         /**< Defines the fast mode (400 kHz)*/
+    I2C_SPEED_MAX           /**< Defines the maximum I2C speed*/
+}I2cSpeed_t;
+
+/**
+ * Defines the ratio of the low to the high period of SCL in fast mode.
+ * 16/9 reaches 400 kHz with APB1 clocks that are multiples of 10 MHz.
+*/
+typedef enum
+{
+    I2C_DUTY_2,             /**< Defines tlow/thigh = 2*/
+    I2C_DUTY_16_9,          /**< Defines tlow/thigh = 16/9*/
+    I2C_DUTY_MAX            /**< Defines the maximum duty*/
+}I2cDuty_t;
+
+/**
+ * Defines the I2C enable.
+*/
+typedef enum
+{
+    I2C_DISABLED,           /**< Defines the I2C disabled*/
+    I2C_ENABLED,            /**< Defines the I2C enabled*/
+    I2C_ENABLE_MAX          /**< Defines the maximum I2C enable*/
+}I2cEnable_t;
+
+/**
+ * Defines the Inter-Integrated Circuit configuration table. This table is
+ * used to configure the I2C peripheral as a bus master in the I2C_init
+ * function. The transfers are done with the DMA streams of the port, which
+ * are configured by the DMA configuration table.
+*/
+typedef struct
+{
+    I2cPort_t           Port;           /**< I2C port*/
+    I2cSpeed_t          Speed;          /**< Standard or fast mode*/
+    I2cDuty_t           Duty;           /**< SCL duty in fast mode*/
+    I2cEnable_t         Enable;         /**< I2C enable*/
+}I2cConfig_t;
+
+/*****************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+const I2cConfig_t * const I2C_configGet(void);
+size_t I2C_configSizeGet(void);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*I2C_CFG_H_*/
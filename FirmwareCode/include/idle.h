@@ -0,0 +1,85 @@
+/**
+ * @file idle.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the event-driven idle. This is the
+ * header file for the definition of the interface for waiting on a hardware
+ * flag in sleep mode instead of polling it. The processor sleeps with WFE
+ * and any interrupt that becomes pending wakes it up (SEVONPEND), even if the
+ * interrupt is disabled in the NVIC. The cycles spent asleep are counted, so
+ * the CPU utilization of a workload can be measured.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef IDLE_H_
+#define IDLE_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include "stm32f4xx.h"  /*Microcontroller family header*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the result of a bounded wait.
+*/
+typedef enum
+{
+    IDLE_CONDITION_MET,         /**< The awaited condition was met */
+    IDLE_TIMEOUT,               /**< The deadline was reached first */
+    IDLE_STATUS_MAX             /**< Defines the maximum wait result */
+}IdleStatus_t;
+
+/**
+ * Defines the idle statistics since the last reset. The CPU utilization is
+ * 1 - (idleCycles / elapsedCycles).
+*/
+typedef struct
+{
+    uint64_t idleCycles;        /**< Processor cycles spent asleep */
+    uint64_t elapsedCycles;     /**< Processor cycles since the reset */
+    uint32_t sleeps;            /**< Number of times the processor slept */
+}IdleStats_t;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void IDLE_init(void);
+void IDLE_sleep(void);
+void IDLE_waitFor(const volatile uint32_t * const address, uint32_t mask,
+uint32_t value, IRQn_Type Irq);
+IdleStatus_t IDLE_waitForDeadline(const volatile uint32_t * const address,
+uint32_t mask, uint32_t value, IRQn_Type Irq, uint32_t deadline);
+void IDLE_statsGet(IdleStats_t * const Stats);
+void IDLE_statsReset(void);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*IDLE_H_*/
@@ -0,0 +1,143 @@
+/**
+ * @file pipe.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the ADC to USART streaming pipeline.
+ * This is the header file for the definition of the interface for sending
+ * the samples of the ADC on a serial line without copying them. The ADC
+ * fills pool blocks after a reserved header; each full block is framed in
+ * place (header and CRC trailer) and sent by the TX stream of the USART,
+ * and it only returns to the pool once its transfer is complete.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef PIPE_H_
+#define PIPE_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <assert.h>
+#include "adc.h"        /*For the acquisition*/
+#include "usart_cfg.h"  /*For the USART ports*/
+#include "dma.h"        /*For the TX stream*/
+#include "stm32f4xx.h"  /*Microcontroller family header*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the size of the header and of the trailer (CRC) of a frame in
+ * bytes. The header keeps the samples aligned on 4 bytes.
+*/
+#define PIPE_HEADER_SIZE 8U
+#define PIPE_TRAILER_SIZE 4U
+
+/**
+ * Defines the first bytes of every frame (A5h, 5Ah on the line).
+*/
+#define PIPE_SYNC 0x5AA5U
+
+/**
+ * Defines the number of frames that can wait for the TX stream.
+*/
+#define PIPE_QUEUE_SIZE 8U
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/**
+ * Gives the size in bytes of a frame of the given number of samples, i.e.
+ * the size of the pool blocks it needs.
+*/
+#define PIPE_FRAME_SIZE(samples) \
+    (PIPE_HEADER_SIZE + (2U * (samples)) + PIPE_TRAILER_SIZE)
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the header of a frame, followed by the samples (little-endian,
+ * interleaved in the order of the sequence) and by the CRC-32 of the header
+ * and the samples: polynomial 04C11DB7h, initial value FFFFFFFFh, without
+ * reflection nor final XOR, computed on little-endian 32-bit words (the
+ * hardware CRC unit).
+*/
+typedef struct
+{
+    uint16_t sync;              /**< PIPE_SYNC */
+    uint16_t sequence;          /**< Counter of the frames sent */
+    uint16_t samples;           /**< Number of samples of the frame */
+    uint16_t dropped;           /**< Frames dropped before this one */
+}PipeHeader_t;
+
+/**
+ * Defines the data needed to stream an acquisition. The sequence, the
+ * sampling time and the trigger are taken from Acquisition; its buffers,
+ * its filter and its callback are set by the pipeline.
+*/
+typedef struct
+{
+    const AdcAcquisitionConfig_t *Acquisition; /**< ADC scan sequence */
+    uint32_t samples;           /**< Samples of each frame (even) */
+    UsartPort_t Port;           /**< USART port of the TX stream */
+    DmaStream_t TxStream;       /**< DMA stream of the USART TX */
+    uint32_t baud;              /**< Baud rate of the port */
+    uint8_t characterBits;      /**< Bits of a character (10 for 8N1) */
+}PipeConfig_t;
+
+/**
+ * Defines the status returned by PIPE_start.
+*/
+typedef enum
+{
+    PIPE_OK,                /**< The pipeline was started*/
+    PIPE_INVALID_SAMPLES,   /**< The samples are zero, odd or too many*/
+    PIPE_NO_BLOCK,          /**< The pool has no blocks of the frame size*/
+    PIPE_STATUS_MAX         /**< Defines the maximum PIPE status*/
+}PipeStatus_t;
+
+/**
+ * Defines the statistics of the pipeline. The latency of a frame is the
+ * time from the end of its ADC buffer to the end of its TX transfer, i.e.
+ * the wait on the queue plus the time of the frame on the line.
+*/
+typedef struct
+{
+    uint32_t frames;            /**< Frames sent */
+    uint32_t dropped;           /**< Frames dropped, no block or queue */
+    uint32_t latency;           /**< Latency of the last frame (us) */
+    uint32_t latencyMax;        /**< Maximum latency of a frame (us) */
+    uint32_t queuedMax;         /**< Maximum frames waiting to be sent */
+}PipeStats_t;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+PipeStatus_t PIPE_start(const PipeConfig_t * const Config);
+void PIPE_stop(void);
+void PIPE_txIrqHandler(void);
+void PIPE_statsGet(PipeStats_t * const Stats);
+uint32_t PIPE_rateMaxGet(const PipeConfig_t * const Config);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*PIPE_H_*/
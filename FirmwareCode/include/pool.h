@@ -0,0 +1,82 @@
+/**
+ * @file pool.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the DMA buffer pool. This is the
+ * header file for the definition of the interface for allocating DMA
+ * buffers out of statically allocated blocks. The blocks of each size class
+ * are aligned to POOL_ALIGNMENT, the allocation and the release take a
+ * bounded time and are lock-free, so both can be called from the main loop
+ * and from interrupts. Each block records its owner (pool, software, or
+ * DMA), so a buffer is never released while a transfer is using it.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef POOL_H_
+#define POOL_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <assert.h>
+#include "pool_cfg.h"   /*For the pool configuration*/
+#include "stm32f4xx.h"  /*Microcontroller family header*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the statistics of a size class. The RAM of the class is
+ * blockSize * blockCount bytes; the bytes of the used blocks that were not
+ * requested (used * blockSize - requestedBytes) are the internal
+ * fragmentation.
+*/
+typedef struct
+{
+    uint32_t blockSize;         /**< Size of each block in bytes */
+    uint32_t blockCount;        /**< Number of blocks of the class */
+    uint32_t used;              /**< Blocks currently allocated */
+    uint32_t peak;              /**< Maximum blocks allocated at a time */
+    uint32_t requestedBytes;    /**< Bytes requested by the used blocks */
+    uint32_t failures;          /**< Allocations refused, class exhausted */
+}PoolStats_t;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void POOL_init(const PoolConfig_t * const Config, size_t configSize);
+void * POOL_alloc(const size_t size);
+void POOL_free(void * const block);
+void POOL_ownerSet(void * const block, const PoolOwner_t Owner);
+PoolOwner_t POOL_ownerGet(const void * const block);
+void POOL_statsGet(const uint8_t sizeClass, PoolStats_t * const Stats);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*POOL_H_*/
@@ -0,0 +1,87 @@
+/**
+ * @file pool_cfg.h
+ * @author Jose Luis Figueroa
+ * @brief This module contains interface definitions for the DMA buffer pool
+ * configuration. This is the header file for the definition of the
+ * interface for retrieving the pool configuration table.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef POOL_CFG_H_
+#define POOL_CFG_H_
+
+/*****************************************************************************
+ * Includes
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * Preprocessor Constants
+******************************************************************************/
+/**
+ * Defines the alignment of the blocks in bytes. A block can then be read and
+ * written by the DMA with word transfers and INCR4 bursts.
+*/
+#define POOL_ALIGNMENT 16U
+
+/**
+ * Defines the maximum number of size classes of the pool.
+*/
+#define POOL_CLASSES_NUMBER 4U
+
+/*****************************************************************************
+ * Typedefs
+******************************************************************************/
+/**
+ * Defines the owner of a block of the pool.
+*/
+typedef enum
+{
+    POOL_OWNER_FREE,        /**< The block is in the pool */
+    POOL_OWNER_CPU,         /**< The block is used by the software */
+    POOL_OWNER_DMA,         /**< The block is used by a DMA transfer */
+    POOL_OWNER_MAX          /**< Defines the maximum block owner */
+}PoolOwner_t;
+
+/**
+ * Defines the state of a block of the pool.
+*/
+typedef struct
+{
+    volatile uint8_t Owner;     /**< PoolOwner_t of the block */
+    uint16_t requested;         /**< Bytes requested on the allocation */
+}PoolBlock_t;
+
+/**
+ * Defines the DMA buffer pool configuration table. Each row is a size class
+ * with its own statically allocated storage. This table is used to build the
+ * pool in the POOL_init function. The rows are sorted by block size, from
+ * the smallest to the largest.
+*/
+typedef struct
+{
+    uint8_t *storage;           /**< Storage of the blocks (aligned) */
+    PoolBlock_t *Blocks;        /**< State of each block */
+    uint16_t blockSize;         /**< Size of each block in bytes */
+    uint16_t blockCount;        /**< Number of blocks of the class */
+}PoolConfig_t;
+
+/*****************************************************************************
+ * Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+const PoolConfig_t * const POOL_configGet(void);
+size_t POOL_configSizeGet(void);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*POOL_CFG_H_*/
@@ -0,0 +1,119 @@
+/**
+ * @file pwm.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the DMA-driven PWM engine. This is the
+ * header file for the definition of the interface for updating up to four
+ * PWM channels of a timer on every period. Each update event of the timer
+ * triggers a DMA burst through the DMA address register (DMAR) that
+ * rewrites the compare registers of the channels from a table, so the duty
+ * cycles change without CPU involvement.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef PWM_H_
+#define PWM_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <assert.h>
+#include "dma.h"        /*For the DMA stream transfers*/
+#include "stm32f4xx.h"  /*Microcontroller family header*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the maximum number of counts of the 16-bit prescaler and
+ * auto-reload registers of the PWM timer.
+*/
+#define PWM_TIMER_COUNTS 65536UL
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the channels of the PWM timer. The value is the position of the
+ * compare register of the channel after CCR1.
+*/
+typedef enum
+{
+    PWM_CHANNEL_1,      /**< Channel 1 (CCR1) */
+    PWM_CHANNEL_2,      /**< Channel 2 (CCR2) */
+    PWM_CHANNEL_3,      /**< Channel 3 (CCR3) */
+    PWM_CHANNEL_4,      /**< Channel 4 (CCR4) */
+    PWM_CHANNEL_MAX     /**< Defines the maximum PWM channel */
+}PwmChannel_t;
+
+/**
+ * Defines the active level of the outputs, i.e. the level while the counter
+ * is below the compare value.
+*/
+typedef enum
+{
+    PWM_POLARITY_HIGH,  /**< The output is high during the duty cycle */
+    PWM_POLARITY_LOW,   /**< The output is low during the duty cycle */
+    PWM_POLARITY_MAX    /**< Defines the maximum PWM polarity */
+}PwmPolarity_t;
+
+/**
+ * Defines the state of the PWM engine.
+*/
+typedef enum
+{
+    PWM_IDLE,           /**< The outputs are not driven by the timer */
+    PWM_RUNNING,        /**< The table is being played */
+    PWM_STATE_MAX       /**< Defines the maximum PWM state */
+}PwmState_t;
+
+/**
+ * Defines the data needed to play a duty table. The channels from
+ * FirstChannel on are updated together, so the table holds channelCount
+ * compare values per period (a frame), one frame after the other. A
+ * compare value of period or more gives a 100% duty cycle.
+*/
+typedef struct
+{
+    PwmChannel_t FirstChannel;  /**< First channel updated by the burst */
+    uint8_t channelCount;       /**< Number of consecutive channels (1-4) */
+    PwmPolarity_t Polarity;     /**< Active level of the outputs */
+    uint32_t prescaler;         /**< Timer clock cycles of each count */
+    uint32_t period;            /**< Counts of each PWM period */
+    const uint32_t *duties;     /**< Compare values, one frame per period */
+    uint32_t length;            /**< Number of frames of the table */
+}PwmBurstConfig_t;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void PWM_start(const PwmBurstConfig_t * const Config);
+void PWM_stop(void);
+PwmState_t PWM_stateGet(void);
+uint32_t PWM_frameGet(void);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*PWM_H_*/
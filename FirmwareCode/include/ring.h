@@ -0,0 +1,845 @@
+/**
+ * @file ring.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition and implementation of the lock-free ring
+ * buffers. This is the header file for handing data between interrupt
+ * handlers and the main loop without disabling interrupts:
+ *     o RingSpsc_t: one producer and one consumer (e.g. a DMA interrupt and
+ *       the main loop). The bytes are reserved and committed in batches.
+ *     o RingMpsc_t: several producers (e.g. interrupts of any priority) and
+ *       one consumer. The data is reserved and committed in records, which
+ *       can be committed in any order.
+ * Both rings hand out contiguous regions of their buffer, which can be the
+ * memory of a DMA transfer directly. The indexes are C11 atomics; on the
+ * Cortex-M4 the read-modify-write operations are LDREX/STREX loops and the
+ * acquire/release orderings are DMB instructions.
+ *
+ * The functions are static inline, so a ring used on a single module does
+ * not need a translation unit of its own.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef RING_H_
+#define RING_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdatomic.h>
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the size of the header of a record of a RingMpsc_t in bytes. The
+ * records are aligned on this size.
+*/
+#define RING_RECORD_HEADER_SIZE 4U
+
+/**
+ * Defines the flags of the header of a record: the record was committed,
+ * and the record is the padding left before the end of the buffer. The
+ * other bits hold the length of the record.
+*/
+#define RING_RECORD_COMMITTED 0x80000000UL
+#define RING_RECORD_PADDING 0x40000000UL
+#define RING_RECORD_LENGTH 0x3FFFFFFFUL
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/**
+ * Gives the bytes taken on a RingMpsc_t by a record of the given length.
+*/
+#define RING_RECORD_SIZE(length) (RING_RECORD_HEADER_SIZE + \
+    (((length) + RING_RECORD_HEADER_SIZE - 1U) & \
+     ~(RING_RECORD_HEADER_SIZE - 1U)))
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines a single-producer single-consumer ring. The indexes run freely
+ * and are reduced with the mask of the size, a power of two; the ring
+ * holds head - tail bytes. Only the producer writes head and only the
+ * consumer writes tail.
+*/
+typedef struct
+{
+    uint8_t *buffer;                    /**< Storage of the ring */
+    uint32_t size;                      /**< Bytes of the storage */
+    atomic_uint_least32_t head;         /**< Index of the next write */
+    atomic_uint_least32_t tail;         /**< Index of the next read */
+}RingSpsc_t;
+
+/**
+ * Defines a multi-producer single-consumer ring. The producers reserve a
+ * record by moving reserve forward (compare and exchange), fill it, and
+ * commit it by setting the flag of its header. The consumer reads the
+ * records in order up to the first one that is not committed, and clears
+ * them when it releases them, so a header is only seen as committed once
+ * its producer commits it.
+*/
+typedef struct
+{
+    uint8_t *buffer;                    /**< Storage (aligned on 4 bytes) */
+    uint32_t size;                      /**< Bytes of the storage */
+    atomic_uint_least32_t reserve;      /**< Index of the next record */
+    atomic_uint_least32_t tail;         /**< Index of the oldest record */
+}RingMpsc_t;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: RING_dmaBarrier()
+ *//**
+ * \b Description:
+ * This function is used to complete the memory accesses of the processor
+ * before a DMA transfer is started on a region of a ring (a DMB on the
+ * Cortex-M4): the bytes committed by the producer before a stream reads
+ * them, or the bytes read by the consumer before a stream writes over
+ * them. The acquire and release orderings of the rings only order the
+ * processor against itself, and the register write that enables a stream
+ * is not an atomic operation.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: The previous memory accesses are complete. <br>
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * length = RING_spscReadPeek(&TxRing, &region);
+ * RING_dmaBarrier();
+ * DMA_transferConfig(&DmaTransferConfig);
+ * @endcode
+ *
+ * @see RING_dmaBarrier
+ * @see RING_spscInit
+ * @see RING_mpscInit
+ *
+*****************************************************************************/
+static inline void RING_dmaBarrier(void)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+/*****************************************************************************
+ * Function: RING_spscInit()
+ *//**
+ * \b Description:
+ * This function is used to initialize a single-producer single-consumer
+ * ring on a buffer. The ring is empty.
+ *
+ * PRE-CONDITION: size is a power of two. <br>
+ * PRE-CONDITION: Neither the producer nor the consumer uses the ring. <br>
+ *
+ * POST-CONDITION: The ring is empty. <br>
+ *
+ * @param[out]  Ring is a pointer to the ring.
+ * @param[in]   buffer is the storage of the ring.
+ * @param[in]   size is the number of bytes of the storage.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * static uint8_t rxStorage[512];
+ * static RingSpsc_t RxRing;
+ *
+ * RING_spscInit(&RxRing, rxStorage, sizeof(rxStorage));
+ * @endcode
+ *
+ * @see RING_spscInit
+ * @see RING_spscUsedGet
+ * @see RING_spscWriteReserve
+ * @see RING_spscWriteCommit
+ * @see RING_spscReadPeek
+ * @see RING_spscReadRelease
+ * @see RING_spscWrite
+ * @see RING_spscRead
+ *
+*****************************************************************************/
+static inline void RING_spscInit(RingSpsc_t * const Ring,
+uint8_t * const buffer, const uint32_t size)
+{
+    /* Prevent to use a size the indexes cannot be reduced with */
+    assert((size > 0U) && ((size & (size - 1U)) == 0U));
+
+    Ring->buffer = buffer;
+    Ring->size = size;
+    atomic_init(&Ring->head, 0U);
+    atomic_init(&Ring->tail, 0U);
+}
+
+/*****************************************************************************
+ * Function: RING_spscUsedGet()
+ *//**
+ * \b Description:
+ * This function is used to get the number of bytes of a ring. The value is
+ * exact for the consumer, and a minimum for the producer.
+ *
+ * PRE-CONDITION: The ring is initialized (RING_spscInit). <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   Ring is a pointer to the ring.
+ *
+ * @return The number of bytes written and not read.
+ *
+ * \b Example:
+ * @code
+ * if(RING_spscUsedGet(&RxRing) >= MESSAGE_SIZE)
+ * {
+ *     (void)RING_spscRead(&RxRing, message, MESSAGE_SIZE);
+ * }
+ * @endcode
+ *
+ * @see RING_spscInit
+ * @see RING_spscUsedGet
+ * @see RING_spscWriteReserve
+ * @see RING_spscWriteCommit
+ * @see RING_spscReadPeek
+ * @see RING_spscReadRelease
+ * @see RING_spscWrite
+ * @see RING_spscRead
+ *
+*****************************************************************************/
+static inline uint32_t RING_spscUsedGet(RingSpsc_t * const Ring)
+{
+    return atomic_load_explicit(&Ring->head, memory_order_acquire) -
+        atomic_load_explicit(&Ring->tail, memory_order_acquire);
+}
+
+/*****************************************************************************
+ * Function: RING_spscWriteReserve()
+ *//**
+ * \b Description:
+ * This function is used by the producer to get the free region of a ring
+ * that is contiguous in memory, up to the end of the buffer. The region
+ * can be filled by the processor or by a DMA stream, and is handed to the
+ * consumer by RING_spscWriteCommit; it can be committed in parts. The
+ * consumer frees bytes only; the region stays valid until it is committed.
+ *
+ * PRE-CONDITION: The ring is initialized (RING_spscInit). <br>
+ * PRE-CONDITION: Only the producer calls the function. <br>
+ *
+ * POST-CONDITION: region points to the first free byte. <br>
+ *
+ * @param[in]   Ring is a pointer to the ring.
+ * @param[out]  region is the first byte of the free region.
+ *
+ * @return The number of bytes of the region (0 if the ring is full).
+ *
+ * \b Example:
+ * @code
+ * uint8_t *region;
+ * uint32_t free = RING_spscWriteReserve(&RxRing, &region);
+ *
+ * //The USART RX stream fills the region; the interrupt commits it
+ * DMA_transferRearm(DMA1_STREAM_5, (uint32_t*)region, free);
+ * @endcode
+ *
+ * @see RING_spscInit
+ * @see RING_spscUsedGet
+ * @see RING_spscWriteReserve
+ * @see RING_spscWriteCommit
+ * @see RING_spscReadPeek
+ * @see RING_spscReadRelease
+ * @see RING_spscWrite
+ * @see RING_spscRead
+ *
+*****************************************************************************/
+static inline uint32_t RING_spscWriteReserve(RingSpsc_t * const Ring,
+uint8_t ** const region)
+{
+    const uint32_t head = atomic_load_explicit(&Ring->head,
+        memory_order_relaxed);
+    const uint32_t tail = atomic_load_explicit(&Ring->tail,
+        memory_order_acquire);
+    const uint32_t offset = head & (Ring->size - 1U);
+    const uint32_t free = Ring->size - (head - tail);
+    const uint32_t contiguous = Ring->size - offset;
+
+    *region = &Ring->buffer[offset];
+
+    return (free < contiguous) ? free : contiguous;
+}
+
+/*****************************************************************************
+ * Function: RING_spscWriteCommit()
+ *//**
+ * \b Description:
+ * This function is used by the producer to hand the first bytes of the
+ * reserved region to the consumer. The release ordering makes the bytes
+ * visible to the consumer before the new head.
+ *
+ * PRE-CONDITION: length is lower or equal than the reserved bytes. <br>
+ * PRE-CONDITION: Only the producer calls the function. <br>
+ *
+ * POST-CONDITION: The bytes can be read by the consumer. <br>
+ *
+ * @param[in]   Ring is a pointer to the ring.
+ * @param[in]   length is the number of bytes written.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * received = free - DMA_transferRemainingGet(DMA1_STREAM_5);
+ * RING_spscWriteCommit(&RxRing, received);
+ * @endcode
+ *
+ * @see RING_spscInit
+ * @see RING_spscUsedGet
+ * @see RING_spscWriteReserve
+ * @see RING_spscWriteCommit
+ * @see RING_spscReadPeek
+ * @see RING_spscReadRelease
+ * @see RING_spscWrite
+ * @see RING_spscRead
+ *
+*****************************************************************************/
+static inline void RING_spscWriteCommit(RingSpsc_t * const Ring,
+const uint32_t length)
+{
+    const uint32_t head = atomic_load_explicit(&Ring->head,
+        memory_order_relaxed);
+
+    /* Prevent to commit more bytes than there is room for */
+    assert((head - atomic_load_explicit(&Ring->tail, memory_order_relaxed) +
+        length) <= Ring->size);
+
+    atomic_store_explicit(&Ring->head, head + length, memory_order_release);
+}
+
+/*****************************************************************************
+ * Function: RING_spscReadPeek()
+ *//**
+ * \b Description:
+ * This function is used by the consumer to get the region of a ring that
+ * holds data and is contiguous in memory, up to the end of the buffer. The
+ * region can be read by the processor or by a DMA stream, and is given
+ * back to the producer by RING_spscReadRelease; it can be released in
+ * parts.
+ *
+ * PRE-CONDITION: The ring is initialized (RING_spscInit). <br>
+ * PRE-CONDITION: Only the consumer calls the function. <br>
+ *
+ * POST-CONDITION: region points to the oldest byte. <br>
+ *
+ * @param[in]   Ring is a pointer to the ring.
+ * @param[out]  region is the first byte of the region.
+ *
+ * @return The number of bytes of the region (0 if the ring is empty).
+ *
+ * \b Example:
+ * @code
+ * uint8_t *region;
+ * uint32_t length = RING_spscReadPeek(&TxRing, &region);
+ *
+ * //The USART TX stream sends the region; the interrupt releases it
+ * RING_dmaBarrier();
+ * DMA_transferRearm(DMA1_STREAM_6, (uint32_t*)region, length);
+ * @endcode
+ *
+ * @see RING_spscInit
+ * @see RING_spscUsedGet
+ * @see RING_spscWriteReserve
+ * @see RING_spscWriteCommit
+ * @see RING_spscReadPeek
+ * @see RING_spscReadRelease
+ * @see RING_spscWrite
+ * @see RING_spscRead
+ *
+*****************************************************************************/
+static inline uint32_t RING_spscReadPeek(RingSpsc_t * const Ring,
+uint8_t ** const region)
+{
+    const uint32_t tail = atomic_load_explicit(&Ring->tail,
+        memory_order_relaxed);
+    const uint32_t head = atomic_load_explicit(&Ring->head,
+        memory_order_acquire);
+    const uint32_t offset = tail & (Ring->size - 1U);
+    const uint32_t used = head - tail;
+    const uint32_t contiguous = Ring->size - offset;
+
+    *region = &Ring->buffer[offset];
+
+    return (used < contiguous) ? used : contiguous;
+}
+
+/*****************************************************************************
+ * Function: RING_spscReadRelease()
+ *//**
+ * \b Description:
+ * This function is used by the consumer to give the first bytes of the
+ * peeked region back to the producer. The release ordering completes the
+ * reads of the bytes before the producer can write over them.
+ *
+ * PRE-CONDITION: length is lower or equal than the peeked bytes. <br>
+ * PRE-CONDITION: Only the consumer calls the function. <br>
+ *
+ * POST-CONDITION: The bytes can be written by the producer. <br>
+ *
+ * @param[in]   Ring is a pointer to the ring.
+ * @param[in]   length is the number of bytes read.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * if(DMA_eventClear(DMA1_STREAM_6, DMA_INTERRUPT_TRANSFER_COMPLETE))
+ * {
+ *     RING_spscReadRelease(&TxRing, length);
+ * }
+ * @endcode
+ *
+ * @see RING_spscInit
+ * @see RING_spscUsedGet
+ * @see RING_spscWriteReserve
+ * @see RING_spscWriteCommit
+ * @see RING_spscReadPeek
+ * @see RING_spscReadRelease
+ * @see RING_spscWrite
+ * @see RING_spscRead
+ *
+*****************************************************************************/
+static inline void RING_spscReadRelease(RingSpsc_t * const Ring,
+const uint32_t length)
+{
+    const uint32_t tail = atomic_load_explicit(&Ring->tail,
+        memory_order_relaxed);
+
+    /* Prevent to release more bytes than the ring holds */
+    assert(length <= (atomic_load_explicit(&Ring->head,
+        memory_order_relaxed) - tail));
+
+    atomic_store_explicit(&Ring->tail, tail + length, memory_order_release);
+}
+
+/*****************************************************************************
+ * Function: RING_spscWrite()
+ *//**
+ * \b Description:
+ * This function is used by the producer to copy data to a ring, in up to
+ * two regions when the free space wraps around the end of the buffer. The
+ * data is committed at once.
+ *
+ * PRE-CONDITION: The ring is initialized (RING_spscInit). <br>
+ * PRE-CONDITION: Only the producer calls the function. <br>
+ *
+ * POST-CONDITION: The bytes written can be read by the consumer. <br>
+ *
+ * @param[in]   Ring is a pointer to the ring.
+ * @param[in]   data is the data to write.
+ * @param[in]   length is the number of bytes of the data.
+ *
+ * @return The number of bytes written, lower than length if the ring is
+ *         full.
+ *
+ * \b Example:
+ * @code
+ * (void)RING_spscWrite(&TxRing, (const uint8_t*)"ready\n", 6U);
+ * @endcode
+ *
+ * @see RING_spscInit
+ * @see RING_spscUsedGet
+ * @see RING_spscWriteReserve
+ * @see RING_spscWriteCommit
+ * @see RING_spscReadPeek
+ * @see RING_spscReadRelease
+ * @see RING_spscWrite
+ * @see RING_spscRead
+ *
+*****************************************************************************/
+static inline uint32_t RING_spscWrite(RingSpsc_t * const Ring,
+const uint8_t * const data, const uint32_t length)
+{
+    const uint32_t head = atomic_load_explicit(&Ring->head,
+        memory_order_relaxed);
+    const uint32_t tail = atomic_load_explicit(&Ring->tail,
+        memory_order_acquire);
+    const uint32_t offset = head & (Ring->size - 1U);
+    const uint32_t free = Ring->size - (head - tail);
+    const uint32_t count = (length < free) ? length : free;
+    const uint32_t first = ((Ring->size - offset) < count) ?
+        (Ring->size - offset) : count;
+
+    memcpy(&Ring->buffer[offset], data, first);
+    memcpy(&Ring->buffer[0], &data[first], count - first);
+    atomic_store_explicit(&Ring->head, head + count, memory_order_release);
+
+    return count;
+}
+
+/*****************************************************************************
+ * Function: RING_spscRead()
+ *//**
+ * \b Description:
+ * This function is used by the consumer to copy data from a ring, in up to
+ * two regions when the data wraps around the end of the buffer. The data
+ * is released at once.
+ *
+ * PRE-CONDITION: The ring is initialized (RING_spscInit). <br>
+ * PRE-CONDITION: Only the consumer calls the function. <br>
+ *
+ * POST-CONDITION: The bytes read can be written by the producer. <br>
+ *
+ * @param[in]   Ring is a pointer to the ring.
+ * @param[out]  data is the buffer of the data.
+ * @param[in]   length is the size of the buffer.
+ *
+ * @return The number of bytes read, lower than length if the ring holds
+ *         less.
+ *
+ * \b Example:
+ * @code
+ * uint8_t command[16];
+ * uint32_t length = RING_spscRead(&RxRing, command, sizeof(command));
+ * @endcode
+ *
+ * @see RING_spscInit
+ * @see RING_spscUsedGet
+ * @see RING_spscWriteReserve
+ * @see RING_spscWriteCommit
+ * @see RING_spscReadPeek
+ * @see RING_spscReadRelease
+ * @see RING_spscWrite
+ * @see RING_spscRead
+ *
+*****************************************************************************/
+static inline uint32_t RING_spscRead(RingSpsc_t * const Ring,
+uint8_t * const data, const uint32_t length)
+{
+    const uint32_t tail = atomic_load_explicit(&Ring->tail,
+        memory_order_relaxed);
+    const uint32_t head = atomic_load_explicit(&Ring->head,
+        memory_order_acquire);
+    const uint32_t offset = tail & (Ring->size - 1U);
+    const uint32_t used = head - tail;
+    const uint32_t count = (length < used) ? length : used;
+    const uint32_t first = ((Ring->size - offset) < count) ?
+        (Ring->size - offset) : count;
+
+    memcpy(data, &Ring->buffer[offset], first);
+    memcpy(&data[first], &Ring->buffer[0], count - first);
+    atomic_store_explicit(&Ring->tail, tail + count, memory_order_release);
+
+    return count;
+}
+
+/*****************************************************************************
+ * Function: RING_mpscInit()
+ *//**
+ * \b Description:
+ * This function is used to initialize a multi-producer single-consumer
+ * ring on a buffer. The buffer is cleared, as a record is committed when
+ * its header has the committed flag.
+ *
+ * PRE-CONDITION: size is a power of two, of 8 bytes or more. <br>
+ * PRE-CONDITION: buffer is aligned on 4 bytes. <br>
+ * PRE-CONDITION: Neither the producers nor the consumer use the ring. <br>
+ *
+ * POST-CONDITION: The ring is empty. <br>
+ *
+ * @param[out]  Ring is a pointer to the ring.
+ * @param[in]   buffer is the storage of the ring.
+ * @param[in]   size is the number of bytes of the storage.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * static uint8_t eventStorage[1024] __attribute__((aligned(4)));
+ * static RingMpsc_t EventRing;
+ *
+ * RING_mpscInit(&EventRing, eventStorage, sizeof(eventStorage));
+ * @endcode
+ *
+ * @see RING_mpscInit
+ * @see RING_mpscReserve
+ * @see RING_mpscCommit
+ * @see RING_mpscPeek
+ * @see RING_mpscRelease
+ *
+*****************************************************************************/
+static inline void RING_mpscInit(RingMpsc_t * const Ring,
+uint8_t * const buffer, const uint32_t size)
+{
+    /* Prevent to use a size or an alignment the records do not fit */
+    assert((size >= (2U * RING_RECORD_HEADER_SIZE)) &&
+           ((size & (size - 1U)) == 0U));
+    assert(((uintptr_t)buffer & (RING_RECORD_HEADER_SIZE - 1U)) == 0U);
+
+    memset(buffer, 0, size);
+    Ring->buffer = buffer;
+    Ring->size = size;
+    atomic_init(&Ring->reserve, 0U);
+    atomic_init(&Ring->tail, 0U);
+}
+
+/*****************************************************************************
+ * Function: RING_mpscReserve()
+ *//**
+ * \b Description:
+ * This function is used by a producer to reserve a record of a ring. The
+ * record is contiguous in memory: when it does not fit before the end of
+ * the buffer, the rest of the buffer is left as padding and the record is
+ * placed at its start. The reservation never waits for another producer,
+ * so it can be called from interrupts of any priority; the record is
+ * handed to the consumer by RING_mpscCommit.
+ *
+ * PRE-CONDITION: The ring is initialized (RING_mpscInit). <br>
+ * PRE-CONDITION: RING_RECORD_SIZE(length) is lower or equal than the size
+ *                of the ring. <br>
+ *
+ * POST-CONDITION: The record belongs to the producer until it is
+ *                 committed. <br>
+ *
+ * @param[in]   Ring is a pointer to the ring.
+ * @param[in]   length is the number of bytes of the record.
+ *
+ * @return The first byte of the record (aligned on 4 bytes), or NULL if
+ *         the ring has no room.
+ *
+ * \b Example:
+ * @code
+ * uint8_t * const record = RING_mpscReserve(&EventRing, 8U);
+ *
+ * if(record != NULL)
+ * {
+ *     memcpy(record, &event, 8U);
+ *     RING_mpscCommit(&EventRing, record);
+ * }
+ * @endcode
+ *
+ * @see RING_mpscInit
+ * @see RING_mpscReserve
+ * @see RING_mpscCommit
+ * @see RING_mpscPeek
+ * @see RING_mpscRelease
+ *
+*****************************************************************************/
+static inline uint8_t * RING_mpscReserve(RingMpsc_t * const Ring,
+const uint32_t length)
+{
+    const uint32_t need = RING_RECORD_SIZE(length);
+    uint32_t reserve;
+    uint32_t tail;
+    uint32_t offset;
+    uint32_t padding;
+
+    /* Prevent to reserve a record that never fits */
+    assert((length <= RING_RECORD_LENGTH) && (need <= Ring->size));
+
+    reserve = atomic_load_explicit(&Ring->reserve, memory_order_relaxed);
+    do
+    {
+        offset = reserve & (Ring->size - 1U);
+        padding = ((Ring->size - offset) < need) ? (Ring->size - offset) : 0U;
+
+        /* The cleared records of the consumer are seen before they are
+         * written
+        */
+        tail = atomic_load_explicit(&Ring->tail, memory_order_acquire);
+        if(((reserve + padding + need) - tail) > Ring->size)
+        {
+            return NULL;
+        }
+    }while(!atomic_compare_exchange_weak_explicit(&Ring->reserve, &reserve,
+        reserve + padding + need, memory_order_relaxed,
+        memory_order_relaxed));
+
+    /* The padding is committed at once, the record when it is filled */
+    if(padding > 0U)
+    {
+        atomic_store_explicit(
+            (atomic_uint_least32_t*)(void*)&Ring->buffer[offset],
+            RING_RECORD_COMMITTED | RING_RECORD_PADDING | padding,
+            memory_order_release);
+        offset = 0U;
+    }
+
+    atomic_store_explicit(
+        (atomic_uint_least32_t*)(void*)&Ring->buffer[offset], length,
+        memory_order_relaxed);
+
+    return &Ring->buffer[offset + RING_RECORD_HEADER_SIZE];
+}
+
+/*****************************************************************************
+ * Function: RING_mpscCommit()
+ *//**
+ * \b Description:
+ * This function is used by a producer to hand a reserved record to the
+ * consumer. The records can be committed in any order; the consumer reads
+ * them in the order they were reserved. The release ordering makes the
+ * bytes of the record visible to the consumer before its flag.
+ *
+ * PRE-CONDITION: record was returned by RING_mpscReserve and was not
+ *                committed. <br>
+ *
+ * POST-CONDITION: The record can be read by the consumer. <br>
+ *
+ * @param[in]   Ring is a pointer to the ring.
+ * @param[in]   record is the first byte of the record.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * RING_mpscCommit(&EventRing, record);
+ * @endcode
+ *
+ * @see RING_mpscInit
+ * @see RING_mpscReserve
+ * @see RING_mpscCommit
+ * @see RING_mpscPeek
+ * @see RING_mpscRelease
+ *
+*****************************************************************************/
+static inline void RING_mpscCommit(RingMpsc_t * const Ring,
+uint8_t * const record)
+{
+    atomic_uint_least32_t * const header = (atomic_uint_least32_t*)
+        (void*)(record - RING_RECORD_HEADER_SIZE);
+
+    (void)Ring;
+    atomic_fetch_or_explicit(header, RING_RECORD_COMMITTED,
+        memory_order_release);
+}
+
+/*****************************************************************************
+ * Function: RING_mpscPeek()
+ *//**
+ * \b Description:
+ * This function is used by the consumer to get the oldest record of a
+ * ring, if it was committed. The padding before the end of the buffer is
+ * released on the way. The record can be read by the processor or by a DMA
+ * stream, and is given back by RING_mpscRelease.
+ *
+ * PRE-CONDITION: The ring is initialized (RING_mpscInit). <br>
+ * PRE-CONDITION: Only the consumer calls the function. <br>
+ *
+ * POST-CONDITION: record points to the oldest record. <br>
+ *
+ * @param[in]   Ring is a pointer to the ring.
+ * @param[out]  record is the first byte of the record.
+ *
+ * @return The number of bytes of the record, or 0 if the oldest record is
+ *         not committed (or the ring is empty).
+ *
+ * \b Example:
+ * @code
+ * uint8_t *record;
+ * uint32_t length;
+ *
+ * while((length = RING_mpscPeek(&EventRing, &record)) > 0U)
+ * {
+ *     eventProcess(record, length);
+ *     RING_mpscRelease(&EventRing);
+ * }
+ * @endcode
+ *
+ * @see RING_mpscInit
+ * @see RING_mpscReserve
+ * @see RING_mpscCommit
+ * @see RING_mpscPeek
+ * @see RING_mpscRelease
+ *
+*****************************************************************************/
+static inline uint32_t RING_mpscPeek(RingMpsc_t * const Ring,
+uint8_t ** const record)
+{
+    uint32_t tail = atomic_load_explicit(&Ring->tail, memory_order_relaxed);
+    uint32_t offset;
+    uint32_t header;
+
+    while(1)
+    {
+        offset = tail & (Ring->size - 1U);
+        header = atomic_load_explicit(
+            (atomic_uint_least32_t*)(void*)&Ring->buffer[offset],
+            memory_order_acquire);
+
+        if((header & RING_RECORD_COMMITTED) == 0U)
+        {
+            return 0U;
+        }
+
+        if((header & RING_RECORD_PADDING) == 0U)
+        {
+            *record = &Ring->buffer[offset + RING_RECORD_HEADER_SIZE];
+            return header & RING_RECORD_LENGTH;
+        }
+
+        /* Clear the padding and go on at the start of the buffer */
+        memset(&Ring->buffer[offset], 0, header & RING_RECORD_LENGTH);
+        tail += header & RING_RECORD_LENGTH;
+        atomic_store_explicit(&Ring->tail, tail, memory_order_release);
+    }
+}
+
+/*****************************************************************************
+ * Function: RING_mpscRelease()
+ *//**
+ * \b Description:
+ * This function is used by the consumer to give the record returned by
+ * RING_mpscPeek back to the producers. The record is cleared first, as any
+ * of its words can be the header of a later record; the release ordering
+ * completes the clearing before a producer can reserve the bytes.
+ *
+ * PRE-CONDITION: RING_mpscPeek returned a record, which is not released.
+ *                <br>
+ * PRE-CONDITION: Only the consumer calls the function. <br>
+ *
+ * POST-CONDITION: The bytes of the record can be reserved again. <br>
+ *
+ * @param[in]   Ring is a pointer to the ring.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * RING_mpscRelease(&EventRing);
+ * @endcode
+ *
+ * @see RING_mpscInit
+ * @see RING_mpscReserve
+ * @see RING_mpscCommit
+ * @see RING_mpscPeek
+ * @see RING_mpscRelease
+ *
+*****************************************************************************/
+static inline void RING_mpscRelease(RingMpsc_t * const Ring)
+{
+    const uint32_t tail = atomic_load_explicit(&Ring->tail,
+        memory_order_relaxed);
+    const uint32_t offset = tail & (Ring->size - 1U);
+    const uint32_t size = RING_RECORD_SIZE(atomic_load_explicit(
+        (atomic_uint_least32_t*)(void*)&Ring->buffer[offset],
+        memory_order_relaxed) & RING_RECORD_LENGTH);
+
+    memset(&Ring->buffer[offset], 0, size);
+    atomic_store_explicit(&Ring->tail, tail + size, memory_order_release);
+}
+
+#endif /*RING_H_*/
@@ -0,0 +1,114 @@
+/**
+ * @file scan.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the delimiter scanner. This is the
+ * header file for the definition of the interface for extracting delimited
+ * lines out of a circular DMA receive buffer. Only the bytes written by the
+ * DMA since the last call are searched, four bytes at a time, and the lines
+ * are returned as views of the buffer in up to two segments, so no data is
+ * copied.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef SCAN_H_
+#define SCAN_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <assert.h>
+#include "dma.h"        /*For the write position of the DMA stream*/
+#include "stm32f4xx.h"  /*Microcontroller family header*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the maximum number of delimiters of a set.
+*/
+#define SCAN_DELIMITERS_MAX 4U
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the result of a line search.
+*/
+typedef enum
+{
+    SCAN_NOT_FOUND,         /**< No complete line in the new data */
+    SCAN_FOUND,             /**< A complete line was found */
+    SCAN_STATUS_MAX         /**< Defines the maximum scan result */
+}ScanStatus_t;
+
+/**
+ * Defines a set of delimiters. Each delimiter is repeated on the four bytes
+ * of a word, so it is compared against four bytes of data at a time.
+*/
+typedef struct
+{
+    uint32_t pattern[SCAN_DELIMITERS_MAX];  /**< Delimiters, one per byte */
+    uint8_t count;                          /**< Number of delimiters */
+}ScanDelimiters_t;
+
+/**
+ * Defines the scan state of a circular receive buffer.
+*/
+typedef struct
+{
+    const uint8_t *buffer;      /**< Circular buffer written by the DMA */
+    uint32_t size;              /**< Size of the buffer in bytes */
+    uint32_t start;             /**< Index of the first byte of the line */
+    uint32_t scanned;           /**< Index of the first byte not searched */
+}ScanRing_t;
+
+/**
+ * Defines a view of a line. A line that wraps around the end of the buffer
+ * is made of two segments, otherwise the second segment is empty.
+*/
+typedef struct
+{
+    const uint8_t *segment[2];  /**< First byte of each segment */
+    uint32_t length[2];         /**< Number of bytes of each segment */
+}ScanView_t;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void SCAN_delimitersInit(ScanDelimiters_t * const Delimiters,
+const uint8_t * const characters, uint8_t count);
+void SCAN_ringInit(ScanRing_t * const Ring, const uint8_t * const buffer,
+uint32_t size);
+uint32_t SCAN_writeIndexGet(const ScanRing_t * const Ring,
+const DmaStream_t Stream);
+uint32_t SCAN_find(const uint8_t * const data, uint32_t length,
+const ScanDelimiters_t * const Delimiters);
+ScanStatus_t SCAN_lineGet(ScanRing_t * const Ring, uint32_t writeIndex,
+const ScanDelimiters_t * const Delimiters, ScanView_t * const Line);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*SCAN_H_*/
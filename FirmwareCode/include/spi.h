@@ -0,0 +1,122 @@
+/**
+ * @file spi.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the Serial Peripheral Interface. This
+ * is the header file for the definition of the interface for a SPI on a
+ * standard microcontroller. The data is moved by the DMA streams of the
+ * port, in both directions at the same time.
+ * @version 1.1
+ * @date 2025-03-25
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef SPI_H_
+#define SPI_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <assert.h>
+#include "spi_cfg.h"    /*For SPI configuration*/
+#include "dma.h"        /*For the DMA streams of the transfers*/
+#include "dio.h"        /*For the chip select pins*/
+#include "stm32f4xx.h"  /*Microcontroller family header*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the word transmitted when a transfer has no data to send. It is
+ * the level of an idle MOSI line, which most devices ignore.
+*/
+#define SPI_DUMMY_WORD 0xFFFFU
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the status returned by the bounded SPI operations.
+*/
+typedef enum
+{
+    SPI_OK,                 /**< The operation was completed*/
+    SPI_TIMEOUT,            /**< The timeout elapsed first*/
+    SPI_STATUS_MAX          /**< Defines the maximum SPI status*/
+}SpiStatus_t;
+
+/**
+ * Defines a full-duplex transfer of a port. The words are bytes with 8-bit
+ * frames and half-words with 16-bit frames. Without txData the dummy word
+ * is sent, from a single word (no memory increment); without rxData the
+ * received words are discarded the same way.
+*/
+typedef struct
+{
+    SpiPort_t Port;                     /**< SPI port*/
+    DmaStream_t TxStream;               /**< DMA stream of the SPI TX*/
+    DmaStream_t RxStream;               /**< DMA stream of the SPI RX*/
+    const void *txData;                 /**< Data to transmit (or NULL)*/
+    void *rxData;                       /**< Data received (or NULL)*/
+    uint32_t length;                    /**< Number of frames*/
+}SpiTransferConfig_t;
+
+/**
+ * Defines a segment of a transaction, e.g. the command, the address, or the
+ * data of an external flash access.
+*/
+typedef struct
+{
+    const void *txData;                 /**< Data to transmit (or NULL)*/
+    void *rxData;                       /**< Data received (or NULL)*/
+    uint32_t length;                    /**< Number of frames*/
+}SpiSegment_t;
+
+/**
+ * Defines a transaction with a device: the segments are chained while the
+ * chip select pin of the device is held low.
+*/
+typedef struct
+{
+    SpiPort_t Port;                     /**< SPI port*/
+    DmaStream_t TxStream;               /**< DMA stream of the SPI TX*/
+    DmaStream_t RxStream;               /**< DMA stream of the SPI RX*/
+    DioPinConfig_t ChipSelect;          /**< Chip select pin (active low)*/
+    const SpiSegment_t *Segments;       /**< Segments of the transaction*/
+    uint32_t segmentCount;              /**< Number of segments*/
+}SpiTransaction_t;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void SPI_init(const SpiConfig_t * const Config, size_t configSize);
+SpiStatus_t SPI_transfer(const SpiTransferConfig_t * const Config,
+const uint32_t timeout);
+SpiStatus_t SPI_transaction(const SpiTransaction_t * const Transaction,
+const uint32_t timeout);
+void SPI_registerWrite(const uint32_t address, const uint32_t value);
+uint32_t SPI_registerRead(const uint32_t address);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*SPI_H_*/
@@ -0,0 +1,169 @@
+/**
+ * @file spi_cfg.h
+ * @author Jose Luis Figueroa
+ * @brief This module contains interface definitions for the SPI
+ * configuration. This is the header file for the definition of the
+ * interface for retrieving the Serial Peripheral Interface configuration
+ * table.
+ * @version 1.1
+ * @date 2025-03-25
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef SPI_CFG_H_
+#define SPI_CFG_H_
+
+/*****************************************************************************
+ * Includes
+******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * Preprocessor Constants
+******************************************************************************/
+/**
+ * Defines the number of SPI peripherals on the processor.
+*/
+#define SPI_PORTS_NUMBER 4U
+
+/*****************************************************************************
+ * Typedefs
+******************************************************************************/
+/**
+ * Defines the SPI ports contained on the MCU device. It is used to specify
+ * the specific SPI peripheral to configure the register map.
+*/
+typedef enum
+{
+    SPI_PORT_1,         /**< SPI1 */
+    SPI_PORT_2,         /**< SPI2 */
+    SPI_PORT_3,         /**< SPI3 */
+    SPI_PORT_4,         /**< SPI4 */
+    SPI_PORT_MAX        /**< Defines the maximum SPI port*/
+}SpiPort_t;
+
+/**
+ * Defines the SPI mode.
+*/
+typedef enum
+{
+    SPI_MODE_SLAVE,     /**< Defines the slave, clocked by the master*/
+    SPI_MODE_MASTER,    /**< Defines the master, driving SCK*/
+    SPI_MODE_MAX        /**< Defines the maximum SPI mode*/
+}SpiMode_t;
+
+/**
+ * Defines the idle level of SCK.
+*/
+typedef enum
+{
+    SPI_CLOCK_POLARITY_LOW,     /**< Defines SCK low when idle*/
+    SPI_CLOCK_POLARITY_HIGH,    /**< Defines SCK high when idle*/
+    SPI_CLOCK_POLARITY_MAX      /**< Defines the maximum clock polarity*/
+}SpiClockPolarity_t;
+
+/**
+ * Defines the SCK edge that captures the data.
+*/
+typedef enum
+{
+    SPI_CLOCK_PHASE_FIRST,      /**< Defines the capture on the first edge*/
+    SPI_CLOCK_PHASE_SECOND,     /**< Defines the capture on the second edge*/
+    SPI_CLOCK_PHASE_MAX         /**< Defines the maximum clock phase*/
+}SpiClockPhase_t;
+
+/**
+ * Defines the divider of the bus clock that gives SCK in master mode. The
+ * settings are the encodings of the BR field.
+*/
+typedef enum
+{
+    SPI_BAUD_RATE_DIV_2,        /**< Defines SCK at the bus clock / 2*/
+    SPI_BAUD_RATE_DIV_4,        /**< Defines SCK at the bus clock / 4*/
+    SPI_BAUD_RATE_DIV_8,        /**< Defines SCK at the bus clock / 8*/
+    SPI_BAUD_RATE_DIV_16,       /**< Defines SCK at the bus clock / 16*/
+    SPI_BAUD_RATE_DIV_32,       /**< Defines SCK at the bus clock / 32*/
+    SPI_BAUD_RATE_DIV_64,       /**< Defines SCK at the bus clock / 64*/
+    SPI_BAUD_RATE_DIV_128,      /**< Defines SCK at the bus clock / 128*/
+    SPI_BAUD_RATE_DIV_256,      /**< Defines SCK at the bus clock / 256*/
+    SPI_BAUD_RATE_MAX           /**< Defines the maximum baud rate*/
+}SpiBaudRate_t;
+
+/**
+ * Defines the SPI data frame format. 16-bit frames are moved by streams
+ * with 16-bit memory and peripheral sizes.
+*/
+typedef enum
+{
+    SPI_DATA_SIZE_8,            /**< Defines 8-bit frames*/
+    SPI_DATA_SIZE_16,           /**< Defines 16-bit frames*/
+    SPI_DATA_SIZE_MAX           /**< Defines the maximum frame format*/
+}SpiDataSize_t;
+
+/**
+ * Defines the SPI bit order.
+*/
+typedef enum
+{
+    SPI_BIT_ORDER_MSB_FIRST,    /**< Defines the MSB transmitted first*/
+    SPI_BIT_ORDER_LSB_FIRST,    /**< Defines the LSB transmitted first*/
+    SPI_BIT_ORDER_MAX           /**< Defines the maximum bit order*/
+}SpiBitOrder_t;
+
+/**
+ * Defines the slave select management. With the software management the
+ * chip select of each device is a DIO pin, driven by SPI_transaction.
+*/
+typedef enum
+{
+    SPI_SLAVE_SELECT_SOFTWARE,  /**< Defines the chip select through DIO*/
+    SPI_SLAVE_SELECT_HARDWARE,  /**< Defines the NSS pin (output on master)*/
+    SPI_SLAVE_SELECT_MAX        /**< Defines the maximum slave select*/
+}SpiSlaveSelect_t;
+
+/**
+ * Defines the SPI enable.
+*/
+typedef enum
+{
+    SPI_DISABLED,               /**< Defines the SPI disabled*/
+    SPI_ENABLED,                /**< Defines the SPI enabled*/
+    SPI_ENABLE_MAX              /**< Defines the maximum SPI enable*/
+}SpiEnable_t;
+
+/**
+ * Defines the Serial Peripheral Interface configuration table. This table is
+ * used to configure the SPI peripheral in the SPI_init function. The
+ * transfers are done with the DMA streams of the port, which are configured
+ * by the DMA configuration table.
+*/
+typedef struct
+{
+    SpiPort_t           Port;           /**< SPI port*/
+    SpiMode_t           Mode;           /**< Master or slave*/
+    SpiClockPolarity_t  ClockPolarity;  /**< Idle level of SCK*/
+    SpiClockPhase_t     ClockPhase;     /**< Capture edge of SCK*/
+    SpiBaudRate_t       BaudRate;       /**< Divider of the bus clock*/
+    SpiDataSize_t       DataSize;       /**< 8-bit or 16-bit frames*/
+    SpiBitOrder_t       BitOrder;       /**< MSB or LSB first*/
+    SpiSlaveSelect_t    SlaveSelect;    /**< Software or hardware NSS*/
+    SpiEnable_t         Enable;         /**< SPI enable*/
+}SpiConfig_t;
+
+/*****************************************************************************
+ * Function Prototypes
+ *****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+const SpiConfig_t * const SPI_configGet(void);
+size_t SPI_configSizeGet(void);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*SPI_CFG_H_*/
@@ -0,0 +1,83 @@
+/**
+ * @file timebase.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the timebase. This is the header file
+ * for the definition of the interface for reading a microsecond timestamp
+ * and for bounding the blocking operations of the drivers with deadlines.
+ * The 32-bit TIM2 counter runs at 1 MHz, so the timestamps wrap every 71.6
+ * minutes; the deadline helpers compare timestamps in modular arithmetic
+ * and are valid for timeouts below 35.7 minutes.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <assert.h>
+#include "stm32f4xx.h"  /*Microcontroller family header*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the frequency of the timebase counter in Hz (1 tick per us).
+*/
+#define TIMEBASE_FREQUENCY 1000000UL
+
+/**
+ * Defines the interrupt of the timebase timer. The interrupt is used to wake
+ * up the processor on a deadline and must stay disabled in the NVIC.
+*/
+#define TIMEBASE_IRQ TIM2_IRQn
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines the state of a deadline.
+*/
+typedef enum
+{
+    TIMEBASE_PENDING,           /**< The deadline is in the future */
+    TIMEBASE_EXPIRED,           /**< The deadline has been reached */
+    TIMEBASE_DEADLINE_MAX       /**< Defines the maximum deadline state */
+}TimebaseDeadline_t;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void TIMEBASE_init(const uint32_t timerClock);
+uint32_t TIMEBASE_now(void);
+uint32_t TIMEBASE_deadlineGet(const uint32_t timeout);
+TimebaseDeadline_t TIMEBASE_deadlineCheck(const uint32_t deadline);
+void TIMEBASE_alarmSet(const uint32_t deadline);
+void TIMEBASE_alarmClear(void);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*TIMEBASE_H_*/
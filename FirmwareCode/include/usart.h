@@ -20,6 +20,8 @@
 #include <stdio.h>
 #include <assert.h>
 #include "usart_cfg.h"  /*For usart configuration*/
+#include "dma.h"        /*For the DMA stream of the receive-to-idle*/
+#include "dio.h"        /*For the driver enable pin of RS-485*/
 #include "stm32f4xx.h"  /*Microcontroller family header*/
 
 /*****************************************************************************
@@ -33,6 +35,14 @@
 /*****************************************************************************
 * Macros
 *****************************************************************************/
+/**
+ * Returns the address frame of a node, for the address mark wakeup: the 
+ * most significant bit of the word (bit 7, or bit 8 with 9-bit words) marks
+ * the address.
+*/
+#define USART_ADDRESS_FRAME(address, WordLength) \
+    ((uint16_t)(((WordLength) == USART_WORD_LENGTH_9 ? 0x100U : 0x80U) | \
+    ((uint16_t)(address) & USART_ADDRESS_MAX)))
 
 /*****************************************************************************
 * Typedefs
@@ -41,8 +51,72 @@ typedef struct
 {
     UsartPort_t Port;       /**< USART port*/
     uint8_t *data;          /**< Data to be transmitted*/
+    uint32_t *timestamp;    /**< Arrival time of received data (or NULL)*/
 }UsartTransferConfig_t;
 
+/**
+ * Defines the status returned by the bounded USART operations.
+*/
+typedef enum
+{
+    USART_OK,               /**< The operation was completed*/
+    USART_TIMEOUT,          /**< The timeout elapsed first*/
+    USART_STATUS_MAX        /**< Defines the maximum USART status*/
+}UsartStatus_t;
+
+/**
+ * Defines the function called with every message received to idle. The
+ * function is called from the interrupt handler, and the data stays valid
+ * until the next message of the port is completed. The length counts the
+ * transfers of the stream: with a 16-bit stream (9-bit words), data points
+ * to length half-words.
+*/
+typedef void (*UsartRxIdleCallback_t)(UsartPort_t Port, 
+const uint8_t * data, uint32_t length, uint32_t timestamp);
+
+/**
+ * Defines the reception of variable-length messages on a port. The DMA 
+ * stream fills one buffer while the other one is processed, and a message
+ * ends when the line goes idle or when the buffer is full.
+*/
+typedef struct
+{
+    UsartPort_t Port;                   /**< USART port*/
+    DmaStream_t Stream;                 /**< DMA stream of the USART RX*/
+    uint8_t *buffer[2];                 /**< Ping-pong message buffers*/
+    uint32_t length;                    /**< Transfers of each buffer*/
+    UsartRxIdleCallback_t Callback;     /**< Called with each message*/
+}UsartRxIdleConfig_t;
+
+/**
+ * Defines a DMA transfer of a block of data in both directions, e.g. on a 
+ * synchronous port, where the words are received with the clock of the 
+ * words transmitted.
+*/
+typedef struct
+{
+    UsartPort_t Port;                   /**< USART port*/
+    DmaStream_t TxStream;               /**< DMA stream of the USART TX*/
+    DmaStream_t RxStream;               /**< DMA stream of the USART RX*/
+    const uint8_t *txData;              /**< Data to be transmitted*/
+    uint8_t *rxData;                    /**< Data received (or NULL)*/
+    uint32_t length;                    /**< Number of transfers*/
+}UsartExchangeConfig_t;
+
+/**
+ * Defines the driver enable (DE) pin of a half-duplex RS-485 port, which 
+ * enables the transmitter of the transceiver while the TX stream sends a
+ * block. The receiver of the transceiver is usually enabled by the 
+ * inverted DE, so the RX pin needs a pull-up while the driver is enabled.
+*/
+typedef struct
+{
+    UsartPort_t Port;                   /**< USART port*/
+    DmaStream_t Stream;                 /**< DMA stream of the USART TX*/
+    DioPinConfig_t DePin;               /**< Driver enable pin (output)*/
+    DioPinState_t Active;               /**< Level that enables the driver*/
+}UsartDriverEnableConfig_t;
+
 /*****************************************************************************
 * Variables
 *****************************************************************************/
@@ -56,8 +130,28 @@ extern "C"{
 
 void USART_init(const UsartConfig_t * const Config, 
 size_t configSize, const uint32_t peripheralClock);  
+void USART_imageInit(const UsartPortImage_t * const Image, size_t imageSize);
+void USART_imageCompose(const UsartConfig_t * const Config, 
+const uint32_t peripheralClock, UsartPortImage_t * const Image);
+UsartStatus_t USART_reconfigure(const UsartConfig_t * const Config, 
+const uint32_t peripheralClock, const uint32_t timeout);
 void USART_transmit(const UsartTransferConfig_t * const TransferConfig);
 void USART_receive(const UsartTransferConfig_t * const TransferConfig);
+UsartStatus_t USART_transmitTimeout(
+const UsartTransferConfig_t * const TransferConfig, const uint32_t timeout);
+UsartStatus_t USART_receiveTimeout(
+const UsartTransferConfig_t * const TransferConfig, const uint32_t timeout);
+void USART_receiveToIdle(const UsartRxIdleConfig_t * const Config);
+void USART_receiveToIdleStop(const UsartPort_t Port);
+UsartStatus_t USART_exchange(const UsartExchangeConfig_t * const Config,
+const uint32_t timeout);
+void USART_driverEnableInit(const UsartDriverEnableConfig_t * const Config);
+UsartStatus_t USART_driverEnableTransmit(const UsartPort_t Port, 
+const uint8_t * const data, const uint32_t length, const uint32_t timeout);
+uint32_t USART_turnaroundGet(const UsartPort_t Port);
+void USART_irqHandler(const UsartPort_t Port);
+uint16_t USART_dataMaskGet(const UsartPort_t Port);
+void USART_muteEnter(const UsartPort_t Port);
 void USART_registerWrite(const uint32_t address, const uint32_t value);
 uint32_t USART_registerRead(const uint32_t address);
 
@@ -0,0 +1,354 @@
+/**
+ * @file usart.hpp
+ * @author Jose Luis Figueroa
+ * @brief The C++17 template interface for the Universal Synchronous/
+ * Asynchronous Receiver Transmitter (USART). A port is a type (UsartPort<2>)
+ * and its configuration is built with UsartConfigBuilder, so the control
+ * register values and the baud rate divider are folded at compile time.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef USART_HPP_
+#define USART_HPP_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include "hal.hpp"      /*For the common template definitions*/
+#include "usart.h"      /*For the C interface definitions*/
+
+namespace hal
+{
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Builds the configuration of a port at compile time. The default
+ * configuration is 8 data bits, 1 stop bit, no parity, receiver and
+ * transmitter enabled, no DMA, 9600 bauds, asynchronous mode, 
+ * oversampling by 16 and the receiver not muted.
+ *
+ * \b Example:
+ * @code
+ * constexpr auto Console = hal::UsartConfigBuilder()
+ *                              .baudRate(USART_BAUD_RATE_115200);
+ * @endcode
+*/
+class UsartConfigBuilder
+{
+public:
+    constexpr UsartConfigBuilder() :
+        WordLength(USART_WORD_LENGTH_8), StopBits(USART_STOP_BITS_1),
+        Parity(USART_PARITY_DISABLED), Rx(USART_RX_ENABLED),
+        Tx(USART_TX_ENABLED), RxDma(USART_RX_DMA_DISABLED),
+        TxDma(USART_TX_DMA_DISABLED), Enable(USART_ENABLED),
+        BaudRate(USART_BAUD_RATE_9600), Clock(USART_CLOCK_DISABLED),
+        ClockPolarity(USART_CLOCK_POLARITY_LOW),
+        ClockPhase(USART_CLOCK_PHASE_FIRST),
+        LastBitClock(USART_LAST_BIT_CLOCK_DISABLED),
+        Oversampling(USART_OVERSAMPLING_16), Mute(USART_MUTE_DISABLED),
+        Wakeup(USART_WAKEUP_IDLE_LINE), Address(0U)
+    {
+    }
+
+    constexpr UsartConfigBuilder wordLength(
+        const UsartWordLength_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.WordLength = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder stopBits(const UsartStopBits_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.StopBits = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder parity(const UsartParity_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.Parity = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder rx(const UsartRx_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.Rx = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder tx(const UsartTx_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.Tx = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder rxDma(const UsartRxDma_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.RxDma = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder txDma(const UsartTxDma_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.TxDma = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder enable(const UsartEnable_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.Enable = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder baudRate(const UsartBaudRate_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.BaudRate = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder clock(const UsartClock_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.Clock = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder clockPolarity(
+        const UsartClockPolarity_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.ClockPolarity = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder clockPhase(
+        const UsartClockPhase_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.ClockPhase = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder lastBitClock(
+        const UsartLastBitClock_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.LastBitClock = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder oversampling(
+        const UsartOversampling_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.Oversampling = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder mute(const UsartMute_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.Mute = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder wakeup(const UsartWakeup_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.Wakeup = value;
+        return builder;
+    }
+
+    constexpr UsartConfigBuilder address(const uint8_t value) const
+    {
+        UsartConfigBuilder builder = *this;
+        builder.Address = value;
+        return builder;
+    }
+
+    /** Returns the value of the control register 1. */
+    constexpr uint32_t cr1() const
+    {
+        return ((WordLength == USART_WORD_LENGTH_9) ? USART_CR1_M : 0UL) |
+               ((Parity == USART_PARITY_ENABLED) ? USART_CR1_PCE : 0UL) |
+               ((Rx == USART_RX_ENABLED) ? USART_CR1_RE : 0UL) |
+               ((Tx == USART_TX_ENABLED) ? USART_CR1_TE : 0UL) |
+               ((Enable == USART_ENABLED) ? USART_CR1_UE : 0UL) |
+               ((Oversampling == USART_OVERSAMPLING_8) ?
+                    USART_CR1_OVER8 : 0UL) |
+               ((Wakeup == USART_WAKEUP_ADDRESS_MARK) ? USART_CR1_WAKE : 0UL) |
+               ((Mute == USART_MUTE_ENABLED) ? USART_CR1_RWU : 0UL);
+    }
+
+    /** Returns the value of the control register 2. */
+    constexpr uint32_t cr2() const
+    {
+        return (static_cast<uint32_t>(StopBits)<<USART_CR2_STOP_Pos) |
+               ((Clock == USART_CLOCK_ENABLED) ? USART_CR2_CLKEN : 0UL) |
+               ((ClockPolarity == USART_CLOCK_POLARITY_HIGH) ?
+                    USART_CR2_CPOL : 0UL) |
+               ((ClockPhase == USART_CLOCK_PHASE_SECOND) ?
+                    USART_CR2_CPHA : 0UL) |
+               ((LastBitClock == USART_LAST_BIT_CLOCK_ENABLED) ?
+                    USART_CR2_LBCL : 0UL) |
+               ((static_cast<uint32_t>(Address)<<USART_CR2_ADD_Pos) &
+                    USART_CR2_ADD);
+    }
+
+    /** Returns the value of the control register 3. */
+    constexpr uint32_t cr3() const
+    {
+        return ((RxDma == USART_RX_DMA_ENABLED) ? USART_CR3_DMAR : 0UL) |
+               ((TxDma == USART_TX_DMA_ENABLED) ? USART_CR3_DMAT : 0UL);
+    }
+
+    /**
+     * Returns the value of the baud rate register, rounded to the nearest
+     * divider as done by USART_init. With oversampling by 8 the fraction
+     * has three bits.
+    */
+    constexpr uint32_t brr(const uint32_t peripheralClock) const
+    {
+        return (Oversampling == USART_OVERSAMPLING_8) ?
+            (((divider(peripheralClock) & ~0x7UL) << 1) |
+                (divider(peripheralClock) & 0x7UL)) :
+            divider(peripheralClock);
+    }
+
+    /** Returns the bus clock divided by the baud rate, rounded. */
+    constexpr uint32_t divider(const uint32_t peripheralClock) const
+    {
+        return (peripheralClock + (static_cast<uint32_t>(BaudRate)/2U)) /
+            static_cast<uint32_t>(BaudRate);
+    }
+
+    /**
+     * Returns the row of the C configuration table of the port.
+    */
+    constexpr UsartConfig_t build(const UsartPort_t port) const
+    {
+        return UsartConfig_t{port, WordLength, StopBits, Parity, Rx, Tx,
+            RxDma, TxDma, Enable, BaudRate, Clock, ClockPolarity, ClockPhase,
+            LastBitClock, Oversampling, Mute, Wakeup, Address};
+    }
+
+    UsartWordLength_t WordLength;   /**< 8 data bits or 9 data bits*/
+    UsartStopBits_t StopBits;       /**< 1, 0.5, 2, or 1.5 stop bits*/
+    UsartParity_t Parity;           /**< Enable or disable parity bit*/
+    UsartRx_t Rx;                   /**< Enable or disable RX mode*/
+    UsartTx_t Tx;                   /**< Enable or disable TX mode*/
+    UsartRxDma_t RxDma;             /**< Enable or disable RX DMA mode*/
+    UsartTxDma_t TxDma;             /**< Enable or disable TX DMA mode*/
+    UsartEnable_t Enable;           /**< USART or disable enable*/
+    UsartBaudRate_t BaudRate;       /**< USART baud rate*/
+    UsartClock_t Clock;             /**< Asynchronous or synchronous mode*/
+    UsartClockPolarity_t ClockPolarity; /**< Idle level of CK*/
+    UsartClockPhase_t ClockPhase;   /**< Capture edge of CK*/
+    UsartLastBitClock_t LastBitClock; /**< Clock pulse of the last bit*/
+    UsartOversampling_t Oversampling; /**< Oversampling by 16 or by 8*/
+    UsartMute_t Mute;               /**< Receiver muted at the start*/
+    UsartWakeup_t Wakeup;           /**< Idle line or address mark wakeup*/
+    uint8_t Address;                /**< Node address (0 to 15)*/
+};
+
+/**
+ * Defines a USART port. Every function is inlined and works on the register
+ * addresses of the port, which are known at compile time.
+ *
+ * @tparam  NUMBER is the USART number (1, 2, or 6).
+ *
+ * \b Example:
+ * @code
+ * using Console = hal::UsartPort<2>;
+ *
+ * Console::init<16000000UL>(hal::UsartConfigBuilder()
+ *                               .baudRate(USART_BAUD_RATE_115200));
+ * Console::write('A');
+ * @endcode
+*/
+template <uint8_t NUMBER>
+struct UsartPort
+{
+    static_assert((NUMBER == 1U) || (NUMBER == 2U) || (NUMBER == 6U),
+        "The device has USART1, USART2, and USART6");
+
+    /** Defines the port for the C interface */
+    static constexpr UsartPort_t id = (NUMBER == 1U) ? USART_PORT_1 :
+                                      (NUMBER == 2U) ? USART_PORT_2 :
+                                                       USART_PORT_6;
+
+    /** Defines the address of the port registers */
+    static constexpr uintptr_t address = (NUMBER == 1U) ? USART1_BASE :
+                                         (NUMBER == 2U) ? USART2_BASE :
+                                                          USART6_BASE;
+
+    /**
+     * Returns the register block of the port.
+    */
+    static HAL_INLINE USART_TypeDef * port()
+    {
+        return registerBlock<USART_TypeDef>(address);
+    }
+
+    /**
+     * Sets up the port. The control registers are written as a whole and
+     * the control register 1 is written last, so the port is enabled once
+     * the frame format and the baud rate are selected. A muted receiver is
+     * muted once the port is enabled.
+     *
+     * @tparam  CLOCK is the peripheral clock of the port in Hz.
+    */
+    template <uint32_t CLOCK>
+    static HAL_INLINE void init(const UsartConfigBuilder & config)
+    {
+        port()->BRR = config.brr(CLOCK);
+        port()->CR2 = config.cr2();
+        port()->CR3 = config.cr3();
+        port()->CR1 = config.cr1() & ~USART_CR1_RWU;
+        if(config.Mute == USART_MUTE_ENABLED)
+        {
+            port()->CR1 = config.cr1();
+        }
+    }
+
+    /** Waits until the transmit data register is empty and writes a data. */
+    static HAL_INLINE void write(const uint16_t data)
+    {
+        while(!(port()->SR & USART_SR_TXE))
+        {
+        }
+        port()->DR = data;
+    }
+
+    /** Waits until a data is received and reads it. */
+    static HAL_INLINE uint16_t read()
+    {
+        while(!(port()->SR & USART_SR_RXNE))
+        {
+        }
+        return static_cast<uint16_t>(port()->DR);
+    }
+
+    /** Returns the data register, used as the peripheral of DMA transfers. */
+    static HAL_INLINE volatile uint32_t * dataRegister()
+    {
+        return &port()->DR;
+    }
+};
+
+} // namespace hal
+
+#endif /*USART_HPP_*/
@@ -18,6 +18,7 @@
  * Includes
 ******************************************************************************/
 #include <stdio.h>
+#include <stdint.h>
 
 /*****************************************************************************
  * Preprocessor Constants
@@ -134,9 +135,97 @@ typedef enum
     USART_BAUD_RATE_38400  = 38400,  /**< Defines the baud rate 38400*/
     USART_BAUD_RATE_57600  = 57600,  /**< Defines the baud rate 57600*/
     USART_BAUD_RATE_115200 = 115200, /**< Defines the baud rate 115200*/
+    USART_BAUD_RATE_230400 = 230400, /**< Defines the baud rate 230400*/
+    USART_BAUD_RATE_460800 = 460800, /**< Defines the baud rate 460800*/
+    USART_BAUD_RATE_921600 = 921600, /**< Defines the baud rate 921600*/
+    USART_BAUD_RATE_1000000 = 1000000, /**< Defines 1 Mbit/s*/
+    USART_BAUD_RATE_2000000 = 2000000, /**< Defines 2 Mbit/s*/
+    USART_BAUD_RATE_4000000 = 4000000, /**< Defines 4 Mbit/s*/
     USART_BAUD_RATE_MAX              /**< Defines the maximum baud rate*/
 }UsartBaudRate_t;
 
+/**
+ * Defines the USART clock output (synchronous mode). The receiver samples
+ * on the clock sent with the transmitted data, so a synchronous master 
+ * receives while it transmits.
+*/
+typedef enum
+{
+    USART_CLOCK_DISABLED,   /**< Defines the asynchronous mode*/
+    USART_CLOCK_ENABLED,    /**< Defines the synchronous mode, CK output*/
+    USART_CLOCK_MAX         /**< Defines the maximum clock mode*/
+}UsartClock_t;
+
+/**
+ * Defines the steady level of the CK pin out of the transmissions.
+*/
+typedef enum
+{
+    USART_CLOCK_POLARITY_LOW,   /**< Defines CK low when idle*/
+    USART_CLOCK_POLARITY_HIGH,  /**< Defines CK high when idle*/
+    USART_CLOCK_POLARITY_MAX    /**< Defines the maximum clock polarity*/
+}UsartClockPolarity_t;
+
+/**
+ * Defines the CK edge on which the data is captured.
+*/
+typedef enum
+{
+    USART_CLOCK_PHASE_FIRST,    /**< Defines the capture on the first edge*/
+    USART_CLOCK_PHASE_SECOND,   /**< Defines the capture on the second edge*/
+    USART_CLOCK_PHASE_MAX       /**< Defines the maximum clock phase*/
+}UsartClockPhase_t;
+
+/**
+ * Defines the clock pulse of the last data bit on the CK pin.
+*/
+typedef enum
+{
+    USART_LAST_BIT_CLOCK_DISABLED,  /**< Defines no pulse for the last bit*/
+    USART_LAST_BIT_CLOCK_ENABLED,   /**< Defines a pulse for the last bit*/
+    USART_LAST_BIT_CLOCK_MAX        /**< Defines the maximum last bit clock*/
+}UsartLastBitClock_t;
+
+/**
+ * Defines the USART oversampling. Oversampling by 8 doubles the highest 
+ * baud rate (the bus clock / 8) with a lower tolerance to clock deviation.
+*/
+typedef enum
+{
+    USART_OVERSAMPLING_16,  /**< Defines oversampling by 16*/
+    USART_OVERSAMPLING_8,   /**< Defines oversampling by 8*/
+    USART_OVERSAMPLING_MAX  /**< Defines the maximum oversampling*/
+}UsartOversampling_t;
+
+/**
+ * Defines the receiver mute mode. A muted receiver discards the frames, so
+ * neither RXNE nor the RX DMA request are raised, until the wakeup event.
+*/
+typedef enum
+{
+    USART_MUTE_DISABLED,    /**< Defines the receiver always active*/
+    USART_MUTE_ENABLED,     /**< Defines the receiver muted at the start*/
+    USART_MUTE_MAX          /**< Defines the maximum mute mode*/
+}UsartMute_t;
+
+/**
+ * Defines the event that wakes up a muted receiver. With the address mark,
+ * a frame with the most significant bit set is an address: the receiver
+ * wakes up when its 4 low bits are the node address, and is muted again by
+ * the address of another node.
+*/
+typedef enum
+{
+    USART_WAKEUP_IDLE_LINE,     /**< Defines the wakeup on an idle line*/
+    USART_WAKEUP_ADDRESS_MARK,  /**< Defines the wakeup on the node address*/
+    USART_WAKEUP_MAX            /**< Defines the maximum wakeup event*/
+}UsartWakeup_t;
+
+/**
+ * Defines the largest node address of the address mark wakeup.
+*/
+#define USART_ADDRESS_MAX 15U
+
 /**
  * Defines the Universal Synchronous/Asynchronous Receiver Transmitter
  * configuration table. This table is used to configure the USART 
@@ -154,8 +243,31 @@ typedef struct
     UsartTxDma_t        TxDma;      /**< Enable or disable TX DMA mode*/
     UsartEnable_t       Enable;     /**< USART or disable enable*/
     UsartBaudRate_t     BaudRate;   /**< USART baud rate*/
+    UsartClock_t        Clock;      /**< Asynchronous or synchronous mode*/
+    UsartClockPolarity_t ClockPolarity; /**< Idle level of CK*/
+    UsartClockPhase_t   ClockPhase; /**< Capture edge of CK*/
+    UsartLastBitClock_t LastBitClock; /**< Clock pulse of the last bit*/
+    UsartOversampling_t Oversampling; /**< Oversampling by 16 or by 8*/
+    UsartMute_t         Mute;       /**< Receiver muted at the start*/
+    UsartWakeup_t       Wakeup;     /**< Idle line or address mark wakeup*/
+    uint8_t             Address;    /**< Node address (0 to 15)*/
 }UsartConfig_t;
 
+/**
+ * Defines the register images of a USART port. They are generated with the
+ * configuration table by scripts/cfg_generate.py, so USART_imageInit writes
+ * the port with plain stores. The baud rate register is computed from the
+ * bus clock of the board description.
+*/
+typedef struct
+{
+    UsartPort_t Port;           /**< USART port*/
+    uint32_t cr1;               /**< Control register 1*/
+    uint32_t cr2;               /**< Control register 2*/
+    uint32_t cr3;               /**< Control register 3*/
+    uint32_t brr;               /**< Baud rate register*/
+}UsartPortImage_t;
+
 /*****************************************************************************
  * Function Prototypes
  *****************************************************************************/
@@ -165,6 +277,8 @@ extern "C"{
 
 const UsartConfig_t * const USART_configGet(void);
 size_t USART_configSizeGet(void);
+const UsartPortImage_t * const USART_imageGet(void);
+size_t USART_imageSizeGet(void);
 
 #ifdef __cplusplus
 } // extern C
@@ -0,0 +1,115 @@
+/**
+ * @file wave.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the DMA-driven waveform engine. This is
+ * the header file for the definition of the interface for generating
+ * multi-pin digital waveforms on a GPIO port. A timer update request drives
+ * a DMA stream that writes a precomputed array of bit set/reset words to
+ * the port, so the waveform is produced without CPU involvement.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef WAVE_H_
+#define WAVE_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <assert.h>
+#include "dio_cfg.h"    /*For the port and pin definitions*/
+#include "dma.h"        /*For the DMA stream transfers*/
+#include "stm32f4xx.h"  /*Microcontroller family header*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the pattern word that leaves every pin of the port unchanged.
+*/
+#define WAVE_IDLE_WORD 0x00000000UL
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+/**
+ * Defines how many times the waveform pattern is played.
+*/
+typedef enum
+{
+    WAVE_ONE_SHOT,      /**< The pattern is played once */
+    WAVE_CIRCULAR,      /**< The pattern is repeated until stopped */
+    WAVE_MODE_MAX       /**< Defines the maximum waveform mode */
+}WaveMode_t;
+
+/**
+ * Defines the state of the waveform engine.
+*/
+typedef enum
+{
+    WAVE_IDLE,          /**< No waveform is being played */
+    WAVE_RUNNING,       /**< A waveform is being played */
+    WAVE_STATE_MAX      /**< Defines the maximum waveform state */
+}WaveState_t;
+
+/**
+ * Defines a single edge of a waveform. A pin is driven to the state from
+ * the given tick on. A tick is one period of the waveform timer.
+*/
+typedef struct
+{
+    DioPin_t Pin;               /**< The I/O pin of the waveform port */
+    DioPinState_t State;        /**< The state driven from the tick on */
+    uint32_t tick;              /**< The tick where the edge is placed */
+}WaveEdge_t;
+
+/**
+ * Defines the data needed to play a waveform on a port.
+*/
+typedef struct
+{
+    DioPort_t Port;             /**< The I/O port driven by the waveform */
+    const uint32_t *pattern;    /**< Bit set/reset words, one per tick */
+    uint32_t length;            /**< Number of ticks of the pattern */
+    uint32_t tickPeriod;        /**< Timer clock cycles of each tick */
+    WaveMode_t Mode;            /**< One shot or circular */
+}WaveTransferConfig_t;
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+size_t WAVE_edgesBuild(const WaveEdge_t * const Edges, size_t edgeCount,
+uint32_t * const pattern, size_t patternLength);
+size_t WAVE_busBuild(const DioPin_t * const Pins, size_t pinCount,
+const uint16_t * const data, size_t dataLength, uint32_t * const pattern);
+DioPinState_t WAVE_pinStateGet(const uint32_t * const pattern, size_t length,
+DioPin_t Pin, uint32_t tick, DioPinState_t InitialState);
+void WAVE_start(const WaveTransferConfig_t * const TransferConfig);
+void WAVE_stop(void);
+WaveState_t WAVE_stateGet(void);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*WAVE_H_*/
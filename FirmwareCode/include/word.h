@@ -0,0 +1,87 @@
+/**
+ * @file word.h
+ * @author Jose Luis Figueroa
+ * @brief The interface definition for the USART word conversions. This is
+ * the header file for the definition of the interface for converting the
+ * half-words moved by a 16-bit DMA stream (9-bit words, or 8-bit words
+ * with parity) to and from byte streams. The conversions handle four words
+ * at a time, so the cost per byte stays low at high baud rates.
+ *
+ * A 9-bit byte stream holds groups of up to eight words: the low eight bits
+ * of each word, followed by one byte with the ninth bit of word i on bit i.
+ * The last group may hold fewer than eight words.
+ * @version 1.1
+ * @date 2025-03-25
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef WORD_H_
+#define WORD_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <assert.h>
+#include "stm32f4xx.h"  /*Microcontroller family header*/
+
+/*****************************************************************************
+* Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the number of words of a 9-bit group.
+*/
+#define WORD_GROUP_SIZE 8U
+
+/**
+ * Defines the ninth bit of a word (the address mark of a multiprocessor
+ * protocol).
+*/
+#define WORD_NINTH_BIT 0x0100U
+
+/*****************************************************************************
+* Configuration Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/**
+ * Returns the size of the 9-bit byte stream of count words.
+*/
+#define WORD_PACKED_SIZE(count) \
+    ((count) + (((count) + WORD_GROUP_SIZE - 1U) / WORD_GROUP_SIZE))
+
+/*****************************************************************************
+* Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Variables
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+void WORD_bytesMask(uint8_t * const data, uint32_t length,
+const uint8_t mask);
+void WORD_narrow(const uint16_t * const words, uint32_t count,
+uint8_t * const bytes, const uint8_t mask);
+void WORD_widen(const uint8_t * const bytes, uint32_t count,
+uint16_t * const words, const uint16_t ninth);
+uint32_t WORD_pack9(const uint16_t * const words, uint32_t count,
+uint8_t * const bytes);
+uint32_t WORD_unpack9(const uint8_t * const bytes, uint32_t count,
+uint16_t * const words);
+
+#ifdef __cplusplus
+} // extern C
+#endif
+
+#endif /*WORD_H_*/
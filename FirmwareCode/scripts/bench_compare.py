@@ -0,0 +1,82 @@
+"""
+@file bench_compare.py
+@author Jose Luis Figueroa
+@brief Throughput regression check of the loopback benchmark reports.
+
+The nucleo_f401re_bench environment transmits a JSON report on USART2 when
+its workloads end (see src/bench/bench_main.c). This script compares a report
+against a baseline report and fails when a workload lost throughput, or has
+more errors than in the baseline:
+
+    python scripts/bench_compare.py BASELINE REPORT [--tolerance PERCENT]
+
+A report may be the raw capture of the serial line: the text before the
+first '{' and after the last '}' is ignored. Keep the baseline next to the
+sources and replace it when a change is expected to alter the throughput.
+
+@version 1.1
+@date 2025-03-25
+
+@copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    """Return the report of a file as a dictionary of workloads by name."""
+    with open(path) as report_file:
+        text = report_file.read()
+    text = text[text.find("{"):text.rfind("}") + 1]
+    report = json.loads(text)
+    return report, {item["name"]: item for item in report["workloads"]}
+
+
+def compare(baseline, report, tolerance):
+    """Return the list of regressions of report against baseline."""
+    problems = []
+    for name, before in sorted(baseline.items()):
+        after = report.get(name)
+        if after is None:
+            problems.append("%s: missing from the report" % name)
+            continue
+        limit = before["bytes_per_s"] * (1.0 - tolerance / 100.0)
+        if after["bytes_per_s"] < limit:
+            problems.append("%s: %d bytes/s, baseline %d bytes/s" % (
+                name, after["bytes_per_s"], before["bytes_per_s"]))
+        if after["errors"] > before["errors"]:
+            problems.append("%s: %d errors, baseline %d" % (
+                name, after["errors"], before["errors"]))
+    return problems
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[3])
+    parser.add_argument("baseline")
+    parser.add_argument("report")
+    parser.add_argument("--tolerance", type=float, default=5.0,
+                        help="throughput loss allowed (percent)")
+    arguments = parser.parse_args()
+    baseline_info, baseline = load(arguments.baseline)
+    report_info, report = load(arguments.report)
+
+    if baseline_info.get("baud") != report_info.get("baud"):
+        sys.stderr.write("bench_compare: the baud rates differ (%s, %s)\n" % (
+            baseline_info.get("baud"), report_info.get("baud")))
+    print("%-10s %12s %12s %8s %8s" % ("workload", "bytes/s", "baseline",
+                                       "idle", "errors"))
+    for name, item in sorted(report.items()):
+        before = baseline.get(name, {}).get("bytes_per_s", 0)
+        print("%-10s %12d %12d %7.1f%% %8d" % (
+            name, item["bytes_per_s"], before,
+            item["idle_permille"] / 10.0, item["errors"]))
+
+    problems = compare(baseline, report, arguments.tolerance)
+    for problem in problems:
+        sys.stderr.write("bench_compare: %s\n" % problem)
+    return 1 if problems else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
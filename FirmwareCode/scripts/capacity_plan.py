@@ -0,0 +1,311 @@
+"""
+@file capacity_plan.py
+@author Jose Luis Figueroa
+@brief Buffer sizing and bus contention planner for the DMA/USART streams.
+
+The ring sizes and the stream order were chosen by guessing. This script
+reads the DmaConfig_t and UsartConfig_t tables of the project (with the
+parser of config_check.py) and a traffic profile, and simulates:
+
+  - the byte timing of each USART line (baud rate and frame length of its
+    UsartConfig_t row),
+  - the arbitration of each DMA controller: a request is served after the
+    requests of higher priority, and between equal priorities the lower
+    stream number wins (RM0368, 9.3.3),
+  - the software that empties (RX) or fills (TX) each ring, which runs
+    isr_latency_us after the half transfer, transfer complete and idle line
+    events.
+
+For every stream it reports the minimum ring size without overrun, the worst
+DMA request latency (a request not served within one frame time is a USART
+overrun whatever the ring size), and the utilization of each controller.
+
+    python scripts/capacity_plan.py [--profile FILE] [--json]
+
+The traffic profile is a JSON file (scripts/traffic_profile.json by
+default):
+
+    {
+        "hclk": 16000000,           AHB clock of the DMA controllers (Hz)
+        "transfer_cycles": 8,       AHB cycles of a single DMA transfer
+        "bursts": 16,               bursts simulated on each stream
+        "max_ring": 4096,           largest ring size searched (bytes)
+        "streams": {
+            "DMA1_STREAM_5": {
+                "burst_bytes": 64,      bytes of a message
+                "burst_period_ms": 20,  time between message starts
+                "isr_latency_us": 50,   worst delay of the ring handler
+                "priority": 0,          PL field (0 low .. 3 very high)
+                "baud": 115200          optional, overrides UsartConfig_t
+            }
+        }
+    }
+
+Streams without a profile entry are not simulated.
+
+@version 1.1
+@date 2025-03-24
+
+@copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+"""
+import argparse
+import heapq
+import json
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from config_check import Project, dma_requests, dma_stream  # noqa: E402
+
+# ---------------------------------------------------------------------------
+# Frame timing
+# ---------------------------------------------------------------------------
+STOP_BITS = {"USART_STOP_BITS_1": 1.0, "USART_STOP_BITS_0_5": 0.5,
+             "USART_STOP_BITS_2": 2.0, "USART_STOP_BITS_1_5": 1.5}
+WORD_BITS = {"USART_WORD_LENGTH_8": 8, "USART_WORD_LENGTH_9": 9}
+
+# Profile values used when a stream entry leaves them out.
+STREAM_DEFAULTS = {"burst_bytes": 64, "burst_period_ms": 20.0,
+                   "isr_latency_us": 50.0, "priority": 0}
+
+
+def frame_time(usart_row, baud):
+    """Return the time of one character on the line in seconds. The parity
+    bit is part of the word length on the STM32 USART."""
+    bits = 1 + WORD_BITS.get(usart_row["WordLength"], 8) + \
+        STOP_BITS.get(usart_row["StopBits"], 1.0)
+    return bits / float(baud)
+
+
+# ---------------------------------------------------------------------------
+# Stream model
+# ---------------------------------------------------------------------------
+class Stream:
+    """A DMA stream serving a USART request, with its traffic profile."""
+
+    def __init__(self, dma_row, usart_row, request, profile, enum_values):
+        self.name = dma_row["Stream"]
+        self.origin = dma_row["origin"]
+        self.request = request
+        self.controller, self.number = dma_stream(dma_row)
+        self.rx = request.endswith("_RX")
+        settings = dict(STREAM_DEFAULTS)
+        settings.update(profile)
+        self.baud = int(settings.get("baud",
+                                     enum_values.get(usart_row["BaudRate"], 0)))
+        self.frame = frame_time(usart_row, self.baud)
+        self.burst_bytes = int(settings["burst_bytes"])
+        self.burst_period = float(settings["burst_period_ms"]) * 1e-3
+        self.latency = float(settings["isr_latency_us"]) * 1e-6
+        self.priority = int(settings["priority"])
+
+    def byte_times(self, bursts):
+        """Return the times of the DMA requests of the stream. An RX request
+        is raised when a character is received (RXNE); a TX request when
+        the transmit data register is empty (TXE) and data is queued."""
+        times = []
+        for burst in range(bursts):
+            start = burst * self.burst_period
+            for index in range(self.burst_bytes):
+                offset = index + 1 if self.rx else index
+                times.append(start + offset * self.frame)
+        return times
+
+
+# ---------------------------------------------------------------------------
+# Ring sizing
+# ---------------------------------------------------------------------------
+def rx_overruns(stream, arrivals, size):
+    """Return True if a circular RX ring of size bytes is overwritten before
+    the handler reads it. The handler runs after the half transfer and
+    transfer complete events and after the idle line that ends a burst, and
+    reads every byte written up to then."""
+    services = []
+    for index, arrival in enumerate(arrivals):
+        count = index + 1
+        if count % (size // 2) == 0:
+            services.append(arrival + stream.latency)
+        if count % stream.burst_bytes == 0:
+            services.append(arrival + stream.frame + stream.latency)
+    services.sort()
+
+    read = 0
+    service = 0
+    for index, arrival in enumerate(arrivals):
+        while service < len(services) and services[service] <= arrival:
+            read = max(read, _count_until(arrivals, services[service]))
+            service += 1
+        if index + 1 - read > size:
+            return True
+    return False
+
+
+def _count_until(arrivals, time):
+    """Return the number of bytes received up to time."""
+    low, high = 0, len(arrivals)
+    while low < high:
+        middle = (low + high) // 2
+        if arrivals[middle] <= time:
+            low = middle + 1
+        else:
+            high = middle
+    return low
+
+
+def rx_ring_size(stream, arrivals, max_ring):
+    """Return the smallest even ring size without overrun, or None."""
+    for size in range(2, max_ring + 1, 2):
+        if not rx_overruns(stream, arrivals, size):
+            return size
+    return None
+
+
+def tx_ring_size(stream, bursts):
+    """Return the peak backlog of a TX ring, or None if the line is slower
+    than the traffic. The software queues a burst every period; the DMA
+    sends the queued bytes, and a new transfer is started by the transfer
+    complete handler, isr_latency_us after the previous one ends."""
+    busy_until = 0.0
+    queued = []
+    peak = 0
+    for burst in range(bursts):
+        now = burst * stream.burst_period
+        queued = [end for end in queued if end > now]
+        start = max(now, busy_until + (stream.latency if queued else 0.0))
+        busy_until = start + stream.burst_bytes * stream.frame
+        queued.append(busy_until)
+        peak = max(peak, len(queued) * stream.burst_bytes)
+    if stream.burst_bytes * stream.frame > stream.burst_period:
+        return None
+    return peak
+
+
+# ---------------------------------------------------------------------------
+# DMA arbitration
+# ---------------------------------------------------------------------------
+def arbitrate(streams, requests, transfer_time):
+    """Serve the requests of one controller and return the worst latency of
+    each stream and the busy time of the controller. requests is a list of
+    (time, stream)."""
+    requests = sorted(requests, key=lambda item: item[0])
+    worst = {stream.name: 0.0 for stream in streams}
+    pending = []
+    now = 0.0
+    busy = 0.0
+    position = 0
+    while position < len(requests) or pending:
+        if not pending and requests[position][0] > now:
+            now = requests[position][0]
+        while position < len(requests) and requests[position][0] <= now:
+            time, stream = requests[position]
+            heapq.heappush(pending, (-stream.priority, stream.number, time,
+                                     stream.name))
+            position += 1
+        _, _, time, name = heapq.heappop(pending)
+        now += transfer_time
+        busy += transfer_time
+        worst[name] = max(worst[name], now - time)
+    return worst, busy
+
+
+# ---------------------------------------------------------------------------
+# Planner
+# ---------------------------------------------------------------------------
+def usart_of(request):
+    """Return the UsartConfig_t port name of a USART request."""
+    return "USART_PORT_" + request.split("_")[0].replace("USART", "")
+
+
+def plan(project, profile):
+    """Simulate the profiled streams and return the results."""
+    usart_rows = {row["Port"]: row for row in project.rows("UsartConfig_t")}
+    stream_profiles = profile.get("streams", {})
+    hclk = float(profile.get("hclk", 16000000))
+    transfer_time = float(profile.get("transfer_cycles", 8)) / hclk
+    bursts = int(profile.get("bursts", 16))
+    max_ring = int(profile.get("max_ring", 4096))
+
+    streams = []
+    for row in project.rows("DmaConfig_t"):
+        if row["Stream"] not in stream_profiles:
+            continue
+        usart = [request for request in dma_requests(row)
+                 if request.startswith("USART")]
+        if not usart or usart_of(usart[0]) not in usart_rows:
+            sys.stderr.write("capacity_plan: %s: no USART request with a "
+                             "UsartConfig_t row, skipped\n" % row["origin"])
+            continue
+        streams.append(Stream(row, usart_rows[usart_of(usart[0])], usart[0],
+                              stream_profiles[row["Stream"]],
+                              project.enum_values))
+
+    results = {"streams": [], "controllers": []}
+    arrivals = {stream.name: stream.byte_times(bursts) for stream in streams}
+    for controller in sorted({stream.controller for stream in streams}):
+        members = [s for s in streams if s.controller == controller]
+        requests = [(time, stream) for stream in members
+                    for time in arrivals[stream.name]]
+        worst, busy = arbitrate(members, requests, transfer_time)
+        span = max(time for time, _ in requests) + transfer_time
+        results["controllers"].append({
+            "controller": "DMA%d" % controller,
+            "utilization": busy / span if span > 0 else 0.0,
+        })
+        for stream in members:
+            if stream.rx:
+                ring = rx_ring_size(stream, arrivals[stream.name], max_ring)
+            else:
+                ring = tx_ring_size(stream, bursts)
+            results["streams"].append({
+                "stream": stream.name,
+                "request": stream.request,
+                "baud": stream.baud,
+                "frame_us": stream.frame * 1e6,
+                "min_ring_bytes": ring,
+                "worst_latency_us": worst[stream.name] * 1e6,
+                "usart_overrun": worst[stream.name] > stream.frame,
+                "line_load": stream.burst_bytes * stream.frame /
+                stream.burst_period,
+            })
+    return results
+
+
+def print_report(results):
+    print("%-14s %-10s %8s %10s %12s %10s" % ("stream", "request", "baud",
+                                              "ring (B)", "latency (us)",
+                                              "line load"))
+    for item in results["streams"]:
+        ring = item["min_ring_bytes"]
+        print("%-14s %-10s %8d %10s %12.2f %9.1f%%%s" % (
+            item["stream"], item["request"], item["baud"],
+            "-" if ring is None else str(ring), item["worst_latency_us"],
+            item["line_load"] * 100.0,
+            "  USART OVERRUN" if item["usart_overrun"] else ""))
+    for item in results["controllers"]:
+        print("%s utilization: %.3f%%" % (item["controller"],
+                                          item["utilization"] * 100.0))
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[3])
+    parser.add_argument("--project", default=os.path.dirname(here))
+    parser.add_argument("--profile",
+                        default=os.path.join(here, "traffic_profile.json"))
+    parser.add_argument("--json", action="store_true",
+                        help="print the results as JSON")
+    arguments = parser.parse_args()
+    with open(arguments.profile) as profile_file:
+        profile = json.load(profile_file)
+    results = plan(Project(arguments.project), profile)
+    if arguments.json:
+        print(json.dumps(results, indent=2))
+    else:
+        print_report(results)
+    overrun = [item for item in results["streams"]
+               if item["usart_overrun"] or item["min_ring_bytes"] is None]
+    return 1 if overrun else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
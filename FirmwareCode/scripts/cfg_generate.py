@@ -0,0 +1,361 @@
+"""
+@file cfg_generate.py
+@author Jose Luis Figueroa
+@brief Generation of the configuration tables from the board description.
+
+The DmaConfig, UsartConfig and DioConfig tables were edited by hand, and the
+drivers translated them into register bits at every boot. This script reads
+a single board description (board.json) and writes, into src/dma_cfg.c,
+src/usart_cfg.c and src/dio_cfg.c:
+
+  - the configuration tables (DmaConfig, UsartConfig, DioConfig), read by
+    DMA_init, USART_init and DIO_init and by the *_configGet functions,
+  - their register images (DmaImage, UsartImage, DioImage): the CR/FCR of
+    each stream, the CR1/CR2/CR3/BRR of each USART and the MODER, OTYPER,
+    OSPEEDR, PUPDR and AFR bits of each port, read by the *_imageInit
+    functions, so the init is a loop of plain stores.
+
+Only the rows of the tables are replaced; the rest of the files is kept. The
+rows are checked with the checks of config_check.py (request map, pins,
+baud rate error) before anything is written.
+
+    python scripts/cfg_generate.py [--board FILE] [--check]
+
+With --check nothing is written and the script fails if the tables of src/
+are not the ones generated from the board description. It runs this way as
+a PlatformIO pre-build script.
+
+The board description uses the field names of the structures and the names
+of the enumerations; a field left out takes the first enumerator:
+
+    {
+        "clocks": {"apb1": 16000000, "apb2": 16000000},
+        "DmaConfig": [{"Stream": "DMA1_STREAM_6", "Channel": "DMA_CHANNEL_4",
+                       ...}],
+        "UsartConfig": [...],
+        "DioConfig": [...]
+    }
+
+@version 1.1
+@date 2025-03-24
+
+@copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+"""
+import argparse
+import json
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from config_check import (Project, Report, USART_BUS, check_dio,  # noqa: E402
+                          check_dma, check_usart, dio_pin, int_literal,
+                          usart_number)
+
+# Tables of the board description: (table, structure, image table, file).
+TABLES = [
+    ("DmaConfig", "DmaConfig_t", "DmaImage", "DmaStreamImage_t",
+     "src/dma_cfg.c"),
+    ("UsartConfig", "UsartConfig_t", "UsartImage", "UsartPortImage_t",
+     "src/usart_cfg.c"),
+    ("DioConfig", "DioConfig_t", "DioImage", "DioPortImage_t",
+     "src/dio_cfg.c"),
+]
+
+# Width of the generated rows, as the hand-written tables.
+ROW_WIDTH = 92
+
+# ---------------------------------------------------------------------------
+# Register bits (RM0368). The DMA and USART images are written with the
+# CMSIS names, as the drivers do.
+# ---------------------------------------------------------------------------
+DMA_CHANNEL_BITS = ["DMA_SxCR_CHSEL_0", "DMA_SxCR_CHSEL_1", "DMA_SxCR_CHSEL_2"]
+DMA_DIRECTION_BITS = {"DMA_PERIPHERAL_TO_MEMORY": [],
+                      "DMA_MEMORY_TO_PERIPHERAL": ["DMA_SxCR_DIR_0"],
+                      "DMA_MEMORY_TO_MEMORY": ["DMA_SxCR_DIR_1"]}
+DMA_SIZE_BITS = {"8": [], "16": ["_0"], "32": ["_1"]}
+DMA_THRESHOLD_BITS = {"DMA_FIFO_THRESHOLD_1_4": [],
+                      "DMA_FIFO_THRESHOLD_1_2": ["DMA_SxFCR_FTH_0"],
+                      "DMA_FIFO_THRESHOLD_3_4": ["DMA_SxFCR_FTH_1"],
+                      "DMA_FIFO_THRESHOLD_FULL": ["DMA_SxFCR_FTH_0",
+                                                  "DMA_SxFCR_FTH_1"]}
+USART_STOP_BITS = {"USART_STOP_BITS_1": [],
+                   "USART_STOP_BITS_0_5": ["USART_CR2_STOP_0"],
+                   "USART_STOP_BITS_2": ["USART_CR2_STOP_1"],
+                   "USART_STOP_BITS_1_5": ["USART_CR2_STOP_0",
+                                           "USART_CR2_STOP_1"]}
+
+DIO_PINS_PER_AFR = 8
+
+
+def bits(names):
+    """Return the C expression of a register image."""
+    return " | ".join(names) if names else "0U"
+
+
+def dma_image(row):
+    """Return the DmaStreamImage_t initializer of a DmaConfig_t row."""
+    channel = int(row["Channel"].replace("DMA_CHANNEL_", ""))
+    cr = [name for bit, name in enumerate(DMA_CHANNEL_BITS)
+          if channel & (1 << bit)]
+    cr += DMA_DIRECTION_BITS[row["Direction"]]
+    cr += ["DMA_SxCR_MSIZE" + suffix for suffix in
+           DMA_SIZE_BITS[row["MemorySize"].split("_")[-1]]]
+    cr += ["DMA_SxCR_PSIZE" + suffix for suffix in
+           DMA_SIZE_BITS[row["PeripheralSize"].split("_")[-1]]]
+    if row["MemoryIncrement"] == "DMA_MEMORY_INCREMENT_ENABLED":
+        cr.append("DMA_SxCR_MINC")
+    if row["PeripheralIncrement"] == "DMA_PERIPHERAL_INCREMENT_ENABLED":
+        cr.append("DMA_SxCR_PINC")
+    if row["CircularMode"] == "DMA_CIRCULAR_MODE_ENABLED":
+        cr.append("DMA_SxCR_CIRC")
+    fcr = list(DMA_THRESHOLD_BITS[row["FifoThreshold"]])
+    if row["FifoMode"] == "DMA_FIFO_DIRECT_MODE_DISABLED":
+        fcr.insert(0, "DMA_SxFCR_DMDIS")
+    return [row["Stream"], bits(cr), bits(fcr)]
+
+
+def usart_image(row, clocks, enum_values):
+    """Return the UsartPortImage_t initializer of a UsartConfig_t row. The
+    baud rate register is rounded as USART_baudRateCalculate does."""
+    cr1, cr2, cr3 = [], list(USART_STOP_BITS[row["StopBits"]]), []
+    if row["WordLength"] == "USART_WORD_LENGTH_9":
+        cr1.append("USART_CR1_M")
+    if row["Parity"] == "USART_PARITY_ENABLED":
+        cr1.append("USART_CR1_PCE")
+    if row["Rx"] == "USART_RX_ENABLED":
+        cr1.append("USART_CR1_RE")
+    if row["Tx"] == "USART_TX_ENABLED":
+        cr1.append("USART_CR1_TE")
+    if row["Enable"] == "USART_ENABLED":
+        cr1.append("USART_CR1_UE")
+    over8 = row["Oversampling"] == "USART_OVERSAMPLING_8"
+    if over8:
+        cr1.append("USART_CR1_OVER8")
+    if row["Wakeup"] == "USART_WAKEUP_ADDRESS_MARK":
+        cr1.append("USART_CR1_WAKE")
+    if row["Mute"] == "USART_MUTE_ENABLED":
+        cr1.append("USART_CR1_RWU")
+    for field, value, name in (
+            ("Clock", "USART_CLOCK_ENABLED", "USART_CR2_CLKEN"),
+            ("ClockPolarity", "USART_CLOCK_POLARITY_HIGH", "USART_CR2_CPOL"),
+            ("ClockPhase", "USART_CLOCK_PHASE_SECOND", "USART_CR2_CPHA"),
+            ("LastBitClock", "USART_LAST_BIT_CLOCK_ENABLED",
+             "USART_CR2_LBCL")):
+        if row[field] == value:
+            cr2.append(name)
+    address = int_literal(row["Address"])
+    if address:
+        cr2.append("(%dU << USART_CR2_ADD_Pos)" % address)
+    if row["RxDma"] == "USART_RX_DMA_ENABLED":
+        cr3.append("USART_CR3_DMAR")
+    if row["TxDma"] == "USART_TX_DMA_ENABLED":
+        cr3.append("USART_CR3_DMAT")
+    clock = clocks[USART_BUS[usart_number(row)]]
+    baud = enum_values[row["BaudRate"]]
+    brr = (clock + baud // 2) // baud
+    if over8:
+        brr = ((brr & ~0x7) << 1) | (brr & 0x7)
+    return [row["Port"], bits(cr1), bits(cr2), bits(cr3), "0x%04XU" % brr]
+
+
+def dio_images(rows, enum_values):
+    """Return the DioPortImage_t initializers of the ports used by the
+    DioConfig_t rows, composed as DIO_imageCompose does."""
+    ports = {}
+    for row in rows:
+        _, pin, _ = dio_pin(row)
+        port = ports.setdefault(row["Port"], {
+            "pins": 0, "Moder": [0, 0], "Otyper": [0, 0], "Ospeedr": [0, 0],
+            "Pupdr": [0, 0], "Afr": [[0, 0], [0, 0]]})
+        port["pins"] |= 1 << pin
+        for field, register, width in (("Mode", "Moder", 2),
+                                       ("Type", "Otyper", 1),
+                                       ("Speed", "Ospeedr", 2),
+                                       ("Resistor", "Pupdr", 2)):
+            shift = pin * width
+            port[register][0] |= ((1 << width) - 1) << shift
+            port[register][1] |= enum_values[row[field]] << shift
+        afr = port["Afr"][pin // DIO_PINS_PER_AFR]
+        shift = (pin % DIO_PINS_PER_AFR) * 4
+        afr[0] |= 0xF << shift
+        afr[1] |= enum_values[row["Function"]] << shift
+
+    def image(register):
+        return "{0x%08XUL, 0x%08XUL}" % tuple(register)
+
+    images = []
+    for name in sorted(ports, key=lambda port: enum_values[port]):
+        port = ports[name]
+        images.append([name, "0x%04XU" % port["pins"], image(port["Moder"]),
+                       image(port["Otyper"]), image(port["Ospeedr"]),
+                       image(port["Pupdr"]),
+                       "{%s, %s}" % (image(port["Afr"][0]),
+                                     image(port["Afr"][1]))])
+    return images
+
+
+# ---------------------------------------------------------------------------
+# Board description
+# ---------------------------------------------------------------------------
+def board_rows(project, board, table, type_name, report):
+    """Return the rows of a table of the board description, in the format of
+    Project.rows, with their fields checked against the structure."""
+    fields = project.structs[type_name]
+    names = [name for _, name in fields]
+    rows = []
+    for index, entry in enumerate(board.get(table, [])):
+        origin = "board.json %s[%d]" % (table, index)
+        for name in entry:
+            if name not in names:
+                report.error(origin, "%s has no field %s" % (type_name, name))
+        row = {"origin": origin}
+        for field_type, name in fields:
+            members = project.enum_types.get(field_type, [])
+            value = str(entry.get(name, members[0] if members else "0"))
+            if members and value not in members:
+                report.error(origin, "%s is not a %s" % (value, field_type))
+            row[name] = value
+        rows.append(row)
+    return rows
+
+
+def generate(project, board):
+    """Return {file: {table: [initializer tokens]}} and the check report."""
+    report = Report()
+    clocks = board.get("clocks", {"apb1": 16000000, "apb2": 16000000})
+    rows = {}
+    for table, type_name, _, _, _ in TABLES:
+        rows[table] = board_rows(project, board, table, type_name, report)
+    if not report.errors:
+        check_dma(rows["DmaConfig"], report)
+        check_dio(rows["DioConfig"], report)
+        check_usart(rows["UsartConfig"], rows["DmaConfig"], rows["DioConfig"],
+                    clocks, project.enum_values, report)
+    if report.errors:
+        return None, report
+
+    fields = {type_name: [name for _, name in project.structs[type_name]]
+              for _, type_name, _, _, _ in TABLES}
+    images = {
+        "DmaImage": [dma_image(row) for row in rows["DmaConfig"]],
+        "UsartImage": [usart_image(row, clocks, project.enum_values)
+                       for row in rows["UsartConfig"]],
+        "DioImage": dio_images(rows["DioConfig"], project.enum_values),
+    }
+    files = {}
+    for table, type_name, image, _, path in TABLES:
+        files[path] = {
+            table: [[row[name] for name in fields[type_name]]
+                    for row in rows[table]],
+            image: images[image],
+        }
+    return files, report
+
+
+# ---------------------------------------------------------------------------
+# C output
+# ---------------------------------------------------------------------------
+def format_row(tokens):
+    """Return the lines of a table row, wrapped as the hand-written rows."""
+    lines, current = [], "   {"
+    for index, token in enumerate(tokens):
+        piece = token + ("}," if index == len(tokens) - 1 else ",")
+        if current.strip() != "{" and \
+                len(current) + len(piece) > ROW_WIDTH:
+            lines.append(current.rstrip())
+            current = "   "
+        current += piece + " "
+    lines.append(current.rstrip())
+    return lines
+
+
+def splice(text, table, rows):
+    """Replace the rows of a table of a C source, keeping its declaration
+    and its column comment."""
+    pattern = r"(\b\w+\s+%s\[\]\s*=\s*\n\{[ \t]*\n(?:/\*.*?\*/[ \t]*\n)?)" \
+        r"(.*?)(\n\};)" % table
+    match = re.search(pattern, text, flags=re.S)
+    if match is None:
+        raise SystemExit("cfg_generate: table %s not found" % table)
+    body = "\n".join(line for row in rows for line in format_row(row))
+    return text[:match.start(2)] + body + text[match.end(2):]
+
+
+def render(project_dir, files):
+    """Return {path: (current text, generated text)} of the sources."""
+    result = {}
+    for path, tables in files.items():
+        with open(os.path.join(project_dir, path), "rb") as source:
+            current = source.read().decode()
+        crlf = "\r\n" in current
+        text = current.replace("\r\n", "\n")
+        for table, rows in tables.items():
+            text = splice(text, table, rows)
+        if crlf:
+            text = text.replace("\n", "\r\n")
+        result[path] = (current, text)
+    return result
+
+
+def run(project_dir, board_path, check, clocks=None):
+    """Generate (or check) the tables and return the error count."""
+    with open(board_path) as board_file:
+        board = json.load(board_file)
+    report = Report()
+    if clocks is not None and board.get("clocks") != clocks:
+        report.error(os.path.basename(board_path), "clocks %s differ from "
+                     "the project clocks %s" % (board.get("clocks"), clocks))
+    files, generated = generate(Project(project_dir), board)
+    report.warnings += generated.warnings
+    report.errors += generated.errors
+    if files is not None:
+        for path, (current, text) in sorted(render(project_dir,
+                                                   files).items()):
+            if current == text:
+                continue
+            if check:
+                report.error(path, "tables are not the ones generated from "
+                             "%s, run scripts/cfg_generate.py"
+                             % os.path.basename(board_path))
+            else:
+                with open(os.path.join(project_dir, path), "wb") as source:
+                    source.write(text.encode())
+                print("cfg_generate: wrote " + path)
+    for line in report.warnings + report.errors:
+        print("cfg_generate: " + line)
+    return len(report.errors)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    project = os.path.dirname(here)
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[3])
+    parser.add_argument("--project", default=project)
+    parser.add_argument("--board", default=os.path.join(project, "board.json"))
+    parser.add_argument("--check", action="store_true",
+                        help="fail if the tables are not up to date")
+    arguments = parser.parse_args()
+    return 1 if run(arguments.project, arguments.board,
+                    arguments.check) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+else:
+    try:
+        Import("env")  # noqa: F821 (provided by PlatformIO/SCons)
+    except NameError:
+        env = None
+    if env is not None:
+        project_dir = env.subst("$PROJECT_DIR")
+        clocks = {
+            "apb1": int(env.GetProjectOption("custom_apb1_clock", "16000000")),
+            "apb2": int(env.GetProjectOption("custom_apb2_clock", "16000000")),
+        }
+        board = os.path.join(project_dir, env.GetProjectOption(
+            "custom_board", "board.json"))
+        if run(project_dir, board, True, clocks):
+            sys.stderr.write("cfg_generate: configuration tables are out of "
+                             "date, build stopped\n")
+            env.Exit(1)
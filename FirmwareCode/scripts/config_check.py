@@ -0,0 +1,685 @@
+"""
+@file config_check.py
+@author Jose Luis Figueroa
+@brief Build-time validation of the DMA, USART, SPI, I2C and DIO
+configuration tables.
+
+The drivers used to catch a bad configuration row, if at all, with asserts
+inside the init loops. This script moves those checks to the build: it reads
+the enumerations and structures of include/*_cfg.h, extracts every
+DmaConfig_t, UsartConfig_t, SpiConfig_t, I2cConfig_t and DioConfig_t
+initializer found in src/, and validates the rows against the STM32F401 request and pin maps.
+
+It runs as a PlatformIO pre-build script (extra_scripts = pre:...) and stops
+the build on any error. It can also be run on its own:
+
+    python scripts/config_check.py [--apb1 HZ] [--apb2 HZ]
+
+The parsing helpers are reused by the other tools of the scripts folder.
+
+@version 1.1
+@date 2025-03-24
+
+@copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+"""
+import argparse
+import os
+import re
+import sys
+
+# ---------------------------------------------------------------------------
+# Device data (STM32F401, RM0368)
+# ---------------------------------------------------------------------------
+# DMA request mapping: (controller, stream, channel) -> request names.
+DMA_REQUESTS = {
+    (1, 0, 0): ["SPI3_RX"], (1, 2, 0): ["SPI3_RX"], (1, 3, 0): ["SPI2_RX"],
+    (1, 4, 0): ["SPI2_TX"], (1, 5, 0): ["SPI3_TX"], (1, 7, 0): ["SPI3_TX"],
+    (1, 0, 1): ["I2C1_RX"], (1, 1, 1): ["I2C3_RX"], (1, 5, 1): ["I2C1_RX"],
+    (1, 6, 1): ["I2C1_TX"], (1, 7, 1): ["I2C1_TX"],
+    (1, 0, 2): ["TIM4_CH1"], (1, 3, 2): ["TIM4_CH2"], (1, 6, 2): ["TIM4_UP"],
+    (1, 7, 2): ["TIM4_CH3"],
+    (1, 1, 3): ["TIM2_UP", "TIM2_CH3"], (1, 2, 3): ["I2C3_RX"],
+    (1, 4, 3): ["I2C3_TX"], (1, 5, 3): ["TIM2_CH1"],
+    (1, 6, 3): ["TIM2_CH2", "TIM2_CH4"], (1, 7, 3): ["TIM2_UP", "TIM2_CH4"],
+    (1, 5, 4): ["USART2_RX"], (1, 6, 4): ["USART2_TX"],
+    (1, 2, 5): ["TIM3_CH4", "TIM3_UP"], (1, 4, 5): ["TIM3_CH1", "TIM3_TRIG"],
+    (1, 5, 5): ["TIM3_CH2"], (1, 7, 5): ["TIM3_CH3"],
+    (1, 0, 6): ["TIM5_CH3", "TIM5_UP"], (1, 1, 6): ["TIM5_CH4", "TIM5_TRIG"],
+    (1, 2, 6): ["TIM5_CH1"], (1, 3, 6): ["TIM5_CH4", "TIM5_TRIG"],
+    (1, 4, 6): ["TIM5_CH2"], (1, 6, 6): ["TIM5_UP"],
+    (1, 2, 7): ["I2C2_RX"], (1, 3, 7): ["I2C2_RX"], (1, 7, 7): ["I2C2_TX"],
+    (2, 0, 0): ["ADC1"], (2, 4, 0): ["ADC1"],
+    (2, 6, 0): ["TIM1_CH1", "TIM1_CH2", "TIM1_CH3"],
+    (2, 0, 3): ["SPI1_RX"], (2, 2, 3): ["SPI1_RX"], (2, 3, 3): ["SPI1_TX"],
+    (2, 5, 3): ["SPI1_TX"],
+    (2, 0, 4): ["SPI4_RX"], (2, 1, 4): ["SPI4_TX"], (2, 2, 4): ["USART1_RX"],
+    (2, 3, 4): ["SDIO"], (2, 5, 4): ["USART1_RX"], (2, 6, 4): ["SDIO"],
+    (2, 7, 4): ["USART1_TX"],
+    (2, 1, 5): ["USART6_RX"], (2, 2, 5): ["USART6_RX"], (2, 3, 5): ["SPI4_RX"],
+    (2, 4, 5): ["SPI4_TX"], (2, 6, 5): ["USART6_TX"], (2, 7, 5): ["USART6_TX"],
+    (2, 0, 6): ["TIM1_TRIG"], (2, 1, 6): ["TIM1_CH1"], (2, 2, 6): ["TIM1_CH2"],
+    (2, 3, 6): ["TIM1_CH1"], (2, 4, 6): ["TIM1_CH4", "TIM1_TRIG", "TIM1_COM"],
+    (2, 5, 6): ["TIM1_UP"], (2, 6, 6): ["TIM1_CH3"],
+}
+
+# Alternate functions of the pins: (port, pin, af) -> signal.
+PIN_FUNCTIONS = {
+    ("A", 0, 1): "TIM2_CH1", ("A", 1, 1): "TIM2_CH2", ("A", 2, 1): "TIM2_CH3",
+    ("A", 3, 1): "TIM2_CH4", ("A", 5, 1): "TIM2_CH1", ("A", 15, 1): "TIM2_CH1",
+    ("B", 3, 1): "TIM2_CH2", ("B", 10, 1): "TIM2_CH3",
+    ("A", 8, 1): "TIM1_CH1", ("A", 9, 1): "TIM1_CH2", ("A", 10, 1): "TIM1_CH3",
+    ("A", 11, 1): "TIM1_CH4",
+    ("A", 6, 2): "TIM3_CH1", ("A", 7, 2): "TIM3_CH2", ("B", 0, 2): "TIM3_CH3",
+    ("B", 1, 2): "TIM3_CH4", ("B", 4, 2): "TIM3_CH1", ("B", 5, 2): "TIM3_CH2",
+    ("C", 6, 2): "TIM3_CH1", ("C", 7, 2): "TIM3_CH2", ("C", 8, 2): "TIM3_CH3",
+    ("C", 9, 2): "TIM3_CH4",
+    ("B", 6, 2): "TIM4_CH1", ("B", 7, 2): "TIM4_CH2", ("B", 8, 2): "TIM4_CH3",
+    ("B", 9, 2): "TIM4_CH4",
+    ("B", 6, 4): "I2C1_SCL", ("B", 7, 4): "I2C1_SDA", ("B", 8, 4): "I2C1_SCL",
+    ("B", 9, 4): "I2C1_SDA", ("B", 10, 4): "I2C2_SCL", ("B", 3, 9): "I2C2_SDA",
+    ("A", 8, 4): "I2C3_SCL", ("C", 9, 4): "I2C3_SDA", ("B", 4, 9): "I2C3_SDA",
+    ("A", 4, 5): "SPI1_NSS", ("A", 5, 5): "SPI1_SCK", ("A", 6, 5): "SPI1_MISO",
+    ("A", 7, 5): "SPI1_MOSI", ("A", 15, 5): "SPI1_NSS", ("B", 3, 5): "SPI1_SCK",
+    ("B", 4, 5): "SPI1_MISO", ("B", 5, 5): "SPI1_MOSI",
+    ("B", 10, 5): "SPI2_SCK", ("B", 12, 5): "SPI2_NSS", ("B", 13, 5): "SPI2_SCK",
+    ("B", 14, 5): "SPI2_MISO", ("B", 15, 5): "SPI2_MOSI",
+    ("C", 2, 5): "SPI2_MISO", ("C", 3, 5): "SPI2_MOSI",
+    ("A", 15, 6): "SPI3_NSS", ("B", 3, 6): "SPI3_SCK", ("B", 4, 6): "SPI3_MISO",
+    ("B", 5, 6): "SPI3_MOSI", ("C", 10, 6): "SPI3_SCK", ("C", 11, 6): "SPI3_MISO",
+    ("C", 12, 6): "SPI3_MOSI",
+    ("A", 8, 7): "USART1_CK", ("A", 9, 7): "USART1_TX", ("A", 10, 7): "USART1_RX",
+    ("A", 15, 7): "USART1_TX", ("B", 3, 7): "USART1_RX", ("B", 6, 7): "USART1_TX",
+    ("B", 7, 7): "USART1_RX",
+    ("A", 2, 7): "USART2_TX", ("A", 3, 7): "USART2_RX", ("A", 4, 7): "USART2_CK",
+    ("A", 11, 8): "USART6_TX", ("A", 12, 8): "USART6_RX", ("C", 6, 8): "USART6_TX",
+    ("C", 7, 8): "USART6_RX", ("C", 8, 8): "USART6_CK",
+}
+
+# Pins reserved by the board (debugger and oscillators).
+RESERVED_PINS = {("A", 13): "SWDIO", ("A", 14): "SWCLK"}
+OSCILLATOR_PINS = {("C", 14): "OSC32_IN", ("C", 15): "OSC32_OUT",
+                   ("H", 0): "OSC_IN", ("H", 1): "OSC_OUT"}
+
+# Bus of each USART port.
+USART_BUS = {"1": "apb2", "2": "apb1", "6": "apb2"}
+
+# Minimum APB1 clock of the I2C speeds (RM0368 27.6.2, FREQ field)
+I2C_CLOCK_MIN = {"I2C_SPEED_STANDARD": 2000000, "I2C_SPEED_FAST": 4000000}
+
+# DMA FIFO size in bytes and threshold levels in bytes.
+DMA_FIFO_BYTES = 16
+DMA_FIFO_THRESHOLD_BYTES = {"1_4": 4, "1_2": 8, "3_4": 12, "FULL": 16}
+DMA_SIZE_BYTES = {"8": 1, "16": 2, "32": 4}
+
+# Maximum baud rate error accepted by the receivers, in percent.
+BAUD_ERROR_LIMIT = 2.0
+
+# Largest node address of the address mark wakeup (CR2 ADD).
+USART_ADDRESS_MAX = 15
+
+# ---------------------------------------------------------------------------
+# C parsing helpers
+# ---------------------------------------------------------------------------
+def strip_comments(text):
+    """Remove the C and C++ comments of a source text."""
+    text = re.sub(r"/\*.*?\*/", " ", text, flags=re.S)
+    return re.sub(r"//[^\n]*", " ", text)
+
+
+def read_defines(text):
+    """Return the object-like macros of a source text."""
+    defines = {}
+    for name, value in re.findall(r"^\s*#define\s+(\w+)\s+([^\n]+)$",
+                                  strip_comments(text), flags=re.M):
+        defines[name] = value.strip()
+    return defines
+
+
+def int_literal(text):
+    """Return the value of a C integer literal (with its U/L suffix)."""
+    return int(re.sub(r"[uUlL]+$", "", text.strip()), 0)
+
+
+def read_enums(text):
+    """Return {enumerator: value} and {type: [enumerators]} of a header."""
+    values = {}
+    types = {}
+    for body, name in re.findall(r"typedef\s+enum\s*\{(.*?)\}\s*(\w+)\s*;",
+                                 strip_comments(text), flags=re.S):
+        current = -1
+        members = []
+        for item in body.split(","):
+            item = item.strip()
+            if not item:
+                continue
+            if "=" in item:
+                member, expression = [x.strip() for x in item.split("=", 1)]
+                expression = values.get(expression, expression)
+                if isinstance(expression, str):
+                    expression = int_literal(expression)
+                current = expression
+            else:
+                member = item
+                current += 1
+            values[member] = current
+            members.append(member)
+        types[name] = members
+    return values, types
+
+
+def read_structs(text):
+    """Return {struct type: [(field type, field name)]} of a header."""
+    structs = {}
+    for body, name in re.findall(r"typedef\s+struct\s*\{(.*?)\}\s*(\w+)\s*;",
+                                 strip_comments(text), flags=re.S):
+        fields = []
+        for declaration in body.split(";"):
+            words = declaration.replace("*", " * ").split()
+            if len(words) >= 2:
+                fields.append((" ".join(words[:-1]), words[-1]))
+        structs[name] = fields
+    return structs
+
+
+def _matching_brace(text, start):
+    depth = 0
+    for index in range(start, len(text)):
+        if text[index] == "{":
+            depth += 1
+        elif text[index] == "}":
+            depth -= 1
+            if depth == 0:
+                return index
+    raise ValueError("unbalanced braces")
+
+
+def _split_top_level(body):
+    items, depth, current = [], 0, ""
+    for char in body:
+        if char == "{":
+            depth += 1
+        elif char == "}":
+            depth -= 1
+        if char == "," and depth == 0:
+            items.append(current.strip())
+            current = ""
+        else:
+            current += char
+    if current.strip():
+        items.append(current.strip())
+    return items
+
+
+def read_tables(text, type_name):
+    """Return [(table name, [[initializer tokens]])] for a struct type."""
+    tables = []
+    clean = strip_comments(text)
+    defines = read_defines(text)
+    pattern = r"\b%s\s+(\w+)\s*(\[\s*\w*\s*\])?\s*=\s*\{" % type_name
+    for match in re.finditer(pattern, clean):
+        open_brace = match.end() - 1
+        body = clean[open_brace + 1:_matching_brace(clean, open_brace)]
+        if match.group(2):
+            rows = [row.strip()[1:-1] for row in _split_top_level(body)]
+        else:
+            rows = [body]
+        parsed = []
+        for row in rows:
+            tokens = [defines.get(token, token) for token in
+                      _split_top_level(" ".join(row.split()))]
+            parsed.append(tokens)
+        tables.append((match.group(1), parsed))
+    return tables
+
+
+class Project:
+    """Configuration tables of the firmware project."""
+
+    def __init__(self, project_dir):
+        self.project_dir = project_dir
+        self.enum_values = {}
+        self.enum_types = {}
+        self.structs = {}
+        include_dir = os.path.join(project_dir, "include")
+        for name in sorted(os.listdir(include_dir)):
+            if name.endswith(".h"):
+                with open(os.path.join(include_dir, name)) as header:
+                    text = header.read()
+                values, types = read_enums(text)
+                self.enum_values.update(values)
+                self.enum_types.update(types)
+                self.structs.update(read_structs(text))
+
+    def rows(self, type_name):
+        """Return the rows of every type_name table found in src/."""
+        fields = self.structs[type_name]
+        source_dir = os.path.join(self.project_dir, "src")
+        result = []
+        for name in sorted(os.listdir(source_dir)):
+            if not name.endswith(".c"):
+                continue
+            with open(os.path.join(source_dir, name)) as source:
+                text = source.read()
+            for table, rows in read_tables(text, type_name):
+                for index, tokens in enumerate(rows):
+                    row = {"origin": "src/%s %s[%d]" % (name, table, index)}
+                    for position, (field_type, field) in enumerate(fields):
+                        if position < len(tokens):
+                            row[field] = tokens[position]
+                        elif field_type in self.enum_types:
+                            row[field] = self.enum_types[field_type][0]
+                        else:
+                            row[field] = "0"
+                    result.append(row)
+        return result
+
+
+# ---------------------------------------------------------------------------
+# Checks
+# ---------------------------------------------------------------------------
+class Report:
+    """Errors and warnings found on the configuration tables."""
+
+    def __init__(self):
+        self.errors = []
+        self.warnings = []
+
+    def error(self, origin, message):
+        self.errors.append("%s: error: %s" % (origin, message))
+
+    def warning(self, origin, message):
+        self.warnings.append("%s: warning: %s" % (origin, message))
+
+
+def dma_stream(row):
+    """Return (controller, stream) of a DmaConfig_t row."""
+    match = re.match(r"DMA(\d)_STREAM_(\d)$", row["Stream"])
+    return (int(match.group(1)), int(match.group(2))) if match else None
+
+
+def dma_requests(row):
+    """Return the requests served by the stream/channel of a row."""
+    stream = dma_stream(row)
+    channel = re.match(r"DMA_CHANNEL_(\d)$", row["Channel"])
+    if stream is None or channel is None:
+        return []
+    return DMA_REQUESTS.get(stream + (int(channel.group(1)),), [])
+
+
+def fifo_threshold_valid(memory_bytes, threshold_bytes, burst_beats=1):
+    """A memory burst must fit an integer number of times the threshold."""
+    return threshold_bytes % (memory_bytes * burst_beats) == 0
+
+
+def check_dma(rows, report):
+    streams = {}
+    for row in rows:
+        origin = row["origin"]
+        stream = dma_stream(row)
+        if stream is None:
+            report.error(origin, "unknown stream %s" % row["Stream"])
+            continue
+        if stream in streams:
+            report.error(origin, "%s already configured by %s"
+                         % (row["Stream"], streams[stream]))
+        streams[stream] = origin
+
+        direction = row["Direction"]
+        memory = DMA_SIZE_BYTES.get(row["MemorySize"].split("_")[-1])
+        peripheral = DMA_SIZE_BYTES.get(row["PeripheralSize"].split("_")[-1])
+        direct = row["FifoMode"] == "DMA_FIFO_DIRECT_MODE_ENABLED"
+
+        if direction == "DMA_MEMORY_TO_MEMORY":
+            if stream[0] != 2:
+                report.error(origin, "memory to memory is only on DMA2")
+            if direct:
+                report.error(origin, "memory to memory needs the FIFO "
+                             "(direct mode disabled)")
+        else:
+            requests = dma_requests(row)
+            if not requests:
+                report.error(origin, "%s has no request on %s"
+                             % (row["Stream"], row["Channel"]))
+            for request in requests:
+                if request.endswith("_RX") or request == "ADC1":
+                    if direction != "DMA_PERIPHERAL_TO_MEMORY":
+                        report.error(origin, "%s needs peripheral to memory"
+                                     % request)
+                elif request.endswith("_TX"):
+                    if direction != "DMA_MEMORY_TO_PERIPHERAL":
+                        report.error(origin, "%s needs memory to peripheral"
+                                     % request)
+
+        if memory is None or peripheral is None:
+            report.error(origin, "unknown data size")
+            continue
+        if direct and memory != peripheral:
+            report.error(origin, "direct mode ignores the memory size, "
+                         "memory and peripheral sizes must match")
+        if not direct:
+            threshold = DMA_FIFO_THRESHOLD_BYTES.get(
+                row["FifoThreshold"].replace("DMA_FIFO_THRESHOLD_", ""))
+            if threshold is None or threshold > DMA_FIFO_BYTES or \
+                    not fifo_threshold_valid(memory, threshold):
+                report.error(origin, "FIFO threshold %s is not valid for "
+                             "%d-bit memory data"
+                             % (row["FifoThreshold"], memory * 8))
+
+
+def usart_number(row):
+    return row["Port"].replace("USART_PORT_", "")
+
+
+def stream_requests(dma_rows):
+    """Return {request: DmaConfig_t row of the stream serving it}."""
+    requests = {}
+    for row in dma_rows:
+        for request in dma_requests(row):
+            requests[request] = row
+    return requests
+
+
+def stream_sizes(row):
+    """Return the [memory, peripheral] data sizes of a stream in bytes."""
+    return [DMA_SIZE_BYTES.get(row[field].split("_")[-1])
+            for field in ("MemorySize", "PeripheralSize")]
+
+
+def pin_functions(dio_rows):
+    """Return the signals routed to a pin by the DioConfig_t rows."""
+    functions = set()
+    for row in dio_rows:
+        pin = dio_pin(row)
+        if pin is not None and row["Mode"] == "DIO_FUNCTION":
+            signal = PIN_FUNCTIONS.get((pin[0], pin[1], dio_af(row)))
+            if signal:
+                functions.add(signal)
+    return functions
+
+
+def check_usart(rows, dma_rows, dio_rows, clocks, enum_values, report):
+    ports = {}
+    requests = stream_requests(dma_rows)
+    functions = pin_functions(dio_rows)
+
+    for row in rows:
+        origin = row["origin"]
+        number = usart_number(row)
+        if number not in USART_BUS:
+            report.error(origin, "unknown port %s" % row["Port"])
+            continue
+        if number in ports:
+            report.error(origin, "%s already configured by %s"
+                         % (row["Port"], ports[number]))
+        ports[number] = origin
+        name = "USART%s" % number
+
+        clock = clocks[USART_BUS[number]]
+        baud = enum_values.get(row["BaudRate"])
+        if baud is None or baud <= 0:
+            report.error(origin, "unknown baud rate %s" % row["BaudRate"])
+        else:
+            divider = (clock + baud // 2) // baud
+            over8 = row["Oversampling"] == "USART_OVERSAMPLING_8"
+            if divider < (8 if over8 else 16) or \
+                    divider > (0x7FFF if over8 else 0xFFFF):
+                report.error(origin, "%d baud is not reachable from a %d Hz "
+                             "%s clock" % (baud, clock, USART_BUS[number]))
+            else:
+                error = abs(clock / divider - baud) * 100.0 / baud
+                if error > BAUD_ERROR_LIMIT:
+                    report.error(origin, "%d baud has a %.2f%% error from a "
+                                 "%d Hz clock" % (baud, error, clock))
+
+        if row["Clock"] == "USART_CLOCK_ENABLED":
+            if "%s_CK" % name not in functions:
+                report.warning(origin, "%s_CK is enabled but no pin is set "
+                               "to its alternate function" % name)
+            if row["Tx"] != "USART_TX_ENABLED":
+                report.error(origin, "synchronous mode sends the clock with "
+                             "the transmitted data, the transmitter must be "
+                             "enabled")
+        else:
+            for field, default in (
+                    ("ClockPolarity", "USART_CLOCK_POLARITY_LOW"),
+                    ("ClockPhase", "USART_CLOCK_PHASE_FIRST"),
+                    ("LastBitClock", "USART_LAST_BIT_CLOCK_DISABLED")):
+                if row[field] != default:
+                    report.warning(origin, "%s has no effect in asynchronous "
+                                   "mode" % row[field])
+
+        try:
+            address = int_literal(row["Address"])
+        except ValueError:
+            address = None
+        if address is None or not 0 <= address <= USART_ADDRESS_MAX:
+            report.error(origin, "node address %s is not in 0..%d"
+                         % (row["Address"], USART_ADDRESS_MAX))
+        if row["Wakeup"] == "USART_WAKEUP_ADDRESS_MARK":
+            if row["Parity"] == "USART_PARITY_ENABLED":
+                report.error(origin, "the parity bit takes the place of the "
+                             "address mark, address mark wakeup needs the "
+                             "parity disabled")
+        elif address:
+            report.warning(origin, "the node address is only used by the "
+                           "address mark wakeup")
+        if row["Mute"] == "USART_MUTE_ENABLED" and \
+                row["Rx"] != "USART_RX_ENABLED":
+            report.warning(origin, "USART_MUTE_ENABLED has no effect with the "
+                           "receiver disabled")
+
+        # The parity bit takes the place of the ninth data bit
+        nine_bits = row["WordLength"] == "USART_WORD_LENGTH_9" and \
+            row["Parity"] == "USART_PARITY_DISABLED"
+        for direction, enabled, dma in (
+                ("TX", row["Tx"] == "USART_TX_ENABLED",
+                 row["TxDma"] == "USART_TX_DMA_ENABLED"),
+                ("RX", row["Rx"] == "USART_RX_ENABLED",
+                 row["RxDma"] == "USART_RX_DMA_ENABLED")):
+            signal = "%s_%s" % (name, direction)
+            if enabled and signal not in functions:
+                report.warning(origin, "%s is enabled but no pin is set to "
+                               "its alternate function" % signal)
+            if dma and signal not in requests:
+                report.warning(origin, "%s DMA is enabled but no stream "
+                               "serves the request" % signal)
+            if dma and signal in requests and nine_bits:
+                stream = requests[signal]
+                if stream_sizes(stream) != [2, 2]:
+                    report.error(stream["origin"], "%s carries 9-bit words, "
+                                 "the stream needs 16-bit memory and "
+                                 "peripheral sizes" % signal)
+
+
+def check_spi(rows, dma_rows, dio_rows, report):
+    ports = {}
+    requests = stream_requests(dma_rows)
+    functions = pin_functions(dio_rows)
+
+    for row in rows:
+        origin = row["origin"]
+        number = row["Port"].replace("SPI_PORT_", "")
+        if number not in ("1", "2", "3", "4"):
+            report.error(origin, "unknown port %s" % row["Port"])
+            continue
+        if number in ports:
+            report.error(origin, "%s already configured by %s"
+                         % (row["Port"], ports[number]))
+        ports[number] = origin
+        if row["Enable"] != "SPI_ENABLED":
+            continue
+        name = "SPI%s" % number
+
+        signals = ["SCK", "MISO", "MOSI"]
+        if row["SlaveSelect"] == "SPI_SLAVE_SELECT_HARDWARE":
+            signals.append("NSS")
+        for signal in ["%s_%s" % (name, signal) for signal in signals]:
+            if signal not in functions:
+                report.warning(origin, "%s is enabled but no pin is set to "
+                               "its alternate function" % signal)
+
+        # The transfers always use both streams, with the frame size
+        size = 2 if row["DataSize"] == "SPI_DATA_SIZE_16" else 1
+        for signal in ("%s_TX" % name, "%s_RX" % name):
+            if signal not in requests:
+                report.warning(origin, "%s has no stream, SPI_transfer "
+                               "needs one" % signal)
+            elif stream_sizes(requests[signal]) != [size, size]:
+                report.error(requests[signal]["origin"], "%s carries %d-bit "
+                             "frames, the stream needs %d-bit memory and "
+                             "peripheral sizes" % (signal, 8 * size, 8 * size))
+
+
+def check_i2c(rows, dma_rows, dio_rows, clocks, report):
+    ports = {}
+    requests = stream_requests(dma_rows)
+    pins = {}
+    for row in dio_rows:
+        pin = dio_pin(row)
+        if pin is not None and row["Mode"] == "DIO_FUNCTION":
+            signal = PIN_FUNCTIONS.get((pin[0], pin[1], dio_af(row)))
+            if signal:
+                pins[signal] = row
+
+    for row in rows:
+        origin = row["origin"]
+        number = row["Port"].replace("I2C_PORT_", "")
+        if number not in ("1", "2", "3"):
+            report.error(origin, "unknown port %s" % row["Port"])
+            continue
+        if number in ports:
+            report.error(origin, "%s already configured by %s"
+                         % (row["Port"], ports[number]))
+        ports[number] = origin
+        name = "I2C%s" % number
+
+        minimum = I2C_CLOCK_MIN.get(row["Speed"])
+        if minimum is None:
+            report.error(origin, "unknown speed %s" % row["Speed"])
+        elif clocks["apb1"] < minimum:
+            report.error(origin, "%s needs APB1 of at least %d MHz, it is "
+                         "%d Hz" % (row["Speed"], minimum // 1000000,
+                                    clocks["apb1"]))
+        if row["Enable"] != "I2C_ENABLED":
+            continue
+
+        # The bus is wired-AND, a push-pull pin fights the devices
+        for signal in ("%s_SCL" % name, "%s_SDA" % name):
+            if signal not in pins:
+                report.warning(origin, "%s is enabled but no pin is set to "
+                               "its alternate function" % signal)
+            elif pins[signal]["Type"] != "DIO_OPEN_DRAIN":
+                report.error(pins[signal]["origin"], "%s must be an "
+                             "open-drain output" % signal)
+
+        for signal in ("%s_TX" % name, "%s_RX" % name):
+            if signal not in requests:
+                report.warning(origin, "%s has no stream, I2C_transfer "
+                               "needs one" % signal)
+            elif stream_sizes(requests[signal]) != [1, 1]:
+                report.error(requests[signal]["origin"], "%s moves bytes, "
+                             "the stream needs 8-bit memory and peripheral "
+                             "sizes" % signal)
+
+
+def dio_pin(row):
+    """Return (port letter, pin number) of a DioConfig_t row."""
+    port = re.match(r"DIO_P([A-Z])$", row["Port"])
+    pin = re.match(r"DIO_P([A-Z])(\d+)$", row["Pin"])
+    if port is None or pin is None:
+        return None
+    return (port.group(1), int(pin.group(2)), pin.group(1))
+
+
+def dio_af(row):
+    return int(row["Function"].replace("DIO_AF", ""))
+
+
+def check_dio(rows, report):
+    pins = {}
+    for row in rows:
+        origin = row["origin"]
+        pin = dio_pin(row)
+        if pin is None:
+            report.error(origin, "unknown pin %s" % row["Pin"])
+            continue
+        port, number, pin_port = pin
+        if port != pin_port:
+            report.error(origin, "%s does not belong to %s"
+                         % (row["Pin"], row["Port"]))
+        key = (port, number)
+        if key in pins:
+            report.error(origin, "P%s%d already configured by %s"
+                         % (port, number, pins[key]))
+        pins[key] = origin
+        if key in RESERVED_PINS:
+            report.error(origin, "P%s%d is reserved for %s"
+                         % (port, number, RESERVED_PINS[key]))
+        if key in OSCILLATOR_PINS:
+            report.warning(origin, "P%s%d is the %s pin"
+                           % (port, number, OSCILLATOR_PINS[key]))
+
+        af = dio_af(row)
+        if row["Mode"] == "DIO_FUNCTION":
+            if (port, number, af) not in PIN_FUNCTIONS:
+                report.warning(origin, "AF%d of P%s%d is not a known "
+                               "function" % (af, port, number))
+        elif af != 0:
+            report.warning(origin, "AF%d is set but the pin is not on "
+                           "alternate function mode" % af)
+
+
+def check_project(project, clocks):
+    """Run every check on the tables of the project and return the report."""
+    report = Report()
+    dma_rows = project.rows("DmaConfig_t")
+    usart_rows = project.rows("UsartConfig_t")
+    dio_rows = project.rows("DioConfig_t")
+    check_dma(dma_rows, report)
+    check_dio(dio_rows, report)
+    check_usart(usart_rows, dma_rows, dio_rows, clocks, project.enum_values,
+                report)
+    if "SpiConfig_t" in project.structs:
+        check_spi(project.rows("SpiConfig_t"), dma_rows, dio_rows, report)
+    if "I2cConfig_t" in project.structs:
+        check_i2c(project.rows("I2cConfig_t"), dma_rows, dio_rows, clocks,
+                  report)
+    return report
+
+
+def run(project_dir, clocks):
+    """Check the project, print the findings and return the error count."""
+    report = check_project(Project(project_dir), clocks)
+    for line in report.warnings + report.errors:
+        print("config_check: " + line)
+    return len(report.errors)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[3])
+    parser.add_argument("--project", default=os.path.dirname(here))
+    parser.add_argument("--apb1", type=int, default=16000000)
+    parser.add_argument("--apb2", type=int, default=16000000)
+    arguments = parser.parse_args()
+    errors = run(arguments.project,
+                 {"apb1": arguments.apb1, "apb2": arguments.apb2})
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+else:
+    try:
+        Import("env")  # noqa: F821 (provided by PlatformIO/SCons)
+    except NameError:
+        env = None
+    if env is not None:
+        clocks = {
+            "apb1": int(env.GetProjectOption("custom_apb1_clock", "16000000")),
+            "apb2": int(env.GetProjectOption("custom_apb2_clock", "16000000")),
+        }
+        if run(env.subst("$PROJECT_DIR"), clocks):
+            sys.stderr.write("config_check: configuration tables have "
+                             "errors, build stopped\n")
+            env.Exit(1)
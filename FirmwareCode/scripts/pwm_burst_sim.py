@@ -0,0 +1,157 @@
+"""
+@file pwm_burst_sim.py
+@author Jose Luis Figueroa
+@brief Host model of the timer DMA burst used by the PWM engine (pwm.c).
+
+PWM_start programs the DMA control register of TIM3 (DCR) and lets every
+update event trigger a burst of writes to its DMA address register (DMAR).
+The order of those writes, and the period where each one reaches the
+outputs, cannot be watched without a logic analyzer. This script replays
+the sequence of PWM_start on a model of the timer and of the circular
+stream, and prints what the timer sees:
+
+  - the DCR value and every DMAR write, with the compare register the timer
+    redirects it to (DBA + index of the write in the burst, RM0368 13.4.19),
+  - the transfer of the preload registers to the active ones on each update
+    event, which happens before the burst of the event,
+  - the compare values of the channels on every period.
+
+    python scripts/pwm_burst_sim.py --first 1 --channels 3
+        --duties "400,200,600;500,300,500" [--periods N] [--check]
+
+With --check, nothing is printed unless the periods do not output the
+frames of the table in order, from the first one; the exit code is 1 then.
+
+@version 1.1
+@date 2025-03-26
+
+@copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+"""
+import argparse
+import sys
+
+# ---------------------------------------------------------------------------
+# Timer register map (offsets in words from the base of TIM3, RM0368 13.4)
+# ---------------------------------------------------------------------------
+TIMER_REGISTERS = {
+    0: "CR1", 1: "CR2", 2: "SMCR", 3: "DIER", 4: "SR", 5: "EGR", 6: "CCMR1",
+    7: "CCMR2", 8: "CCER", 9: "CNT", 10: "PSC", 11: "ARR", 13: "CCR1",
+    14: "CCR2", 15: "CCR3", 16: "CCR4", 18: "DCR", 19: "DMAR", 20: "OR",
+}
+
+# Burst base address (DBA) of CCR1, as PWM_BURST_BASE_CCR1 in pwm.c
+BURST_BASE_CCR1 = 13
+DCR_DBL_POS = 8
+
+
+class Timer:
+    """Preload and active registers of the timer, with its DMA burst."""
+
+    def __init__(self, dcr, log):
+        self.dcr = dcr
+        self.preload = {}
+        self.active = {}
+        self.log = log
+
+    def dmar_write(self, index, value):
+        base = self.dcr & 0x1F
+        offset = base + index
+        name = TIMER_REGISTERS.get(offset, "0x%02X" % (4 * offset))
+        self.log("    DMAR <- %-6d -> %s (offset 0x%02X)"
+                 % (value, name, 4 * offset))
+        self.preload[name] = value
+
+    def burst_length(self):
+        return ((self.dcr >> DCR_DBL_POS) & 0x1F) + 1
+
+    def update_event(self):
+        """Transfer the preload registers to the active ones."""
+        self.active.update(self.preload)
+
+
+class Stream:
+    """Circular memory-to-peripheral stream with a fixed peripheral."""
+
+    def __init__(self, table):
+        self.table = table
+        self.remaining = len(table)
+
+    def serve(self, timer):
+        for index in range(timer.burst_length()):
+            position = len(self.table) - self.remaining
+            timer.dmar_write(index, self.table[position])
+            self.remaining -= 1
+            if self.remaining == 0:
+                self.remaining = len(self.table)
+
+
+def simulate(first, frames, periods, log):
+    """Replay PWM_start and return the compare values of each period."""
+    count = len(frames[0])
+    table = [value for frame in frames for value in frame]
+    dcr = ((count - 1) << DCR_DBL_POS) | (BURST_BASE_CCR1 + first - 1)
+    names = ["CCR%d" % (first + i) for i in range(count)]
+    timer = Timer(dcr, log)
+    stream = Stream(table)
+
+    log("DCR = 0x%04X (DBA %d, DBL %d)" % (dcr, dcr & 0x1F, count - 1))
+    outputs = []
+    # The two software update events of PWM_start, then one per period
+    for event in range(periods + 2):
+        label = ("UG %d" % (event + 1)) if event < 2 else \
+            ("update event %d" % (event - 2))
+        timer.update_event()
+        log("%s: active %s" % (label, ", ".join(
+            "%s=%s" % (name, timer.active.get(name, "-")) for name in names)))
+        stream.serve(timer)
+        if event >= 1 and len(outputs) < periods:
+            outputs.append([timer.active.get(name) for name in names])
+            log("  period %d outputs %s" % (len(outputs) - 1,
+                                            outputs[-1]))
+    return outputs
+
+
+def parse_frames(text, count):
+    frames = []
+    for item in text.split(";"):
+        frame = [int(value, 0) for value in item.split(",")]
+        if len(frame) != count:
+            raise ValueError("frame %r has %d values, expected %d"
+                             % (item, len(frame), count))
+        frames.append(frame)
+    return frames
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[3])
+    parser.add_argument("--first", type=int, default=1,
+                        help="first channel of the burst (1-4)")
+    parser.add_argument("--channels", type=int, required=True,
+                        help="number of channels of the burst")
+    parser.add_argument("--duties", required=True,
+                        help="frames separated by ';', values by ','")
+    parser.add_argument("--periods", type=int, default=0,
+                        help="periods to simulate (two loops by default)")
+    parser.add_argument("--check", action="store_true",
+                        help="only report periods out of order")
+    arguments = parser.parse_args()
+
+    if not (1 <= arguments.first and arguments.channels >= 1 and
+            arguments.first + arguments.channels - 1 <= 4):
+        parser.error("the channels of the burst must be within 1-4")
+    frames = parse_frames(arguments.duties, arguments.channels)
+    periods = arguments.periods or 2 * len(frames)
+
+    log = (lambda line: None) if arguments.check else print
+    outputs = simulate(arguments.first, frames, periods, log)
+    wrong = [period for period, values in enumerate(outputs)
+             if values != frames[period % len(frames)]]
+    for period in wrong:
+        print("pwm_burst_sim: period %d outputs %s, expected frame %d %s"
+              % (period, outputs[period], period % len(frames),
+                 frames[period % len(frames)]))
+    return 1 if wrong else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
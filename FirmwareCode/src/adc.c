@@ -0,0 +1,565 @@
+/**
+ * @file adc.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the ADC acquisition. ADC1 scans the
+ * sequence and requests DMA2 stream 0 or 4 (channel 0) after each
+ * conversion. The stream runs in circular mode and packs two samples per
+ * memory word through its FIFO; its half transfer and transfer complete
+ * interrupts tell which half of the buffer is ready. With two buffers, the
+ * stream runs in double-buffer mode and its transfer complete interrupt
+ * tells that the buffer it left is ready. The timer-triggered
+ * scans start on the compare 1 event of TIM5, as TIM2 is the timebase.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "adc.h"        /*For this modules definitions*/
+#include "timebase.h"   /*For the stabilization time*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the number of channels of each sequence register and the width
+ * of their fields.
+*/
+#define ADC_SEQUENCE_SLOTS 6U
+#define ADC_SEQUENCE_SLOT_BITS 5U
+
+/**
+ * Defines the channels whose sampling time is set on SMPR2 (the others are
+ * set on SMPR1) and the width of their fields.
+*/
+#define ADC_SMPR2_CHANNELS 10U
+#define ADC_SAMPLE_TIME_BITS 3U
+
+/**
+ * Defines the stabilization time of the ADC after it is powered on (us).
+*/
+#define ADC_STABILIZATION_TIME 3U
+
+/**
+ * Defines the external trigger of the regular sequence (TIM5_CC1) and its
+ * rising edge.
+*/
+#define ADC_EXTSEL_TIM5_CC1 0x0AUL
+#define ADC_EXTEN_RISING 0x01UL
+
+/**
+ * Defines the PWM mode 1 of the TIM5 compare output, which rises at the
+ * start of every period.
+*/
+#define ADC_TIMER_PWM_MODE 0x06UL
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+/**
+ * Gives the number of samples passed to the callback at a time: a half of
+ * the buffer, or a whole buffer in double-buffer mode.
+*/
+#define ADC_BUFFER_SAMPLES(Config) (((Config)->buffer2 != NULL) ? \
+    (Config)->length : ((Config)->length / 2U))
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/**
+ * The following structure contains the configuration of the DMA stream used
+ * by the acquisition. Each 16-bit sample is packed by the FIFO into 32-bit
+ * memory words, which halves the writes to the memory. The FIFO threshold
+ * is one word, so each word is written as soon as it is packed and a half
+ * is in memory when its event is raised. The stream is selected on every
+ * start.
+ */
+static const DmaConfig_t AdcDmaConfig =
+{
+/*
+ *  Stream          Channel        Direction                MemorySize
+ *  PeripheralSize         MemoryIncrement              PeripheralIncrement
+ *  FifoMode                      FifoThreshold            CircularMode
+ *
+*/
+    DMA2_STREAM_0, DMA_CHANNEL_0, DMA_PERIPHERAL_TO_MEMORY, DMA_MEMORY_SIZE_32,
+    DMA_PERIPHERAL_SIZE_16, DMA_MEMORY_INCREMENT_ENABLED, DMA_PERIPHERAL_INCREMENT_DISABLED,
+    DMA_FIFO_DIRECT_MODE_DISABLED, DMA_FIFO_THRESHOLD_1_4, DMA_CIRCULAR_MODE_ENABLED
+};
+
+/* Defines the acquisition being run (NULL when idle)*/
+static const AdcAcquisitionConfig_t * acquisition = NULL;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void ADC_halfProcess(const AdcAcquisitionConfig_t * const Config,
+const uint16_t * const samples);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: ADC_start()
+*//**
+ *\b Description:
+ * This function is used to sample a scan sequence into a circular buffer.
+ * The ADC is powered on and set up with the sequence, the DMA stream fills
+ * the buffer over and over, and ADC_irqHandler passes each half to the
+ * callback once it is full. With a decimation filter, the callback gets
+ * the averages of the half instead of the samples. With a second buffer
+ * (buffer2), the stream fills both buffers in turn in double-buffer mode
+ * and the callback gets each whole buffer; the callback may hand the
+ * buffer over and give the stream another one (ADC_bufferNextSet), so the
+ * samples are never copied. Any acquisition being run is stopped first.
+ *
+ * PRE-CONDITION: The clocks of ADC1 and DMA2 are enabled, and the clock of
+ * TIM5 with ADC_TRIGGER_TIMER. <br>
+ * PRE-CONDITION: The channel pins are configured as analog (DIO_init). <br>
+ * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+ * PRE-CONDITION: The interrupt of the stream is enabled in the NVIC, and
+ * its handler calls ADC_irqHandler. <br>
+ * PRE-CONDITION: length is a multiple of 4, and each half holds whole
+ * decimation windows (channelCount * factor samples). With buffer2, length
+ * is even and each buffer holds whole windows. <br>
+ * PRE-CONDITION: Config stays valid until ADC_stop. <br>
+ *
+ * POST-CONDITION: The sequence is being sampled. <br>
+ *
+ * @param[in]   Config is a pointer to the acquisition to run.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * static const AdcChannel_t Sequence[2] = {ADC_CHANNEL_0, ADC_CHANNEL_1};
+ * static const FilterDecimation_t Decimation = {2U, 16U};
+ * static uint16_t samples[1024] __attribute__((aligned(4)));
+ * static uint16_t averages[FILTER_OUTPUT_SIZE(512U, 2U, 16U)];
+ * static const AdcAcquisitionConfig_t Acquisition =
+ * {
+ *      .Channels = Sequence,
+ *      .channelCount = 2U,
+ *      .SampleTime = ADC_SAMPLE_TIME_3,
+ *      .Prescaler = ADC_PRESCALER_DIV_4,
+ *      .Trigger = ADC_TRIGGER_CONTINUOUS,
+ *      .scanPeriod = 0U,
+ *      .Stream = DMA2_STREAM_0,
+ *      .buffer = samples,
+ *      .length = 1024U,
+ *      .Decimation = &Decimation,
+ *      .output = averages,
+ *      .Callback = averagesReady
+ * };
+ *
+ * void DMA2_Stream0_IRQHandler(void)
+ * {
+ *      ADC_irqHandler();
+ * }
+ *
+ * ADC_start(&Acquisition);
+ * NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+ * @endcode
+ *
+ * @see ADC_start
+ * @see ADC_stop
+ * @see ADC_stateGet
+ * @see ADC_irqHandler
+ * @see ADC_bufferNextSet
+ *
+*****************************************************************************/
+void ADC_start(const AdcAcquisitionConfig_t * const Config)
+{
+    uint32_t sequence[3] = {0U, 0U, 0U};
+    uint32_t sampleTime[2] = {0U, 0U};
+    uint32_t common = 0U;
+    uint32_t deadline;
+    uint8_t slot;
+
+    /* Prevent to assign a value out of the range of the settings */
+    assert((Config->channelCount > 0U) &&
+           (Config->channelCount <= ADC_SEQUENCE_MAX));
+    assert(Config->SampleTime < ADC_SAMPLE_TIME_MAX);
+    assert(Config->Prescaler < ADC_PRESCALER_MAX);
+    assert(Config->Trigger < ADC_TRIGGER_MAX);
+    assert((Config->Stream == DMA2_STREAM_0) ||
+           (Config->Stream == DMA2_STREAM_4));
+    assert(((uint32_t)Config->buffer & 0x03UL) == 0U);
+    assert(((uint32_t)Config->buffer2 & 0x03UL) == 0U);
+    assert((Config->length > 0U) &&
+           ((Config->length % ((Config->buffer2 != NULL) ? 2U : 4U)) == 0U));
+    assert((Config->Trigger != ADC_TRIGGER_TIMER) ||
+           (Config->scanPeriod > 1U));
+
+    /* Prevent to split a window of the filter between the halves */
+    if(Config->Decimation != NULL)
+    {
+        assert(Config->Decimation->channels == Config->channelCount);
+        assert((ADC_BUFFER_SAMPLES(Config) % (Config->channelCount *
+            Config->Decimation->factor)) == 0U);
+    }
+
+    /* Release the ADC and the stream from a previous acquisition */
+    ADC_stop();
+
+    /* Set up the stream on the selected stream number */
+    DmaConfig_t StreamConfig = AdcDmaConfig;
+    StreamConfig.Stream = Config->Stream;
+    DMA_init(&StreamConfig, 1U);
+    DMA_doubleBufferSet(Config->Stream, (uint32_t*)Config->buffer2);
+
+    /* Place each channel of the sequence on its slot (SQR3 holds the first
+     * six, then SQR2 and SQR1) and set its sampling time.
+    */
+    for(uint8_t i=0; i<Config->channelCount; i++)
+    {
+        const AdcChannel_t Channel = Config->Channels[i];
+        assert(Channel < ADC_CHANNEL_MAX);
+
+        slot = i % ADC_SEQUENCE_SLOTS;
+        sequence[i / ADC_SEQUENCE_SLOTS] |=
+            ((uint32_t)Channel << (slot * ADC_SEQUENCE_SLOT_BITS));
+
+        if(Channel < ADC_SMPR2_CHANNELS)
+        {
+            sampleTime[1] |= ((uint32_t)Config->SampleTime <<
+                (Channel * ADC_SAMPLE_TIME_BITS));
+        }
+        else
+        {
+            sampleTime[0] |= ((uint32_t)Config->SampleTime <<
+                ((Channel - ADC_SMPR2_CHANNELS) * ADC_SAMPLE_TIME_BITS));
+        }
+
+        /* The internal channels are connected on request */
+        if((Channel == ADC_CHANNEL_16) || (Channel == ADC_CHANNEL_17))
+        {
+            common |= ADC_CCR_TSVREFE;
+        }
+        else if(Channel == ADC_CHANNEL_18)
+        {
+            common |= ADC_CCR_VBATE;
+        }
+    }
+    sequence[2] |= ((uint32_t)(Config->channelCount - 1U) << ADC_SQR1_L_Pos);
+
+    ADC1_COMMON->CCR = (ADC1_COMMON->CCR &
+        ~(ADC_CCR_ADCPRE | ADC_CCR_TSVREFE | ADC_CCR_VBATE)) |
+        ((uint32_t)Config->Prescaler << ADC_CCR_ADCPRE_Pos) | common;
+
+    /* 12-bit resolution, right aligned */
+    ADC1->CR1 = ADC_CR1_SCAN;
+    ADC1->SMPR1 = sampleTime[0];
+    ADC1->SMPR2 = sampleTime[1];
+    ADC1->SQR3 = sequence[0];
+    ADC1->SQR2 = sequence[1];
+    ADC1->SQR1 = sequence[2];
+
+    /* Power on the ADC and wait for it to be stable */
+    ADC1->CR2 = ADC_CR2_ADON;
+    deadline = TIMEBASE_deadlineGet(ADC_STABILIZATION_TIME);
+    while(TIMEBASE_deadlineCheck(deadline) == TIMEBASE_PENDING)
+    {
+    }
+
+    /* Set the transfer to the buffer, with an interrupt on each half (on
+     * each buffer in double-buffer mode)
+    */
+    DmaTransferConfig_t DmaTransferConfig =
+    {
+        .Stream = Config->Stream,
+        .peripheral = (uint32_t*)&ADC1->DR,
+        .memory = (uint32_t*)Config->buffer,
+        .length = Config->length
+    };
+
+    acquisition = Config;
+    DMA_transferConfig(&DmaTransferConfig);
+    if(Config->buffer2 == NULL)
+    {
+        DMA_interruptEnable(Config->Stream, DMA_INTERRUPT_HALF_TRANSFER);
+    }
+    DMA_interruptEnable(Config->Stream, DMA_INTERRUPT_TRANSFER_COMPLETE);
+
+    /* Keep the DMA requests after the end of the first buffer (DDS) */
+    ADC1->SR = 0U;
+    if(Config->Trigger == ADC_TRIGGER_CONTINUOUS)
+    {
+        ADC1->CR2 |= ADC_CR2_DMA | ADC_CR2_DDS | ADC_CR2_CONT;
+        ADC1->CR2 |= ADC_CR2_SWSTART;
+    }
+    else
+    {
+        /* The compare output rises at the start of every period */
+        TIM5->CR1 &= ~TIM_CR1_CEN;
+        TIM5->PSC = 0U;
+        TIM5->ARR = Config->scanPeriod - 1UL;
+        TIM5->CCR1 = Config->scanPeriod / 2UL;
+        TIM5->CCMR1 = (TIM5->CCMR1 & ~TIM_CCMR1_OC1M) |
+            (ADC_TIMER_PWM_MODE << TIM_CCMR1_OC1M_Pos);
+        TIM5->CCER |= TIM_CCER_CC1E;
+        TIM5->CNT = 0U;
+        TIM5->EGR = TIM_EGR_UG;
+
+        ADC1->CR2 |= ADC_CR2_DMA | ADC_CR2_DDS |
+            (ADC_EXTSEL_TIM5_CC1 << ADC_CR2_EXTSEL_Pos) |
+            (ADC_EXTEN_RISING << ADC_CR2_EXTEN_Pos);
+        TIM5->CR1 |= TIM_CR1_CEN;
+    }
+}
+
+/*****************************************************************************
+ * Function: ADC_stop()
+*//**
+ *\b Description:
+ * This function is used to stop the acquisition being run. The ADC is
+ * powered off, the trigger timer is stopped and the DMA stream is
+ * disabled. The half being filled is discarded.
+ *
+ * PRE-CONDITION: The clocks of ADC1 and DMA2 are enabled. <br>
+ *
+ * POST-CONDITION: No acquisition is running. <br>
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * ADC_stop();
+ * @endcode
+ *
+ * @see ADC_start
+ * @see ADC_stop
+ * @see ADC_stateGet
+ * @see ADC_irqHandler
+ * @see ADC_bufferNextSet
+ *
+*****************************************************************************/
+void ADC_stop(void)
+{
+    const AdcAcquisitionConfig_t * Config = acquisition;
+
+    /* Power off the ADC, which also ends its DMA requests */
+    ADC1->CR2 = 0U;
+    ADC1->SR = 0U;
+
+    if(Config != NULL)
+    {
+        if(Config->Trigger == ADC_TRIGGER_TIMER)
+        {
+            TIM5->CR1 &= ~TIM_CR1_CEN;
+        }
+
+        DMA_interruptDisable(Config->Stream, DMA_INTERRUPT_HALF_TRANSFER);
+        DMA_interruptDisable(Config->Stream, DMA_INTERRUPT_TRANSFER_COMPLETE);
+        DMA_transferStop(Config->Stream);
+        DMA_doubleBufferSet(Config->Stream, NULL);
+        acquisition = NULL;
+    }
+}
+
+/*****************************************************************************
+ * Function: ADC_stateGet()
+*//**
+ *\b Description:
+ * This function is used to know if the acquisition is running. A sample
+ * converted before the DMA had moved the previous one is an overrun: the
+ * ADC stops its DMA requests, and the acquisition is started again with
+ * ADC_start.
+ *
+ * PRE-CONDITION: The clock of ADC1 is enabled. <br>
+ *
+ * POST-CONDITION: The state of the acquisition is returned. <br>
+ *
+ * @return ADC_RUNNING while the sequence is being sampled, ADC_OVERRUN
+ *         after an overrun, otherwise ADC_IDLE.
+ *
+ * \b Example:
+ * @code
+ * if(ADC_stateGet() == ADC_OVERRUN)
+ * {
+ *      ADC_start(&Acquisition);
+ * }
+ * @endcode
+ *
+ * @see ADC_start
+ * @see ADC_stop
+ * @see ADC_stateGet
+ * @see ADC_irqHandler
+ * @see ADC_bufferNextSet
+ *
+*****************************************************************************/
+AdcState_t ADC_stateGet(void)
+{
+    AdcState_t State = ADC_IDLE;
+
+    if(acquisition != NULL)
+    {
+        State = (ADC1->SR & ADC_SR_OVR) ? ADC_OVERRUN : ADC_RUNNING;
+    }
+
+    return State;
+}
+
+/*****************************************************************************
+ * Function: ADC_irqHandler()
+*//**
+ *\b Description:
+ * This function is used to service the interrupt of the acquisition
+ * stream. It must be called from the interrupt handler of the stream. The
+ * half transfer event means the first half of the buffer is full, and the
+ * transfer complete event the second one; each full half is filtered and
+ * passed to the callback while the stream fills the other one. If both
+ * events are pending, the halves are processed in order. In double-buffer
+ * mode, the transfer complete event means the buffer the stream left is
+ * full.
+ *
+ * PRE-CONDITION: The acquisition was started (ADC_start). <br>
+ *
+ * POST-CONDITION: The full halves are passed to the callback. <br>
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * void DMA2_Stream0_IRQHandler(void)
+ * {
+ *      ADC_irqHandler();
+ * }
+ * @endcode
+ *
+ * @see ADC_start
+ * @see ADC_stop
+ * @see ADC_stateGet
+ * @see ADC_irqHandler
+ * @see ADC_bufferNextSet
+ *
+*****************************************************************************/
+void ADC_irqHandler(void)
+{
+    const AdcAcquisitionConfig_t * Config = acquisition;
+
+    if(Config == NULL)
+    {
+        return;
+    }
+
+    if(Config->buffer2 != NULL)
+    {
+        if(DMA_eventClear(Config->Stream, DMA_INTERRUPT_TRANSFER_COMPLETE))
+        {
+            ADC_halfProcess(Config,
+                (const uint16_t*)DMA_memoryIdleGet(Config->Stream));
+        }
+
+        return;
+    }
+
+    if(DMA_eventClear(Config->Stream, DMA_INTERRUPT_HALF_TRANSFER))
+    {
+        ADC_halfProcess(Config, &Config->buffer[0]);
+    }
+
+    if(DMA_eventClear(Config->Stream, DMA_INTERRUPT_TRANSFER_COMPLETE))
+    {
+        ADC_halfProcess(Config, &Config->buffer[Config->length / 2U]);
+    }
+}
+
+/*****************************************************************************
+ * Function: ADC_bufferNextSet()
+*//**
+ *\b Description:
+ * This function is used to give the stream a new buffer in double-buffer
+ * mode, in place of the buffer passed to the callback. The stream fills it
+ * after the buffer being filled, so the buffer of the callback can be kept
+ * by the software (e.g. until it is transmitted) without being overwritten.
+ * It must be called from the callback, as the stream takes its next buffer
+ * at the end of the current one.
+ *
+ * PRE-CONDITION: The acquisition runs in double-buffer mode (buffer2). <br>
+ * PRE-CONDITION: buffer holds length samples and is aligned on 4 bytes. <br>
+ *
+ * POST-CONDITION: The stream fills buffer after the current one. <br>
+ *
+ * @param[in]   buffer is the new buffer.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * void samplesReady(const uint16_t * const data, uint32_t count)
+ * {
+ *      uint16_t * const next = POOL_alloc(count * 2U);
+ *
+ *      if(next != NULL)
+ *      {
+ *          ADC_bufferNextSet(next);
+ *          queuePush(data);
+ *      }
+ * }
+ * @endcode
+ *
+ * @see ADC_start
+ * @see ADC_stop
+ * @see ADC_stateGet
+ * @see ADC_irqHandler
+ * @see ADC_bufferNextSet
+ *
+*****************************************************************************/
+void ADC_bufferNextSet(uint16_t * const buffer)
+{
+    const AdcAcquisitionConfig_t * Config = acquisition;
+
+    /* Prevent to replace a buffer out of the double-buffer mode */
+    assert((Config != NULL) && (Config->buffer2 != NULL));
+    assert(((uint32_t)buffer & 0x03UL) == 0U);
+
+    DMA_memoryIdleSet(Config->Stream, (uint32_t*)buffer);
+}
+
+/*****************************************************************************
+ * Function: ADC_halfProcess()
+*//**
+ *\b Description:
+ * This function is used to pass a full half of the buffer (a full buffer
+ * in double-buffer mode) to the callback, averaged by the decimation
+ * filter if the acquisition has one.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: The callback was called with the half. <br>
+ *
+ * @param[in]   Config is the acquisition being run.
+ * @param[in]   samples is the first sample of the half.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void ADC_halfProcess(const AdcAcquisitionConfig_t * const Config,
+const uint16_t * const samples)
+{
+    uint32_t count = ADC_BUFFER_SAMPLES(Config);
+
+    if(Config->Callback == NULL)
+    {
+        return;
+    }
+
+    if(Config->Decimation != NULL)
+    {
+        count = FILTER_decimate(Config->Decimation, samples, count,
+            Config->output);
+        Config->Callback(Config->output, count);
+    }
+    else
+    {
+        Config->Callback(samples, count);
+    }
+}
@@ -0,0 +1,1040 @@
+/**
+ * @file bench_main.c
+ * @author Jose Luis Figueroa
+ * @brief Loopback throughput benchmark of the USART/DMA paths.
+ * This application replaces main.c in the nucleo_f401re_bench environment.
+ * USART2 TX (PA2) must be connected to USART2 RX (PA3) with a jumper, so
+ * every byte transmitted is received back. The workloads are:
+ *     o bulk_tx: blocks transmitted by the DMA, nothing is received.
+ *     o bulk_rx: blocks transmitted and received by the DMA, and verified.
+ *     o echo: short messages received and transmitted back as received.
+ *     o mixed: messages of several sizes received to idle.
+ *     o async_fast, sync_fast: blocks exchanged at BENCH_FAST_BAUD_RATE in
+ *       asynchronous and in synchronous mode (USART_exchange). The CK pin
+ *       is not needed by the loopback, the receiver uses the internal 
+ *       clock.
+ *     o scan: SCAN_find against a byte-by-byte search (no USART).
+ *     o ring_spsc, ring_mpsc: batches reserved, committed, peeked and
+ *       released on the lock-free rings, and verified (no USART).
+ * Each workload reports the bytes per second, the CPU idle (per mille) and
+ * the number of errors (timeouts, data mismatches and USART line errors).
+ * The report is a JSON document written to benchReport, which can be read
+ * with the debugger, and transmitted on USART2 when the workloads end, so
+ * it can be captured on the ST-LINK virtual COM port once the jumper is
+ * removed.
+ *
+ * @version 1.1
+ * @date 2025-03-25
+ * @note The line speed is the baud rate of board.json.
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+*/
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include<stdio.h>
+#include<stdint.h>
+#include<string.h>
+#include "usart.h"
+#include "dio.h"
+#include "dma.h"
+#include "idle.h"
+#include "timebase.h"
+#include "pool.h"
+#include "scan.h"
+#include "ring.h"
+
+/*****************************************************************************
+ * Preprocessor Constants
+******************************************************************************/
+#define SYSTEM_CLOCK    16000000
+#define APB1_CLOCK      SYSTEM_CLOCK
+
+/**
+ * Defines the size of the DMA blocks (bytes).
+*/
+#define BENCH_BLOCK_SIZE        256U
+
+/**
+ * Defines the size of the echo messages (bytes).
+*/
+#define BENCH_ECHO_SIZE         16U
+
+/**
+ * Defines the time each USART workload runs (us).
+*/
+#define BENCH_DURATION          2000000UL
+
+/**
+ * Defines the time allowed for one block to come back (us).
+*/
+#define BENCH_TIMEOUT           1000000UL
+
+/**
+ * Defines the baud rate of the fast workloads, the highest one of the bus
+ * clock (oversampling by 8).
+*/
+#define BENCH_FAST_BAUD_RATE    USART_BAUD_RATE_2000000
+
+/**
+ * Defines the size of the data searched by the scan workload (bytes) and
+ * the number of searches.
+*/
+#define BENCH_SCAN_SIZE         1024U
+#define BENCH_SCAN_ROUNDS       64U
+
+/**
+ * Defines the storage of the ring workloads (bytes), the number of batches
+ * and the largest batch (bytes).
+*/
+#define BENCH_RING_SIZE         512U
+#define BENCH_RING_ROUNDS       1024U
+#define BENCH_RING_BATCH        96U
+
+/**
+ * Defines the size of the JSON report (bytes).
+*/
+#define BENCH_REPORT_SIZE       1536U
+
+/**
+ * Defines the USART status flags counted as line errors.
+*/
+#define BENCH_LINE_ERRORS       (USART_SR_ORE | USART_SR_NE | USART_SR_FE | \
+                                 USART_SR_PE)
+
+/*****************************************************************************
+ * Typedefs
+******************************************************************************/
+/**
+ * Defines the result of a workload.
+*/
+typedef struct
+{
+    const char *name;           /**< Name of the workload */
+    uint32_t bytes;             /**< Bytes moved (or searched) */
+    uint32_t elapsed;           /**< Time of the workload (us) */
+    uint32_t idle;              /**< CPU idle (per mille) */
+    uint32_t errors;            /**< Timeouts, mismatches and line errors */
+}BenchResult_t;
+
+/**
+ * Defines the workloads.
+*/
+typedef enum
+{
+    BENCH_BULK_TX,
+    BENCH_BULK_RX,
+    BENCH_ECHO,
+    BENCH_MIXED,
+    BENCH_ASYNC_FAST,
+    BENCH_SYNC_FAST,
+    BENCH_SCAN,
+    BENCH_RING_SPSC,
+    BENCH_RING_MPSC,
+    BENCH_WORKLOAD_MAX
+}BenchWorkload_t;
+
+/*****************************************************************************
+ * Preprocessor variables
+******************************************************************************/
+/* Defines the sizes of the mixed messages. All of them fit in a block, so
+ * every message is ended by the idle line.
+*/
+static const uint16_t mixedSize[] = {1U, 7U, 32U, 100U, 255U};
+
+/* Defines the DMA buffers, taken from the pool */
+static uint8_t *txBlock;
+static uint8_t *rxBlock;
+static uint8_t *idleBlock[2];
+
+/* Defines the state of the mixed workload, updated by the callback */
+static volatile uint32_t mixedMessages = 0U;
+static volatile uint32_t mixedErrors = 0U;
+static volatile uint32_t mixedBytes = 0U;
+static uint32_t mixedExpected = 0U;
+
+/* Defines the data searched by the scan workload, and the processor cycles
+ * spent by SCAN_find and by the byte-by-byte search
+*/
+static uint8_t scanData[BENCH_SCAN_SIZE];
+static uint32_t scanCycles = 0U;
+static uint32_t naiveCycles = 0U;
+
+/* Defines the storage of the ring workloads */
+static uint8_t ringData[BENCH_RING_SIZE] __attribute__((aligned(4)));
+
+/* Defines the results of the workloads */
+static BenchResult_t BenchResult[BENCH_WORKLOAD_MAX] =
+{
+    {"bulk_tx", 0U, 0U, 0U, 0U},
+    {"bulk_rx", 0U, 0U, 0U, 0U},
+    {"echo", 0U, 0U, 0U, 0U},
+    {"mixed", 0U, 0U, 0U, 0U},
+    {"async_fast", 0U, 0U, 0U, 0U},
+    {"sync_fast", 0U, 0U, 0U, 0U},
+    {"scan", 0U, 0U, 0U, 0U},
+    {"ring_spsc", 0U, 0U, 0U, 0U},
+    {"ring_mpsc", 0U, 0U, 0U, 0U}
+};
+
+/* Defines the JSON report, read with the debugger or from USART2 */
+char benchReport[BENCH_REPORT_SIZE];
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void BENCH_patternFill(uint8_t * const data, uint32_t length,
+uint8_t seed);
+static uint32_t BENCH_lineErrorsGet(void);
+static void BENCH_start(BenchResult_t * const Result);
+static void BENCH_stop(BenchResult_t * const Result, const uint32_t start);
+static uint32_t BENCH_loopback(const uint32_t length);
+static void BENCH_bulkTx(void);
+static void BENCH_bulkRx(void);
+static void BENCH_echo(void);
+static void BENCH_mixed(void);
+static void BENCH_mixedReceived(UsartPort_t Port, const uint8_t * data,
+uint32_t length, uint32_t timestamp);
+static void BENCH_fast(const BenchWorkload_t Workload, 
+const UsartClock_t Clock);
+static uint32_t BENCH_naiveFind(const uint8_t * const data, uint32_t length,
+uint8_t delimiter);
+static void BENCH_scan(void);
+static uint32_t BENCH_ringBatchGet(const uint32_t round);
+static void BENCH_ringSpsc(void);
+static void BENCH_ringMpsc(void);
+static void BENCH_reportWrite(void);
+
+int main(void)
+{   /*Enable clock access to GPIOA, USART2, DMA1, and TIM2*/
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;
+    RCC->APB1ENR |= RCC_APB1ENR_USART2EN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+
+    /*Sleep instead of polling, and count the cycles spent asleep*/
+    IDLE_init();
+
+    /*Start the microsecond timebase (APB1 prescaler 1: TIM2 at APB1 clock)*/
+    TIMEBASE_init(APB1_CLOCK);
+
+    /*Initialize the DIO pins, the USART and the DMA streams with the
+     *register images generated from board.json
+    */
+    DIO_imageInit(DIO_imageGet(), DIO_imageSizeGet());
+    USART_imageInit(USART_imageGet(), USART_imageSizeGet());
+    DMA_imageInit(DMA_imageGet(), DMA_imageSizeGet());
+
+    /*Build the DMA buffer pool and take the blocks of the workloads*/
+    POOL_init(POOL_configGet(), POOL_configSizeGet());
+    txBlock = POOL_alloc(BENCH_BLOCK_SIZE);
+    rxBlock = POOL_alloc(BENCH_BLOCK_SIZE);
+    idleBlock[0] = POOL_alloc(BENCH_BLOCK_SIZE);
+    idleBlock[1] = POOL_alloc(BENCH_BLOCK_SIZE);
+    assert((txBlock != NULL) && (rxBlock != NULL) &&
+           (idleBlock[0] != NULL) && (idleBlock[1] != NULL));
+
+    BENCH_bulkTx();
+    BENCH_bulkRx();
+    BENCH_echo();
+    BENCH_mixed();
+    BENCH_fast(BENCH_ASYNC_FAST, USART_CLOCK_DISABLED);
+    BENCH_fast(BENCH_SYNC_FAST, USART_CLOCK_ENABLED);
+    BENCH_scan();
+    BENCH_ringSpsc();
+    BENCH_ringMpsc();
+
+    /*Write the report and transmit it*/
+    BENCH_reportWrite();
+    UsartTransferConfig_t ReportConfig =
+    {
+        .Port = USART_PORT_2,
+        .data = (uint8_t*)benchReport,
+        .timestamp = NULL
+    };
+    USART_transmit(&ReportConfig);
+
+    while(1)
+    {
+        IDLE_sleep();
+    }
+
+    return 0;
+}
+
+/*****************************************************************************
+ * Function: USART2_IRQHandler()
+ *//**
+ * \b Description:
+ * Interrupt handler of USART2, used by the mixed workload.
+ *
+*****************************************************************************/
+void USART2_IRQHandler(void)
+{
+    USART_irqHandler(USART_PORT_2);
+}
+
+/*****************************************************************************
+ * Function: DMA1_Stream5_IRQHandler()
+ *//**
+ * \b Description:
+ * Interrupt handler of the USART2 RX stream, used by the mixed workload.
+ *
+*****************************************************************************/
+void DMA1_Stream5_IRQHandler(void)
+{
+    USART_irqHandler(USART_PORT_2);
+}
+
+/*****************************************************************************
+ * Function: BENCH_patternFill()
+ *//**
+ * \b Description:
+ * This function is used to fill a buffer with a pattern that differs from
+ * one block to the next, so a stale block is found by the verification.
+ *
+ * @param[out]  data is the buffer to fill.
+ * @param[in]   length is the number of bytes.
+ * @param[in]   seed is the first value of the pattern.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_patternFill(uint8_t * const data, uint32_t length,
+uint8_t seed)
+{
+    for(uint32_t i=0; i<length; i++)
+    {
+        data[i] = (uint8_t)(seed + (i * 7U));
+    }
+}
+
+/*****************************************************************************
+ * Function: BENCH_lineErrorsGet()
+ *//**
+ * \b Description:
+ * This function is used to read and clear the line errors of USART2. The
+ * error flags are cleared by reading the status register and then the data
+ * register, so it is called only while no reception is in progress.
+ *
+ * @return 1 if an overrun, noise, framing or parity error was flagged,
+ *         otherwise 0.
+ *
+*****************************************************************************/
+static uint32_t BENCH_lineErrorsGet(void)
+{
+    uint32_t errors = 0U;
+
+    if((USART2->SR & BENCH_LINE_ERRORS) != 0U)
+    {
+        (void)USART2->DR;
+        errors = 1U;
+    }
+
+    return errors;
+}
+
+/*****************************************************************************
+ * Function: BENCH_start()
+ *//**
+ * \b Description:
+ * This function is used to start the measurement of a workload. The line
+ * errors left by the previous workload are discarded.
+ *
+ * @param[out]  Result is the result of the workload.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_start(BenchResult_t * const Result)
+{
+    (void)BENCH_lineErrorsGet();
+    Result->bytes = 0U;
+    Result->errors = 0U;
+    IDLE_statsReset();
+}
+
+/*****************************************************************************
+ * Function: BENCH_stop()
+ *//**
+ * \b Description:
+ * This function is used to end the measurement of a workload.
+ *
+ * @param[out]  Result is the result of the workload.
+ * @param[in]   start is the time the workload started (us).
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_stop(BenchResult_t * const Result, const uint32_t start)
+{
+    IdleStats_t Stats;
+
+    Result->elapsed = TIMEBASE_now() - start;
+    IDLE_statsGet(&Stats);
+    Result->idle = (Stats.elapsedCycles == 0U) ? 0U :
+        (uint32_t)((Stats.idleCycles * 1000U) / Stats.elapsedCycles);
+}
+
+/*****************************************************************************
+ * Function: BENCH_loopback()
+ *//**
+ * \b Description:
+ * This function is used to transmit the first length bytes of txBlock and
+ * receive them back in rxBlock. The reception is started first, so no byte
+ * is lost.
+ *
+ * PRE-CONDITION: PA2 is connected to PA3. <br>
+ *
+ * @param[in]   length is the number of bytes.
+ *
+ * @return The number of errors: 1 for a timeout or a mismatch, plus 1 for a
+ *         line error.
+ *
+*****************************************************************************/
+static uint32_t BENCH_loopback(const uint32_t length)
+{
+    uint32_t errors = 0U;
+
+    DmaTransferConfig_t DmaTxConfig =
+    {
+        .Stream = DMA1_STREAM_6,
+        .peripheral = (uint32_t*)&USART2->DR,
+        .memory = (uint32_t*)txBlock,
+        .length = length
+    };
+
+    DmaTransferConfig_t DmaRxConfig =
+    {
+        .Stream = DMA1_STREAM_5,
+        .peripheral = (uint32_t*)&USART2->DR,
+        .memory = (uint32_t*)rxBlock,
+        .length = length
+    };
+
+    POOL_ownerSet(txBlock, POOL_OWNER_DMA);
+    POOL_ownerSet(rxBlock, POOL_OWNER_DMA);
+    DMA_transferConfig(&DmaRxConfig);
+    DMA_transferConfig(&DmaTxConfig);
+
+    if(DMA_transferWaitTimeout(DMA1_STREAM_5, BENCH_TIMEOUT) != DMA_OK)
+    {
+        DMA_transferStop(DMA1_STREAM_5);
+        DMA_transferStop(DMA1_STREAM_6);
+        errors++;
+    }
+    else if(memcmp(txBlock, rxBlock, length) != 0)
+    {
+        errors++;
+    }
+    POOL_ownerSet(txBlock, POOL_OWNER_CPU);
+    POOL_ownerSet(rxBlock, POOL_OWNER_CPU);
+
+    return errors + BENCH_lineErrorsGet();
+}
+
+/*****************************************************************************
+ * Function: BENCH_bulkTx()
+ *//**
+ * \b Description:
+ * This function is used to transmit blocks with the DMA for the duration of
+ * the workload. The bytes received back are not read, so the overrun flag
+ * is not counted.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_bulkTx(void)
+{
+    BenchResult_t * const Result = &BenchResult[BENCH_BULK_TX];
+    const uint32_t start = TIMEBASE_now();
+
+    DmaTransferConfig_t DmaTxConfig =
+    {
+        .Stream = DMA1_STREAM_6,
+        .peripheral = (uint32_t*)&USART2->DR,
+        .memory = (uint32_t*)txBlock,
+        .length = BENCH_BLOCK_SIZE
+    };
+
+    BENCH_start(Result);
+    BENCH_patternFill(txBlock, BENCH_BLOCK_SIZE, 0U);
+    POOL_ownerSet(txBlock, POOL_OWNER_DMA);
+
+    while((TIMEBASE_now() - start) < BENCH_DURATION)
+    {
+        DMA_transferConfig(&DmaTxConfig);
+        if(DMA_transferWaitTimeout(DMA1_STREAM_6, BENCH_TIMEOUT) != DMA_OK)
+        {
+            DMA_transferStop(DMA1_STREAM_6);
+            Result->errors++;
+        }
+        else
+        {
+            Result->bytes += BENCH_BLOCK_SIZE;
+        }
+    }
+
+    POOL_ownerSet(txBlock, POOL_OWNER_CPU);
+    BENCH_stop(Result, start);
+}
+
+/*****************************************************************************
+ * Function: BENCH_bulkRx()
+ *//**
+ * \b Description:
+ * This function is used to receive blocks with the DMA for the duration of
+ * the workload. Each block is verified against the block transmitted.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_bulkRx(void)
+{
+    BenchResult_t * const Result = &BenchResult[BENCH_BULK_RX];
+    const uint32_t start = TIMEBASE_now();
+    uint32_t errors;
+    uint8_t seed = 0U;
+
+    BENCH_start(Result);
+
+    while((TIMEBASE_now() - start) < BENCH_DURATION)
+    {
+        BENCH_patternFill(txBlock, BENCH_BLOCK_SIZE, seed++);
+        errors = BENCH_loopback(BENCH_BLOCK_SIZE);
+        if(errors == 0U)
+        {
+            Result->bytes += BENCH_BLOCK_SIZE;
+        }
+        Result->errors += errors;
+    }
+
+    BENCH_stop(Result, start);
+}
+
+/*****************************************************************************
+ * Function: BENCH_echo()
+ *//**
+ * \b Description:
+ * This function is used to transmit back each short message as it was
+ * received, for the duration of the workload. The throughput is limited by
+ * the turnaround between the reception and the next transmission.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_echo(void)
+{
+    BenchResult_t * const Result = &BenchResult[BENCH_ECHO];
+    const uint32_t start = TIMEBASE_now();
+    uint32_t errors;
+
+    BENCH_start(Result);
+    BENCH_patternFill(txBlock, BENCH_ECHO_SIZE, 0U);
+
+    while((TIMEBASE_now() - start) < BENCH_DURATION)
+    {
+        errors = BENCH_loopback(BENCH_ECHO_SIZE);
+        if(errors == 0U)
+        {
+            Result->bytes += BENCH_ECHO_SIZE;
+        }
+        else
+        {
+            /*Restart from a known message after a failed round trip*/
+            BENCH_patternFill(rxBlock, BENCH_ECHO_SIZE, 0U);
+        }
+        Result->errors += errors;
+
+        /*The message received is the next one transmitted*/
+        memcpy(txBlock, rxBlock, BENCH_ECHO_SIZE);
+    }
+
+    BENCH_stop(Result, start);
+}
+
+/*****************************************************************************
+ * Function: BENCH_mixed()
+ *//**
+ * \b Description:
+ * This function is used to transmit messages of several sizes with the DMA
+ * and receive them to idle, for the duration of the workload. The callback
+ * verifies each message.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_mixed(void)
+{
+    BenchResult_t * const Result = &BenchResult[BENCH_MIXED];
+    const uint32_t start = TIMEBASE_now();
+    uint32_t messages = 0U;
+    uint8_t size = 0U;
+
+    static const UsartRxIdleConfig_t RxIdleConfig =
+    {
+        USART_PORT_2, DMA1_STREAM_5, {NULL, NULL}, BENCH_BLOCK_SIZE,
+        BENCH_mixedReceived
+    };
+    UsartRxIdleConfig_t Config = RxIdleConfig;
+    Config.buffer[0] = idleBlock[0];
+    Config.buffer[1] = idleBlock[1];
+
+    DmaTransferConfig_t DmaTxConfig =
+    {
+        .Stream = DMA1_STREAM_6,
+        .peripheral = (uint32_t*)&USART2->DR,
+        .memory = (uint32_t*)txBlock,
+        .length = 0U
+    };
+
+    BENCH_start(Result);
+    BENCH_patternFill(txBlock, BENCH_BLOCK_SIZE, 0U);
+    mixedMessages = 0U;
+    mixedErrors = 0U;
+    mixedBytes = 0U;
+
+    USART_receiveToIdle(&Config);
+    NVIC_EnableIRQ(USART2_IRQn);
+    NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+
+    while((TIMEBASE_now() - start) < BENCH_DURATION)
+    {
+        mixedExpected = mixedSize[size];
+        DmaTxConfig.length = mixedExpected;
+        DMA_transferConfig(&DmaTxConfig);
+
+        /*Wait for the callback of the message*/
+        if(IDLE_waitForDeadline(&mixedMessages, 0xFFFFFFFFU, messages + 1U,
+           USART2_IRQn, TIMEBASE_deadlineGet(BENCH_TIMEOUT)) != 
+           IDLE_CONDITION_MET)
+        {
+            Result->errors++;
+        }
+        messages = mixedMessages;
+
+        size = (uint8_t)((size + 1U) %
+            (sizeof(mixedSize)/sizeof(mixedSize[0])));
+    }
+
+    NVIC_DisableIRQ(USART2_IRQn);
+    NVIC_DisableIRQ(DMA1_Stream5_IRQn);
+    USART_receiveToIdleStop(USART_PORT_2);
+
+    Result->bytes = mixedBytes;
+    Result->errors += mixedErrors;
+    BENCH_stop(Result, start);
+}
+
+/*****************************************************************************
+ * Function: BENCH_mixedReceived()
+ *//**
+ * \b Description:
+ * This function is used to verify a message of the mixed workload. It is
+ * called from the USART interrupt.
+ *
+ * @param[in]   Port is the USART port.
+ * @param[in]   data is the message.
+ * @param[in]   length is the number of bytes of the message.
+ * @param[in]   timestamp is the arrival time of the message (us).
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_mixedReceived(UsartPort_t Port, const uint8_t * data,
+uint32_t length, uint32_t timestamp)
+{
+    (void)Port;
+    (void)timestamp;
+
+    if((length != mixedExpected) || (memcmp(data, txBlock, length) != 0))
+    {
+        mixedErrors++;
+    }
+    else
+    {
+        mixedBytes += length;
+    }
+    mixedMessages++;
+}
+
+/*****************************************************************************
+ * Function: BENCH_fast()
+ *//**
+ * \b Description:
+ * This function is used to switch USART2 to BENCH_FAST_BAUD_RATE, in 
+ * asynchronous or synchronous mode, and exchange verified blocks for the
+ * duration of the workload. The port is switched back to the row of the
+ * configuration table afterwards.
+ *
+ * @param[in]   Workload is the result to write.
+ * @param[in]   Clock is the mode of the port.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_fast(const BenchWorkload_t Workload, 
+const UsartClock_t Clock)
+{
+    BenchResult_t * const Result = &BenchResult[Workload];
+    const UsartConfig_t * const UsartConfig = USART_configGet();
+    const UsartConfig_t * Board = NULL;
+    UsartConfig_t Fast;
+    uint32_t start;
+
+    UsartExchangeConfig_t Exchange =
+    {
+        USART_PORT_2, DMA1_STREAM_6, DMA1_STREAM_5, NULL, NULL,
+        BENCH_BLOCK_SIZE
+    };
+    Exchange.txData = txBlock;
+    Exchange.rxData = rxBlock;
+
+    for(size_t i=0; i<USART_configSizeGet(); i++)
+    {
+        if(UsartConfig[i].Port == USART_PORT_2)
+        {
+            Board = &UsartConfig[i];
+        }
+    }
+    assert(Board != NULL);
+
+    Fast = *Board;
+    Fast.BaudRate = BENCH_FAST_BAUD_RATE;
+    Fast.Oversampling = USART_OVERSAMPLING_8;
+    Fast.Clock = Clock;
+    if(USART_reconfigure(&Fast, APB1_CLOCK, BENCH_TIMEOUT) != USART_OK)
+    {
+        Result->errors++;
+        return;
+    }
+
+    BENCH_start(Result);
+    start = TIMEBASE_now();
+    for(uint8_t seed=0; (TIMEBASE_now() - start) < BENCH_DURATION; seed++)
+    {
+        BENCH_patternFill(txBlock, BENCH_BLOCK_SIZE, seed);
+        if((USART_exchange(&Exchange, BENCH_TIMEOUT) != USART_OK) ||
+           (memcmp(txBlock, rxBlock, BENCH_BLOCK_SIZE) != 0))
+        {
+            Result->errors++;
+        }
+        else
+        {
+            Result->bytes += BENCH_BLOCK_SIZE;
+        }
+        Result->errors += BENCH_lineErrorsGet();
+    }
+    BENCH_stop(Result, start);
+
+    if(USART_reconfigure(Board, APB1_CLOCK, BENCH_TIMEOUT) != USART_OK)
+    {
+        Result->errors++;
+    }
+}
+
+/*****************************************************************************
+ * Function: BENCH_naiveFind()
+ *//**
+ * \b Description:
+ * This function is used to search an array for a delimiter one byte at a
+ * time, as the reference of SCAN_find.
+ *
+ * @param[in]   data is the array to search.
+ * @param[in]   length is the number of bytes.
+ * @param[in]   delimiter is the byte to find.
+ *
+ * @return The index of the delimiter, or length if there is none.
+ *
+*****************************************************************************/
+static uint32_t BENCH_naiveFind(const uint8_t * const data, uint32_t length,
+uint8_t delimiter)
+{
+    uint32_t i = 0U;
+
+    while((i < length) && (data[i] != delimiter))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+/*****************************************************************************
+ * Function: BENCH_scan()
+ *//**
+ * \b Description:
+ * This function is used to measure SCAN_find on data with a single
+ * delimiter at the end. The bytes per second of SCAN_find are reported,
+ * and the errors are the searches whose result differs from the byte-by-
+ * byte search. The speed-up is the ratio of the two cycle counts, written
+ * to the report as scan_speedup (per cent).
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_scan(void)
+{
+    BenchResult_t * const Result = &BenchResult[BENCH_SCAN];
+    const uint8_t newLine = '\n';
+    ScanDelimiters_t Delimiters;
+    uint32_t found;
+    uint32_t expected;
+    uint32_t cycle;
+    uint32_t start;
+
+    BENCH_start(Result);
+    start = TIMEBASE_now();
+    SCAN_delimitersInit(&Delimiters, &newLine, 1U);
+    memset(scanData, 'a', sizeof(scanData));
+    scanData[sizeof(scanData) - 1U] = newLine;
+    scanCycles = 0U;
+    naiveCycles = 0U;
+
+    for(uint32_t i=0; i<BENCH_SCAN_ROUNDS; i++)
+    {
+        /*Start at a different alignment on each round*/
+        const uint32_t offset = i & 3U;
+
+        cycle = DWT->CYCCNT;
+        found = SCAN_find(&scanData[offset], sizeof(scanData) - offset,
+            &Delimiters);
+        scanCycles += DWT->CYCCNT - cycle;
+
+        cycle = DWT->CYCCNT;
+        expected = BENCH_naiveFind(&scanData[offset],
+            sizeof(scanData) - offset, newLine);
+        naiveCycles += DWT->CYCCNT - cycle;
+
+        if(found != expected)
+        {
+            Result->errors++;
+        }
+        Result->bytes += sizeof(scanData) - offset;
+    }
+
+    BENCH_stop(Result, start);
+    /*The search time is the cycles of SCAN_find, not the wall time*/
+    Result->elapsed = (uint32_t)(((uint64_t)scanCycles * 1000000U) /
+        SYSTEM_CLOCK);
+}
+
+/*****************************************************************************
+ * Function: BENCH_ringBatchGet()
+ *//**
+ * \b Description:
+ * This function is used to get the size of a batch of the ring workloads,
+ * from 1 to BENCH_RING_BATCH bytes, so the batches wrap around the end of
+ * the storage at every offset.
+ *
+ * @param[in]   round is the number of the batch.
+ *
+ * @return The number of bytes of the batch.
+ *
+*****************************************************************************/
+static uint32_t BENCH_ringBatchGet(const uint32_t round)
+{
+    return 1U + ((round * 37U) % BENCH_RING_BATCH);
+}
+
+/*****************************************************************************
+ * Function: BENCH_ringSpsc()
+ *//**
+ * \b Description:
+ * This function is used to measure the single-producer single-consumer
+ * ring. Each batch is written in the reserved regions and read from the
+ * peeked regions in place, with the byte counter as data. The bytes per
+ * second are the bytes read, over the cycles of the workload, and the
+ * errors are the bytes that differ from the counter.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_ringSpsc(void)
+{
+    BenchResult_t * const Result = &BenchResult[BENCH_RING_SPSC];
+    RingSpsc_t Ring;
+    uint8_t *region;
+    uint32_t length;
+    uint32_t written = 0U;
+    uint32_t read = 0U;
+    uint32_t cycles;
+    uint32_t start;
+
+    BENCH_start(Result);
+    start = TIMEBASE_now();
+    RING_spscInit(&Ring, ringData, sizeof(ringData));
+    cycles = DWT->CYCCNT;
+
+    for(uint32_t i=0; i<BENCH_RING_ROUNDS; i++)
+    {
+        /*Write the batch in up to two regions*/
+        for(uint32_t left = BENCH_ringBatchGet(i); left > 0U; left -= length)
+        {
+            length = RING_spscWriteReserve(&Ring, &region);
+            length = (length < left) ? length : left;
+            for(uint32_t j=0; j<length; j++)
+            {
+                region[j] = (uint8_t)written++;
+            }
+            RING_spscWriteCommit(&Ring, length);
+        }
+
+        /*Read everything but the last bytes, which are read by the next
+         *batch, so the regions are split at the end of the storage
+        */
+        while(RING_spscUsedGet(&Ring) > (BENCH_RING_BATCH / 2U))
+        {
+            length = RING_spscReadPeek(&Ring, &region);
+            for(uint32_t j=0; j<length; j++)
+            {
+                if(region[j] != (uint8_t)read++)
+                {
+                    Result->errors++;
+                }
+            }
+            RING_spscReadRelease(&Ring, length);
+            Result->bytes += length;
+        }
+    }
+
+    cycles = DWT->CYCCNT - cycles;
+    BENCH_stop(Result, start);
+    /*The time is the cycles of the ring, not the wall time*/
+    Result->elapsed = (uint32_t)(((uint64_t)cycles * 1000000U) /
+        SYSTEM_CLOCK);
+}
+
+/*****************************************************************************
+ * Function: BENCH_ringMpsc()
+ *//**
+ * \b Description:
+ * This function is used to measure the multi-producer single-consumer
+ * ring. Each round reserves two records and commits them in the reverse
+ * order, as an interrupt would when it preempts a producer: the first
+ * record must not be read before it is committed. The records hold the
+ * byte counter as data. The bytes per second are the bytes read, over the
+ * cycles of the workload, and the errors are the records read early, of
+ * another length, or with bytes that differ from the counter.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_ringMpsc(void)
+{
+    BenchResult_t * const Result = &BenchResult[BENCH_RING_MPSC];
+    RingMpsc_t Ring;
+    uint8_t *record[2];
+    uint32_t size[2];
+    uint8_t *region;
+    uint32_t length;
+    uint32_t written = 0U;
+    uint32_t read = 0U;
+    uint32_t cycles;
+    uint32_t start;
+
+    BENCH_start(Result);
+    start = TIMEBASE_now();
+    RING_mpscInit(&Ring, ringData, sizeof(ringData));
+    cycles = DWT->CYCCNT;
+
+    for(uint32_t i=0; i<BENCH_RING_ROUNDS; i++)
+    {
+        /*Reserve and fill the two records*/
+        for(uint32_t r=0; r<2U; r++)
+        {
+            size[r] = BENCH_ringBatchGet((2U * i) + r);
+            record[r] = RING_mpscReserve(&Ring, size[r]);
+            assert(record[r] != NULL);
+            for(uint32_t j=0; j<size[r]; j++)
+            {
+                record[r][j] = (uint8_t)written++;
+            }
+        }
+
+        /*The second record is held back by the first one*/
+        RING_mpscCommit(&Ring, record[1]);
+        if(RING_mpscPeek(&Ring, &region) != 0U)
+        {
+            Result->errors++;
+        }
+        RING_mpscCommit(&Ring, record[0]);
+
+        for(uint32_t r=0; r<2U; r++)
+        {
+            length = RING_mpscPeek(&Ring, &region);
+            if(length != size[r])
+            {
+                Result->errors++;
+            }
+            for(uint32_t j=0; j<length; j++)
+            {
+                if(region[j] != (uint8_t)read++)
+                {
+                    Result->errors++;
+                }
+            }
+            RING_mpscRelease(&Ring);
+            Result->bytes += length;
+        }
+    }
+
+    cycles = DWT->CYCCNT - cycles;
+    BENCH_stop(Result, start);
+    /*The time is the cycles of the ring, not the wall time*/
+    Result->elapsed = (uint32_t)(((uint64_t)cycles * 1000000U) /
+        SYSTEM_CLOCK);
+}
+
+/*****************************************************************************
+ * Function: BENCH_reportWrite()
+ *//**
+ * \b Description:
+ * This function is used to write the results to benchReport as JSON:
+ * @code
+ * {"clock":16000000,"baud":9600,"scan_speedup":412,"workloads":[
+ * {"name":"bulk_tx","bytes":1792,"us":2187000,"bytes_per_s":819,
+ * "idle_permille":991,"errors":0},...]}
+ * @endcode
+ * A line feed ends the report.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void BENCH_reportWrite(void)
+{
+    size_t used;
+    uint32_t rate;
+    uint32_t speedup = (scanCycles == 0U) ? 0U :
+        (uint32_t)(((uint64_t)naiveCycles * 100U) / scanCycles);
+
+    used = (size_t)snprintf(benchReport, sizeof(benchReport),
+        "{\"clock\":%lu,\"baud\":%lu,\"scan_speedup\":%lu,\"workloads\":[",
+        (unsigned long)SYSTEM_CLOCK,
+        (unsigned long)(APB1_CLOCK / USART2->BRR),
+        (unsigned long)speedup);
+
+    for(uint8_t i=0; (i<BENCH_WORKLOAD_MAX) && (used<sizeof(benchReport)); i++)
+    {
+        rate = (BenchResult[i].elapsed == 0U) ? 0U :
+            (uint32_t)(((uint64_t)BenchResult[i].bytes * 1000000U) /
+            BenchResult[i].elapsed);
+
+        used += (size_t)snprintf(&benchReport[used],
+            sizeof(benchReport) - used,
+            "%s{\"name\":\"%s\",\"bytes\":%lu,\"us\":%lu,\"bytes_per_s\":%lu,"
+            "\"idle_permille\":%lu,\"errors\":%lu}",
+            (i == 0U) ? "" : ",", BenchResult[i].name,
+            (unsigned long)BenchResult[i].bytes,
+            (unsigned long)BenchResult[i].elapsed, (unsigned long)rate,
+            (unsigned long)BenchResult[i].idle,
+            (unsigned long)BenchResult[i].errors);
+    }
+
+    if(used < sizeof(benchReport))
+    {
+        (void)snprintf(&benchReport[used], sizeof(benchReport) - used,
+            "]}\n");
+    }
+}
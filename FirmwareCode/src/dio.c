@@ -16,10 +16,36 @@
 /*****************************************************************************
 * Module Preprocessor Constants
 *****************************************************************************/
+/**
+ * Defines the number of pins configured by each alternate function register.
+ */
+#define DIO_PINS_PER_AFR 8U
+
+/**
+ * Defines the masks of the register fields of one pin.
+ */
+#define DIO_FIELD_1_BIT     0x1UL
+#define DIO_FIELD_2_BITS    0x3UL
+#define DIO_FIELD_4_BITS    0xFUL
+
+/**
+ * Defines the position of the reset bits in the bit set/reset register.
+ */
+#define DIO_BSRR_RESET_SHIFT 16U
 
 /*****************************************************************************
 * Module Preprocessor Macros
 *****************************************************************************/
+/**
+ * Checks a setting of the DIO configuration table. Compiled out when the
+ * build defines CONFIG_TABLES_CHECKED (see scripts/config_check.py). The 
+ * port and pin index the images, so they use assert instead.
+*/
+#ifdef CONFIG_TABLES_CHECKED
+#define DIO_CONFIG_ASSERT(expression) ((void)0)
+#else
+#define DIO_CONFIG_ASSERT(expression) assert(expression)
+#endif
 
 /*****************************************************************************
 * Module Typedefs
@@ -74,6 +100,17 @@ static uint32_t volatile * const odrRegister[NUMBER_OF_PORTS] =
     (uint32_t*)&GPIOD->ODR, (uint32_t*)&GPIOH->ODR
 };
 
+/* Defines a array of pointers to the GPIO port bit set/reset register. A
+ * write sets or resets the pins without a read-modify-write of the output
+ * data register, so it does not race with the interrupts.
+*/
+static uint32_t volatile * const bsrrRegister[NUMBER_OF_PORTS] =
+{
+    (uint32_t*)&GPIOA->BSRR, (uint32_t*)&GPIOB->BSRR, 
+    (uint32_t*)&GPIOC->BSRR, (uint32_t*)&GPIOD->BSRR, 
+    (uint32_t*)&GPIOH->BSRR
+};
+
 /* Defines a array of pointers to the GPIO alternate function low register.
  * This is compound for two 32 bits registers.
 */
@@ -84,9 +121,20 @@ static uint32_t volatile * const afrRegister[NUMBER_OF_PORTS] =
     (uint32_t*)&GPIOH->AFR[0]
 };
 
+/* Defines a array of pointers to the GPIO alternate function high register.
+*/
+static uint32_t volatile * const afrHighRegister[NUMBER_OF_PORTS] =
+{
+    (uint32_t*)&GPIOA->AFR[1], (uint32_t*)&GPIOB->AFR[1], 
+    (uint32_t*)&GPIOC->AFR[1], (uint32_t*)&GPIOD->AFR[1], 
+    (uint32_t*)&GPIOH->AFR[1]
+};
+
 /*****************************************************************************
 * Function Prototypes
 *****************************************************************************/
+static void DIO_registerImageWrite(uint32_t volatile * const Register,
+const DioRegisterImage_t * const Image);
 
 /*****************************************************************************
 * Function Definitions
@@ -96,12 +144,15 @@ static uint32_t volatile * const afrRegister[NUMBER_OF_PORTS] =
 *//**
 *\b Description:
  * This function is used to initialize the DIO based on the configuration  
- * table defined in dio_cfg module.
+ * table defined in dio_cfg module. The table is grouped by port into 
+ * register images (DIO_imageCompose), so each GPIO register is written once
+ * per port (DIO_imageInit) instead of once per pin and setting.
  * 
  * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
  * PRE-CONDITION: Configuration table needs to be populated (sizeof > 0) <br>
  * PRE-CONDITION: NUMBER_OF_PORTS > 0 <br>
  * PRE-CONDITION: The setting is within the maximum values (DIO_MAX). <br>
+ * PRE-CONDITION: Each pin is assigned once on the configuration table. <br>
  * 
  * POST-CONDITION: The DIO peripheral is set up with the configuration 
  * settings.
@@ -123,251 +174,196 @@ static uint32_t volatile * const afrRegister[NUMBER_OF_PORTS] =
  * @see DIO_configGet
  * @see DIO_configSizeGet
  * @see DIO_init
+ * @see DIO_imageCompose
+ * @see DIO_imageInit
  * @see DIO_pinRead
  * @see DIO_pinWrite
  * @see DIO_pinToggle
+ * @see DIO_pinSetResetGet
  * @see DIO_registerWrite
  * @see DIO_registerRead
  * 
 *****************************************************************************/
 void DIO_init(const DioConfig_t * const Config, size_t configSize)
 {
+    DioPortImage_t Image[NUMBER_OF_PORTS];
+
+    /* Compose the register images of every port */
+    DIO_imageCompose(Config, configSize, &Image[0]);
+
+    /* Write the registers of every port */
+    DIO_imageInit(&Image[0], NUMBER_OF_PORTS);
+}
+
+/*****************************************************************************
+ * Function: DIO_imageCompose()
+*//**
+*\b Description:
+ * This function is used to group the configuration table by port and to 
+ * compose the final value of each GPIO register in a single pass. The 
+ * settings of the DioConfig_t enumerations match the register encoding, so 
+ * each setting is placed on its field as it is. A pin assigned twice on the
+ * table (duplicated or conflicting row) is detected during the grouping.
+ * The images can be composed once and kept to initialize the ports again.
+ * 
+ * PRE-CONDITION: Configuration table needs to be populated (sizeof > 0) <br>
+ * PRE-CONDITION: The setting is within the maximum values (DIO_MAX). <br>
+ * PRE-CONDITION: Each pin is assigned once on the configuration table. <br>
+ * PRE-CONDITION: Image holds NUMBER_OF_PORTS elements. <br>
+ * 
+ * POST-CONDITION: Image contains the registers of every port, indexed by
+ * DioPort_t. Ports without pins on the table have an empty mask. <br>
+ * 
+ * @param[in]   Config is a pointer to the configuration table that contains 
+ *               the initialization for the peripheral.
+ * @param[in]   configSize is the size of the configuration table.
+ * @param[out]  Image is a pointer to the register images of the ports.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * DioPortImage_t Image[NUMBER_OF_PORTS];
+ * 
+ * DIO_imageCompose(DIO_configGet(), DIO_configSizeGet(), &Image[0]);
+ * DIO_imageInit(&Image[0], NUMBER_OF_PORTS);
+ * @endcode
+ * 
+ * @see DIO_configGet
+ * @see DIO_configSizeGet
+ * @see DIO_init
+ * @see DIO_imageCompose
+ * @see DIO_imageInit
+ * @see DIO_pinRead
+ * @see DIO_pinWrite
+ * @see DIO_pinToggle
+ * @see DIO_pinSetResetGet
+ * @see DIO_registerWrite
+ * @see DIO_registerRead
+ * 
+*****************************************************************************/
+void DIO_imageCompose(const DioConfig_t * const Config, size_t configSize,
+    DioPortImage_t * const Image)
+{
+    /* Start from empty images */
+    for(uint8_t port=0; port<NUMBER_OF_PORTS; port++)
+    {
+        Image[port] = (DioPortImage_t){0};
+        Image[port].Port = (DioPort_t)port;
+    }
+
     /* Loop through all the elements of the configuration table. */
-    for(uint8_t i=0; i<configSize; i++)
+    for(size_t i=0; i<configSize; i++)
     {
         /* Prevent to assign a value out of the range of the port and pin.
-         * The registers arrays are limited to the NUMBER_OF_PORTS, higher 
-         * value can cause a memory violation.
+         * The images are limited to the NUMBER_OF_PORTS, higher value can
+         * cause a memory violation. The drivers build rows at run time, so
+         * the indexes are checked even when the table was checked.
         */
         assert(Config[i].Port < DIO_MAX_PORT);
         assert(Config[i].Pin < DIO_MAX_PIN);
+        DIO_CONFIG_ASSERT(Config[i].Mode < DIO_MAX_MODE);
+        DIO_CONFIG_ASSERT(Config[i].Type < DIO_MAX_TYPE);
+        DIO_CONFIG_ASSERT(Config[i].Speed < DIO_MAX_SPEED);
+        DIO_CONFIG_ASSERT(Config[i].Resistor < DIO_MAX_RESISTOR);
+        DIO_CONFIG_ASSERT(Config[i].Function < DIO_MAX_FUNCTION);
 
-        /* 
-         * Set the mode of the Dio pin on the GPIO port mode register. 
-         * Multiply the pin number (Config[i].Pin) by two as MODER uses two 
-         * bits to configure one pin.
+        DioPortImage_t * const Port = &Image[Config[i].Port];
+        const uint32_t pin = Config[i].Pin;
+
+        /* A pin found twice on the table is a duplicated or conflicting 
+         * assignment.
         */
-        if(Config[i].Mode == DIO_INPUT)
-        {
-            *moderRegister[Config[i].Port] &=~ (1UL<<(Config[i].Pin*2));
-            *moderRegister[Config[i].Port] &=~ (2UL<<(Config[i].Pin*2));
+        assert((Port->pins & (1UL<<pin)) == 0U);
+        Port->pins |= (uint16_t)(1UL<<pin);
 
-        }
-        else if (Config[i].Mode == DIO_OUTPUT)
-        {
-            *moderRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*2));
-            *moderRegister[Config[i].Port] &=~ (2UL<<(Config[i].Pin*2));
-        }
-        else if (Config[i].Mode == DIO_FUNCTION)
-        {
-            *moderRegister[Config[i].Port] &=~ (1UL<<(Config[i].Pin*2));
-            *moderRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*2));
-        }
-        else if (Config[i].Mode == DIO_ANALOG)
-        {
-            *moderRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*2));
-            *moderRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*2));
-        }
-        else
-        {
-            assert(Config[i].Mode < DIO_MAX_MODE);
-        }
+        /* MODER, OSPEEDR and PUPDR use two bits to configure one pin */
+        Port->Moder.mask |= (DIO_FIELD_2_BITS<<(pin*2U));
+        Port->Moder.value |= ((uint32_t)Config[i].Mode<<(pin*2U));
 
-        /*
-         * Set the output type of the Dio pin on the GPIO port output type 
-         * register.
-         */
-        if(Config[i].Type == DIO_PUSH_PULL)
-        {
-            *otyperRegister[Config[i].Port] &= ~(1UL<<Config[i].Pin);
-        }
-        else if (Config[i].Type == DIO_OPEN_DRAIN)
-        {
-            *otyperRegister[Config[i].Port] |= (1UL<<Config[i].Pin);
-        }
-        else
-        {
-            assert(Config[i].Type < DIO_MAX_TYPE);
-        }
+        /* OTYPER uses one bit to configure one pin */
+        Port->Otyper.mask |= (DIO_FIELD_1_BIT<<pin);
+        Port->Otyper.value |= ((uint32_t)Config[i].Type<<pin);
 
-        /*
-         * Set the speed of the Dio pin on the GPIO port output speed 
-         * register. Multiply the pin number (Config[i].Pin) by two as 
-         * OSPEEDR uses two bits to configure one pin. 
-         */
-        if(Config[i].Speed == DIO_LOW_SPEED)
-        {
-            *ospeedrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*2));
-            *ospeedrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*2));
-        }
-        else if (Config[i].Speed == DIO_MEDIUM_SPEED)
-        {
-            *ospeedrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*2));
-            *ospeedrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*2));
-        }
-        else if (Config[i].Speed == DIO_HIGH_SPEED)
-        {
-            *ospeedrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*2));
-            *ospeedrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*2));
-        }
-        else if(Config[i].Speed == DIO_VERY_SPEED)
-        {
-            *ospeedrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*2));
-            *ospeedrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*2));
-        }
-        else
+        Port->Ospeedr.mask |= (DIO_FIELD_2_BITS<<(pin*2U));
+        Port->Ospeedr.value |= ((uint32_t)Config[i].Speed<<(pin*2U));
+
+        Port->Pupdr.mask |= (DIO_FIELD_2_BITS<<(pin*2U));
+        Port->Pupdr.value |= ((uint32_t)Config[i].Resistor<<(pin*2U));
+
+        /* AFR is compound for two registers, using four bits per pin. The 
+         * pins 0 to 7 are on the low register and 8 to 15 on the high one.
+        */
+        const uint32_t afr = pin/DIO_PINS_PER_AFR;
+        const uint32_t afrShift = (pin%DIO_PINS_PER_AFR)*4U;
+        Port->Afr[afr].mask |= (DIO_FIELD_4_BITS<<afrShift);
+        Port->Afr[afr].value |= ((uint32_t)Config[i].Function<<afrShift);
+    }
+}
+
+/*****************************************************************************
+ * Function: DIO_imageInit()
+*//**
+*\b Description:
+ * This function is used to write the register images of the ports. Each
+ * register is written once with a single read-modify-write that only 
+ * changes the bits owned by the image. The mode register is written last, 
+ * so every pin enters its final mode with the output type, speed, resistor 
+ * and alternate function already selected.
+ * 
+ * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
+ * PRE-CONDITION: The images are composed (DIO_imageCompose). <br>
+ * 
+ * POST-CONDITION: The registers of the ports are written with the images. 
+ * <br>
+ * 
+ * @param[in]   Image is a pointer to the register images of the ports.
+ * @param[in]   imageSize is the number of images.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * DioPortImage_t Image[NUMBER_OF_PORTS];
+ * 
+ * DIO_imageCompose(DIO_configGet(), DIO_configSizeGet(), &Image[0]);
+ * DIO_imageInit(&Image[0], NUMBER_OF_PORTS);
+ * @endcode
+ * 
+ * @see DIO_configGet
+ * @see DIO_configSizeGet
+ * @see DIO_init
+ * @see DIO_imageCompose
+ * @see DIO_imageInit
+ * @see DIO_pinRead
+ * @see DIO_pinWrite
+ * @see DIO_pinToggle
+ * @see DIO_pinSetResetGet
+ * @see DIO_registerWrite
+ * @see DIO_registerRead
+ * 
+*****************************************************************************/
+void DIO_imageInit(const DioPortImage_t * const Image, size_t imageSize)
+{
+    for(size_t i=0; i<imageSize; i++)
+    {
+        /* The register arrays are limited to the NUMBER_OF_PORTS */
+        assert(Image[i].Port < DIO_MAX_PORT);
+
+        /* Skip the ports that are not on the configuration table */
+        if(Image[i].pins == 0U)
         {
-            assert(Config[i].Speed < DIO_MAX_SPEED);
+            continue;
         }
 
-        /*
-         * Set the internal resistor of the Dio pin on the GPIO port 
-         * pull-up/pull-down register. Multiply the pin number 
-         * (Config[i].Pin) by two as PUPDR uses two bits to configure 
-         * one pin. 
-        */
-       if(Config[i].Resistor == DIO_NO_RESISTOR)
-       {
-            *pupdrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*2));
-            *pupdrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*2));
-       }
-       else if (Config[i].Resistor == DIO_PULLUP)
-       {
-            *pupdrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*2));
-            *pupdrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*2));
-       }
-       else if (Config[i].Resistor == DIO_PULLDOWN)
-       {
-            *pupdrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*2));
-            *pupdrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*2));
-       }
-       else
-       {
-            assert(Config[i].Resistor < DIO_MAX_RESISTOR);
-       }
-
-        /*
-         * Set the alternate function of the Dio pin on the GPIO alternate 
-         * function. Multiply the pin number (Config[i].Pin) by four as AFR 
-         * uses four bits to configure one pin. 
-        */
-       if(Config[i].Function == DIO_AF0)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF1)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF2)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF3)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF4)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF5)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF6)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF7)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF8)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF9)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF10)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF11)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF12)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF13)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] &= ~(2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF14)
-       {
-            *afrRegister[Config[i].Port] &= ~(1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else if(Config[i].Function == DIO_AF15)
-       {
-            *afrRegister[Config[i].Port] |= (1UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (2UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (4UL<<(Config[i].Pin*4));
-            *afrRegister[Config[i].Port] |= (8UL<<(Config[i].Pin*4));
-       }
-       else
-       {
-            assert(Config[i].Function < DIO_MAX_FUNCTION);
-       }
+        const DioPort_t Port = Image[i].Port;
 
+        DIO_registerImageWrite(otyperRegister[Port], &Image[i].Otyper);
+        DIO_registerImageWrite(ospeedrRegister[Port], &Image[i].Ospeedr);
+        DIO_registerImageWrite(pupdrRegister[Port], &Image[i].Pupdr);
+        DIO_registerImageWrite(afrRegister[Port], &Image[i].Afr[0]);
+        DIO_registerImageWrite(afrHighRegister[Port], &Image[i].Afr[1]);
+        DIO_registerImageWrite(moderRegister[Port], &Image[i].Moder);
     }
 }
 
@@ -409,6 +405,7 @@ void DIO_init(const DioConfig_t * const Config, size_t configSize)
  * @see DIO_pinRead
  * @see DIO_pinWrite
  * @see DIO_pinToggle
+ * @see DIO_pinSetResetGet
  * @see DIO_registerWrite
  * @see DIO_registerRead
  * 
@@ -475,6 +472,7 @@ DioPinState_t DIO_pinRead(const DioPinConfig_t * const PinConfig)
  * @see DIO_pinRead
  * @see DIO_pinWrite
  * @see DIO_pinToggle
+ * @see DIO_pinSetResetGet
  * @see DIO_registerWrite
  * @see DIO_registerRead
  * 
@@ -490,11 +488,12 @@ void DIO_pinWrite(const DioPinConfig_t * const PinConfig, DioPinState_t State)
 
     if(State == DIO_HIGH)
     {
-        *odrRegister[PinConfig->Port] |= (1UL<<(PinConfig->Pin));
+        *bsrrRegister[PinConfig->Port] = (1UL<<(PinConfig->Pin));
     }
     else if (State == DIO_LOW)
     {
-        *odrRegister[PinConfig->Port] &= ~(1UL<<(PinConfig->Pin));
+        *bsrrRegister[PinConfig->Port] = 
+            (1UL<<(PinConfig->Pin)) << DIO_BSRR_RESET_SHIFT;
     }
     else
     {
@@ -540,12 +539,16 @@ void DIO_pinWrite(const DioPinConfig_t * const PinConfig, DioPinState_t State)
  * @see DIO_pinRead
  * @see DIO_pinWrite
  * @see DIO_pinToggle
+ * @see DIO_pinSetResetGet
  * @see DIO_registerWrite
  * @see DIO_registerRead
  * 
  **********************************************************************/
 void DIO_pinToggle(const DioPinConfig_t * const PinConfig)
 {
+    const uint32_t mask = (1UL<<(PinConfig->Pin));
+    uint32_t output;
+
     /* Prevent to assign a value out of the range of the port and pin.
      * The registers arrays are limited to the NUMBER_OF_PORTS, higher 
      * value can cause a memory violation.
@@ -553,7 +556,62 @@ void DIO_pinToggle(const DioPinConfig_t * const PinConfig)
     assert(PinConfig->Port < DIO_MAX_PORT);
     assert(PinConfig->Pin < DIO_MAX_PIN);
 
-    *odrRegister[PinConfig->Port] ^= (1UL<<(PinConfig->Pin));
+    /* The pin is set or reset from its output state */
+    output = *odrRegister[PinConfig->Port];
+    *bsrrRegister[PinConfig->Port] = 
+        ((output & mask) << DIO_BSRR_RESET_SHIFT) | (~output & mask);
+}
+
+/**********************************************************************
+ * Function: DIO_pinSetResetGet()
+*//**
+ *\b Description:
+ * This function is used to get the set/reset words of a pin. A driver 
+ * that switches a pin from an interrupt (e.g. the driver enable of a 
+ * RS-485 transceiver) keeps the words, and then drives the pin with a 
+ * single store to the bit set/reset register, without the checks and the
+ * table lookups of DIO_pinWrite.
+ * 
+ * PRE-CONDITION: DioPinConfig_t needs to be populated (sizeof > 0) <br>
+ * PRE-CONDITION: The Port is within the maximum DioPort_t. <br>
+ * PRE-CONDITION: The Pin is within the maximum DioPin_t. <br>
+ *
+ * POST-CONDITION: SetReset holds the register and the words of the pin. <br>
+ * 
+ * @param[in]   pinConfig A pointer to a structure containing the port 
+ *              and pin.
+ * @param[out]  SetReset is the register and the words of the pin.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * DioPinSetReset_t DriverEnable;
+ * DIO_pinSetResetGet(&DePin, &DriverEnable);
+ * *DriverEnable.bsrr = DriverEnable.set;
+ * @endcode
+ * 
+ * @see DIO_ConfigGet
+ * @see DIO_configSizeGet
+ * @see DIO_init
+ * @see DIO_pinRead
+ * @see DIO_pinWrite
+ * @see DIO_pinToggle
+ * @see DIO_pinSetResetGet
+ * @see DIO_registerWrite
+ * @see DIO_registerRead
+ * 
+ **********************************************************************/
+void DIO_pinSetResetGet(const DioPinConfig_t * const PinConfig, 
+DioPinSetReset_t * const SetReset)
+{
+    /* Prevent to assign a value out of the range of the port and pin.*/
+    assert(PinConfig->Port < DIO_MAX_PORT);
+    assert(PinConfig->Pin < DIO_MAX_PIN);
+
+    SetReset->bsrr = bsrrRegister[PinConfig->Port];
+    SetReset->set = (1UL<<(PinConfig->Pin));
+    SetReset->reset = (1UL<<(PinConfig->Pin)) << DIO_BSRR_RESET_SHIFT;
 }
 
 /**********************************************************************
@@ -588,6 +646,7 @@ void DIO_pinToggle(const DioPinConfig_t * const PinConfig)
  * @see DIO_pinRead
  * @see DIO_pinWrite
  * @see DIO_pinToggle
+ * @see DIO_pinSetResetGet
  * @see DIO_registerWrite
  * @see DIO_registerRead
  * 
@@ -628,6 +687,7 @@ void DIO_registerWrite(uint32_t address, uint32_t value)
  * @see DIO_pinRead
  * @see DIO_pinWrite
  * @see DIO_pinToggle
+ * @see DIO_pinSetResetGet
  * @see DIO_registerWrite
  * @see DIO_registerRead
  *
@@ -637,4 +697,42 @@ uint32_t DIO_registerRead(uint32_t address)
     volatile uint32_t * const registerPointer = (uint32_t*)address;
 
     return *registerPointer;
-}
\ No newline at end of file
+}
+
+/**********************************************************************
+ * Function: DIO_registerImageWrite()
+*//**
+ *\b Description:
+ * This function is used to write a register image on a GPIO register. 
+ * Only the bits of the mask are modified and the register is accessed 
+ * once for reading and once for writing. A register without bits on
+ * the mask is not accessed.
+ * 
+ * PRE-CONDITION: The register belongs to a GPIO port with its clock 
+ * enabled. <br>
+ * 
+ * POST-CONDITION: The bits of the mask hold the value of the image. <br>
+ * 
+ * @param[in]   Register is a pointer to the GPIO register.
+ * @param[in]   Image is a pointer to the image of the register.
+ * 
+ * @return  void
+ * 
+ * \b Example:
+ * @code
+ * DIO_registerImageWrite(moderRegister[DIO_PA], &Image[DIO_PA].Moder);
+ * @endcode
+ * 
+ * @see DIO_init
+ * @see DIO_imageCompose
+ * @see DIO_imageInit
+ *
+ **********************************************************************/ 
+static void DIO_registerImageWrite(uint32_t volatile * const Register,
+    const DioRegisterImage_t * const Image)
+{
+    if(Image->mask != 0U)
+    {
+        *Register = (*Register & ~Image->mask) | Image->value;
+    }
+}
@@ -47,6 +47,24 @@ const DioConfig_t DioConfig[] =
    {DIO_PA, DIO_PA3, DIO_FUNCTION, DIO_PUSH_PULL, DIO_LOW_SPEED, DIO_PULLUP, DIO_AF7},
 };
 
+/**
+ * The following array contains the register images of the ports used by the
+ * DioConfig table, each one as the mask and the value of the register bits
+ * owned by the table. This table is read in by DIO_imageInit. Both tables 
+ * are generated from board.json by scripts/cfg_generate.py.
+ */
+const DioPortImage_t DioImage[] = 
+{
+/*                                                          
+ *  Port    Pins
+ *  MODER    OTYPER    OSPEEDR    PUPDR    AFRL    AFRH
+ *                
+*/ 
+   {DIO_PA, 0x000CU, {0x000000F0UL, 0x000000A0UL}, {0x0000000CUL, 0x00000000UL},
+   {0x000000F0UL, 0x00000000UL}, {0x000000F0UL, 0x00000050UL},
+   {{0x0000FF00UL, 0x00007700UL}, {0x00000000UL, 0x00000000UL}}},
+};
+
 /*****************************************************************************
 * Function Prototypes
 *****************************************************************************/
@@ -131,4 +149,72 @@ const DioConfig_t * const DIO_configGet(void)
 size_t DIO_configSizeGet(void)
 {
    return sizeof(DioConfig)/sizeof(DioConfig[0]);
-}
\ No newline at end of file
+}
+
+/*****************************************************************************
+ * Function: DIO_imageGet()
+*/
+/**
+*\b Description:
+ * This function is used to get the register images generated from the 
+ * configuration table defined in dio_cfg module.
+ * 
+ * PRE-CONDITION: The image table must be populated (sizeof>0). <br>
+ * 
+ * POST-CONDITION: A constant pointer to the first member of the image table
+ * is returned. <br>
+ * 
+ * @return A pointer to the image table. <br>
+ * 
+ * \b Example:
+ * @code
+ * const DioPortImage_t * const DioImage = DIO_imageGet();
+ * size_t imageSize = DIO_imageSizeGet();
+ * 
+ * DIO_imageInit(DioImage, imageSize);
+ * @endcode
+ * 
+ * @see DIO_configGet
+ * @see DIO_configSizeGet
+ * @see DIO_imageGet
+ * @see DIO_imageSizeGet
+ * @see DIO_imageInit
+ * 
+*****************************************************************************/
+const DioPortImage_t * const DIO_imageGet(void)
+{
+    return (const DioPortImage_t *)&DioImage[0];
+}
+
+/*****************************************************************************
+ * Function: DIO_imageSizeGet()
+*/
+/**
+*\b Description:
+ * This function is used to get the size of the image table.
+ * 
+ * PRE-CONDITION: The image table needs to be populated (sizeof > 0) <br>
+ * 
+ * POST-CONDITION: The size of the image table will be returned. <br>
+ * 
+ * @return The size of the image table.
+ * 
+ * \b Example: 
+ * @code
+ * const DioPortImage_t * const DioImage = DIO_imageGet();
+ * size_t imageSize = DIO_imageSizeGet();
+ * 
+ * DIO_imageInit(DioImage, imageSize);
+ * @endcode
+ * 
+ * @see DIO_configGet
+ * @see DIO_configSizeGet
+ * @see DIO_imageGet
+ * @see DIO_imageSizeGet
+ * @see DIO_imageInit
+ * 
+*****************************************************************************/
+size_t DIO_imageSizeGet(void)
+{
+   return sizeof(DioImage)/sizeof(DioImage[0]);
+}
@@ -12,18 +12,85 @@
 * Includes
 *****************************************************************************/
 #include "dma.h"        /*For this modules definitions*/
+#include "idle.h"       /*For the event-driven waits*/
+#include "timebase.h"   /*For the timeouts*/
 
 /*****************************************************************************
 * Module Preprocessor Constants
 *****************************************************************************/
+/**
+ * Defines the mask of the event flags of a single stream (FEIF, DMEIF, TEIF,
+ * HTIF and TCIF) before being shifted to the position of the stream.
+*/
+#define DMA_STREAM_FLAGS_MASK 0x3DUL
+
+/**
+ * Defines the bits of the stream registers that are set by a DmaConfig_t
+ * row. The other bits (enable, interrupts, priority) are kept on a 
+ * reconfiguration.
+*/
+#define DMA_CR_CONFIG_MASK (DMA_SxCR_CHSEL | DMA_SxCR_DIR | DMA_SxCR_MSIZE | \
+    DMA_SxCR_PSIZE | DMA_SxCR_MINC | DMA_SxCR_PINC | DMA_SxCR_CIRC)
+#define DMA_FCR_CONFIG_MASK (DMA_SxFCR_DMDIS | DMA_SxFCR_FTH)
+
+/**
+ * Defines the error flags (FEIF, DMEIF, TEIF) and the transfer complete flag
+ * (TCIF) of a single stream, before being shifted to its position.
+*/
+#define DMA_STREAM_ERROR_FLAGS 0x0DUL
+#define DMA_STREAM_TC_FLAG 0x20UL
+
+/**
+ * Defines the time allowed to a stalled stream to stop (us).
+*/
+#define DMA_STOP_TIMEOUT 1000UL
 
 /*****************************************************************************
 * Module Preprocessor Macros
 *****************************************************************************/
+/**
+ * Defines the check of a DMA configuration setting. DmaConfig[] is validated
+ * at build time by scripts/config_check.py, so the check is compiled out of
+ * DMA_init when the build defines CONFIG_TABLES_CHECKED. The stream indexes
+ * the register tables and is checked with assert.
+*/
+#ifdef CONFIG_TABLES_CHECKED
+#define DMA_CONFIG_ASSERT(expression) ((void)0)
+#else
+#define DMA_CONFIG_ASSERT(expression) assert(expression)
+#endif
 
 /*****************************************************************************
 * Module Typedefs
 *****************************************************************************/
+/**
+ * Defines the recovery state of a stream.
+*/
+typedef enum
+{
+    DMA_RECOVERY_RUNNING,   /**< The transfer is running or finished */
+    DMA_RECOVERY_RESTART,   /**< The transfer waits for the restart delay */
+    DMA_RECOVERY_RESUMING,  /**< A circular transfer finishes its lap */
+    DMA_RECOVERY_STOPPING,  /**< The watchdog stops a stalled transfer */
+    DMA_RECOVERY_MAX        /**< Defines the maximum recovery state */
+}DmaRecoveryState_t;
+
+/**
+ * Defines the recovery of a stream: its policy, its error record and where
+ * the transfer is restarted.
+*/
+typedef struct
+{
+    const DmaRecoveryConfig_t * Config; /**< Policy (NULL: no recovery) */
+    DmaRecoveryStats_t Stats;           /**< Error record */
+    volatile uint8_t State;             /**< DmaRecoveryState_t */
+    uint32_t delay;                     /**< Delay of the next restart (us) */
+    uint32_t deadline;                  /**< Time of the restart */
+    uint32_t resume;                    /**< Data transferred at the stop */
+    uint32_t remaining;                 /**< Number of data seen last */
+    uint32_t progress;                  /**< Time of the last progress */
+    uint32_t interrupts;                /**< TCIE of the user on a resume */
+}DmaRecovery_t;
 
 /*****************************************************************************
  * Module Variable Definitions
@@ -66,6 +133,19 @@ static uint32_t volatile * const streamMemory0Address[DMA_PORTS_NUMBER] =
     (uint32_t*)&DMA2_Stream6->M0AR, (uint32_t*)&DMA2_Stream7->M0AR
 };
 
+/* Defines a array of pointers to the DMA stream x memory 1 address*/
+static uint32_t volatile * const streamMemory1Address[DMA_PORTS_NUMBER] =
+{
+    (uint32_t*)&DMA1_Stream0->M1AR, (uint32_t*)&DMA1_Stream1->M1AR, 
+    (uint32_t*)&DMA1_Stream2->M1AR, (uint32_t*)&DMA1_Stream3->M1AR,
+    (uint32_t*)&DMA1_Stream4->M1AR, (uint32_t*)&DMA1_Stream5->M1AR,
+    (uint32_t*)&DMA1_Stream6->M1AR, (uint32_t*)&DMA1_Stream7->M1AR,
+    (uint32_t*)&DMA2_Stream0->M1AR, (uint32_t*)&DMA2_Stream1->M1AR,
+    (uint32_t*)&DMA2_Stream2->M1AR, (uint32_t*)&DMA2_Stream3->M1AR,
+    (uint32_t*)&DMA2_Stream4->M1AR, (uint32_t*)&DMA2_Stream5->M1AR,
+    (uint32_t*)&DMA2_Stream6->M1AR, (uint32_t*)&DMA2_Stream7->M1AR
+};
+
 /* Defines a array of pointers to the DMA stream x peripheral address*/
 static uint32_t volatile * const streamPeripheralAddress[DMA_PORTS_NUMBER] =
 {
@@ -92,9 +172,82 @@ static uint32_t volatile * const streamNumberOfData[DMA_PORTS_NUMBER] =
     (uint32_t*)&DMA2_Stream6->NDTR, (uint32_t*)&DMA2_Stream7->NDTR
 };
 
+/* Defines a array of pointers to the DMA interrupt flag clear register of
+ * each stream. The streams 0 to 3 use the low register and the streams 4 to 7
+ * use the high register.
+*/
+static uint32_t volatile * const streamFlagClearRegister[DMA_PORTS_NUMBER] =
+{
+    (uint32_t*)&DMA1->LIFCR, (uint32_t*)&DMA1->LIFCR,
+    (uint32_t*)&DMA1->LIFCR, (uint32_t*)&DMA1->LIFCR,
+    (uint32_t*)&DMA1->HIFCR, (uint32_t*)&DMA1->HIFCR,
+    (uint32_t*)&DMA1->HIFCR, (uint32_t*)&DMA1->HIFCR,
+    (uint32_t*)&DMA2->LIFCR, (uint32_t*)&DMA2->LIFCR,
+    (uint32_t*)&DMA2->LIFCR, (uint32_t*)&DMA2->LIFCR,
+    (uint32_t*)&DMA2->HIFCR, (uint32_t*)&DMA2->HIFCR,
+    (uint32_t*)&DMA2->HIFCR, (uint32_t*)&DMA2->HIFCR
+};
+
+/* Defines the bit position of the event flags of each stream inside the
+ * interrupt status and flag clear registers.
+*/
+static const uint8_t streamFlagPosition[DMA_PORTS_NUMBER] =
+{
+    0U, 6U, 16U, 22U, 0U, 6U, 16U, 22U,
+    0U, 6U, 16U, 22U, 0U, 6U, 16U, 22U
+};
+
+/* Defines the interrupt of each stream, used to wake up the processor. */
+static const IRQn_Type streamIrq[DMA_PORTS_NUMBER] =
+{
+    DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn,
+    DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn,
+    DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn,
+    DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn
+};
+
+/* Defines the enable bit of each stream interrupt on the control register. */
+static const uint32_t interruptEnableBit[DMA_INTERRUPT_MAX] =
+{
+    DMA_SxCR_TEIE, DMA_SxCR_HTIE, DMA_SxCR_TCIE
+};
+
+/* Defines the event flag of each stream interrupt (TEIF, HTIF and TCIF),
+ * before being shifted to the position of the stream.
+*/
+static const uint32_t interruptFlag[DMA_INTERRUPT_MAX] =
+{
+    0x08UL, 0x10UL, 0x20UL
+};
+
+/* Defines the streams owned by a user, one bit per stream. */
+static volatile uint16_t streamClaimed = 0U;
+
+/* Defines a array of pointers to the DMA interrupt status register of each
+ * stream. The streams 0 to 3 use the low register and the streams 4 to 7 
+ * use the high register.
+*/
+static uint32_t volatile * const streamFlagStatusRegister[DMA_PORTS_NUMBER] =
+{
+    (uint32_t*)&DMA1->LISR, (uint32_t*)&DMA1->LISR,
+    (uint32_t*)&DMA1->LISR, (uint32_t*)&DMA1->LISR,
+    (uint32_t*)&DMA1->HISR, (uint32_t*)&DMA1->HISR,
+    (uint32_t*)&DMA1->HISR, (uint32_t*)&DMA1->HISR,
+    (uint32_t*)&DMA2->LISR, (uint32_t*)&DMA2->LISR,
+    (uint32_t*)&DMA2->LISR, (uint32_t*)&DMA2->LISR,
+    (uint32_t*)&DMA2->HISR, (uint32_t*)&DMA2->HISR,
+    (uint32_t*)&DMA2->HISR, (uint32_t*)&DMA2->HISR
+};
+
+/* Defines the recovery of each stream. */
+static DmaRecovery_t recovery[DMA_PORTS_NUMBER];
+
 /*****************************************************************************
 * Function Prototypes
 *****************************************************************************/
+static void DMA_recoverySchedule(const DmaStream_t Stream);
+static void DMA_recoveryRestart(const DmaStream_t Stream);
+static void DMA_recoveryLapRestart(const DmaStream_t Stream);
 
 /*****************************************************************************
  * Function Definitions
@@ -139,7 +292,9 @@ void DMA_init(const DmaConfig_t * const Config, size_t configSize)
     /* Loop through all the elements of the configuration table. */
     for(uint8_t i=0; i<configSize; i++)
     {
-        /*Review if the DMA port is correct*/
+        /*Review if the DMA port is correct. WAVE, ADC and PWM pass rows
+         *built at run time, so the index is always checked
+        */
         assert(Config[i].Stream < DMA_PORTS_NUMBER);
 
         /* Set the configuration of the DMA on the control register */
@@ -194,7 +349,7 @@ void DMA_init(const DmaConfig_t * const Config, size_t configSize)
         }
         else
         {
-            assert(Config[i].Channel < DMA_CHANNEL_MAX);
+            DMA_CONFIG_ASSERT(Config[i].Channel < DMA_CHANNEL_MAX);
         }
         
         /* Set the direction of the stream*/
@@ -215,7 +370,7 @@ void DMA_init(const DmaConfig_t * const Config, size_t configSize)
         }
         else
         {
-            assert(Config[i].Direction < DMA_DIRECTION_MAX);
+            DMA_CONFIG_ASSERT(Config[i].Direction < DMA_DIRECTION_MAX);
         }
 
         /* Set the memory data size */
@@ -236,7 +391,7 @@ void DMA_init(const DmaConfig_t * const Config, size_t configSize)
         }
         else
         {
-            assert(Config[i].MemorySize < DMA_MEMORY_SIZE_MAX);
+            DMA_CONFIG_ASSERT(Config[i].MemorySize < DMA_MEMORY_SIZE_MAX);
         }
 
         /* Set the peripheral data size */
@@ -257,7 +412,7 @@ void DMA_init(const DmaConfig_t * const Config, size_t configSize)
         }
         else
         {
-            assert(Config[i].PeripheralSize < DMA_PERIPHERAL_SIZE_MAX);
+            DMA_CONFIG_ASSERT(Config[i].PeripheralSize < DMA_PERIPHERAL_SIZE_MAX);
         }
 
         /* Set the memory increment mode*/
@@ -271,7 +426,7 @@ void DMA_init(const DmaConfig_t * const Config, size_t configSize)
         }
         else
         {
-            assert(Config[i].MemoryIncrement < DMA_MEMORY_INCREMENT_MAX);
+            DMA_CONFIG_ASSERT(Config[i].MemoryIncrement < DMA_MEMORY_INCREMENT_MAX);
         }
 
         /* Set the peripheral increment mode*/
@@ -285,7 +440,7 @@ void DMA_init(const DmaConfig_t * const Config, size_t configSize)
         }
         else
         {
-            assert(Config[i].PeripheralIncrement < DMA_PERIPHERAL_INCREMENT_MAX);
+            DMA_CONFIG_ASSERT(Config[i].PeripheralIncrement < DMA_PERIPHERAL_INCREMENT_MAX);
         }
 
         /* Set the configuration of the DMA on the FIFO control register */
@@ -300,7 +455,7 @@ void DMA_init(const DmaConfig_t * const Config, size_t configSize)
         }
         else
         {
-            assert(Config[i].FifoMode < DMA_FIFO_DIRECT_MODE_MAX);
+            DMA_CONFIG_ASSERT(Config[i].FifoMode < DMA_FIFO_DIRECT_MODE_MAX);
         }
 
         /* Set the FIFO threshold level*/
@@ -326,11 +481,206 @@ void DMA_init(const DmaConfig_t * const Config, size_t configSize)
         }
         else
         {
-            assert(Config[i].FifoThreshold < DMA_FIFO_THRESHOLD_MAX);
+            DMA_CONFIG_ASSERT(Config[i].FifoThreshold < DMA_FIFO_THRESHOLD_MAX);
         }
 
+        /* Set the circular mode*/
+        if(Config[i].CircularMode == DMA_CIRCULAR_MODE_DISABLED)
+        {
+            *streamControlRegister[Config[i].Stream] &= ~DMA_SxCR_CIRC;
+        }
+        else if(Config[i].CircularMode == DMA_CIRCULAR_MODE_ENABLED)
+        {
+            *streamControlRegister[Config[i].Stream] |= DMA_SxCR_CIRC;
+        }
+        else
+        {
+            DMA_CONFIG_ASSERT(Config[i].CircularMode < DMA_CIRCULAR_MODE_MAX);
+        }
+
+    }
+
+}
+
+/*****************************************************************************
+ * Function: DMA_imageInit()
+ *//**
+ * \b Description:
+ * This function is used to initialize the DMA streams with the register 
+ * images generated from the configuration table. Each register is written 
+ * with a single store, without translating the table.
+ * 
+ * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
+ * PRE-CONDITION: The streams are disabled. <br>
+ * PRE-CONDITION: The images are generated from the configuration table
+ *                (scripts/cfg_generate.py). <br>
+ * 
+ * POST-CONDITION: The streams are set up with the images. <br>
+ * 
+ * @param[in]   Image is a pointer to the register images of the streams.
+ * @param[in]   imageSize is the number of images.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * const DmaStreamImage_t * const DmaImage = DMA_imageGet();
+ * size_t imageSize = DMA_imageSizeGet();
+ * 
+ * DMA_imageInit(DmaImage, imageSize);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_imageGet
+ * @see DMA_imageSizeGet
+ * @see DMA_init
+ * @see DMA_imageInit
+ * @see DMA_transferConfig
+ * 
+*****************************************************************************/
+void DMA_imageInit(const DmaStreamImage_t * const Image, size_t imageSize)
+{
+    for(size_t i=0; i<imageSize; i++)
+    {
+        /*Review if the DMA port is correct*/
+        assert(Image[i].Stream < DMA_PORTS_NUMBER);
+
+        *streamFifoRegister[Image[i].Stream] = Image[i].fcr;
+        *streamControlRegister[Image[i].Stream] = Image[i].cr;
+    }
+}
+
+/*****************************************************************************
+ * Function: DMA_imageCompose()
+ *//**
+ * \b Description:
+ * This function is used to compose the register images of a configuration
+ * row. The settings of DmaConfig_t are the encodings of the register 
+ * fields, so each field is placed with a shift instead of a chain of 
+ * read-modify-writes.
+ * 
+ * PRE-CONDITION: The setting is within the maximum values (DMA_MAX). <br>
+ * 
+ * POST-CONDITION: Image holds the CR and FCR bits of the row. <br>
+ * 
+ * @param[in]   Config is a pointer to the configuration row.
+ * @param[out]  Image is the register image of the stream.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * DmaStreamImage_t Image;
+ * DMA_imageCompose(&DmaConfig[0], &Image);
+ * @endcode
+ * 
+ * @see DMA_init
+ * @see DMA_imageInit
+ * @see DMA_imageCompose
+ * @see DMA_reconfigure
+ * 
+*****************************************************************************/
+void DMA_imageCompose(const DmaConfig_t * const Config, 
+    DmaStreamImage_t * const Image)
+{
+    /*Review if the settings are correct. The row can be built at run time,
+     *so it is checked whether or not the tables were checked at build time
+    */
+    assert(Config->Stream < DMA_PORTS_NUMBER);
+    assert(Config->Channel < DMA_CHANNEL_MAX);
+    assert(Config->Direction < DMA_DIRECTION_MAX);
+    assert(Config->MemorySize < DMA_MEMORY_SIZE_MAX);
+    assert(Config->PeripheralSize < DMA_PERIPHERAL_SIZE_MAX);
+    assert(Config->FifoThreshold < DMA_FIFO_THRESHOLD_MAX);
+
+    Image->Stream = Config->Stream;
+    Image->cr = ((uint32_t)Config->Channel << DMA_SxCR_CHSEL_Pos) |
+        ((uint32_t)Config->Direction << DMA_SxCR_DIR_Pos) |
+        ((uint32_t)Config->MemorySize << DMA_SxCR_MSIZE_Pos) |
+        ((uint32_t)Config->PeripheralSize << DMA_SxCR_PSIZE_Pos) |
+        ((Config->MemoryIncrement == DMA_MEMORY_INCREMENT_ENABLED) ? 
+            DMA_SxCR_MINC : 0U) |
+        ((Config->PeripheralIncrement == DMA_PERIPHERAL_INCREMENT_ENABLED) ? 
+            DMA_SxCR_PINC : 0U) |
+        ((Config->CircularMode == DMA_CIRCULAR_MODE_ENABLED) ? 
+            DMA_SxCR_CIRC : 0U);
+
+    /* The direct mode is enabled when DMDIS is cleared */
+    Image->fcr = ((uint32_t)Config->FifoThreshold << DMA_SxFCR_FTH_Pos) |
+        ((Config->FifoMode == DMA_FIFO_DIRECT_MODE_DISABLED) ? 
+            DMA_SxFCR_DMDIS : 0U);
+}
+
+/*****************************************************************************
+ * Function: DMA_reconfigure()
+ *//**
+ * \b Description:
+ * This function is used to switch a stream to another configuration row, 
+ * e.g. to turn a half-duplex stream around. The current registers are 
+ * compared with the image of the row and only a register with different 
+ * configuration bits is written, once. The enable, interrupt and priority
+ * bits are kept.
+ * 
+ * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
+ * PRE-CONDITION: The setting is within the maximum values (DMA_MAX). <br>
+ * 
+ * POST-CONDITION: The stream is set up with the row, unless it is 
+ * transferring. <br>
+ * 
+ * @param[in]   Config is a pointer to the configuration row.
+ * 
+ * @return DMA_OK if the stream has the configuration of the row, or 
+ *         DMA_BUSY if it differs and the stream is enabled (the 
+ *         configuration bits are read-only while EN is set).
+ * 
+ * \b Example:
+ * @code
+ * DMA_transferWait(DMA1_STREAM_5);
+ * DMA_reconfigure(&HalfDuplexTxConfig);
+ * @endcode
+ * 
+ * @see DMA_init
+ * @see DMA_imageInit
+ * @see DMA_imageCompose
+ * @see DMA_reconfigure
+ * 
+*****************************************************************************/
+DmaStatus_t DMA_reconfigure(const DmaConfig_t * const Config)
+{
+    DmaStreamImage_t Image;
+    uint32_t cr;
+    uint32_t fcr;
+
+    DMA_imageCompose(Config, &Image);
+
+    cr = *streamControlRegister[Config->Stream];
+    fcr = *streamFifoRegister[Config->Stream];
+
+    if((((cr ^ Image.cr) & DMA_CR_CONFIG_MASK) == 0U) &&
+       (((fcr ^ Image.fcr) & DMA_FCR_CONFIG_MASK) == 0U))
+    {
+        return DMA_OK;
+    }
+
+    if(cr & DMA_SxCR_EN)
+    {
+        return DMA_BUSY;
+    }
+
+    if((cr ^ Image.cr) & DMA_CR_CONFIG_MASK)
+    {
+        *streamControlRegister[Config->Stream] = 
+            (cr & ~DMA_CR_CONFIG_MASK) | Image.cr;
+    }
+
+    if((fcr ^ Image.fcr) & DMA_FCR_CONFIG_MASK)
+    {
+        *streamFifoRegister[Config->Stream] = 
+            (fcr & ~DMA_FCR_CONFIG_MASK) | Image.fcr;
     }
 
+    return DMA_OK;
 }
 
 /*****************************************************************************
@@ -379,6 +729,9 @@ void DMA_init(const DmaConfig_t * const Config, size_t configSize)
 */
 void DMA_transferConfig(const DmaTransferConfig_t * const TransferConfig)
 {
+    /*Review if the DMA stream is correct*/
+    assert(TransferConfig->Stream < DMA_STREAM_MAX);
+
     /* Set the memory address */
     *streamMemory0Address[TransferConfig->Stream] = (uint32_t)TransferConfig->memory;
 
@@ -388,6 +741,1556 @@ void DMA_transferConfig(const DmaTransferConfig_t * const TransferConfig)
     /* Set the number of data */
     *streamNumberOfData[TransferConfig->Stream] = TransferConfig->length;
 
+    /* The event flags of the previous transfer must be cleared before the
+     * stream is enabled again.
+    */
+    *streamFlagClearRegister[TransferConfig->Stream] = 
+        (DMA_STREAM_FLAGS_MASK << streamFlagPosition[TransferConfig->Stream]);
+
     /* Enable the stream */
     *streamControlRegister[TransferConfig->Stream] |= DMA_SxCR_EN;
-}
\ No newline at end of file
+}
+
+/*****************************************************************************
+ * Function: DMA_transferStop()
+ *//**
+ * \b Description:
+ * This function is used to stop the transfer of a DMA stream. The stream is
+ * disabled and the function waits until the hardware confirms it, as the 
+ * current data item is completed before the stream goes idle. The event 
+ * flags of the stream are cleared so that it can be configured again.
+ * 
+ * PRE-CONDITION: The DMA peripheral must be initialized. <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The stream is disabled and its event flags are cleared. <br>
+ * 
+ * @param[in]  Stream is the DMA stream to stop.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * DMA_transferStop(DMA1_STREAM_5);
+ * DMA_transferConfig(&DmaRxConfig);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+void DMA_transferStop(const DmaStream_t Stream)
+{
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    /* Disable the stream */
+    *streamControlRegister[Stream] &= ~DMA_SxCR_EN;
+
+    /* Wait until the current data item is transferred and the stream is 
+     * disabled by the hardware.
+    */
+    while(*streamControlRegister[Stream] & DMA_SxCR_EN)
+    {
+        asm("nop");
+    }
+
+    /* Clear the event flags of the stream */
+    *streamFlagClearRegister[Stream] = 
+        (DMA_STREAM_FLAGS_MASK << streamFlagPosition[Stream]);
+}
+
+/*****************************************************************************
+ * Function: DMA_transferStopTimeout()
+ *//**
+ * \b Description:
+ * This function is used to stop the transfer of a DMA stream as 
+ * DMA_transferStop, but the wait for the hardware is abandoned if the 
+ * stream is still enabled after the timeout, e.g. when the peripheral never
+ * completes the current data item. The event flags are only cleared once 
+ * the stream is disabled. The wait polls the timebase, so it can be used 
+ * with the interrupts masked.
+ * 
+ * PRE-CONDITION: The DMA peripheral must be initialized. <br>
+ * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The stream is disabled and its event flags are cleared 
+ *                 if DMA_OK is returned. <br>
+ * 
+ * @param[in]  Stream is the DMA stream to stop.
+ * @param[in]  timeout is the time allowed to the hardware in microseconds.
+ * 
+ * @return DMA_OK if the stream is disabled, otherwise DMA_TIMEOUT.
+ * 
+ * \b Example:
+ * @code
+ * if(DMA_transferStopTimeout(DMA1_STREAM_5, 100U) == DMA_OK)
+ * {
+ *     DMA_transferConfig(&DmaRxConfig);
+ * }
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+DmaStatus_t DMA_transferStopTimeout(const DmaStream_t Stream, 
+const uint32_t timeout)
+{
+    const uint32_t deadline = TIMEBASE_deadlineGet(timeout);
+
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    /* Disable the stream */
+    *streamControlRegister[Stream] &= ~DMA_SxCR_EN;
+
+    /* Wait until the current data item is transferred, or the deadline */
+    while(*streamControlRegister[Stream] & DMA_SxCR_EN)
+    {
+        if(TIMEBASE_deadlineCheck(deadline) == TIMEBASE_EXPIRED)
+        {
+            return DMA_TIMEOUT;
+        }
+    }
+
+    /* Clear the event flags of the stream */
+    *streamFlagClearRegister[Stream] = 
+        (DMA_STREAM_FLAGS_MASK << streamFlagPosition[Stream]);
+
+    return DMA_OK;
+}
+
+/*****************************************************************************
+ * Function: DMA_streamStateGet()
+ *//**
+ * \b Description:
+ * This function is used to read the state of a DMA stream. A stream in normal
+ * mode is disabled by the hardware once all the data items are transferred,
+ * so this function can be used to know when a transfer has finished.
+ * 
+ * PRE-CONDITION: The DMA peripheral must be initialized. <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The state of the stream is returned. <br>
+ * 
+ * @param[in]  Stream is the DMA stream to read.
+ * 
+ * @return DMA_STREAM_ENABLED while a transfer is ongoing, otherwise 
+ *         DMA_STREAM_DISABLED.
+ * 
+ * \b Example:
+ * @code
+ * DMA_transferConfig(&DmaTxConfig);
+ * while(DMA_streamStateGet(DMA1_STREAM_6) == DMA_STREAM_ENABLED)
+ * {
+ * }
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+DmaStreamState_t DMA_streamStateGet(const DmaStream_t Stream)
+{
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    return ((*streamControlRegister[Stream] & DMA_SxCR_EN) ? 
+        DMA_STREAM_ENABLED : DMA_STREAM_DISABLED);
+}
+
+/*****************************************************************************
+ * Function: DMA_streamClaim()
+ *//**
+ * \b Description:
+ * This function is used to take the ownership of a DMA stream. A stream can
+ * only be owned by one user at a time, so a driver that claims its stream
+ * before configuring it cannot reprogram a stream that is in use by another
+ * driver. The ownership is checked and taken with the interrupts masked, so
+ * the function can be called from the main loop and from interrupts.
+ * 
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The stream is owned by the caller if DMA_OK is returned. <br>
+ * 
+ * @param[in]  Stream is the DMA stream to claim.
+ * 
+ * @return DMA_OK if the stream was free, otherwise DMA_BUSY.
+ * 
+ * \b Example:
+ * @code
+ * if(DMA_streamClaim(DMA1_STREAM_6) == DMA_OK)
+ * {
+ *     DMA_transferConfig(&DmaTxConfig);
+ * }
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+DmaStatus_t DMA_streamClaim(const DmaStream_t Stream)
+{
+    DmaStatus_t Status = DMA_BUSY;
+    uint32_t primask;
+
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    /* The ownership is read and written without being interrupted */
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if((streamClaimed & (1U << Stream)) == 0U)
+    {
+        streamClaimed |= (uint16_t)(1U << Stream);
+        Status = DMA_OK;
+    }
+
+    __set_PRIMASK(primask);
+
+    return Status;
+}
+
+/*****************************************************************************
+ * Function: DMA_streamRelease()
+ *//**
+ * \b Description:
+ * This function is used to give back the ownership of a DMA stream, so it
+ * can be claimed by another user. The transfer of the stream must be 
+ * finished or stopped before the stream is released.
+ * 
+ * PRE-CONDITION: The stream is owned by the caller. <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The stream can be claimed again. <br>
+ * 
+ * @param[in]  Stream is the DMA stream to release.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * DMA_transferStop(DMA1_STREAM_6);
+ * DMA_streamRelease(DMA1_STREAM_6);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+void DMA_streamRelease(const DmaStream_t Stream)
+{
+    uint32_t primask;
+
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    streamClaimed &= (uint16_t)~(1U << Stream);
+
+    __set_PRIMASK(primask);
+}
+
+/*****************************************************************************
+ * Function: DMA_transferWait()
+ *//**
+ * \b Description:
+ * This function is used to wait until the transfer of a DMA stream is 
+ * finished. The processor sleeps during the transfer and is woken up by the
+ * transfer complete or transfer error interrupt of the stream, which are 
+ * enabled only while waiting.
+ * 
+ * PRE-CONDITION: The transfer is configured (DMA_transferConfig). <br>
+ * PRE-CONDITION: The stream is in normal mode (not circular). <br>
+ * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The stream is disabled. <br>
+ * 
+ * @param[in]  Stream is the DMA stream to wait for.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * DMA_transferConfig(&DmaTxConfig);
+ * DMA_transferWait(DMA1_STREAM_6);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+void DMA_transferWait(const DmaStream_t Stream)
+{
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    /* The interrupts enabled by the user are kept after the wait */
+    const uint32_t waitInterrupts = (DMA_SxCR_TCIE | DMA_SxCR_TEIE) &
+        ~(*streamControlRegister[Stream]);
+
+    /* The stream is disabled by the hardware at the end of the transfer and
+     * on a transfer error. Both events wake up the processor.
+    */
+    *streamControlRegister[Stream] |= waitInterrupts;
+    IDLE_waitFor(streamControlRegister[Stream], DMA_SxCR_EN, 0U, 
+        streamIrq[Stream]);
+    *streamControlRegister[Stream] &= ~waitInterrupts;
+}
+
+/*****************************************************************************
+ * Function: DMA_transferWaitTimeout()
+ *//**
+ * \b Description:
+ * This function is used to wait until the transfer of a DMA stream is 
+ * finished as DMA_transferWait, but the wait is abandoned if the transfer 
+ * does not finish within the timeout. The transfer is not stopped on a 
+ * timeout, so the caller decides whether to keep waiting or to stop it with
+ * DMA_transferStop.
+ * 
+ * PRE-CONDITION: The transfer is configured (DMA_transferConfig). <br>
+ * PRE-CONDITION: The stream is in normal mode (not circular). <br>
+ * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
+ * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The stream is disabled if DMA_OK is returned. <br>
+ * 
+ * @param[in]  Stream is the DMA stream to wait for.
+ * @param[in]  timeout is the time allowed for the transfer in microseconds.
+ * 
+ * @return DMA_OK if the transfer finished, otherwise DMA_TIMEOUT.
+ * 
+ * \b Example:
+ * @code
+ * DMA_transferConfig(&DmaTxConfig);
+ * if(DMA_transferWaitTimeout(DMA1_STREAM_6, 2000U) == DMA_TIMEOUT)
+ * {
+ *     DMA_transferStop(DMA1_STREAM_6);
+ * }
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+DmaStatus_t DMA_transferWaitTimeout(const DmaStream_t Stream, 
+const uint32_t timeout)
+{
+    DmaStatus_t Status = DMA_OK;
+
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    /* The interrupts enabled by the user are kept after the wait */
+    const uint32_t waitInterrupts = (DMA_SxCR_TCIE | DMA_SxCR_TEIE) &
+        ~(*streamControlRegister[Stream]);
+
+    *streamControlRegister[Stream] |= waitInterrupts;
+    if(IDLE_waitForDeadline(streamControlRegister[Stream], DMA_SxCR_EN, 0U,
+        streamIrq[Stream], TIMEBASE_deadlineGet(timeout)) == IDLE_TIMEOUT)
+    {
+        Status = DMA_TIMEOUT;
+    }
+    *streamControlRegister[Stream] &= ~waitInterrupts;
+
+    return Status;
+}
+
+/*****************************************************************************
+ * Function: DMA_transferRemainingGet()
+ *//**
+ * \b Description:
+ * This function is used to read the number of data items left to transfer
+ * on a DMA stream. Once the stream is stopped, the number of data items 
+ * transferred is the length of the transfer minus the returned value.
+ * 
+ * PRE-CONDITION: The transfer is configured (DMA_transferConfig). <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: None. <br>
+ * 
+ * @param[in]  Stream is the DMA stream to read.
+ * 
+ * @return The number of data items left to transfer.
+ * 
+ * \b Example:
+ * @code
+ * DMA_transferStop(DMA1_STREAM_5);
+ * received = DmaRxConfig.length - DMA_transferRemainingGet(DMA1_STREAM_5);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+uint32_t DMA_transferRemainingGet(const DmaStream_t Stream)
+{
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    return *streamNumberOfData[Stream];
+}
+
+/*****************************************************************************
+ * Function: DMA_transferRearm()
+ *//**
+ * \b Description:
+ * This function is used to start a new transfer on a stream that keeps the
+ * peripheral of its previous transfer. Only the memory address and the 
+ * number of data are written, so the stream is restarted with a short and
+ * fixed sequence of register writes.
+ * 
+ * PRE-CONDITION: The stream is disabled (DMA_transferStop or completed). <br>
+ * PRE-CONDITION: The peripheral address was set by DMA_transferConfig. <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The stream is enabled with the new memory space. <br>
+ * 
+ * @param[in]  Stream is the DMA stream to restart.
+ * @param[in]  memory is the memory space of the new transfer.
+ * @param[in]  length is the number of data to transfer.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * DMA_transferStop(DMA1_STREAM_5);
+ * DMA_transferRearm(DMA1_STREAM_5, (uint32_t*)rxBuffer[1], RX_LENGTH);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+void DMA_transferRearm(const DmaStream_t Stream, uint32_t * const memory,
+const uint32_t length)
+{
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    *streamMemory0Address[Stream] = (uint32_t)memory;
+    *streamNumberOfData[Stream] = length;
+    *streamFlagClearRegister[Stream] = 
+        (DMA_STREAM_FLAGS_MASK << streamFlagPosition[Stream]);
+    *streamControlRegister[Stream] |= DMA_SxCR_EN;
+}
+
+/*****************************************************************************
+ * Function: DMA_interruptEnable()
+ *//**
+ * \b Description:
+ * This function is used to enable an interrupt of a DMA stream. The 
+ * interrupt of the stream must also be enabled in the NVIC, with a handler
+ * that clears the event flags, for the interrupt to be serviced.
+ * 
+ * PRE-CONDITION: The DMA peripheral must be initialized. <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * PRE-CONDITION: The Interrupt is within the maximum DMA_INTERRUPT_MAX. <br>
+ * 
+ * POST-CONDITION: The interrupt of the stream is enabled. <br>
+ * 
+ * @param[in]  Stream is the DMA stream.
+ * @param[in]  Interrupt is the interrupt to enable.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * DMA_interruptEnable(DMA1_STREAM_5, DMA_INTERRUPT_TRANSFER_COMPLETE);
+ * NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+void DMA_interruptEnable(const DmaStream_t Stream, 
+const DmaInterrupt_t Interrupt)
+{
+    /*Review if the DMA stream and the interrupt are correct*/
+    assert(Stream < DMA_STREAM_MAX);
+    assert(Interrupt < DMA_INTERRUPT_MAX);
+
+    *streamControlRegister[Stream] |= interruptEnableBit[Interrupt];
+}
+
+/*****************************************************************************
+ * Function: DMA_interruptDisable()
+ *//**
+ * \b Description:
+ * This function is used to disable an interrupt of a DMA stream.
+ * 
+ * PRE-CONDITION: The DMA peripheral must be initialized. <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * PRE-CONDITION: The Interrupt is within the maximum DMA_INTERRUPT_MAX. <br>
+ * 
+ * POST-CONDITION: The interrupt of the stream is disabled. <br>
+ * 
+ * @param[in]  Stream is the DMA stream.
+ * @param[in]  Interrupt is the interrupt to disable.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * DMA_interruptDisable(DMA1_STREAM_5, DMA_INTERRUPT_TRANSFER_COMPLETE);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+void DMA_interruptDisable(const DmaStream_t Stream, 
+const DmaInterrupt_t Interrupt)
+{
+    /*Review if the DMA stream and the interrupt are correct*/
+    assert(Stream < DMA_STREAM_MAX);
+    assert(Interrupt < DMA_INTERRUPT_MAX);
+
+    *streamControlRegister[Stream] &= ~interruptEnableBit[Interrupt];
+}
+
+/*****************************************************************************
+ * Function: DMA_memoryIncrementSet()
+ *//**
+ * \b Description:
+ * This function is used to change the memory increment mode of a stream 
+ * between transfers. A stream without memory increment moves the same 
+ * memory word on every request, e.g. the dummy word sent by a SPI master to
+ * clock the data in, or the sink of the data that is not wanted.
+ * 
+ * PRE-CONDITION: The DMA peripheral must be initialized. <br>
+ * PRE-CONDITION: The stream is disabled (no transfer in progress). <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The next transfers use the memory increment mode. <br>
+ * 
+ * @param[in]  Stream is the DMA stream.
+ * @param[in]  MemoryIncrement is the memory increment mode.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * DMA_memoryIncrementSet(DMA2_STREAM_3, DMA_MEMORY_INCREMENT_DISABLED);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+void DMA_memoryIncrementSet(const DmaStream_t Stream, 
+const DmaMemoryIncrement_t MemoryIncrement)
+{
+    /*Review if the DMA stream and the mode are correct*/
+    assert(Stream < DMA_STREAM_MAX);
+    assert(MemoryIncrement < DMA_MEMORY_INCREMENT_MAX);
+
+    if(MemoryIncrement == DMA_MEMORY_INCREMENT_ENABLED)
+    {
+        *streamControlRegister[Stream] |= DMA_SxCR_MINC;
+    }
+    else
+    {
+        *streamControlRegister[Stream] &= ~DMA_SxCR_MINC;
+    }
+}
+
+/*****************************************************************************
+ * Function: DMA_eventClear()
+*//**
+ * \b Description:
+ * This function is used to check and clear the event flag of a stream 
+ * interrupt. It is called from the interrupt handler of the stream, e.g. 
+ * to tell the half transfer from the transfer complete of a circular 
+ * stream, whose halves are processed while the other one is being filled.
+ * 
+ * PRE-CONDITION: The DMA peripheral must be initialized. <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * PRE-CONDITION: The Interrupt is within the maximum DMA_INTERRUPT_MAX. <br>
+ * 
+ * POST-CONDITION: The event flag of the interrupt is cleared. <br>
+ * 
+ * @param[in]  Stream is the DMA stream.
+ * @param[in]  Interrupt is the interrupt of the event.
+ * 
+ * @return 1 if the event had happened, otherwise 0.
+ * 
+ * \b Example:
+ * @code
+ * void DMA2_Stream0_IRQHandler(void)
+ * {
+ *      if(DMA_eventClear(DMA2_STREAM_0, DMA_INTERRUPT_HALF_TRANSFER))
+ *      {
+ *          //The first half of the buffer is ready
+ *      }
+ * }
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+uint8_t DMA_eventClear(const DmaStream_t Stream, 
+const DmaInterrupt_t Interrupt)
+{
+    uint32_t flag;
+
+    /*Review if the DMA stream and the interrupt are correct*/
+    assert(Stream < DMA_STREAM_MAX);
+    assert(Interrupt < DMA_INTERRUPT_MAX);
+
+    flag = (interruptFlag[Interrupt] << streamFlagPosition[Stream]);
+    if((*streamFlagStatusRegister[Stream] & flag) == 0U)
+    {
+        return 0U;
+    }
+
+    *streamFlagClearRegister[Stream] = flag;
+
+    return 1U;
+}
+
+/*****************************************************************************
+ * Function: DMA_doubleBufferSet()
+ *//**
+ * \b Description:
+ * This function is used to set the double-buffer mode of a stream. The 
+ * stream fills the memory of DMA_transferConfig (memory 0), then memory 1,
+ * and switches between them on every transfer complete event without being
+ * disabled, so the peripheral is never left without a buffer. The memory
+ * that is not being used can be replaced while the stream runs 
+ * (DMA_memoryIdleSet). The mode implies the circular mode.
+ * 
+ * PRE-CONDITION: The DMA peripheral must be initialized. <br>
+ * PRE-CONDITION: The stream is disabled (no transfer in progress). <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The next transfer starts on memory 0, in double-buffer 
+ * mode unless memory1 is NULL. <br>
+ * 
+ * @param[in]  Stream is the DMA stream.
+ * @param[in]  memory1 is the second memory space, or NULL to leave the 
+ *             double-buffer mode.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * DMA_doubleBufferSet(DMA2_STREAM_0, (uint32_t*)samples[1]);
+ * DMA_transferConfig(&DmaTransferConfig);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+void DMA_doubleBufferSet(const DmaStream_t Stream, uint32_t * const memory1)
+{
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    /* The current target is only written with the stream disabled */
+    *streamControlRegister[Stream] &= ~DMA_SxCR_CT;
+
+    if(memory1 != NULL)
+    {
+        *streamMemory1Address[Stream] = (uint32_t)memory1;
+        *streamControlRegister[Stream] |= DMA_SxCR_DBM;
+    }
+    else
+    {
+        *streamControlRegister[Stream] &= ~DMA_SxCR_DBM;
+    }
+}
+
+/*****************************************************************************
+ * Function: DMA_memoryIdleGet()
+ *//**
+ * \b Description:
+ * This function is used to get the memory of a stream in double-buffer mode
+ * that is not being used. Right after a transfer complete event, it is the
+ * memory that was just completed.
+ * 
+ * PRE-CONDITION: The stream is in double-buffer mode (DMA_doubleBufferSet).
+ * <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: None. <br>
+ * 
+ * @param[in]  Stream is the DMA stream.
+ * 
+ * @return The memory space that is not being used.
+ * 
+ * \b Example:
+ * @code
+ * if(DMA_eventClear(DMA2_STREAM_0, DMA_INTERRUPT_TRANSFER_COMPLETE))
+ * {
+ *     const uint16_t * const completed = 
+ *         (uint16_t*)DMA_memoryIdleGet(DMA2_STREAM_0);
+ * }
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+uint32_t * DMA_memoryIdleGet(const DmaStream_t Stream)
+{
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    return (uint32_t*)((*streamControlRegister[Stream] & DMA_SxCR_CT) ?
+        *streamMemory0Address[Stream] : *streamMemory1Address[Stream]);
+}
+
+/*****************************************************************************
+ * Function: DMA_memoryIdleSet()
+ *//**
+ * \b Description:
+ * This function is used to replace the memory of a stream in double-buffer
+ * mode that is not being used, e.g. to hand the completed memory to the 
+ * software without a copy. The stream fills the new memory after the one 
+ * being used. The memory being used cannot be written (the hardware 
+ * ignores the write), so the function must be called before the stream 
+ * switches again, i.e. within one transfer.
+ * 
+ * PRE-CONDITION: The stream is in double-buffer mode (DMA_doubleBufferSet).
+ * <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The stream fills the memory after the current one. <br>
+ * 
+ * @param[in]  Stream is the DMA stream.
+ * @param[in]  memory is the new memory space.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * DMA_memoryIdleSet(DMA2_STREAM_0, (uint32_t*)freeBuffer);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_getConfigSize
+ * @see DMA_init
+ * @see DMA_transferConfig
+ * @see DMA_transferStop
+ * @see DMA_transferStopTimeout
+ * @see DMA_streamStateGet
+ * @see DMA_transferWait
+ * @see DMA_transferWaitTimeout
+ * @see DMA_transferRemainingGet
+ * @see DMA_transferRearm
+ * @see DMA_interruptEnable
+ * @see DMA_interruptDisable
+ * @see DMA_memoryIncrementSet
+ * @see DMA_eventClear
+ * @see DMA_doubleBufferSet
+ * @see DMA_memoryIdleGet
+ * @see DMA_memoryIdleSet
+ * @see DMA_streamClaim
+ * @see DMA_streamRelease
+ * 
+*****************************************************************************/
+void DMA_memoryIdleSet(const DmaStream_t Stream, uint32_t * const memory)
+{
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    if(*streamControlRegister[Stream] & DMA_SxCR_CT)
+    {
+        *streamMemory0Address[Stream] = (uint32_t)memory;
+    }
+    else
+    {
+        *streamMemory1Address[Stream] = (uint32_t)memory;
+    }
+}
+
+/*****************************************************************************
+ * Function: DMA_recoveryEnable()
+ *//**
+ * \b Description:
+ * This function is used to give a stream a recovery policy. The error 
+ * interrupts of the stream are enabled, so a FIFO, direct mode or transfer
+ * error is recorded by DMA_irqHandler, and the transfer is restarted by 
+ * DMA_recoveryPoll without the application being involved.
+ * 
+ * PRE-CONDITION: The DMA peripheral must be initialized. <br>
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * PRE-CONDITION: The stream interrupt calls DMA_irqHandler and is enabled
+ *                in the NVIC. <br>
+ * PRE-CONDITION: DMA_recoveryPoll is called periodically (main loop). <br>
+ * 
+ * POST-CONDITION: The errors of the stream are recovered. <br>
+ * 
+ * @param[in]  Config is the recovery policy. It must stay valid until
+ *             DMA_recoveryDisable.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * static const DmaRecoveryConfig_t RxRecovery =
+ * {
+ *      .Transfer = {DMA1_STREAM_5, &USART2->DR, (uint32_t*)ring, 256U},
+ *      .backoff = 100U, .backoffMax = 10000U, .stallTimeout = 5000U,
+ *      .pendingRegister = &USART2->SR, .pendingMask = USART_SR_RXNE
+ * };
+ * 
+ * void DMA1_Stream5_IRQHandler(void)
+ * {
+ *      DMA_irqHandler(DMA1_STREAM_5);
+ * }
+ * 
+ * DMA_transferConfig(&RxRecovery.Transfer);
+ * DMA_recoveryEnable(&RxRecovery);
+ * NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+ * @endcode
+ * 
+ * @see DMA_recoveryEnable
+ * @see DMA_recoveryDisable
+ * @see DMA_irqHandler
+ * @see DMA_recoveryPoll
+ * @see DMA_recoveryStatsGet
+ * 
+*****************************************************************************/
+void DMA_recoveryEnable(const DmaRecoveryConfig_t * const Config)
+{
+    /*Review if the DMA stream is correct*/
+    assert(Config->Transfer.Stream < DMA_STREAM_MAX);
+
+    const DmaStream_t Stream = Config->Transfer.Stream;
+
+    recovery[Stream] = (DmaRecovery_t){0};
+    recovery[Stream].delay = Config->backoff;
+    recovery[Stream].remaining = *streamNumberOfData[Stream];
+    recovery[Stream].progress = TIMEBASE_now();
+    recovery[Stream].Config = Config;
+
+    *streamControlRegister[Stream] |= (DMA_SxCR_TEIE | DMA_SxCR_DMEIE);
+    *streamFifoRegister[Stream] |= DMA_SxFCR_FEIE;
+}
+
+/*****************************************************************************
+ * Function: DMA_recoveryDisable()
+ *//**
+ * \b Description:
+ * This function is used to remove the recovery policy of a stream. The 
+ * error interrupts are disabled and a pending restart is cancelled.
+ * 
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The errors of the stream are no longer recovered. <br>
+ * 
+ * @param[in]  Stream is the DMA stream.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * DMA_recoveryDisable(DMA1_STREAM_5);
+ * @endcode
+ * 
+ * @see DMA_recoveryEnable
+ * @see DMA_recoveryDisable
+ * @see DMA_irqHandler
+ * @see DMA_recoveryPoll
+ * @see DMA_recoveryStatsGet
+ * 
+*****************************************************************************/
+void DMA_recoveryDisable(const DmaStream_t Stream)
+{
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    recovery[Stream].Config = NULL;
+    *streamControlRegister[Stream] &= ~(DMA_SxCR_TEIE | DMA_SxCR_DMEIE);
+    *streamFifoRegister[Stream] &= ~DMA_SxFCR_FEIE;
+}
+
+/*****************************************************************************
+ * Function: DMA_irqHandler()
+ *//**
+ * \b Description:
+ * This function is used to record the errors of a stream with a recovery
+ * policy. It is called from the interrupt handler of the stream. The error
+ * flags are cleared and counted. If the error stopped the stream, the 
+ * position of the transfer is saved and the restart is scheduled after the 
+ * backoff delay, which doubles for the next error. The end of the lap of a
+ * resumed circular transfer is also handled here. Streams without a 
+ * recovery policy are not touched.
+ * 
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+ * 
+ * POST-CONDITION: The errors are recorded and the restart is scheduled. 
+ * <br>
+ * 
+ * @param[in]  Stream is the DMA stream of the interrupt.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * void DMA1_Stream5_IRQHandler(void)
+ * {
+ *      DMA_irqHandler(DMA1_STREAM_5);
+ * }
+ * @endcode
+ * 
+ * @see DMA_recoveryEnable
+ * @see DMA_recoveryDisable
+ * @see DMA_irqHandler
+ * @see DMA_recoveryPoll
+ * @see DMA_recoveryStatsGet
+ * 
+*****************************************************************************/
+void DMA_irqHandler(const DmaStream_t Stream)
+{
+    DmaRecovery_t * Recovery;
+    uint32_t flags;
+    uint32_t errors;
+
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    Recovery = &recovery[Stream];
+    if(Recovery->Config == NULL)
+    {
+        return;
+    }
+
+    flags = (*streamFlagStatusRegister[Stream] >> streamFlagPosition[Stream]);
+    errors = flags & DMA_STREAM_ERROR_FLAGS;
+
+    if(errors != 0U)
+    {
+        *streamFlagClearRegister[Stream] = 
+            (errors << streamFlagPosition[Stream]);
+
+        Recovery->Stats.lastError = (uint8_t)errors;
+        Recovery->Stats.fifoErrors += (errors & DMA_ERROR_FIFO) ? 1U : 0U;
+        Recovery->Stats.directModeErrors += 
+            (errors & DMA_ERROR_DIRECT_MODE) ? 1U : 0U;
+        Recovery->Stats.transferErrors += 
+            (errors & DMA_ERROR_TRANSFER) ? 1U : 0U;
+
+        /* A FIFO error does not always stop the stream, it is only 
+         * recorded if the transfer goes on. A stream being stopped by the
+         * watchdog is scheduled by DMA_recoveryPoll.
+        */
+        if(((*streamControlRegister[Stream] & DMA_SxCR_EN) == 0U) &&
+           (Recovery->State != DMA_RECOVERY_STOPPING))
+        {
+            DMA_recoverySchedule(Stream);
+        }
+    }
+
+    /* The resumed lap of a circular transfer has reached the end of the 
+     * ring, so the ring is started again from its beginning.
+    */
+    if((flags & DMA_STREAM_TC_FLAG) && 
+       (Recovery->State == DMA_RECOVERY_RESUMING))
+    {
+        *streamFlagClearRegister[Stream] = 
+            (DMA_STREAM_TC_FLAG << streamFlagPosition[Stream]);
+        DMA_recoveryLapRestart(Stream);
+    }
+}
+
+/*****************************************************************************
+ * Function: DMA_recoveryPoll()
+ *//**
+ * \b Description:
+ * This function is used to restart the stopped transfers and to watch the
+ * progress of the running ones. A transfer waiting for its restart delay is
+ * restarted where it stopped: a normal transfer continues with the data not
+ * transferred yet, and a circular transfer continues at the same ring 
+ * position (the rest of the lap first, then the whole ring again), so the
+ * readers of the ring keep their position. A running or resuming transfer
+ * whose number of data has not changed for stallTimeout while its 
+ * peripheral has pending data is recorded as stalled, stopped and 
+ * restarted. A resumed lap that ended without DMA_irqHandler seeing its TC
+ * flag (e.g. cleared by the handler of the user) starts the ring again. 
+ * The interrupts are only masked to read and change the state of a 
+ * stream; a stalled stream is stopped with them enabled.
+ * 
+ * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+ * 
+ * POST-CONDITION: The streams due for a restart are restarted. <br>
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * while(1)
+ * {
+ *      DMA_recoveryPoll();
+ *      IDLE_sleep();
+ * }
+ * @endcode
+ * 
+ * @see DMA_recoveryEnable
+ * @see DMA_recoveryDisable
+ * @see DMA_irqHandler
+ * @see DMA_recoveryPoll
+ * @see DMA_recoveryStatsGet
+ * 
+*****************************************************************************/
+void DMA_recoveryPoll(void)
+{
+    DmaRecovery_t * Recovery;
+    uint32_t remaining;
+    uint32_t now;
+    uint32_t primask;
+    uint8_t stalled;
+    uint8_t State;
+
+    for(uint8_t Stream=0; Stream<DMA_PORTS_NUMBER; Stream++)
+    {
+        Recovery = &recovery[Stream];
+        if(Recovery->Config == NULL)
+        {
+            continue;
+        }
+
+        /* The state is shared with DMA_irqHandler */
+        primask = __get_PRIMASK();
+        __disable_irq();
+
+        now = TIMEBASE_now();
+        stalled = 0U;
+        State = Recovery->State;
+        if((State == DMA_RECOVERY_RESTART) &&
+           (TIMEBASE_deadlineCheck(Recovery->deadline) == TIMEBASE_EXPIRED))
+        {
+            DMA_recoveryRestart((DmaStream_t)Stream);
+        }
+        else if((State == DMA_RECOVERY_RESUMING) &&
+                ((*streamControlRegister[Stream] & DMA_SxCR_EN) == 0U) &&
+                (*streamNumberOfData[Stream] == 0U) &&
+                (((*streamFlagStatusRegister[Stream] >> 
+                   streamFlagPosition[Stream]) & 
+                  DMA_STREAM_ERROR_FLAGS) == 0U))
+        {
+            /* The lap ended and its TC flag was taken by another handler */
+            DMA_recoveryLapRestart((DmaStream_t)Stream);
+        }
+        else if(((State == DMA_RECOVERY_RUNNING) || 
+                 (State == DMA_RECOVERY_RESUMING)) &&
+                (Recovery->Config->stallTimeout != 0U) &&
+                (*streamControlRegister[Stream] & DMA_SxCR_EN))
+        {
+            remaining = *streamNumberOfData[Stream];
+            if((remaining != Recovery->remaining) || 
+               (Recovery->Config->pendingRegister == NULL) ||
+               ((*Recovery->Config->pendingRegister & 
+                 Recovery->Config->pendingMask) == 0U))
+            {
+                /* Progress, or nothing to transfer: not a stall. Progress
+                 * also ends the backoff.
+                */
+                if(remaining != Recovery->remaining)
+                {
+                    Recovery->delay = Recovery->Config->backoff;
+                }
+                Recovery->remaining = remaining;
+                Recovery->progress = now;
+            }
+            else if((now - Recovery->progress) >= 
+                    Recovery->Config->stallTimeout)
+            {
+                Recovery->Stats.stalls++;
+                Recovery->Stats.lastError = DMA_ERROR_STALL;
+                Recovery->State = DMA_RECOVERY_STOPPING;
+                stalled = 1U;
+            }
+        }
+
+        __set_PRIMASK(primask);
+
+        if(stalled == 0U)
+        {
+            continue;
+        }
+
+        /* The stream completes its current data item with the interrupts
+         * enabled. A stream that does not stop is stopped again on the next
+         * poll, as it is still stalled.
+        */
+        if(DMA_transferStopTimeout((DmaStream_t)Stream, DMA_STOP_TIMEOUT) 
+            == DMA_OK)
+        {
+            primask = __get_PRIMASK();
+            __disable_irq();
+            Recovery->State = State;
+            DMA_recoverySchedule((DmaStream_t)Stream);
+            __set_PRIMASK(primask);
+        }
+        else
+        {
+            Recovery->State = State;
+        }
+    }
+}
+
+/*****************************************************************************
+ * Function: DMA_recoveryStatsGet()
+ *//**
+ * \b Description:
+ * This function is used to read the error record of a stream.
+ * 
+ * PRE-CONDITION: The Stream is within the maximum DMA_STREAM_MAX. <br>
+ * 
+ * POST-CONDITION: The error record is copied to Stats. <br>
+ * 
+ * @param[in]   Stream is the DMA stream.
+ * @param[out]  Stats is the structure where the record is copied.
+ * 
+ * @return void
+ * 
+ * \b Example:
+ * @code
+ * DmaRecoveryStats_t Stats;
+ * DMA_recoveryStatsGet(DMA1_STREAM_5, &Stats);
+ * @endcode
+ * 
+ * @see DMA_recoveryEnable
+ * @see DMA_recoveryDisable
+ * @see DMA_irqHandler
+ * @see DMA_recoveryPoll
+ * @see DMA_recoveryStatsGet
+ * 
+*****************************************************************************/
+void DMA_recoveryStatsGet(const DmaStream_t Stream, 
+DmaRecoveryStats_t * const Stats)
+{
+    uint32_t primask;
+
+    /*Review if the DMA stream is correct*/
+    assert(Stream < DMA_STREAM_MAX);
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    *Stats = recovery[Stream].Stats;
+    __set_PRIMASK(primask);
+}
+
+/*****************************************************************************
+ * Function: DMA_recoverySchedule()
+ *//**
+ * \b Description:
+ * This function is used to save the position of a stopped transfer and to 
+ * schedule its restart after the backoff delay. The delay is doubled for 
+ * the next error, up to the maximum of the policy.
+ * 
+ * PRE-CONDITION: The stream is disabled and has a recovery policy. <br>
+ * 
+ * POST-CONDITION: The restart of the stream is scheduled. <br>
+ * 
+ * @param[in]  Stream is the DMA stream.
+ * 
+ * @return void
+ * 
+*****************************************************************************/
+static void DMA_recoverySchedule(const DmaStream_t Stream)
+{
+    DmaRecovery_t * const Recovery = &recovery[Stream];
+    const uint32_t remaining = *streamNumberOfData[Stream];
+    uint32_t length = Recovery->Config->Transfer.length;
+
+    /* A resumed lap counts from its start on the ring */
+    if(Recovery->State == DMA_RECOVERY_RESUMING)
+    {
+        *streamControlRegister[Stream] = (*streamControlRegister[Stream] & 
+            ~DMA_SxCR_TCIE) | Recovery->interrupts | DMA_SxCR_CIRC;
+    }
+
+    Recovery->resume = (remaining <= length) ? (length - remaining) : 0U;
+    Recovery->deadline = TIMEBASE_deadlineGet(Recovery->delay);
+    Recovery->delay = (Recovery->delay > (Recovery->Config->backoffMax / 2U))
+        ? Recovery->Config->backoffMax : (Recovery->delay * 2U);
+    Recovery->State = DMA_RECOVERY_RESTART;
+}
+
+/*****************************************************************************
+ * Function: DMA_recoveryRestart()
+ *//**
+ * \b Description:
+ * This function is used to restart a stopped transfer at the saved 
+ * position. The addresses are moved past the data already transferred on 
+ * the sides that increment. A circular transfer is restarted without the 
+ * circular mode for the rest of its lap; DMA_irqHandler starts the whole 
+ * ring again at the end of the lap.
+ * 
+ * PRE-CONDITION: The stream is disabled and has a recovery policy. <br>
+ * 
+ * POST-CONDITION: The transfer is running again. <br>
+ * 
+ * @param[in]  Stream is the DMA stream.
+ * 
+ * @return void
+ * 
+*****************************************************************************/
+static void DMA_recoveryRestart(const DmaStream_t Stream)
+{
+    DmaRecovery_t * const Recovery = &recovery[Stream];
+    const DmaTransferConfig_t * const Transfer = &Recovery->Config->Transfer;
+    const uint32_t cr = *streamControlRegister[Stream];
+    uint32_t offset;
+
+    Recovery->State = DMA_RECOVERY_RUNNING;
+
+    /* A circular transfer that stopped at the end of its lap starts the 
+     * ring again
+    */
+    if((cr & DMA_SxCR_CIRC) && (Recovery->resume >= Transfer->length))
+    {
+        Recovery->resume = 0U;
+    }
+
+    /* The number of data counts peripheral data items */
+    offset = Recovery->resume << ((cr & DMA_SxCR_PSIZE) >> DMA_SxCR_PSIZE_Pos);
+
+    /* A normal transfer that stopped on its last data is finished */
+    if(((cr & DMA_SxCR_CIRC) == 0U) && 
+       (Recovery->resume >= Transfer->length))
+    {
+        return;
+    }
+
+    Recovery->Stats.restarts++;
+
+    *streamMemory0Address[Stream] = (uint32_t)Transfer->memory + 
+        ((cr & DMA_SxCR_MINC) ? offset : 0U);
+    *streamPeripheralAddress[Stream] = (uint32_t)Transfer->peripheral + 
+        ((cr & DMA_SxCR_PINC) ? offset : 0U);
+    *streamNumberOfData[Stream] = Transfer->length - Recovery->resume;
+    *streamFlagClearRegister[Stream] = 
+        (DMA_STREAM_FLAGS_MASK << streamFlagPosition[Stream]);
+
+    if((cr & DMA_SxCR_CIRC) && (Recovery->resume > 0U))
+    {
+        Recovery->interrupts = cr & DMA_SxCR_TCIE;
+        Recovery->State = DMA_RECOVERY_RESUMING;
+        *streamControlRegister[Stream] = (cr & ~DMA_SxCR_CIRC) | 
+            DMA_SxCR_TCIE;
+    }
+
+    Recovery->remaining = *streamNumberOfData[Stream];
+    Recovery->progress = TIMEBASE_now();
+    *streamControlRegister[Stream] |= DMA_SxCR_EN;
+}
+
+/*****************************************************************************
+ * Function: DMA_recoveryLapRestart()
+ *//**
+ * \b Description:
+ * This function is used to start the ring of a circular transfer again 
+ * from its beginning, at the end of a resumed lap. The circular mode and 
+ * the transfer complete interrupt of the user are set back.
+ * 
+ * PRE-CONDITION: The stream is disabled at the end of a resumed lap. <br>
+ * 
+ * POST-CONDITION: The whole ring is running again. <br>
+ * 
+ * @param[in]  Stream is the DMA stream.
+ * 
+ * @return void
+ * 
+*****************************************************************************/
+static void DMA_recoveryLapRestart(const DmaStream_t Stream)
+{
+    DmaRecovery_t * const Recovery = &recovery[Stream];
+
+    *streamMemory0Address[Stream] = 
+        (uint32_t)Recovery->Config->Transfer.memory;
+    *streamPeripheralAddress[Stream] = 
+        (uint32_t)Recovery->Config->Transfer.peripheral;
+    *streamNumberOfData[Stream] = Recovery->Config->Transfer.length;
+    *streamControlRegister[Stream] = (*streamControlRegister[Stream] & 
+        ~DMA_SxCR_TCIE) | Recovery->interrupts | DMA_SxCR_CIRC;
+    Recovery->State = DMA_RECOVERY_RUNNING;
+    Recovery->remaining = *streamNumberOfData[Stream];
+    Recovery->progress = TIMEBASE_now();
+    *streamControlRegister[Stream] |= DMA_SxCR_EN;
+}
@@ -13,6 +13,7 @@
 * Module Includes
 *****************************************************************************/
 #include "dma_cfg.h"
+#include "stm32f4xx.h"  /*For the register bit definitions*/
 
 /*****************************************************************************
 * Module Preprocessor Constants
@@ -40,15 +41,33 @@ const DmaConfig_t DmaConfig[] =
 /*                                                          
  *  Stream          Channel        Direction                MemorySize
  *  PeripheralSize         MemoryIncrement              PeripheralIncrement
- *  FifoMode                      FifoThreshold
+ *  FifoMode                      FifoThreshold            CircularMode
  *                
 */ 
    {DMA1_STREAM_6, DMA_CHANNEL_4, DMA_MEMORY_TO_PERIPHERAL, DMA_MEMORY_SIZE_8,
    DMA_PERIPHERAL_SIZE_8, DMA_MEMORY_INCREMENT_ENABLED, DMA_PERIPHERAL_INCREMENT_DISABLED,
-   DMA_FIFO_DIRECT_MODE_ENABLED, DMA_FIFO_THRESHOLD_FULL},
+   DMA_FIFO_DIRECT_MODE_ENABLED, DMA_FIFO_THRESHOLD_FULL, DMA_CIRCULAR_MODE_DISABLED},
    {DMA1_STREAM_5, DMA_CHANNEL_4, DMA_PERIPHERAL_TO_MEMORY, DMA_MEMORY_SIZE_8,
    DMA_PERIPHERAL_SIZE_8, DMA_MEMORY_INCREMENT_ENABLED, DMA_PERIPHERAL_INCREMENT_DISABLED,
-   DMA_FIFO_DIRECT_MODE_ENABLED, DMA_FIFO_THRESHOLD_FULL},
+   DMA_FIFO_DIRECT_MODE_ENABLED, DMA_FIFO_THRESHOLD_FULL, DMA_CIRCULAR_MODE_DISABLED},
+};
+
+/**
+ * The following array contains the register images of the DmaConfig table.
+ * Each row represent a single DMA stream. This table is read in by 
+ * DMA_imageInit, where each stream is written with plain stores. Both tables
+ * are generated from board.json by scripts/cfg_generate.py.
+ */
+const DmaStreamImage_t DmaImage[] = 
+{
+/*                                                          
+ *  Stream          CR
+ *  FCR
+ *                
+*/ 
+   {DMA1_STREAM_6, DMA_SxCR_CHSEL_2 | DMA_SxCR_DIR_0 | DMA_SxCR_MINC,
+   DMA_SxFCR_FTH_0 | DMA_SxFCR_FTH_1},
+   {DMA1_STREAM_5, DMA_SxCR_CHSEL_2 | DMA_SxCR_MINC, DMA_SxFCR_FTH_0 | DMA_SxFCR_FTH_1},
 };
 /*****************************************************************************
  * Function Prototypes
@@ -125,4 +144,72 @@ const DmaConfig_t * const DMA_configGet(void)
 size_t DMA_configSizeGet(void)
 {
    return sizeof(DmaConfig)/sizeof(DmaConfig[0]);
-}
\ No newline at end of file
+}
+
+/*****************************************************************************
+ * Function: DMA_imageGet()
+*/
+/**
+*\b Description:
+ * This function is used to get the register images generated from the 
+ * configuration table defined in dma_cfg module.
+ * 
+ * PRE-CONDITION: The image table must be populated (sizeof>0). <br>
+ * 
+ * POST-CONDITION: A constant pointer to the first member of the image table
+ * is returned. <br>
+ * 
+ * @return A pointer to the image table. <br>
+ * 
+ * \b Example:
+ * @code
+ * const DmaStreamImage_t * const DmaImage = DMA_imageGet();
+ * size_t imageSize = DMA_imageSizeGet();
+ * 
+ * DMA_imageInit(DmaImage, imageSize);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_configSizeGet
+ * @see DMA_imageGet
+ * @see DMA_imageSizeGet
+ * @see DMA_imageInit
+ * 
+*****************************************************************************/
+const DmaStreamImage_t * const DMA_imageGet(void)
+{
+    return (const DmaStreamImage_t *)&DmaImage[0];
+}
+
+/*****************************************************************************
+ * Function: DMA_imageSizeGet()
+*/
+/**
+*\b Description:
+ * This function is used to get the size of the image table.
+ * 
+ * PRE-CONDITION: The image table needs to be populated (sizeof > 0) <br>
+ * 
+ * POST-CONDITION: The size of the image table will be returned. <br>
+ * 
+ * @return The size of the image table.
+ * 
+ * \b Example: 
+ * @code
+ * const DmaStreamImage_t * const DmaImage = DMA_imageGet();
+ * size_t imageSize = DMA_imageSizeGet();
+ * 
+ * DMA_imageInit(DmaImage, imageSize);
+ * @endcode
+ * 
+ * @see DMA_configGet
+ * @see DMA_configSizeGet
+ * @see DMA_imageGet
+ * @see DMA_imageSizeGet
+ * @see DMA_imageInit
+ * 
+*****************************************************************************/
+size_t DMA_imageSizeGet(void)
+{
+   return sizeof(DmaImage)/sizeof(DmaImage[0]);
+}
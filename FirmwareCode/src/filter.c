@@ -0,0 +1,206 @@
+/**
+ * @file filter.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the decimation filter. On the Cortex-M4 two
+ * samples are held in a 32-bit register and added together (SIMD within a
+ * register): SMLAD adds both halves of a word of a single channel to a
+ * 32-bit sum, and SADD16 adds the words of a channel pair lane by lane. The
+ * data is little-endian.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "filter.h"     /*For this modules definitions*/
+#if defined(__ARM_FEATURE_SIMD32)
+#include "stm32f4xx.h"  /*For the SIMD instructions*/
+#endif
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the multiplier of both halves of a word, so SMLAD adds them.
+*/
+#define FILTER_PAIR_ONES 0x00010001UL
+
+/**
+ * Defines the number of frames added on the 16-bit lanes of a channel pair
+ * before the lanes are moved to the 32-bit sums. The lanes are signed, so
+ * they hold up to 0x7FFF.
+*/
+#define FILTER_LANE_FRAMES (0x7FFFU / FILTER_SAMPLE_MAX)
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void FILTER_windowSum(const uint16_t * const samples,
+const uint32_t channels, const uint32_t factor, uint32_t * const sums);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: FILTER_decimate()
+ *//**
+ * \b Description:
+ * This function is used to average and decimate the samples of a scan
+ * sequence. The samples are split in windows of factor frames (one sample
+ * of each channel per frame), and each window gives one output per channel:
+ * the average of its samples, rounded to the nearest integer (halves up).
+ * The samples after the last whole window are not used.
+ *
+ * PRE-CONDITION: channels is between 1 and FILTER_CHANNELS_MAX. <br>
+ * PRE-CONDITION: factor is greater than 0. <br>
+ * PRE-CONDITION: The samples are lower or equal than FILTER_SAMPLE_MAX. <br>
+ * PRE-CONDITION: output has room for FILTER_OUTPUT_SIZE(count) words. <br>
+ *
+ * POST-CONDITION: output holds the averages, interleaved like the
+ * samples. <br>
+ *
+ * @param[in]   Decimation is the decimation of the sequence.
+ * @param[in]   samples is the array of samples.
+ * @param[in]   count is the number of samples.
+ * @param[out]  output is the array of averages.
+ *
+ * @return The number of averages.
+ *
+ * \b Example:
+ * @code
+ * static const FilterDecimation_t Decimation = {2U, 16U};
+ * uint16_t averages[FILTER_OUTPUT_SIZE(256U, 2U, 16U)];
+ *
+ * uint32_t size = FILTER_decimate(&Decimation, samples, 256U, averages);
+ * @endcode
+ *
+ * @see FILTER_decimate
+ *
+*****************************************************************************/
+uint32_t FILTER_decimate(const FilterDecimation_t * const Decimation,
+const uint16_t * const samples, uint32_t count, uint16_t * const output)
+{
+    uint32_t sums[FILTER_CHANNELS_MAX];
+    const uint32_t channels = Decimation->channels;
+    const uint32_t factor = Decimation->factor;
+    uint32_t windows;
+
+    /* Prevent to write out of the sums */
+    assert((channels > 0U) && (channels <= FILTER_CHANNELS_MAX));
+    assert(factor > 0U);
+
+    windows = count / (channels * factor);
+
+    for(uint32_t i=0; i<windows; i++)
+    {
+        FILTER_windowSum(&samples[i * channels * factor], channels, factor,
+            sums);
+
+        for(uint32_t channel=0; channel<channels; channel++)
+        {
+            output[(i * channels) + channel] =
+                (uint16_t)((sums[channel] + (factor / 2U)) / factor);
+        }
+    }
+
+    return windows * channels;
+}
+
+/*****************************************************************************
+ * Function: FILTER_windowSum()
+ *//**
+ * \b Description:
+ * This function is used to add the samples of each channel of a window. On
+ * the Cortex-M4, a single channel is added two samples at a time with
+ * SMLAD, and an even number of channels is added a pair at a time with
+ * SADD16, moving the lanes to the sums every FILTER_LANE_FRAMES frames. An
+ * odd number of channels, and any other target, adds one sample at a time.
+ *
+ * PRE-CONDITION: The samples are lower or equal than FILTER_SAMPLE_MAX. <br>
+ *
+ * POST-CONDITION: sums holds the sum of each channel. <br>
+ *
+ * @param[in]   samples is the array of samples of the window.
+ * @param[in]   channels is the number of channels.
+ * @param[in]   factor is the number of frames of the window.
+ * @param[out]  sums is the array of sums, one per channel.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void FILTER_windowSum(const uint16_t * const samples,
+const uint32_t channels, const uint32_t factor, uint32_t * const sums)
+{
+    uint32_t frame = 0U;
+
+    for(uint32_t channel=0; channel<channels; channel++)
+    {
+        sums[channel] = 0U;
+    }
+
+#if defined(__ARM_FEATURE_SIMD32)
+    if(channels == 1U)
+    {
+        for(; (frame + 1U) < factor; frame += 2U)
+        {
+            sums[0] = __SMLAD(__UNALIGNED_UINT32_READ(&samples[frame]),
+                FILTER_PAIR_ONES, sums[0]);
+        }
+    }
+    else if((channels & 1U) == 0U)
+    {
+        uint32_t lanes[FILTER_CHANNELS_MAX / 2U];
+        uint32_t end;
+
+        while(frame < factor)
+        {
+            end = ((factor - frame) > FILTER_LANE_FRAMES) ?
+                (frame + FILTER_LANE_FRAMES) : factor;
+
+            for(uint32_t pair=0; pair<(channels / 2U); pair++)
+            {
+                lanes[pair] = 0U;
+            }
+
+            for(; frame<end; frame++)
+            {
+                for(uint32_t pair=0; pair<(channels / 2U); pair++)
+                {
+                    lanes[pair] = __SADD16(lanes[pair],
+                        __UNALIGNED_UINT32_READ(
+                            &samples[(frame * channels) + (2U * pair)]));
+                }
+            }
+
+            for(uint32_t pair=0; pair<(channels / 2U); pair++)
+            {
+                sums[2U * pair] += lanes[pair] & 0x0000FFFFUL;
+                sums[(2U * pair) + 1U] += lanes[pair] >> 16;
+            }
+        }
+    }
+#endif
+
+    for(; frame<factor; frame++)
+    {
+        for(uint32_t channel=0; channel<channels; channel++)
+        {
+            sums[channel] += samples[(frame * channels) + channel];
+        }
+    }
+}
@@ -0,0 +1,1005 @@
+/**
+ * @file i2c.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the I2C driver. The bytes of a transfer are
+ * moved by the DMA: the transmit stream on TXE and the receive stream on
+ * RXNE. With the LAST bit set, the end of the receive stream makes the
+ * peripheral answer the last byte with a NACK. The waits for the bus
+ * events sleep until the event or error interrupt of the port is pending.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+*/
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include "i2c.h"          /*For this modules definitions*/
+#include "idle.h"         /*For the event-driven waits*/
+#include "timebase.h"     /*For the timeouts*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the range of the peripheral clock in MHz (FREQ field).
+*/
+#define I2C_CLOCK_MHZ 1000000UL
+#define I2C_FREQ_MIN 2U
+#define I2C_FREQ_MAX 50U
+
+/**
+ * Defines the SCL frequencies of the standard and the fast mode, and the
+ * minimum CCR values of each mode.
+*/
+#define I2C_STANDARD_RATE 100000UL
+#define I2C_FAST_RATE 400000UL
+#define I2C_STANDARD_CCR_MIN 4U
+#define I2C_FAST_CCR_MIN 1U
+
+/**
+ * Defines the number of peripheral clock cycles of one SCL period in fast
+ * mode: 3 with tlow/thigh = 2, 25 with tlow/thigh = 16/9.
+*/
+#define I2C_FAST_CYCLES_DUTY_2 3U
+#define I2C_FAST_CYCLES_DUTY_16_9 25U
+
+/**
+ * Defines the maximum SCL rise time of the fast mode (ns). It is 1000 ns
+ * in standard mode, one peripheral clock period per MHz.
+*/
+#define I2C_FAST_RISE_TIME 300U
+
+/**
+ * Defines the error flags of a transfer (SR1).
+*/
+#define I2C_SR1_ERRORS (I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF)
+
+/**
+ * Defines the read bit of the address byte.
+*/
+#define I2C_READ 0x01U
+
+/**
+ * Defines the half period of SCL during the bus recovery (us), i.e. less
+ * than the standard mode.
+*/
+#define I2C_RECOVERY_HALF_PERIOD 5U
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+/**
+ * Checks a setting of the I2C configuration table. Compiled out when the
+ * build defines CONFIG_TABLES_CHECKED (see scripts/config_check.py). The 
+ * port indexes the register tables, so it uses assert instead.
+*/
+#ifdef CONFIG_TABLES_CHECKED
+#define I2C_CONFIG_ASSERT(expression) ((void)0)
+#else
+#define I2C_CONFIG_ASSERT(expression) assert(expression)
+#endif
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/* Defines a array of pointers to the I2C control register 1*/
+static uint32_t volatile * const controlRegister1[I2C_PORTS_NUMBER] =
+{
+    (uint32_t*)&I2C1->CR1, (uint32_t*)&I2C2->CR1, (uint32_t*)&I2C3->CR1
+};
+
+/* Defines a array of pointers to the I2C control register 2*/
+static uint32_t volatile * const controlRegister2[I2C_PORTS_NUMBER] =
+{
+    (uint32_t*)&I2C1->CR2, (uint32_t*)&I2C2->CR2, (uint32_t*)&I2C3->CR2
+};
+
+/* Defines a array of pointers to the I2C status register 1*/
+static uint32_t volatile * const statusRegister1[I2C_PORTS_NUMBER] =
+{
+    (uint32_t*)&I2C1->SR1, (uint32_t*)&I2C2->SR1, (uint32_t*)&I2C3->SR1
+};
+
+/* Defines a array of pointers to the I2C status register 2*/
+static uint32_t volatile * const statusRegister2[I2C_PORTS_NUMBER] =
+{
+    (uint32_t*)&I2C1->SR2, (uint32_t*)&I2C2->SR2, (uint32_t*)&I2C3->SR2
+};
+
+/* Defines a array of pointers to the I2C data register*/
+static uint32_t volatile * const dataRegister[I2C_PORTS_NUMBER] =
+{
+    (uint32_t*)&I2C1->DR, (uint32_t*)&I2C2->DR, (uint32_t*)&I2C3->DR
+};
+
+/* Defines a array of pointers to the I2C clock control register*/
+static uint32_t volatile * const clockControlRegister[I2C_PORTS_NUMBER] =
+{
+    (uint32_t*)&I2C1->CCR, (uint32_t*)&I2C2->CCR, (uint32_t*)&I2C3->CCR
+};
+
+/* Defines a array of pointers to the I2C rise time register*/
+static uint32_t volatile * const riseTimeRegister[I2C_PORTS_NUMBER] =
+{
+    (uint32_t*)&I2C1->TRISE, (uint32_t*)&I2C2->TRISE, (uint32_t*)&I2C3->TRISE
+};
+
+/* Defines the event and the error interrupt of each port, used to wake up
+ * the processor.
+*/
+static const IRQn_Type eventIrq[I2C_PORTS_NUMBER] =
+{
+    I2C1_EV_IRQn, I2C2_EV_IRQn, I2C3_EV_IRQn
+};
+
+static const IRQn_Type errorIrq[I2C_PORTS_NUMBER] =
+{
+    I2C1_ER_IRQn, I2C2_ER_IRQn, I2C3_ER_IRQn
+};
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static I2cStatus_t I2C_transaction(const I2cDevice_t * const Device,
+const uint8_t * const command, const I2cTransfer_t * const Transfer,
+const uint32_t timeout);
+static I2cStatus_t I2C_addressSend(const I2cPort_t Port, const uint8_t data,
+const uint32_t deadline);
+static I2cStatus_t I2C_eventWait(const I2cPort_t Port, const uint32_t flag,
+const uint32_t deadline);
+static I2cStatus_t I2C_registerWait(uint32_t volatile * const address,
+const uint32_t mask, const uint32_t value, const uint32_t deadline);
+static void I2C_delay(const uint32_t time);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: I2C_init()
+*//**
+    *\b Description:
+    * This function is used to initialize the I2C based on the configuration
+    * table defined in i2c_cfg module. The SCL frequency and the rise time
+    * are derived from the peripheral clock, and the port is enabled (PE)
+    * once it is configured.
+    *
+    * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
+    * PRE-CONDITION: Configuration table needs to be populated (sizeof>0) <br>
+    * PRE-CONDITION: The peripheral clock is between 2 MHz (4 MHz in fast
+    *                mode) and 50 MHz. <br>
+    * PRE-CONDITION: The setting is within the maximum values (I2C_MAX). <br>
+    *
+    * POST-CONDITION: The I2C peripheral is set up with the configuration
+    * table. <br>
+    *
+    * @param[in]   Config is a pointer to the configuration table that contains
+    * the initialization for the peripheral.
+    * @param[in]   configSize is the size of the configuration table.
+    * @param[in]   peripheralClock is the clock of the APB1 bus in Hz.
+    *
+    * @return void
+    *
+    * \b Example:
+    * @code
+    * const I2cConfig_t * const I2cConfig = I2C_configGet();
+    * size_t configSize = I2C_configSizeGet();
+    *
+    * I2C_init(I2cConfig, configSize, APB1_CLOCK);
+    * @endcode
+    *
+    * @see I2C_configGet
+    * @see I2C_configSizeGet
+    * @see I2C_init
+    * @see I2C_transfer
+    * @see I2C_burstRead
+    * @see I2C_burstWrite
+    * @see I2C_busRecover
+    * @see I2C_registerWrite
+    * @see I2C_registerRead
+    *
+*****************************************************************************/
+void I2C_init(const I2cConfig_t * const Config, size_t configSize,
+const uint32_t peripheralClock)
+{
+    const uint32_t frequency = peripheralClock / I2C_CLOCK_MHZ;
+    uint32_t cycles;
+    uint32_t ccr;
+    uint32_t trise;
+
+    /* Prevent to use a clock out of the range of the peripheral */
+    assert((frequency >= I2C_FREQ_MIN) && (frequency <= I2C_FREQ_MAX));
+
+    /* Loop through all the elements of the configuration table. */
+    for(uint8_t i=0; i<configSize; i++)
+    {
+        /* Prevent to assign a value out of the range of the port.*/
+        assert(Config[i].Port < I2C_PORT_MAX);
+
+        /* The clock is changed with the port disabled */
+        *controlRegister1[Config[i].Port] &= ~I2C_CR1_PE;
+
+        *controlRegister2[Config[i].Port] =
+            (*controlRegister2[Config[i].Port] & ~I2C_CR2_FREQ) |
+            (frequency << I2C_CR2_FREQ_Pos);
+
+        /* Set the speed. CCR is the SCL high time in peripheral clock
+         * cycles, rounded up so the bus is never faster than the mode.
+         * TRISE is the maximum rise time in cycles, plus one.
+        */
+        if(Config[i].Speed == I2C_SPEED_FAST)
+        {
+            I2C_CONFIG_ASSERT(Config[i].Duty < I2C_DUTY_MAX);
+            cycles = (Config[i].Duty == I2C_DUTY_16_9) ?
+                I2C_FAST_CYCLES_DUTY_16_9 : I2C_FAST_CYCLES_DUTY_2;
+            ccr = (peripheralClock + (cycles * I2C_FAST_RATE) - 1UL) /
+                (cycles * I2C_FAST_RATE);
+            ccr = (ccr < I2C_FAST_CCR_MIN) ? I2C_FAST_CCR_MIN : ccr;
+            ccr |= I2C_CCR_FS;
+            if(Config[i].Duty == I2C_DUTY_16_9)
+            {
+                ccr |= I2C_CCR_DUTY;
+            }
+            trise = ((frequency * I2C_FAST_RISE_TIME) / 1000U) + 1U;
+        }
+        else
+        {
+            I2C_CONFIG_ASSERT(Config[i].Speed == I2C_SPEED_STANDARD);
+            ccr = (peripheralClock + (2UL * I2C_STANDARD_RATE) - 1UL) /
+                (2UL * I2C_STANDARD_RATE);
+            ccr = (ccr < I2C_STANDARD_CCR_MIN) ? I2C_STANDARD_CCR_MIN : ccr;
+            trise = frequency + 1U;
+        }
+
+        *clockControlRegister[Config[i].Port] = ccr;
+        *riseTimeRegister[Config[i].Port] = trise;
+
+        /* Set the enable, once the port is configured */
+        if(Config[i].Enable == I2C_ENABLED)
+        {
+            *controlRegister1[Config[i].Port] |= I2C_CR1_PE;
+        }
+        else if(Config[i].Enable == I2C_DISABLED)
+        {
+            *controlRegister1[Config[i].Port] &= ~I2C_CR1_PE;
+        }
+        else
+        {
+            I2C_CONFIG_ASSERT(Config[i].Enable < I2C_ENABLE_MAX);
+        }
+    }
+}
+
+/*****************************************************************************
+ * Function: I2C_transfer()
+ *//**
+    * \b Description:
+    * This function is used to run a transfer with a device. The data is
+    * written first; the data is then read after a repeated start, so no
+    * other master can take the bus in between. The bytes are moved by the
+    * DMA and the last byte read is answered with a NACK, as the protocol
+    * requires. A single byte is read without the DMA. The bus is released
+    * with a stop, also when the device does not acknowledge. On a timeout
+    * or a bus error the streams are stopped and the bus is recovered
+    * (I2C_busRecover) if its pins are known. The processor sleeps during
+    * the transfer.
+    *
+    * PRE-CONDITION: The I2C peripheral must be initialized (I2C_init). <br>
+    * PRE-CONDITION: The streams are initialized in normal mode for the I2C
+    *                TX and RX, with 8-bit data. <br>
+    * PRE-CONDITION: The idle and the timebase must be initialized. <br>
+    * PRE-CONDITION: The Port is within the maximum I2cPort_t. <br>
+    *
+    * POST-CONDITION: The bytes are exchanged and the bus is released. <br>
+    *
+    * @param[in]   Device is a pointer to the device.
+    * @param[in]   Transfer is a pointer to the transfer.
+    * @param[in]   timeout is the time allowed for the transfer in
+    *              microseconds.
+    *
+    * @return I2C_OK if the transfer completed, I2C_NACK if the device did
+    *         not acknowledge, otherwise I2C_TIMEOUT or I2C_BUS_ERROR.
+    *
+    * \b Example:
+    * @code
+    * static const I2cBus_t Bus =
+    * {
+    *     I2C_PORT_1, DMA1_STREAM_6, DMA1_STREAM_0, &DioConfig[8],
+    *     &DioConfig[9]
+    * };
+    * static const I2cDevice_t Sensor = {&Bus, 0x68U};
+    * static const uint8_t reset[2] = {0x6BU, 0x80U};
+    * const I2cTransfer_t Transfer = {reset, 2U, NULL, 0U};
+    *
+    * if(I2C_transfer(&Sensor, &Transfer, 1000U) == I2C_NACK)
+    * {
+    *     //The sensor is not on the bus
+    * }
+    * @endcode
+    *
+    * @see I2C_configGet
+    * @see I2C_configSizeGet
+    * @see I2C_init
+    * @see I2C_transfer
+    * @see I2C_burstRead
+    * @see I2C_burstWrite
+    * @see I2C_busRecover
+    * @see I2C_registerWrite
+    * @see I2C_registerRead
+    *
+*****************************************************************************/
+I2cStatus_t I2C_transfer(const I2cDevice_t * const Device,
+const I2cTransfer_t * const Transfer, const uint32_t timeout)
+{
+    return I2C_transaction(Device, NULL, Transfer, timeout);
+}
+
+/*****************************************************************************
+ * Function: I2C_burstRead()
+ *//**
+    * \b Description:
+    * This function is used to read a block of registers of a device in one
+    * transaction: the address of the first register is written, and the
+    * block is read by the DMA after a repeated start. The device is
+    * expected to increment its register address after each byte.
+    *
+    * PRE-CONDITION: As for I2C_transfer. <br>
+    *
+    * POST-CONDITION: data holds the registers if I2C_OK is returned. <br>
+    *
+    * @param[in]   Device is a pointer to the device.
+    * @param[in]   reg is the address of the first register.
+    * @param[out]  data is the buffer of the registers.
+    * @param[in]   length is the number of registers.
+    * @param[in]   timeout is the time allowed for the transaction in
+    *              microseconds.
+    *
+    * @return I2C_OK if the registers were read, otherwise the error of
+    *         I2C_transfer.
+    *
+    * \b Example:
+    * @code
+    * uint8_t motion[14];
+    *
+    * //Accelerometer, temperature and gyroscope of a MPU-6050
+    * if(I2C_burstRead(&Sensor, 0x3BU, motion, 14U, 1000U) == I2C_OK)
+    * {
+    *     accelX = (int16_t)((motion[0] << 8) | motion[1]);
+    * }
+    * @endcode
+    *
+    * @see I2C_configGet
+    * @see I2C_configSizeGet
+    * @see I2C_init
+    * @see I2C_transfer
+    * @see I2C_burstRead
+    * @see I2C_burstWrite
+    * @see I2C_busRecover
+    * @see I2C_registerWrite
+    * @see I2C_registerRead
+    *
+*****************************************************************************/
+I2cStatus_t I2C_burstRead(const I2cDevice_t * const Device,
+const uint8_t reg, uint8_t * const data, const uint32_t length,
+const uint32_t timeout)
+{
+    const I2cTransfer_t Transfer = {NULL, 0U, data, length};
+
+    return I2C_transaction(Device, &reg, &Transfer, timeout);
+}
+
+/*****************************************************************************
+ * Function: I2C_burstWrite()
+ *//**
+    * \b Description:
+    * This function is used to write a block of registers of a device in one
+    * transaction: the address of the first register is written, followed
+    * by the block, moved by the DMA from the buffer of the application. The
+    * device is expected to increment its register address after each byte.
+    *
+    * PRE-CONDITION: As for I2C_transfer. <br>
+    *
+    * POST-CONDITION: The registers are written if I2C_OK is returned. <br>
+    *
+    * @param[in]   Device is a pointer to the device.
+    * @param[in]   reg is the address of the first register.
+    * @param[in]   data is the buffer of the registers.
+    * @param[in]   length is the number of registers.
+    * @param[in]   timeout is the time allowed for the transaction in
+    *              microseconds.
+    *
+    * @return I2C_OK if the registers were written, otherwise the error of
+    *         I2C_transfer.
+    *
+    * \b Example:
+    * @code
+    * //Sample rate divider, filter, gyroscope and accelerometer ranges
+    * static const uint8_t setup[4] = {0x07U, 0x03U, 0x08U, 0x10U};
+    *
+    * (void)I2C_burstWrite(&Sensor, 0x19U, setup, 4U, 1000U);
+    * @endcode
+    *
+    * @see I2C_configGet
+    * @see I2C_configSizeGet
+    * @see I2C_init
+    * @see I2C_transfer
+    * @see I2C_burstRead
+    * @see I2C_burstWrite
+    * @see I2C_busRecover
+    * @see I2C_registerWrite
+    * @see I2C_registerRead
+    *
+*****************************************************************************/
+I2cStatus_t I2C_burstWrite(const I2cDevice_t * const Device,
+const uint8_t reg, const uint8_t * const data, const uint32_t length,
+const uint32_t timeout)
+{
+    const I2cTransfer_t Transfer = {data, length, NULL, 0U};
+
+    return I2C_transaction(Device, &reg, &Transfer, timeout);
+}
+
+/*****************************************************************************
+ * Function: I2C_busRecover()
+ *//**
+    * \b Description:
+    * This function is used to free a bus held low by a device, e.g. after a
+    * reset of the master in the middle of a read. The pins are taken as
+    * open-drain outputs and SCL is pulsed, up to I2C_RECOVERY_CLOCKS times,
+    * until the device releases SDA; a stop is then sent. The pins are given
+    * back to the peripheral, which is reset (SWRST) and configured again as
+    * it was, as it may still see the bus busy. The recovery takes at most
+    * about 100 microseconds.
+    *
+    * PRE-CONDITION: The I2C peripheral must be initialized (I2C_init). <br>
+    * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+    * PRE-CONDITION: Scl and Sda are the rows of the pins on the DIO
+    *                configuration table. <br>
+    *
+    * POST-CONDITION: The bus is idle, unless SDA is still held low. <br>
+    *
+    * @param[in]   Bus is a pointer to the bus.
+    *
+    * @return I2C_OK if SDA was released, otherwise I2C_BUS_ERROR.
+    *
+    * \b Example:
+    * @code
+    * if(I2C_busRecover(&Bus) == I2C_BUS_ERROR)
+    * {
+    *     //A device keeps SDA low, it needs a power cycle
+    * }
+    * @endcode
+    *
+    * @see I2C_configGet
+    * @see I2C_configSizeGet
+    * @see I2C_init
+    * @see I2C_transfer
+    * @see I2C_burstRead
+    * @see I2C_burstWrite
+    * @see I2C_busRecover
+    * @see I2C_registerWrite
+    * @see I2C_registerRead
+    *
+*****************************************************************************/
+I2cStatus_t I2C_busRecover(const I2cBus_t * const Bus)
+{
+    I2cStatus_t Status = I2C_BUS_ERROR;
+    DioConfig_t Pins[2];
+    uint32_t cr1;
+    uint32_t cr2;
+    uint32_t ccr;
+    uint32_t trise;
+
+    /*Prevent to assign a value out of the range of the port and pins.*/
+    assert(Bus->Port < I2C_PORT_MAX);
+    assert((Bus->Scl != NULL) && (Bus->Sda != NULL));
+
+    const DioPinConfig_t Scl = {Bus->Scl->Port, Bus->Scl->Pin};
+    const DioPinConfig_t Sda = {Bus->Sda->Port, Bus->Sda->Pin};
+
+    cr1 = *controlRegister1[Bus->Port] &
+        ~(I2C_CR1_START | I2C_CR1_STOP | I2C_CR1_POS);
+    cr2 = *controlRegister2[Bus->Port] &
+        ~(I2C_CR2_DMAEN | I2C_CR2_LAST | I2C_CR2_ITEVTEN | I2C_CR2_ITERREN |
+          I2C_CR2_ITBUFEN);
+    ccr = *clockControlRegister[Bus->Port];
+    trise = *riseTimeRegister[Bus->Port];
+
+    /* Take the lines as released open-drain outputs */
+    DIO_pinWrite(&Scl, DIO_HIGH);
+    DIO_pinWrite(&Sda, DIO_HIGH);
+    Pins[0] = *Bus->Scl;
+    Pins[1] = *Bus->Sda;
+    Pins[0].Mode = DIO_OUTPUT;
+    Pins[1].Mode = DIO_OUTPUT;
+    Pins[0].Type = DIO_OPEN_DRAIN;
+    Pins[1].Type = DIO_OPEN_DRAIN;
+    DIO_init(&Pins[0], 2U);
+    I2C_delay(I2C_RECOVERY_HALF_PERIOD);
+
+    /* Clock the device through the rest of its byte */
+    for(uint8_t i=0; (i<I2C_RECOVERY_CLOCKS) &&
+        (DIO_pinRead(&Sda) == DIO_LOW); i++)
+    {
+        DIO_pinWrite(&Scl, DIO_LOW);
+        I2C_delay(I2C_RECOVERY_HALF_PERIOD);
+        DIO_pinWrite(&Scl, DIO_HIGH);
+        I2C_delay(I2C_RECOVERY_HALF_PERIOD);
+    }
+
+    /* Send a stop: SDA rises while SCL is high */
+    if(DIO_pinRead(&Sda) == DIO_HIGH)
+    {
+        DIO_pinWrite(&Scl, DIO_LOW);
+        I2C_delay(I2C_RECOVERY_HALF_PERIOD);
+        DIO_pinWrite(&Sda, DIO_LOW);
+        I2C_delay(I2C_RECOVERY_HALF_PERIOD);
+        DIO_pinWrite(&Scl, DIO_HIGH);
+        I2C_delay(I2C_RECOVERY_HALF_PERIOD);
+        DIO_pinWrite(&Sda, DIO_HIGH);
+        I2C_delay(I2C_RECOVERY_HALF_PERIOD);
+        Status = I2C_OK;
+    }
+
+    /* Give the pins back and restart the peripheral with its settings */
+    DIO_init(Bus->Scl, 1U);
+    DIO_init(Bus->Sda, 1U);
+
+    *controlRegister1[Bus->Port] |= I2C_CR1_SWRST;
+    *controlRegister1[Bus->Port] &= ~I2C_CR1_SWRST;
+    *controlRegister2[Bus->Port] = cr2;
+    *clockControlRegister[Bus->Port] = ccr;
+    *riseTimeRegister[Bus->Port] = trise;
+    *controlRegister1[Bus->Port] = cr1;
+
+    return Status;
+}
+
+/*****************************************************************************
+ * Function: I2C_registerWrite()
+ *//**
+    * \b Description:
+    * This function is used to directly address and modify a I2C register.
+    * The function should be used to access specialized functionality in
+    * the I2C peripheral that is not exposed by any other function of the
+    * interface.
+    *
+    * PRE-CONDITION: The I2C peripheral must be initialized (I2C_init).<br>
+    * PRE-CONDITION: Address is within the boundaries of the I2C register
+    *                map. <br>
+    *
+    * POST-CONDITION: The data is written to the address.<br>
+    *
+    * @param[in]   address is the address of the register to write to.
+    * @param[in]   value is the value to write to the I2C register.
+    *
+    * @return void
+    *
+    * \b Example:
+    * @code
+    * I2C_registerWrite(0x40005424, 0x0004);
+    * @endcode
+    *
+    * @see I2C_configGet
+    * @see I2C_configSizeGet
+    * @see I2C_init
+    * @see I2C_transfer
+    * @see I2C_burstRead
+    * @see I2C_burstWrite
+    * @see I2C_busRecover
+    * @see I2C_registerWrite
+    * @see I2C_registerRead
+    *
+*****************************************************************************/
+void I2C_registerWrite(const uint32_t address, const uint32_t value)
+{
+    /* Write the value to the address */
+    volatile uint32_t * const registerPointer = (uint32_t*)address;
+    *registerPointer = value;
+}
+
+/*****************************************************************************
+ * Function: I2C_registerRead()
+ *//**
+    * \b Description:
+    * This function is used to directly address and read a I2C register.
+    * The function should be used to access specialized functionality in
+    * the I2C peripheral that is not exposed by any other function of the
+    * interface.
+    *
+    * PRE-CONDITION: The I2C peripheral must be initialized (I2C_init). <br>
+    * PRE-CONDITION: Address is within the boundaries of the I2C register
+    *                map. <br>
+    *
+    * POST-CONDITION: The data is read from the address. <br>
+    *
+    * @param[in]   address is the address of the register to read from.
+    *
+    * @return the value of the register.
+    *
+    * \b Example:
+    * @code
+    * uint32_t value = I2C_registerRead(0x40005418);
+    * @endcode
+    *
+    * @see I2C_configGet
+    * @see I2C_configSizeGet
+    * @see I2C_init
+    * @see I2C_transfer
+    * @see I2C_burstRead
+    * @see I2C_burstWrite
+    * @see I2C_busRecover
+    * @see I2C_registerWrite
+    * @see I2C_registerRead
+    *
+*****************************************************************************/
+uint32_t I2C_registerRead(const uint32_t address)
+{
+    /* Read the value from the address */
+    volatile uint32_t * const registerPointer = (uint32_t*)address;
+    return *registerPointer;
+}
+
+/*****************************************************************************
+ * Function: I2C_transaction()
+ *//**
+    * \b Description:
+    * This function is used to run a transaction: the address of the device,
+    * an optional command byte (a register address) written by the
+    * processor, the data written by the DMA, then the data read by the DMA
+    * after a repeated start, and a stop. The write phase is skipped when
+    * there is nothing to write and something to read.
+    *
+    * PRE-CONDITION: As for I2C_transfer. <br>
+    *
+    * POST-CONDITION: The bus is released. <br>
+    *
+    * @param[in]   Device is a pointer to the device.
+    * @param[in]   command is a pointer to the command byte (or NULL).
+    * @param[in]   Transfer is a pointer to the transfer.
+    * @param[in]   timeout is the time allowed for the transaction in
+    *              microseconds.
+    *
+    * @return The status of the transaction.
+    *
+*****************************************************************************/
+static I2cStatus_t I2C_transaction(const I2cDevice_t * const Device,
+const uint8_t * const command, const I2cTransfer_t * const Transfer,
+const uint32_t timeout)
+{
+    const I2cBus_t * const Bus = Device->Bus;
+    const I2cPort_t Port = Bus->Port;
+    const uint32_t deadline = TIMEBASE_deadlineGet(timeout);
+    const uint8_t address = (uint8_t)(Device->address << 1);
+    I2cStatus_t Status;
+    uint8_t stopped = 0U;
+    uint32_t left;
+
+    /*Prevent to assign a value out of the range of the port and streams.*/
+    assert(Port < I2C_PORT_MAX);
+    assert(Bus->TxStream < DMA_STREAM_MAX);
+    assert(Bus->RxStream < DMA_STREAM_MAX);
+
+    DmaTransferConfig_t DmaTxConfig =
+    {
+        .Stream = Bus->TxStream,
+        .peripheral = dataRegister[Port],
+        .memory = (uint32_t*)Transfer->txData,
+        .length = Transfer->txLength
+    };
+
+    DmaTransferConfig_t DmaRxConfig =
+    {
+        .Stream = Bus->RxStream,
+        .peripheral = dataRegister[Port],
+        .memory = (uint32_t*)Transfer->rxData,
+        .length = Transfer->rxLength
+    };
+
+    /* A device holding SDA low keeps the bus busy */
+    Status = I2C_registerWait(statusRegister2[Port], I2C_SR2_BUSY, 0U,
+        deadline);
+
+    /* Write phase: the address, the command and the data. A transfer
+     * without data at all only checks the acknowledge of the address.
+    */
+    if((Status == I2C_OK) && ((command != NULL) ||
+       (Transfer->txLength > 0U) || (Transfer->rxLength == 0U)))
+    {
+        Status = I2C_addressSend(Port, address, deadline);
+        if(Status == I2C_OK)
+        {
+            /* ADDR is cleared by reading SR1 and SR2, then DR is empty */
+            (void)*statusRegister1[Port];
+            (void)*statusRegister2[Port];
+
+            if(command != NULL)
+            {
+                *dataRegister[Port] = *command;
+            }
+
+            if(Transfer->txLength > 0U)
+            {
+                DMA_transferConfig(&DmaTxConfig);
+                *controlRegister2[Port] |= I2C_CR2_DMAEN;
+            }
+
+            /* The last byte was acknowledged once BTF is set with the
+             * stream done (a late stream can also leave BTF set)
+            */
+            if((command != NULL) || (Transfer->txLength > 0U))
+            {
+                do
+                {
+                    Status = I2C_eventWait(Port, I2C_SR1_BTF, deadline);
+                }while((Status == I2C_OK) && (Transfer->txLength > 0U) &&
+                       (DMA_transferRemainingGet(Bus->TxStream) > 0U));
+            }
+
+            *controlRegister2[Port] &= ~I2C_CR2_DMAEN;
+        }
+    }
+
+    /* Read phase, after a (repeated) start */
+    if((Status == I2C_OK) && (Transfer->rxLength > 0U))
+    {
+        if(Transfer->rxLength > 1U)
+        {
+            /* The end of the stream (LAST) answers the last byte with a
+             * NACK, the other bytes are acknowledged.
+            */
+            *controlRegister1[Port] |= I2C_CR1_ACK;
+            DMA_transferConfig(&DmaRxConfig);
+            *controlRegister2[Port] |= (I2C_CR2_DMAEN | I2C_CR2_LAST);
+        }
+        else
+        {
+            *controlRegister1[Port] &= ~I2C_CR1_ACK;
+        }
+
+        Status = I2C_addressSend(Port, (uint8_t)(address | I2C_READ),
+            deadline);
+        if(Status == I2C_OK)
+        {
+            (void)*statusRegister1[Port];
+            (void)*statusRegister2[Port];
+
+            if(Transfer->rxLength > 1U)
+            {
+                left = (TIMEBASE_deadlineCheck(deadline) == TIMEBASE_PENDING)
+                    ? (deadline - TIMEBASE_now()) : 0U;
+                if(DMA_transferWaitTimeout(Bus->RxStream, left) != DMA_OK)
+                {
+                    Status = I2C_TIMEOUT;
+                }
+            }
+            else
+            {
+                /* The only byte gets the NACK and the stop is sent after
+                 * it, so both are set once the address was acknowledged.
+                */
+                *controlRegister1[Port] |= I2C_CR1_STOP;
+                stopped = 1U;
+                Status = I2C_eventWait(Port, I2C_SR1_RXNE, deadline);
+                if(Status == I2C_OK)
+                {
+                    Transfer->rxData[0] = (uint8_t)*dataRegister[Port];
+                }
+            }
+        }
+
+        *controlRegister2[Port] &= ~(I2C_CR2_DMAEN | I2C_CR2_LAST);
+        *controlRegister1[Port] &= ~I2C_CR1_ACK;
+    }
+
+    /* Release the bus, also after a NACK */
+    if((Status == I2C_OK) || (Status == I2C_NACK))
+    {
+        if(stopped == 0U)
+        {
+            *controlRegister1[Port] |= I2C_CR1_STOP;
+        }
+        *statusRegister1[Port] &= ~I2C_SR1_AF;
+        if(I2C_registerWait(controlRegister1[Port], I2C_CR1_STOP, 0U,
+            deadline) != I2C_OK)
+        {
+            Status = I2C_TIMEOUT;
+        }
+    }
+
+    if((Status == I2C_TIMEOUT) || (Status == I2C_BUS_ERROR))
+    {
+        DMA_transferStop(Bus->TxStream);
+        DMA_transferStop(Bus->RxStream);
+        *statusRegister1[Port] &= ~I2C_SR1_ERRORS;
+
+        if((Bus->Scl != NULL) && (Bus->Sda != NULL))
+        {
+            (void)I2C_busRecover(Bus);
+        }
+    }
+
+    return Status;
+}
+
+/*****************************************************************************
+ * Function: I2C_addressSend()
+ *//**
+    * \b Description:
+    * This function is used to send a (repeated) start and the address byte,
+    * and to wait for the acknowledge of the device. ADDR is left set, so
+    * the caller sets the acknowledge of the read before clearing it.
+    *
+    * PRE-CONDITION: The Port is within the maximum I2cPort_t. <br>
+    *
+    * POST-CONDITION: The device acknowledged its address if I2C_OK is
+    *                 returned. <br>
+    *
+    * @param[in]   Port is the I2C port.
+    * @param[in]   data is the address byte (address and direction bit).
+    * @param[in]   deadline is the timestamp where the wait is abandoned.
+    *
+    * @return The status of the wait.
+    *
+*****************************************************************************/
+static I2cStatus_t I2C_addressSend(const I2cPort_t Port, const uint8_t data,
+const uint32_t deadline)
+{
+    I2cStatus_t Status;
+
+    *controlRegister1[Port] |= I2C_CR1_START;
+
+    /* SB is cleared by reading SR1 (on the wait) and writing DR */
+    Status = I2C_eventWait(Port, I2C_SR1_SB, deadline);
+    if(Status == I2C_OK)
+    {
+        *dataRegister[Port] = data;
+        Status = I2C_eventWait(Port, I2C_SR1_ADDR, deadline);
+    }
+
+    return Status;
+}
+
+/*****************************************************************************
+ * Function: I2C_eventWait()
+ *//**
+    * \b Description:
+    * This function is used to wait in sleep mode for an event flag of SR1,
+    * an error of the transfer, or the deadline. The event and error
+    * interrupts of the port wake the processor, as in IDLE_waitForDeadline;
+    * the buffer interrupt is only enabled for TXE and RXNE, as it stays
+    * pending while they are set.
+    *
+    * PRE-CONDITION: The idle and the timebase must be initialized. <br>
+    * PRE-CONDITION: The I2C interrupts are disabled in the NVIC. <br>
+    *
+    * POST-CONDITION: The interrupts of the port are disabled. <br>
+    *
+    * @param[in]   Port is the I2C port.
+    * @param[in]   flag is the awaited flag of SR1.
+    * @param[in]   deadline is the timestamp where the wait is abandoned.
+    *
+    * @return I2C_OK if the flag is set, I2C_NACK on an acknowledge failure,
+    *         I2C_BUS_ERROR on a bus error or an arbitration lost,
+    *         otherwise I2C_TIMEOUT.
+    *
+*****************************************************************************/
+static I2cStatus_t I2C_eventWait(const I2cPort_t Port, const uint32_t flag,
+const uint32_t deadline)
+{
+    I2cStatus_t Status = I2C_TIMEOUT;
+    uint32_t interrupts = I2C_CR2_ITEVTEN | I2C_CR2_ITERREN;
+    uint32_t status;
+
+    if(flag & (I2C_SR1_TXE | I2C_SR1_RXNE))
+    {
+        interrupts |= I2C_CR2_ITBUFEN;
+    }
+
+    *controlRegister2[Port] |= interrupts;
+    TIMEBASE_alarmSet(deadline);
+
+    while(1)
+    {
+        status = *statusRegister1[Port];
+        if(status & I2C_SR1_AF)
+        {
+            Status = I2C_NACK;
+            break;
+        }
+        if(status & (I2C_SR1_BERR | I2C_SR1_ARLO))
+        {
+            Status = I2C_BUS_ERROR;
+            break;
+        }
+        if(status & flag)
+        {
+            Status = I2C_OK;
+            break;
+        }
+        if(TIMEBASE_deadlineCheck(deadline) == TIMEBASE_EXPIRED)
+        {
+            break;
+        }
+
+        /* A new event sets the pending bit again and generates an event */
+        NVIC_ClearPendingIRQ(eventIrq[Port]);
+        NVIC_ClearPendingIRQ(errorIrq[Port]);
+
+        if(((*statusRegister1[Port] & (flag | I2C_SR1_ERRORS)) == 0U) &&
+           (TIMEBASE_deadlineCheck(deadline) == TIMEBASE_PENDING))
+        {
+            IDLE_sleep();
+        }
+    }
+
+    *controlRegister2[Port] &= ~interrupts;
+    NVIC_ClearPendingIRQ(eventIrq[Port]);
+    NVIC_ClearPendingIRQ(errorIrq[Port]);
+    TIMEBASE_alarmClear();
+
+    return Status;
+}
+
+/*****************************************************************************
+ * Function: I2C_registerWait()
+ *//**
+    * \b Description:
+    * This function is used to poll the bits of a register without an
+    * interrupt (BUSY, STOP) until they reach a value or the deadline.
+    *
+    * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+    *
+    * POST-CONDITION: None. <br>
+    *
+    * @param[in]   address is the address of the register to check.
+    * @param[in]   mask is the mask of the bits to check.
+    * @param[in]   value is the awaited value of the masked bits.
+    * @param[in]   deadline is the timestamp where the wait is abandoned.
+    *
+    * @return I2C_OK if the bits reached the value, otherwise I2C_TIMEOUT.
+    *
+*****************************************************************************/
+static I2cStatus_t I2C_registerWait(uint32_t volatile * const address,
+const uint32_t mask, const uint32_t value, const uint32_t deadline)
+{
+    while((*address & mask) != value)
+    {
+        if(TIMEBASE_deadlineCheck(deadline) == TIMEBASE_EXPIRED)
+        {
+            return I2C_TIMEOUT;
+        }
+    }
+
+    return I2C_OK;
+}
+
+/*****************************************************************************
+ * Function: I2C_delay()
+ *//**
+    * \b Description:
+    * This function is used to wait for a time, e.g. a half period of SCL
+    * during the bus recovery.
+    *
+    * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+    *
+    * POST-CONDITION: The time has elapsed. <br>
+    *
+    * @param[in]   time is the time to wait in microseconds.
+    *
+    * @return void
+    *
+*****************************************************************************/
+static void I2C_delay(const uint32_t time)
+{
+    const uint32_t deadline = TIMEBASE_deadlineGet(time);
+
+    while(TIMEBASE_deadlineCheck(deadline) == TIMEBASE_PENDING)
+    {
+    }
+}
@@ -0,0 +1,134 @@
+/**
+ * @file i2c_cfg.c
+ * @author Jose Luis Figueroa
+ * @brief This module contains the implementation for the Inter-Integrated
+ * Circuit configuration.
+ * @version 1.1
+ * @date 2025-03-26
+ * 
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ * 
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "i2c_cfg.h"
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/**
+ * The following array contains the configuration data for each I2C 
+ * peripheral. Each row represent a single I2C peripheral. Each column is 
+ * representing a member of the I2cConfig_t structure. This table is read 
+ * in by I2C_init, where each peripheral is then set up based on this table.
+ * The port is enabled once its pins (DioConfig, open-drain on AF4) and its
+ * TX and RX streams (DmaConfig) are configured: I2C1 is served by DMA1 
+ * stream 6 or 7 (TX) and stream 0 or 5 (RX) on channel 1.
+ */
+const I2cConfig_t I2cConfig[] = 
+{
+/*                                                          
+ *  Port        Speed           Duty        I2C Enabler
+*/ 
+   {I2C_PORT_1, I2C_SPEED_FAST, I2C_DUTY_2, I2C_DISABLED},
+};
+
+/*****************************************************************************
+ * Function Prototypes
+*****************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: I2C_configGet()
+ */
+/**
+ * \b Description
+ * This function is used to initialize the I2C based on the configuration 
+ * table defined in i2c_cfg module.
+ * 
+ * PRE-CONDITION: The configuration table needs to be populated (sizeof > 0) <br>
+ * 
+ * POST-CONDITION: A constant pointer to the first member of the configuration
+ * table is returned. <br>
+ * 
+ * @return A pointer to the configuration table. <br>
+ * 
+ * \b Example:
+ * @code
+ * const I2cConfig_t * const I2cConfig = I2C_configGet();
+ * size_t configSize = I2C_configSizeGet();
+ * 
+ * I2C_init(I2cConfig, configSize, APB1_CLOCK);
+ * @endcode
+ * 
+ * @see I2C_configGet
+ * @see I2C_configSizeGet
+ * @see I2C_init
+ * @see I2C_transfer
+ * @see I2C_burstRead
+ * @see I2C_burstWrite
+ * @see I2C_busRecover
+ * @see I2C_registerWrite
+ * @see I2C_registerRead
+ * 
+*****************************************************************************/
+const I2cConfig_t * const I2C_configGet(void)
+{
+    /* The cast is performed to ensure that the address of the first element 
+     * of configuration table is returned as a constant pointer and not a
+     * pointer that can be modified
+    */
+    return (const I2cConfig_t *)&I2cConfig[0];
+}
+
+/*****************************************************************************
+ * Function: I2C_configSizeGet()
+*/
+/**
+*\b Description:
+ * This function is used to get the size of the configuration table.
+ * 
+ * PRE-CONDITION: configuration table needs to be populated (sizeof > 0) <br>
+ * 
+ * POST-CONDITION: The size of the configuration table will be returned. <br>
+ * 
+ * @return The size of the configuration table.
+ * 
+ * \b Example: 
+ * @code
+ * const I2cConfig_t * const I2cConfig = I2C_configGet();
+ * size_t configSize = I2C_configSizeGet();
+ * 
+ * I2C_init(I2cConfig, configSize, APB1_CLOCK);
+ * @endcode
+ * 
+ * @see I2C_configGet
+ * @see I2C_configSizeGet
+ * @see I2C_init
+ * @see I2C_transfer
+ * @see I2C_burstRead
+ * @see I2C_burstWrite
+ * @see I2C_busRecover
+ * @see I2C_registerWrite
+ * @see I2C_registerRead
+ * 
+*****************************************************************************/
+size_t I2C_configSizeGet(void)
+{
+   return sizeof(I2cConfig)/sizeof(I2cConfig[0]);
+}
@@ -0,0 +1,369 @@
+/**
+ * @file idle.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the event-driven idle. The cycle counter of
+ * the Data Watchpoint and Trace unit (DWT) is used to measure the time spent
+ * asleep.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "idle.h"       /*For this modules definitions*/
+#include "timebase.h"   /*For the deadlines of the bounded waits*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/* Defines the statistics since the last reset */
+static IdleStats_t IdleStats;
+
+/* Defines the value of the cycle counter when the elapsed cycles were last
+ * updated. The 32-bit counter wraps, so the elapsed cycles are accumulated
+ * on every sleep and every read of the statistics.
+*/
+static uint32_t lastCycle = 0U;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void IDLE_elapsedUpdate(void);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: IDLE_init()
+ *//**
+ * \b Description:
+ * This function is used to initialize the idle. The send event on pending
+ * bit (SEVONPEND) is set, so an interrupt that becomes pending wakes the
+ * processor from WFE even if it is disabled in the NVIC. The peripherals
+ * can then wake the processor by setting their interrupt enable bits only.
+ * The cycle counter of the DWT is started for the statistics.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: The processor can sleep with IDLE_sleep and IDLE_waitFor.
+ * <br>
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * IDLE_init();
+ * @endcode
+ *
+ * @see IDLE_init
+ * @see IDLE_sleep
+ * @see IDLE_waitFor
+ * @see IDLE_waitForDeadline
+ * @see IDLE_statsGet
+ * @see IDLE_statsReset
+ *
+*****************************************************************************/
+void IDLE_init(void)
+{
+    /* Wake up from WFE on every new pending interrupt */
+    SCB->SCR |= SCB_SCR_SEVONPEND_Msk;
+
+    /* Sleep mode is used, so the peripherals keep their clocks */
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+    /* Start the cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    IDLE_statsReset();
+}
+
+/*****************************************************************************
+ * Function: IDLE_sleep()
+ *//**
+ * \b Description:
+ * This function is used to put the processor in sleep mode until the next
+ * event. The event can be an interrupt that becomes pending, an enabled
+ * interrupt, or a SEV instruction. The function can return without sleeping
+ * if an event happened since the last sleep, so the caller must check its
+ * wake-up condition again after the function returns.
+ *
+ * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
+ *
+ * POST-CONDITION: The cycles spent asleep are added to the statistics. <br>
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * while(1)
+ * {
+ *     IDLE_sleep();
+ * }
+ * @endcode
+ *
+ * @see IDLE_init
+ * @see IDLE_sleep
+ * @see IDLE_waitFor
+ * @see IDLE_waitForDeadline
+ * @see IDLE_statsGet
+ * @see IDLE_statsReset
+ *
+*****************************************************************************/
+void IDLE_sleep(void)
+{
+    uint32_t start;
+
+    IDLE_elapsedUpdate();
+    start = DWT->CYCCNT;
+
+    /* Complete the outstanding memory accesses before sleeping */
+    __DSB();
+    __WFE();
+
+    IdleStats.idleCycles += (uint32_t)(DWT->CYCCNT - start);
+    IdleStats.sleeps++;
+}
+
+/*****************************************************************************
+ * Function: IDLE_waitFor()
+ *//**
+ * \b Description:
+ * This function is used to wait in sleep mode until the masked bits of a
+ * register reach a value. The processor is woken up by the interrupt of the
+ * peripheral, so the interrupt enable bit of the awaited event must be set
+ * before the call. The pending bit of the interrupt is cleared before the
+ * register is checked, so an event that happens between the check and the
+ * sleep still wakes the processor.
+ *
+ * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
+ * PRE-CONDITION: The peripheral interrupt of the event is enabled. <br>
+ * PRE-CONDITION: The interrupt is disabled in the NVIC, or its handler does
+ *                not clear the awaited condition. <br>
+ *
+ * POST-CONDITION: The masked bits of the register match the value. <br>
+ *
+ * @param[in]   address is the address of the register to check.
+ * @param[in]   mask is the mask of the bits to check.
+ * @param[in]   value is the awaited value of the masked bits.
+ * @param[in]   Irq is the interrupt that wakes up the processor.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * USART2->CR1 |= USART_CR1_RXNEIE;
+ * IDLE_waitFor(&USART2->SR, USART_SR_RXNE, USART_SR_RXNE, USART2_IRQn);
+ * USART2->CR1 &= ~USART_CR1_RXNEIE;
+ * @endcode
+ *
+ * @see IDLE_init
+ * @see IDLE_sleep
+ * @see IDLE_waitFor
+ * @see IDLE_waitForDeadline
+ * @see IDLE_statsGet
+ * @see IDLE_statsReset
+ *
+*****************************************************************************/
+void IDLE_waitFor(const volatile uint32_t * const address, uint32_t mask,
+uint32_t value, IRQn_Type Irq)
+{
+    while((*address & mask) != value)
+    {
+        /* A new event sets the pending bit again and generates an event */
+        NVIC_ClearPendingIRQ(Irq);
+
+        if((*address & mask) != value)
+        {
+            IDLE_sleep();
+        }
+    }
+
+    NVIC_ClearPendingIRQ(Irq);
+}
+
+/*****************************************************************************
+ * Function: IDLE_waitForDeadline()
+ *//**
+ * \b Description:
+ * This function is used to wait in sleep mode until the masked bits of a
+ * register reach a value or a deadline is reached, whichever comes first.
+ * The alarm of the timebase wakes up the processor on the deadline, so the
+ * processor sleeps as in IDLE_waitFor. The alarm is shared, so the bounded
+ * waits must not be nested (e.g. from an interrupt).
+ *
+ * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
+ * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+ * PRE-CONDITION: The peripheral interrupt of the event is enabled. <br>
+ *
+ * POST-CONDITION: The alarm of the timebase is disarmed. <br>
+ *
+ * @param[in]   address is the address of the register to check.
+ * @param[in]   mask is the mask of the bits to check.
+ * @param[in]   value is the awaited value of the masked bits.
+ * @param[in]   Irq is the interrupt that wakes up the processor.
+ * @param[in]   deadline is the timestamp where the wait is abandoned.
+ *
+ * @return IDLE_CONDITION_MET if the bits reached the value, otherwise
+ *         IDLE_TIMEOUT.
+ *
+ * \b Example:
+ * @code
+ * USART2->CR1 |= USART_CR1_RXNEIE;
+ * status = IDLE_waitForDeadline(&USART2->SR, USART_SR_RXNE, USART_SR_RXNE,
+ *                               USART2_IRQn, TIMEBASE_deadlineGet(1000U));
+ * USART2->CR1 &= ~USART_CR1_RXNEIE;
+ * @endcode
+ *
+ * @see IDLE_init
+ * @see IDLE_sleep
+ * @see IDLE_waitFor
+ * @see IDLE_waitForDeadline
+ * @see IDLE_statsGet
+ * @see IDLE_statsReset
+ *
+*****************************************************************************/
+IdleStatus_t IDLE_waitForDeadline(const volatile uint32_t * const address,
+uint32_t mask, uint32_t value, IRQn_Type Irq, uint32_t deadline)
+{
+    IdleStatus_t Status = IDLE_CONDITION_MET;
+
+    TIMEBASE_alarmSet(deadline);
+
+    while((*address & mask) != value)
+    {
+        if(TIMEBASE_deadlineCheck(deadline) == TIMEBASE_EXPIRED)
+        {
+            Status = IDLE_TIMEOUT;
+            break;
+        }
+
+        NVIC_ClearPendingIRQ(Irq);
+
+        /* The alarm is checked again, as it may have been missed when the
+         * deadline was already reached on arming.
+        */
+        if(((*address & mask) != value) &&
+           (TIMEBASE_deadlineCheck(deadline) == TIMEBASE_PENDING))
+        {
+            IDLE_sleep();
+        }
+    }
+
+    NVIC_ClearPendingIRQ(Irq);
+    TIMEBASE_alarmClear();
+
+    return Status;
+}
+
+/*****************************************************************************
+ * Function: IDLE_statsGet()
+ *//**
+ * \b Description:
+ * This function is used to read the idle statistics since the last reset.
+ * The statistics must be read at least once every 2^32 processor cycles
+ * (268 seconds at 16 MHz) when the processor does not sleep, so the
+ * elapsed cycles do not miss a wrap of the cycle counter.
+ *
+ * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
+ *
+ * POST-CONDITION: The statistics are copied to Stats. <br>
+ *
+ * @param[out]  Stats is the structure where the statistics are copied.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * IdleStats_t Stats;
+ * IDLE_statsGet(&Stats);
+ * uint32_t load = 100U - (uint32_t)((Stats.idleCycles * 100U) /
+ *                                   Stats.elapsedCycles);
+ * @endcode
+ *
+ * @see IDLE_init
+ * @see IDLE_sleep
+ * @see IDLE_waitFor
+ * @see IDLE_waitForDeadline
+ * @see IDLE_statsGet
+ * @see IDLE_statsReset
+ *
+*****************************************************************************/
+void IDLE_statsGet(IdleStats_t * const Stats)
+{
+    IDLE_elapsedUpdate();
+
+    *Stats = IdleStats;
+}
+
+/*****************************************************************************
+ * Function: IDLE_statsReset()
+ *//**
+ * \b Description:
+ * This function is used to reset the idle statistics, so the utilization of
+ * the next workload can be measured.
+ *
+ * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
+ *
+ * POST-CONDITION: The statistics are cleared. <br>
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * IDLE_statsReset();
+ * @endcode
+ *
+ * @see IDLE_init
+ * @see IDLE_sleep
+ * @see IDLE_waitFor
+ * @see IDLE_waitForDeadline
+ * @see IDLE_statsGet
+ * @see IDLE_statsReset
+ *
+*****************************************************************************/
+void IDLE_statsReset(void)
+{
+    IdleStats.idleCycles = 0U;
+    IdleStats.elapsedCycles = 0U;
+    IdleStats.sleeps = 0U;
+    lastCycle = DWT->CYCCNT;
+}
+
+/*****************************************************************************
+ * Function: IDLE_elapsedUpdate()
+ *//**
+ * \b Description:
+ * This function is used to add the cycles since the last update to the
+ * elapsed cycles.
+ *
+ * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
+ *
+ * POST-CONDITION: The elapsed cycles are up to date. <br>
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void IDLE_elapsedUpdate(void)
+{
+    const uint32_t cycle = DWT->CYCCNT;
+
+    IdleStats.elapsedCycles += (uint32_t)(cycle - lastCycle);
+    lastCycle = cycle;
+}
@@ -28,6 +28,9 @@
 #include "usart.h"
 #include "dio.h"
 #include "dma.h"
+#include "idle.h"
+#include "timebase.h"
+#include "pool.h"
 
 /*****************************************************************************
  * Preprocessor Constants
@@ -38,35 +41,59 @@
 /*****************************************************************************
  * Preprocessor variables
 ******************************************************************************/
-const char txBuffer[14] = "Hello World!\n";
-char rxBuffer;
+const char txMessage[14] = "Hello World!\n";
 
 int main(void)
-{   /*Enable clock access to GPIOA, USART2, and DMA1*/
+{   /*Enable clock access to GPIOA, USART2, DMA1, and TIM2*/
     RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;
     RCC->APB1ENR |= RCC_APB1ENR_USART2EN;
     RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+    RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
 
-    /*Get the address of the configuration table for DIO*/
-    const DioConfig_t * const DioConfig = DIO_configGet();
-    /*Get the size of the configuration table*/
-    size_t configSizeDio = DIO_configSizeGet();
-    /*Initialize the DIO pins according to the configuration table*/
-    DIO_init(DioConfig, configSizeDio);
+    /*Sleep instead of polling while waiting for the peripherals*/
+    IDLE_init();
 
-    /*Get the address of the configuration table for USART*/
-    const UsartConfig_t * const UsartConfig = USART_configGet();
-    /*Get the size of the configuration table*/
-    size_t configSizeUsart = USART_configSizeGet();
-    /*Initialize the USART peripheral according to the configuration table*/
-    USART_init(UsartConfig, configSizeUsart, APB1_CLOCK);
+    /*Start the microsecond timebase (APB1 prescaler 1: TIM2 at APB1 clock)*/
+    TIMEBASE_init(APB1_CLOCK);
+
+    /*Get the register images generated from the DIO configuration table*/
+    const DioPortImage_t * const DioImage = DIO_imageGet();
+    /*Get the size of the image table*/
+    size_t imageSizeDio = DIO_imageSizeGet();
+    /*Initialize the DIO pins with the register images*/
+    DIO_imageInit(DioImage, imageSizeDio);
 
-    /*Get the address of the configuration table for DMA*/
-    const DmaConfig_t * const DmaConfig = DMA_configGet();
+    /*Get the register images generated from the USART configuration table
+     *(the baud rate register is computed for the APB1 clock of board.json)
+    */
+    const UsartPortImage_t * const UsartImage = USART_imageGet();
+    /*Get the size of the image table*/
+    size_t imageSizeUsart = USART_imageSizeGet();
+    /*Initialize the USART peripheral with the register images*/
+    USART_imageInit(UsartImage, imageSizeUsart);
+
+    /*Get the address of the configuration table for the DMA buffer pool*/
+    const PoolConfig_t * const PoolConfig = POOL_configGet();
     /*Get the size of the configuration table*/
-    size_t configSizeDma = DMA_configSizeGet();
-    /*Initialize the DMA peripheral according to the configuration table*/
-    DMA_init(DmaConfig, configSizeDma);
+    size_t configSizePool = POOL_configSizeGet();
+    /*Build the DMA buffer pool according to the configuration table*/
+    POOL_init(PoolConfig, configSizePool);
+
+    /*Take the DMA buffers from the pool (aligned for word bursts)*/
+    char * const txBuffer = POOL_alloc(sizeof(txMessage));
+    char * const rxBuffer = POOL_alloc(sizeof(char));
+    assert((txBuffer != NULL) && (rxBuffer != NULL));
+    for(uint8_t i=0; i<sizeof(txMessage); i++)
+    {
+        txBuffer[i] = txMessage[i];
+    }
+
+    /*Get the register images generated from the DMA configuration table*/
+    const DmaStreamImage_t * const DmaImage = DMA_imageGet();
+    /*Get the size of the image table*/
+    size_t imageSizeDma = DMA_imageSizeGet();
+    /*Initialize the DMA streams with the register images*/
+    DMA_imageInit(DmaImage, imageSizeDma);
 
     /*Configure the DMA peripheral for a transfer to memory*/
     DmaTransferConfig_t DmaTxConfig =
@@ -74,7 +101,7 @@ int main(void)
         .Stream = DMA1_STREAM_6,
         .peripheral = (uint32_t*)&USART2->DR,
         .memory = (uint32_t*)&txBuffer[0],
-        .length = sizeof(txBuffer)/sizeof(txBuffer[0])
+        .length = sizeof(txMessage)/sizeof(txMessage[0])
     };
 
     /*Configure the DMA peripheral for receiving data from memory*/
@@ -82,19 +109,24 @@ int main(void)
     {
         .Stream = DMA1_STREAM_5,
         .peripheral = (uint32_t*)&USART2->DR,
-        .memory = (uint32_t*)&rxBuffer,
-        .length = sizeof(rxBuffer)/sizeof(rxBuffer)
+        .memory = (uint32_t*)&rxBuffer[0],
+        .length = sizeof(char)
     };
 
+    /*The buffers belong to the DMA until the transfers are completed*/
+    POOL_ownerSet(txBuffer, POOL_OWNER_DMA);
+    POOL_ownerSet(rxBuffer, POOL_OWNER_DMA);
+
     /*Configure the DMA peripheral (USART_TX) for a transfer to memory*/
     DMA_transferConfig(&DmaTxConfig);
 
     /*Configure the DMA peripheral (USART_RX) for receiving data from memory*/
     DMA_transferConfig(&DmaRxConfig);
 
+    /*The transfers are done by the DMA, so the processor sleeps*/
     while(1)
     {
-        asm("nop");
+        IDLE_sleep();
     }
     
     return 0;
@@ -0,0 +1,564 @@
+/**
+ * @file pipe.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the ADC to USART streaming pipeline. The
+ * ADC stream runs in double-buffer mode over two pool blocks; when it
+ * leaves a block, the block is replaced by a free one, framed where the
+ * samples are (the header space before them, the CRC after them) and
+ * queued for the TX stream, which sends it from the same memory. The
+ * transfer complete interrupt of the TX stream gives the block back to the
+ * pool and sends the next frame.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "pipe.h"       /*For this modules definitions*/
+#include "pool.h"       /*For the blocks of the frames*/
+#include "timebase.h"   /*For the latency*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the maximum number of samples of a frame (samples field of the
+ * header).
+*/
+#define PIPE_SAMPLES_MAX 0xFFFEUL
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+/**
+ * Defines a frame waiting for, or on, the TX stream.
+*/
+typedef struct
+{
+    uint8_t *frame;             /**< Block of the frame */
+    uint32_t timestamp;         /**< End of its ADC buffer (us) */
+}PipeEntry_t;
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/* Defines a array of pointers to the USART data register */
+static uint32_t volatile * const dataRegister[USART_PORTS_NUMBER] =
+{
+    (uint32_t*)&USART1->DR, (uint32_t*)&USART2->DR, (uint32_t*)&USART6->DR
+};
+
+/* Defines the pipeline being run (NULL when idle)*/
+static const PipeConfig_t * pipeConfig = NULL;
+
+/* Defines the acquisition of the pipeline, with its blocks and callback */
+static AdcAcquisitionConfig_t pipeAcquisition;
+
+/* Defines the blocks on the memory 0 and 1 of the ADC stream */
+static uint8_t * adcBlocks[2] = {NULL, NULL};
+
+/* Defines the frames waiting for the TX stream, and the frame on it. The
+ * indexes only grow; the queue holds head - tail frames.
+*/
+static PipeEntry_t queue[PIPE_QUEUE_SIZE];
+static uint32_t queueHead = 0U;
+static uint32_t queueTail = 0U;
+static PipeEntry_t txEntry = {NULL, 0U};
+
+/* Defines the sequence number of the next frame, and the frames dropped
+ * since the last frame
+*/
+static uint16_t sequence = 0U;
+static uint16_t droppedSince = 0U;
+
+/* Defines the statistics of the pipeline */
+static PipeStats_t PipeStats;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void PIPE_samplesReady(const uint16_t * const data, uint32_t count);
+static void PIPE_frameBuild(uint8_t * const frame, const uint32_t samples);
+static void PIPE_transmitNext(void);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: PIPE_start()
+*//**
+ *\b Description:
+ * This function is used to stream an acquisition on a serial line. Two
+ * blocks of PIPE_FRAME_SIZE(samples) bytes are taken from the pool for the
+ * ADC, and one more for each full buffer; the frames are sent back to back
+ * by the TX stream. When the pool or the queue has no room, the full buffer
+ * is dropped and the ADC fills it again, so the acquisition never stops;
+ * the next frame tells how many were dropped. Any pipeline being run is
+ * stopped first; it stays stopped when the new one cannot be started.
+ *
+ * PRE-CONDITION: As for ADC_start, without the buffer conditions. <br>
+ * PRE-CONDITION: The pool has a class of PIPE_FRAME_SIZE(samples) bytes
+ *                or more with three blocks or more (POOL_init), e.g. 250
+ *                samples or less for the blocks of 512 bytes. <br>
+ * PRE-CONDITION: The USART is initialized with its TX DMA enabled, and the
+ *                TX stream in normal mode with 8-bit data (DMA_init). <br>
+ * PRE-CONDITION: The clock of the CRC unit is enabled. <br>
+ * PRE-CONDITION: The interrupts of both streams are enabled in the NVIC
+ *                with the same priority; their handlers call ADC_irqHandler
+ *                and PIPE_txIrqHandler. <br>
+ * PRE-CONDITION: Config stays valid until PIPE_stop. <br>
+ *
+ * POST-CONDITION: The acquisition is being streamed if PIPE_OK is
+ *                 returned. <br>
+ *
+ * @param[in]   Config is a pointer to the pipeline to run.
+ *
+ * @return PIPE_OK, PIPE_INVALID_SAMPLES if samples is zero, odd or above
+ *         the samples field of the header, or PIPE_NO_BLOCK if the pool
+ *         has no two blocks of PIPE_FRAME_SIZE(samples) bytes.
+ *
+ * \b Example:
+ * @code
+ * static const AdcChannel_t Sequence[2] = {ADC_CHANNEL_0, ADC_CHANNEL_1};
+ * static const AdcAcquisitionConfig_t Acquisition =
+ * {
+ *      .Channels = Sequence,
+ *      .channelCount = 2U,
+ *      .SampleTime = ADC_SAMPLE_TIME_84,
+ *      .Prescaler = ADC_PRESCALER_DIV_4,
+ *      .Trigger = ADC_TRIGGER_TIMER,
+ *      .scanPeriod = 16000000U / 2000U,
+ *      .Stream = DMA2_STREAM_0
+ * };
+ * static const PipeConfig_t Pipe =
+ * {
+ *      .Acquisition = &Acquisition,
+ *      .samples = 250U,
+ *      .Port = USART_PORT_2,
+ *      .TxStream = DMA1_STREAM_6,
+ *      .baud = 115200U,
+ *      .characterBits = 10U
+ * };
+ *
+ * void DMA2_Stream0_IRQHandler(void)
+ * {
+ *      ADC_irqHandler();
+ * }
+ *
+ * void DMA1_Stream6_IRQHandler(void)
+ * {
+ *      PIPE_txIrqHandler();
+ * }
+ *
+ * if(PIPE_start(&Pipe) != PIPE_OK)
+ * {
+ *      //The frames do not fit the blocks of the pool
+ * }
+ * @endcode
+ *
+ * @see PIPE_start
+ * @see PIPE_stop
+ * @see PIPE_txIrqHandler
+ * @see PIPE_statsGet
+ * @see PIPE_rateMaxGet
+ *
+*****************************************************************************/
+PipeStatus_t PIPE_start(const PipeConfig_t * const Config)
+{
+    const uint32_t frameSize = PIPE_FRAME_SIZE(Config->samples);
+
+    /* Prevent to assign a value out of the range of the settings */
+    assert(Config->Acquisition != NULL);
+    assert(Config->Port < USART_PORT_MAX);
+    assert(Config->TxStream < DMA_STREAM_MAX);
+    assert((Config->baud > 0U) && (Config->characterBits > 0U));
+
+    /* Release the blocks and the streams of a previous pipeline */
+    PIPE_stop();
+
+    if((Config->samples == 0U) || (Config->samples > PIPE_SAMPLES_MAX) ||
+       ((Config->samples % 2U) != 0U))
+    {
+        return PIPE_INVALID_SAMPLES;
+    }
+
+    /* A frame larger than the largest class of the pool gets no block */
+    adcBlocks[0] = POOL_alloc(frameSize);
+    adcBlocks[1] = POOL_alloc(frameSize);
+    if((adcBlocks[0] == NULL) || (adcBlocks[1] == NULL))
+    {
+        if(adcBlocks[0] != NULL)
+        {
+            POOL_free(adcBlocks[0]);
+        }
+        if(adcBlocks[1] != NULL)
+        {
+            POOL_free(adcBlocks[1]);
+        }
+        adcBlocks[0] = NULL;
+        adcBlocks[1] = NULL;
+
+        return PIPE_NO_BLOCK;
+    }
+    POOL_ownerSet(adcBlocks[0], POOL_OWNER_DMA);
+    POOL_ownerSet(adcBlocks[1], POOL_OWNER_DMA);
+
+    queueHead = 0U;
+    queueTail = 0U;
+    txEntry.frame = NULL;
+    sequence = 0U;
+    droppedSince = 0U;
+    PipeStats = (PipeStats_t){0U, 0U, 0U, 0U, 0U};
+    pipeConfig = Config;
+
+    DMA_interruptEnable(Config->TxStream, DMA_INTERRUPT_TRANSFER_COMPLETE);
+
+    /* The samples are placed after the header space of each block */
+    pipeAcquisition = *Config->Acquisition;
+    pipeAcquisition.buffer = (uint16_t*)(adcBlocks[0] + PIPE_HEADER_SIZE);
+    pipeAcquisition.buffer2 = (uint16_t*)(adcBlocks[1] + PIPE_HEADER_SIZE);
+    pipeAcquisition.length = Config->samples;
+    pipeAcquisition.Decimation = NULL;
+    pipeAcquisition.output = NULL;
+    pipeAcquisition.Callback = PIPE_samplesReady;
+    ADC_start(&pipeAcquisition);
+
+    return PIPE_OK;
+}
+
+/*****************************************************************************
+ * Function: PIPE_stop()
+*//**
+ *\b Description:
+ * This function is used to stop the pipeline. The acquisition and the TX
+ * stream are stopped, and every block is given back to the pool, including
+ * the frames that were not sent.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: The pipeline is idle and its blocks are free. <br>
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * PIPE_stop();
+ * @endcode
+ *
+ * @see PIPE_start
+ * @see PIPE_stop
+ * @see PIPE_txIrqHandler
+ * @see PIPE_statsGet
+ * @see PIPE_rateMaxGet
+ *
+*****************************************************************************/
+void PIPE_stop(void)
+{
+    const PipeConfig_t * Config = pipeConfig;
+
+    if(Config == NULL)
+    {
+        return;
+    }
+
+    ADC_stop();
+    DMA_interruptDisable(Config->TxStream, DMA_INTERRUPT_TRANSFER_COMPLETE);
+    DMA_transferStop(Config->TxStream);
+    pipeConfig = NULL;
+
+    if(txEntry.frame != NULL)
+    {
+        POOL_free(txEntry.frame);
+        txEntry.frame = NULL;
+    }
+
+    for(; queueTail != queueHead; queueTail++)
+    {
+        POOL_free(queue[queueTail % PIPE_QUEUE_SIZE].frame);
+    }
+
+    POOL_free(adcBlocks[0]);
+    POOL_free(adcBlocks[1]);
+    adcBlocks[0] = NULL;
+    adcBlocks[1] = NULL;
+}
+
+/*****************************************************************************
+ * Function: PIPE_txIrqHandler()
+*//**
+ *\b Description:
+ * This function is used to service the interrupt of the TX stream. It must
+ * be called from the interrupt handler of the stream. At the end of a
+ * frame, its latency is recorded, its block is given back to the pool and
+ * the next frame of the queue is sent.
+ *
+ * PRE-CONDITION: The pipeline was started (PIPE_start). <br>
+ *
+ * POST-CONDITION: The next frame is being sent, if any. <br>
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * void DMA1_Stream6_IRQHandler(void)
+ * {
+ *      PIPE_txIrqHandler();
+ * }
+ * @endcode
+ *
+ * @see PIPE_start
+ * @see PIPE_stop
+ * @see PIPE_txIrqHandler
+ * @see PIPE_statsGet
+ * @see PIPE_rateMaxGet
+ *
+*****************************************************************************/
+void PIPE_txIrqHandler(void)
+{
+    const PipeConfig_t * Config = pipeConfig;
+    uint32_t latency;
+
+    if(Config == NULL)
+    {
+        return;
+    }
+
+    if(DMA_eventClear(Config->TxStream, DMA_INTERRUPT_TRANSFER_COMPLETE) &&
+       (txEntry.frame != NULL))
+    {
+        latency = TIMEBASE_now() - txEntry.timestamp;
+        PipeStats.frames++;
+        PipeStats.latency = latency;
+        if(latency > PipeStats.latencyMax)
+        {
+            PipeStats.latencyMax = latency;
+        }
+
+        POOL_free(txEntry.frame);
+        txEntry.frame = NULL;
+        PIPE_transmitNext();
+    }
+}
+
+/*****************************************************************************
+ * Function: PIPE_statsGet()
+*//**
+ *\b Description:
+ * This function is used to get the statistics of the pipeline since it was
+ * started.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: Stats holds the statistics. <br>
+ *
+ * @param[out]  Stats is a pointer to the statistics.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * PipeStats_t Stats;
+ *
+ * PIPE_statsGet(&Stats);
+ * @endcode
+ *
+ * @see PIPE_start
+ * @see PIPE_stop
+ * @see PIPE_txIrqHandler
+ * @see PIPE_statsGet
+ * @see PIPE_rateMaxGet
+ *
+*****************************************************************************/
+void PIPE_statsGet(PipeStats_t * const Stats)
+{
+    *Stats = PipeStats;
+}
+
+/*****************************************************************************
+ * Function: PIPE_rateMaxGet()
+*//**
+ *\b Description:
+ * This function is used to get the maximum sample rate that the serial line
+ * sustains: the characters of a frame (samples, header and CRC) must leave
+ * the line before the next buffer is full. Above that rate the queue grows
+ * until frames are dropped.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   Config is a pointer to the pipeline.
+ *
+ * @return The maximum sample rate in samples per second (all the channels
+ *         of the sequence).
+ *
+ * \b Example:
+ * @code
+ * //115200 baud 8N1, 250 samples (512 bytes) per frame: 5625 samples/s
+ * uint32_t rate = PIPE_rateMaxGet(&Pipe);
+ * @endcode
+ *
+ * @see PIPE_start
+ * @see PIPE_stop
+ * @see PIPE_txIrqHandler
+ * @see PIPE_statsGet
+ * @see PIPE_rateMaxGet
+ *
+*****************************************************************************/
+uint32_t PIPE_rateMaxGet(const PipeConfig_t * const Config)
+{
+    /* Prevent to divide by zero */
+    assert((Config->samples > 0U) && (Config->characterBits > 0U));
+
+    return (uint32_t)(((uint64_t)Config->baud * Config->samples) /
+        ((uint64_t)Config->characterBits * PIPE_FRAME_SIZE(Config->samples)));
+}
+
+/*****************************************************************************
+ * Function: PIPE_samplesReady()
+*//**
+ *\b Description:
+ * This function is called by the acquisition with each full buffer. A free
+ * block takes the place of the buffer on the ADC stream first, as the
+ * stream needs it at the end of the current buffer; the buffer is then
+ * framed and queued. Without a free block or room on the queue, the buffer
+ * stays on the stream and is filled again.
+ *
+ * PRE-CONDITION: The pipeline was started (PIPE_start). <br>
+ *
+ * POST-CONDITION: The frame is queued or dropped. <br>
+ *
+ * @param[in]   data is the first sample of the buffer.
+ * @param[in]   count is the number of samples.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void PIPE_samplesReady(const uint16_t * const data, uint32_t count)
+{
+    const uint32_t timestamp = TIMEBASE_now();
+    uint8_t * const frame = (uint8_t*)data - PIPE_HEADER_SIZE;
+    uint8_t * next = NULL;
+    uint32_t queued;
+
+    if((queueHead - queueTail) < PIPE_QUEUE_SIZE)
+    {
+        next = POOL_alloc(PIPE_FRAME_SIZE(count));
+    }
+
+    if(next == NULL)
+    {
+        PipeStats.dropped++;
+        if(droppedSince < UINT16_MAX)
+        {
+            droppedSince++;
+        }
+        return;
+    }
+
+    POOL_ownerSet(next, POOL_OWNER_DMA);
+    ADC_bufferNextSet((uint16_t*)(next + PIPE_HEADER_SIZE));
+    adcBlocks[(frame == adcBlocks[0]) ? 0U : 1U] = next;
+
+    POOL_ownerSet(frame, POOL_OWNER_CPU);
+    PIPE_frameBuild(frame, count);
+
+    queue[queueHead % PIPE_QUEUE_SIZE].frame = frame;
+    queue[queueHead % PIPE_QUEUE_SIZE].timestamp = timestamp;
+    queueHead++;
+
+    queued = queueHead - queueTail;
+    if(queued > PipeStats.queuedMax)
+    {
+        PipeStats.queuedMax = queued;
+    }
+
+    if(txEntry.frame == NULL)
+    {
+        PIPE_transmitNext();
+    }
+}
+
+/*****************************************************************************
+ * Function: PIPE_frameBuild()
+*//**
+ *\b Description:
+ * This function is used to frame the samples of a block in place: the
+ * header is written before them and the CRC-32 of the header and the
+ * samples after them. The CRC unit takes a 32-bit word per write, so the
+ * samples are only read once.
+ *
+ * PRE-CONDITION: The clock of the CRC unit is enabled. <br>
+ * PRE-CONDITION: samples is even, so the trailer is aligned. <br>
+ *
+ * POST-CONDITION: The block holds a frame. <br>
+ *
+ * @param[in]   frame is the block of the frame.
+ * @param[in]   samples is the number of samples.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void PIPE_frameBuild(uint8_t * const frame, const uint32_t samples)
+{
+    PipeHeader_t * const Header = (PipeHeader_t*)frame;
+    const uint32_t * const words = (const uint32_t*)frame;
+    const uint32_t wordCount = (PIPE_HEADER_SIZE + (2U * samples)) / 4U;
+
+    Header->sync = PIPE_SYNC;
+    Header->sequence = sequence++;
+    Header->samples = (uint16_t)samples;
+    Header->dropped = droppedSince;
+    droppedSince = 0U;
+
+    CRC->CR = CRC_CR_RESET;
+    for(uint32_t i=0; i<wordCount; i++)
+    {
+        CRC->DR = words[i];
+    }
+    *(uint32_t*)&frame[wordCount * 4U] = CRC->DR;
+}
+
+/*****************************************************************************
+ * Function: PIPE_transmitNext()
+*//**
+ *\b Description:
+ * This function is used to send the oldest frame of the queue on the TX
+ * stream, from the block where it was acquired.
+ *
+ * PRE-CONDITION: The TX stream is idle. <br>
+ *
+ * POST-CONDITION: The frame is being sent, if the queue was not empty. <br>
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void PIPE_transmitNext(void)
+{
+    const PipeConfig_t * Config = pipeConfig;
+
+    if(queueTail == queueHead)
+    {
+        return;
+    }
+
+    txEntry = queue[queueTail % PIPE_QUEUE_SIZE];
+    queueTail++;
+    POOL_ownerSet(txEntry.frame, POOL_OWNER_DMA);
+
+    DmaTransferConfig_t DmaTransferConfig =
+    {
+        .Stream = Config->TxStream,
+        .peripheral = dataRegister[Config->Port],
+        .memory = (uint32_t*)txEntry.frame,
+        .length = PIPE_FRAME_SIZE(Config->samples)
+    };
+    DMA_transferConfig(&DmaTransferConfig);
+}
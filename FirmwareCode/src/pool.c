@@ -0,0 +1,504 @@
+/**
+ * @file pool.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the DMA buffer pool. The free blocks of each
+ * size class form a linked list whose links are stored in the free blocks
+ * themselves. The head of the list holds the index of the first free block
+ * and a tag that changes on every update, and it is updated with a
+ * compare-and-swap (LDREX/STREX on the Cortex-M4). The tag prevents the ABA
+ * problem: a head read before an interrupt allocated and released blocks no
+ * longer matches, so the update is retried.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include <stdatomic.h>
+#include "pool.h"       /*For this modules definitions*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the index of the end of a free list.
+*/
+#define POOL_LIST_END 0xFFFFU
+
+/**
+ * Defines the mask of the block index in the head of a free list.
+*/
+#define POOL_INDEX_MASK 0x0000FFFFUL
+
+/**
+ * Defines the increment of the tag in the head of a free list.
+*/
+#define POOL_TAG_INCREMENT 0x00010000UL
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/* Defines the configuration table of the pool */
+static const PoolConfig_t * poolConfig = NULL;
+static size_t poolClasses = 0U;
+
+/* Defines the head of the free list of each class (tag:index) */
+static atomic_uint_least32_t freeHead[POOL_CLASSES_NUMBER];
+
+/* Defines the statistics of each class */
+static atomic_uint_least32_t usedBlocks[POOL_CLASSES_NUMBER];
+static atomic_uint_least32_t peakBlocks[POOL_CLASSES_NUMBER];
+static atomic_uint_least32_t requestedBytes[POOL_CLASSES_NUMBER];
+static atomic_uint_least32_t allocFailures[POOL_CLASSES_NUMBER];
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static uint8_t POOL_blockLocate(const void * const block,
+uint16_t * const index);
+static volatile uint16_t * POOL_link(const uint8_t sizeClass,
+const uint16_t index);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: POOL_init()
+ *//**
+ * \b Description:
+ * This function is used to build the pool based on the configuration table
+ * defined in the pool_cfg module. All the blocks of each class are linked
+ * in its free list.
+ *
+ * PRE-CONDITION: Configuration table needs to be populated (sizeof>0) <br>
+ * PRE-CONDITION: configSize <= POOL_CLASSES_NUMBER. <br>
+ * PRE-CONDITION: The block sizes are multiples of POOL_ALIGNMENT and are
+ *                sorted from the smallest to the largest. <br>
+ * PRE-CONDITION: No block is in use. <br>
+ *
+ * POST-CONDITION: All the blocks are free and the statistics are cleared.
+ * <br>
+ *
+ * @param[in]   Config is a pointer to the configuration table of the pool.
+ * @param[in]   configSize is the size of the configuration table.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * const PoolConfig_t * const PoolConfig = POOL_configGet();
+ * size_t configSize = POOL_configSizeGet();
+ *
+ * POOL_init(PoolConfig, configSize);
+ * @endcode
+ *
+ * @see POOL_configGet
+ * @see POOL_configSizeGet
+ * @see POOL_init
+ * @see POOL_alloc
+ * @see POOL_free
+ * @see POOL_ownerSet
+ * @see POOL_ownerGet
+ * @see POOL_statsGet
+ *
+*****************************************************************************/
+void POOL_init(const PoolConfig_t * const Config, size_t configSize)
+{
+    /*Review if the table fits the pool*/
+    assert(configSize <= POOL_CLASSES_NUMBER);
+
+    poolConfig = Config;
+    poolClasses = configSize;
+
+    for(uint8_t i=0; i<configSize; i++)
+    {
+        /*Review if the blocks are aligned and can be indexed*/
+        assert(((uintptr_t)Config[i].storage % POOL_ALIGNMENT) == 0U);
+        assert((Config[i].blockSize % POOL_ALIGNMENT) == 0U);
+        assert(Config[i].blockCount < POOL_LIST_END);
+        assert((i == 0U) || (Config[i-1U].blockSize < Config[i].blockSize));
+
+        /* Link every block to the next one */
+        for(uint16_t j=0; j<Config[i].blockCount; j++)
+        {
+            *POOL_link(i, j) = ((j + 1U) < Config[i].blockCount) ?
+                (uint16_t)(j + 1U) : POOL_LIST_END;
+            Config[i].Blocks[j].Owner = POOL_OWNER_FREE;
+            Config[i].Blocks[j].requested = 0U;
+        }
+
+        atomic_store(&freeHead[i], (Config[i].blockCount > 0U) ?
+            0UL : POOL_LIST_END);
+        atomic_store(&usedBlocks[i], 0UL);
+        atomic_store(&peakBlocks[i], 0UL);
+        atomic_store(&requestedBytes[i], 0UL);
+        atomic_store(&allocFailures[i], 0UL);
+    }
+}
+
+/*****************************************************************************
+ * Function: POOL_alloc()
+ *//**
+ * \b Description:
+ * This function is used to allocate a block of at least size bytes. The
+ * block is taken from the smallest class that fits the size; if that class
+ * is exhausted, the next larger class is used. The time of the call does
+ * not depend on the number of blocks, and it can be called from interrupts.
+ *
+ * PRE-CONDITION: The pool must be initialized (POOL_init). <br>
+ *
+ * POST-CONDITION: The block is owned by the software. <br>
+ *
+ * @param[in]   size is the number of bytes needed.
+ *
+ * @return A pointer to the block aligned to POOL_ALIGNMENT, or NULL if no
+ *         class can provide it.
+ *
+ * \b Example:
+ * @code
+ * uint8_t * const txBuffer = POOL_alloc(64U);
+ * @endcode
+ *
+ * @see POOL_configGet
+ * @see POOL_configSizeGet
+ * @see POOL_init
+ * @see POOL_alloc
+ * @see POOL_free
+ * @see POOL_ownerSet
+ * @see POOL_ownerGet
+ * @see POOL_statsGet
+ *
+*****************************************************************************/
+void * POOL_alloc(const size_t size)
+{
+    uint32_t head;
+    uint32_t next;
+    uint32_t used;
+    uint32_t peak;
+    uint16_t index;
+    uint8_t fit = POOL_CLASSES_NUMBER;
+
+    for(uint8_t i=0; i<poolClasses; i++)
+    {
+        if(size > poolConfig[i].blockSize)
+        {
+            continue;
+        }
+
+        if(fit == POOL_CLASSES_NUMBER)
+        {
+            fit = i;
+        }
+
+        /* Take the first block of the free list. The link of the block may
+         * be overwritten by another user that took it first, but then the
+         * tag of the head changed and the exchange fails.
+        */
+        head = atomic_load(&freeHead[i]);
+        do
+        {
+            index = (uint16_t)(head & POOL_INDEX_MASK);
+            if(index == POOL_LIST_END)
+            {
+                break;
+            }
+            next = ((head & ~POOL_INDEX_MASK) + POOL_TAG_INCREMENT) |
+                *POOL_link(i, index);
+        }while(!atomic_compare_exchange_weak(&freeHead[i], &head, next));
+
+        if(index != POOL_LIST_END)
+        {
+            poolConfig[i].Blocks[index].Owner = POOL_OWNER_CPU;
+            poolConfig[i].Blocks[index].requested = (uint16_t)size;
+
+            atomic_fetch_add(&requestedBytes[i], (uint32_t)size);
+            used = atomic_fetch_add(&usedBlocks[i], 1UL) + 1UL;
+            peak = atomic_load(&peakBlocks[i]);
+            while((used > peak) &&
+                  !atomic_compare_exchange_weak(&peakBlocks[i], &peak, used))
+            {
+            }
+
+            return &poolConfig[i].storage[index * poolConfig[i].blockSize];
+        }
+    }
+
+    /* The failure is counted on the class that fits the size */
+    if(fit != POOL_CLASSES_NUMBER)
+    {
+        atomic_fetch_add(&allocFailures[fit], 1UL);
+    }
+
+    return NULL;
+}
+
+/*****************************************************************************
+ * Function: POOL_free()
+ *//**
+ * \b Description:
+ * This function is used to give a block back to the pool. The block is put
+ * at the head of the free list of its class. The time of the call does not
+ * depend on the number of blocks, and it can be called from interrupts.
+ *
+ * PRE-CONDITION: The block was allocated by POOL_alloc. <br>
+ * PRE-CONDITION: The block is owned by the software (not by the DMA). <br>
+ *
+ * POST-CONDITION: The block is free. <br>
+ *
+ * @param[in]   block is the block to release.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * POOL_free(txBuffer);
+ * @endcode
+ *
+ * @see POOL_configGet
+ * @see POOL_configSizeGet
+ * @see POOL_init
+ * @see POOL_alloc
+ * @see POOL_free
+ * @see POOL_ownerSet
+ * @see POOL_ownerGet
+ * @see POOL_statsGet
+ *
+*****************************************************************************/
+void POOL_free(void * const block)
+{
+    uint32_t head;
+    uint16_t index = 0U;
+    const uint8_t sizeClass = POOL_blockLocate(block, &index);
+
+    /*Review if the block belongs to the pool and is owned by the software*/
+    assert(sizeClass < poolClasses);
+    assert(poolConfig[sizeClass].Blocks[index].Owner == POOL_OWNER_CPU);
+
+    atomic_fetch_sub(&requestedBytes[sizeClass],
+        poolConfig[sizeClass].Blocks[index].requested);
+    atomic_fetch_sub(&usedBlocks[sizeClass], 1UL);
+    poolConfig[sizeClass].Blocks[index].Owner = POOL_OWNER_FREE;
+
+    /* Put the block at the head of the free list */
+    head = atomic_load(&freeHead[sizeClass]);
+    do
+    {
+        *POOL_link(sizeClass, index) = (uint16_t)(head & POOL_INDEX_MASK);
+    }while(!atomic_compare_exchange_weak(&freeHead[sizeClass], &head,
+        ((head & ~POOL_INDEX_MASK) + POOL_TAG_INCREMENT) | index));
+}
+
+/*****************************************************************************
+ * Function: POOL_ownerSet()
+ *//**
+ * \b Description:
+ * This function is used to hand a block over between the software and the
+ * DMA. Before a block is handed to the DMA, a memory barrier completes the
+ * writes of the software, so the transfer started next reads the final
+ * data. After a block is handed back to the software, the barrier keeps the
+ * reads of the software after the end of the transfer.
+ *
+ * PRE-CONDITION: The block was allocated by POOL_alloc. <br>
+ * PRE-CONDITION: Owner is POOL_OWNER_CPU or POOL_OWNER_DMA. <br>
+ *
+ * POST-CONDITION: The block is owned by Owner. <br>
+ *
+ * @param[in]   block is the block to hand over.
+ * @param[in]   Owner is the new owner of the block.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * POOL_ownerSet(txBuffer, POOL_OWNER_DMA);
+ * DMA_transferConfig(&DmaTxConfig);
+ * DMA_transferWait(DMA1_STREAM_6);
+ * POOL_ownerSet(txBuffer, POOL_OWNER_CPU);
+ * POOL_free(txBuffer);
+ * @endcode
+ *
+ * @see POOL_configGet
+ * @see POOL_configSizeGet
+ * @see POOL_init
+ * @see POOL_alloc
+ * @see POOL_free
+ * @see POOL_ownerSet
+ * @see POOL_ownerGet
+ * @see POOL_statsGet
+ *
+*****************************************************************************/
+void POOL_ownerSet(void * const block, const PoolOwner_t Owner)
+{
+    uint16_t index = 0U;
+    const uint8_t sizeClass = POOL_blockLocate(block, &index);
+
+    /*Review if the block is allocated and the owner is correct*/
+    assert(sizeClass < poolClasses);
+    assert((Owner == POOL_OWNER_CPU) || (Owner == POOL_OWNER_DMA));
+    assert(poolConfig[sizeClass].Blocks[index].Owner != POOL_OWNER_FREE);
+
+    __DMB();
+    poolConfig[sizeClass].Blocks[index].Owner = (uint8_t)Owner;
+    __DMB();
+}
+
+/*****************************************************************************
+ * Function: POOL_ownerGet()
+ *//**
+ * \b Description:
+ * This function is used to read the owner of a block.
+ *
+ * PRE-CONDITION: The block belongs to the pool. <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   block is the block to read.
+ *
+ * @return The owner of the block.
+ *
+ * \b Example:
+ * @code
+ * assert(POOL_ownerGet(rxBuffer) == POOL_OWNER_CPU);
+ * @endcode
+ *
+ * @see POOL_configGet
+ * @see POOL_configSizeGet
+ * @see POOL_init
+ * @see POOL_alloc
+ * @see POOL_free
+ * @see POOL_ownerSet
+ * @see POOL_ownerGet
+ * @see POOL_statsGet
+ *
+*****************************************************************************/
+PoolOwner_t POOL_ownerGet(const void * const block)
+{
+    uint16_t index = 0U;
+    const uint8_t sizeClass = POOL_blockLocate(block, &index);
+
+    /*Review if the block belongs to the pool*/
+    assert(sizeClass < poolClasses);
+
+    return (PoolOwner_t)poolConfig[sizeClass].Blocks[index].Owner;
+}
+
+/*****************************************************************************
+ * Function: POOL_statsGet()
+ *//**
+ * \b Description:
+ * This function is used to read the statistics of a size class. They are
+ * used to size the classes from the measured peak use instead of guessing.
+ *
+ * PRE-CONDITION: The pool must be initialized (POOL_init). <br>
+ * PRE-CONDITION: sizeClass is a row of the configuration table. <br>
+ *
+ * POST-CONDITION: The statistics are copied to Stats. <br>
+ *
+ * @param[in]   sizeClass is the row of the class in the configuration table.
+ * @param[out]  Stats is the structure where the statistics are copied.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * PoolStats_t Stats;
+ * POOL_statsGet(0U, &Stats);
+ * @endcode
+ *
+ * @see POOL_configGet
+ * @see POOL_configSizeGet
+ * @see POOL_init
+ * @see POOL_alloc
+ * @see POOL_free
+ * @see POOL_ownerSet
+ * @see POOL_ownerGet
+ * @see POOL_statsGet
+ *
+*****************************************************************************/
+void POOL_statsGet(const uint8_t sizeClass, PoolStats_t * const Stats)
+{
+    /*Review if the class is correct*/
+    assert(sizeClass < poolClasses);
+
+    Stats->blockSize = poolConfig[sizeClass].blockSize;
+    Stats->blockCount = poolConfig[sizeClass].blockCount;
+    Stats->used = atomic_load(&usedBlocks[sizeClass]);
+    Stats->peak = atomic_load(&peakBlocks[sizeClass]);
+    Stats->requestedBytes = atomic_load(&requestedBytes[sizeClass]);
+    Stats->failures = atomic_load(&allocFailures[sizeClass]);
+}
+
+/*****************************************************************************
+ * Function: POOL_blockLocate()
+ *//**
+ * \b Description:
+ * This function is used to find the class and the index of a block from
+ * its address.
+ *
+ * PRE-CONDITION: The pool must be initialized (POOL_init). <br>
+ *
+ * POST-CONDITION: index holds the block index if the block was found. <br>
+ *
+ * @param[in]   block is the address of the block.
+ * @param[out]  index is the index of the block within its class.
+ *
+ * @return The class of the block, or POOL_CLASSES_NUMBER if the address is
+ *         not the start of a block.
+ *
+*****************************************************************************/
+static uint8_t POOL_blockLocate(const void * const block,
+uint16_t * const index)
+{
+    const uint8_t * const address = (const uint8_t *)block;
+    uint32_t offset;
+
+    for(uint8_t i=0; i<poolClasses; i++)
+    {
+        offset = (uint32_t)(address - poolConfig[i].storage);
+        if((address >= poolConfig[i].storage) &&
+           (offset < ((uint32_t)poolConfig[i].blockSize *
+                      poolConfig[i].blockCount)) &&
+           ((offset % poolConfig[i].blockSize) == 0U))
+        {
+            *index = (uint16_t)(offset / poolConfig[i].blockSize);
+            return i;
+        }
+    }
+
+    return POOL_CLASSES_NUMBER;
+}
+
+/*****************************************************************************
+ * Function: POOL_link()
+ *//**
+ * \b Description:
+ * This function is used to get the link to the next free block, which is
+ * stored in the first bytes of a free block.
+ *
+ * PRE-CONDITION: The pool must be initialized (POOL_init). <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   sizeClass is the class of the block.
+ * @param[in]   index is the index of the block within its class.
+ *
+ * @return A pointer to the link of the block.
+ *
+*****************************************************************************/
+static volatile uint16_t * POOL_link(const uint8_t sizeClass,
+const uint16_t index)
+{
+    return (volatile uint16_t *)&poolConfig[sizeClass].storage[
+        (uint32_t)index * poolConfig[sizeClass].blockSize];
+}
@@ -0,0 +1,148 @@
+/**
+ * @file pool_cfg.c
+ * @author Jose Luis Figueroa
+ * @brief This module contains the implementation for the DMA buffer pool
+ * configuration.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+*/
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "pool_cfg.h"
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the number of blocks of each size class.
+*/
+#define POOL_SMALL_BLOCKS   16U
+#define POOL_MEDIUM_BLOCKS  8U
+#define POOL_LARGE_BLOCKS   4U
+
+/**
+ * Defines the size of the blocks of each size class in bytes.
+*/
+#define POOL_SMALL_SIZE     32U
+#define POOL_MEDIUM_SIZE    128U
+#define POOL_LARGE_SIZE     512U
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/* Defines the storage and the state of the blocks of each size class. */
+static uint8_t smallStorage[POOL_SMALL_BLOCKS][POOL_SMALL_SIZE]
+    __attribute__((aligned(POOL_ALIGNMENT)));
+static PoolBlock_t smallBlocks[POOL_SMALL_BLOCKS];
+
+static uint8_t mediumStorage[POOL_MEDIUM_BLOCKS][POOL_MEDIUM_SIZE]
+    __attribute__((aligned(POOL_ALIGNMENT)));
+static PoolBlock_t mediumBlocks[POOL_MEDIUM_BLOCKS];
+
+static uint8_t largeStorage[POOL_LARGE_BLOCKS][POOL_LARGE_SIZE]
+    __attribute__((aligned(POOL_ALIGNMENT)));
+static PoolBlock_t largeBlocks[POOL_LARGE_BLOCKS];
+
+/**
+ * The following array contains the configuration data for each size class of
+ * the DMA buffer pool. Each row represent a single size class. Each column is
+ * representing a member of the PoolConfig_t structure. This table is read in
+ * by POOL_init, where the free list of each class is then built.
+ */
+const PoolConfig_t PoolConfig[] =
+{
+/*
+ *  storage               Blocks        blockSize          blockCount
+ *
+*/
+    {&smallStorage[0][0],  smallBlocks,  POOL_SMALL_SIZE,   POOL_SMALL_BLOCKS},
+    {&mediumStorage[0][0], mediumBlocks, POOL_MEDIUM_SIZE,  POOL_MEDIUM_BLOCKS},
+    {&largeStorage[0][0],  largeBlocks,  POOL_LARGE_SIZE,   POOL_LARGE_BLOCKS},
+};
+
+/*****************************************************************************
+ * Function Prototypes
+*****************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: POOL_configGet()
+ */
+/**
+ * \b Description
+ * This function is used to get the configuration table of the DMA buffer
+ * pool defined in the pool_cfg module.
+ *
+ * PRE-CONDITION: The configuration table must be populated (sizeof>0). <br>
+ *
+ * POST-CONDITION: A constant pointer to the first member of the configuration
+ * table is returned. <br>
+ *
+ * @return A pointer to the configuration table. <br>
+ *
+ * \b Example:
+ * @code
+ * const PoolConfig_t * const PoolConfig = POOL_configGet();
+ * size_t configSize = POOL_configSizeGet();
+ *
+ * POOL_init(PoolConfig, configSize);
+ * @endcode
+ *
+ * @see POOL_configGet
+ * @see POOL_configSizeGet
+ * @see POOL_init
+ *
+ */
+const PoolConfig_t * const POOL_configGet(void)
+{
+    /* The cast is performed to ensure that the address of the first element
+     * of configuration table is returned as a constant pointer and not a
+     * pointer that can be modified
+    */
+    return (const PoolConfig_t *)&PoolConfig[0];
+}
+
+/*****************************************************************************
+ * Function: POOL_configSizeGet()
+*/
+/**
+*\b Description:
+ * This function is used to get the size of the configuration table.
+ *
+ * PRE-CONDITION: configuration table needs to be populated (sizeof > 0) <br>
+ *
+ * POST-CONDITION: The size of the configuration table will be returned. <br>
+ *
+ * @return The size of the configuration table.
+ *
+ * \b Example:
+ * @code
+ * const PoolConfig_t * const PoolConfig = POOL_configGet();
+ * size_t configSize = POOL_configSizeGet();
+ *
+ * POOL_init(PoolConfig, configSize);
+ * @endcode
+ *
+ * @see POOL_configGet
+ * @see POOL_configSizeGet
+ * @see POOL_init
+ *
+*****************************************************************************/
+size_t POOL_configSizeGet(void)
+{
+   return sizeof(PoolConfig)/sizeof(PoolConfig[0]);
+}
@@ -0,0 +1,375 @@
+/**
+ * @file pwm.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the DMA-driven PWM engine. The update
+ * request of TIM3 triggers DMA1 stream 2 (channel 5). The DMA control
+ * register (DCR) of the timer sets the burst: its base address (DBA) is the
+ * compare register of the first channel and its length (DBL) the number of
+ * channels, so every request is served by writing the address register
+ * (DMAR) once per channel, and the timer redirects each write to the next
+ * compare register.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "pwm.h"        /*For this modules definitions*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the DMA stream mapped to the TIM3 update request.
+*/
+#define PWM_STREAM DMA1_STREAM_2
+
+/**
+ * Defines the offset of CCR1 from the base of the timer in words (0x34),
+ * i.e. the burst base address (DBA) of the first channel.
+*/
+#define PWM_BURST_BASE_CCR1 13U
+
+/**
+ * Defines the number of bits of a channel on the capture/compare mode
+ * register (CCMRx) and on the capture/compare enable register (CCER).
+*/
+#define PWM_CCMR_CHANNEL_BITS 8U
+#define PWM_CCER_CHANNEL_BITS 4U
+
+/**
+ * Defines the output compare mode of the PWM mode 1: the output is active
+ * while the counter is below the compare value.
+*/
+#define PWM_MODE_1 6UL
+
+/**
+ * Defines the maximum number of data of a DMA transfer.
+*/
+#define PWM_TRANSFER_MAX 65535UL
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/* Defines a array of pointers to the capture/compare mode registers, two
+ * channels per register.
+*/
+static uint32_t volatile * const modeRegister[PWM_CHANNEL_MAX / 2U] =
+{
+    (uint32_t*)&TIM3->CCMR1, (uint32_t*)&TIM3->CCMR2
+};
+
+/**
+ * The following structure contains the configuration of the DMA stream used
+ * by the PWM engine. The compare values are moved from memory to the DMA
+ * address register of the timer, which does not move, one word at a time,
+ * so the FIFO is bypassed (direct mode). The table is played in a loop.
+ */
+static const DmaConfig_t PwmDmaConfig =
+{
+/*
+ *  Stream          Channel        Direction                MemorySize
+ *  PeripheralSize         MemoryIncrement              PeripheralIncrement
+ *  FifoMode                      FifoThreshold            CircularMode
+ *
+*/
+    PWM_STREAM, DMA_CHANNEL_5, DMA_MEMORY_TO_PERIPHERAL, DMA_MEMORY_SIZE_32,
+    DMA_PERIPHERAL_SIZE_32, DMA_MEMORY_INCREMENT_ENABLED, DMA_PERIPHERAL_INCREMENT_DISABLED,
+    DMA_FIFO_DIRECT_MODE_ENABLED, DMA_FIFO_THRESHOLD_FULL, DMA_CIRCULAR_MODE_ENABLED
+};
+
+/* Defines the number of channels and frames of the table being played */
+static uint32_t pwmChannels = 0U;
+static uint32_t pwmFrames = 0U;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void PWM_burstWait(const uint32_t total);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: PWM_start()
+*//**
+ *\b Description:
+ * This function is used to play a duty table on the channels of TIM3. The
+ * timer counts up to period in PWM mode 1, with the compare registers
+ * preloaded: a value written during a period is used from the next update
+ * event on, so a duty cycle never changes in the middle of a period. On
+ * every update event a DMA burst writes the next frame of the table, and
+ * the table is played in a loop until PWM_stop. The first two frames are
+ * loaded by two software update events before the counter starts, so the
+ * frames are output in order from the first period. Any table being played
+ * is stopped first.
+ *
+ * PRE-CONDITION: The clocks of TIM3, DMA1 and the GPIO ports are enabled. <br>
+ * PRE-CONDITION: The channel pins are set to their TIM3 alternate function
+ *                (DIO_init). <br>
+ * PRE-CONDITION: The table remains valid while it is played. <br>
+ * PRE-CONDITION: The period is long enough for the DMA burst (a few bus
+ *                cycles per channel). <br>
+ *
+ * POST-CONDITION: The table is being played on the channels. <br>
+ *
+ * @param[in]   Config is a pointer to the table to play.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * //Three phases of a motor at 20 kHz (16 MHz timer clock)
+ * static const uint32_t duties[3U * 4U] =
+ * {
+ *     400U, 200U, 600U,   500U, 300U, 500U,
+ *     600U, 200U, 400U,   500U, 300U, 500U
+ * };
+ *
+ * PwmBurstConfig_t Pwm =
+ * {
+ *      .FirstChannel = PWM_CHANNEL_1,
+ *      .channelCount = 3U,
+ *      .Polarity = PWM_POLARITY_HIGH,
+ *      .prescaler = 1U,
+ *      .period = 800U,
+ *      .duties = &duties[0],
+ *      .length = 4U
+ * };
+ *
+ * PWM_start(&Pwm);
+ * @endcode
+ *
+ * @see PWM_start
+ * @see PWM_stop
+ * @see PWM_stateGet
+ * @see PWM_frameGet
+ *
+*****************************************************************************/
+void PWM_start(const PwmBurstConfig_t * const Config)
+{
+    const uint32_t first = Config->FirstChannel;
+    const uint32_t count = Config->channelCount;
+    uint32_t channel;
+    uint32_t shift;
+
+    /* Prevent to assign a value out of the range of the settings */
+    assert(Config->FirstChannel < PWM_CHANNEL_MAX);
+    assert((count > 0U) && ((first + count) <= PWM_CHANNEL_MAX));
+    assert(Config->Polarity < PWM_POLARITY_MAX);
+    assert((Config->prescaler > 0U) &&
+           (Config->prescaler <= PWM_TIMER_COUNTS));
+    assert((Config->period > 1U) && (Config->period <= PWM_TIMER_COUNTS));
+    assert((Config->length > 0U) &&
+           (Config->length <= (PWM_TRANSFER_MAX / count)));
+
+    /* Release the timer and the stream from a previous table */
+    PWM_stop();
+    DMA_init(&PwmDmaConfig, 1U);
+
+    /* Set the period. The auto-reload register is preloaded as well */
+    TIM3->PSC = Config->prescaler - 1UL;
+    TIM3->ARR = Config->period - 1UL;
+    TIM3->CNT = 0U;
+    TIM3->CR1 = TIM_CR1_ARPE;
+
+    /* Set the channels on PWM mode 1 with preloaded compare registers */
+    for(uint32_t i=0; i<count; i++)
+    {
+        channel = first + i;
+        shift = (channel % 2U) * PWM_CCMR_CHANNEL_BITS;
+        *modeRegister[channel / 2U] = (*modeRegister[channel / 2U] &
+            ~((TIM_CCMR1_OC1M | TIM_CCMR1_OC1PE) << shift)) |
+            (((PWM_MODE_1 << TIM_CCMR1_OC1M_Pos) | TIM_CCMR1_OC1PE) << shift);
+
+        shift = channel * PWM_CCER_CHANNEL_BITS;
+        TIM3->CCER = (TIM3->CCER & ~(TIM_CCER_CC1P << shift)) |
+            (TIM_CCER_CC1E << shift) |
+            ((Config->Polarity == PWM_POLARITY_LOW) ?
+                (TIM_CCER_CC1P << shift) : 0UL);
+    }
+
+    /* Set the burst: one write of DMAR per channel, from the compare
+     * register of the first channel on
+    */
+    TIM3->DCR = ((count - 1UL) << TIM_DCR_DBL_Pos) |
+        ((PWM_BURST_BASE_CCR1 + first) << TIM_DCR_DBA_Pos);
+
+    pwmChannels = count;
+    pwmFrames = Config->length;
+
+    /* Set the transfer from the table to the timer */
+    DmaTransferConfig_t DmaTransferConfig =
+    {
+        .Stream = PWM_STREAM,
+        .peripheral = (uint32_t*)&TIM3->DMAR,
+        .memory = (uint32_t*)Config->duties,
+        .length = Config->length * count
+    };
+    DMA_transferConfig(&DmaTransferConfig);
+
+    /* A burst is written after the transfer of the preload registers of its
+     * update event, so a frame is output one period after its burst. The
+     * first update event writes the first frame to the preload registers;
+     * the second one outputs it and writes the second frame.
+    */
+    TIM3->DIER |= TIM_DIER_UDE;
+    TIM3->EGR = TIM_EGR_UG;
+    PWM_burstWait(Config->length * count);
+    TIM3->EGR = TIM_EGR_UG;
+    TIM3->SR &= ~TIM_SR_UIF;
+
+    /* Start the timer */
+    TIM3->CR1 |= TIM_CR1_CEN;
+}
+
+/*****************************************************************************
+ * Function: PWM_stop()
+*//**
+ *\b Description:
+ * This function is used to stop the table being played. The timer, its DMA
+ * request and the stream are stopped, and the outputs of the channels are
+ * disabled.
+ *
+ * PRE-CONDITION: The clocks of TIM3 and DMA1 are enabled. <br>
+ *
+ * POST-CONDITION: The outputs are not driven by the timer. <br>
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * PWM_stop();
+ * @endcode
+ *
+ * @see PWM_start
+ * @see PWM_stop
+ * @see PWM_stateGet
+ * @see PWM_frameGet
+ *
+*****************************************************************************/
+void PWM_stop(void)
+{
+    /* Stop the timer and its DMA request */
+    TIM3->CR1 &= ~TIM_CR1_CEN;
+    TIM3->DIER &= ~TIM_DIER_UDE;
+
+    /* Stop the stream */
+    DMA_transferStop(PWM_STREAM);
+
+    /* Disable the outputs of every channel */
+    for(uint32_t channel=0; channel<PWM_CHANNEL_MAX; channel++)
+    {
+        TIM3->CCER &= ~(TIM_CCER_CC1E << (channel * PWM_CCER_CHANNEL_BITS));
+    }
+}
+
+/*****************************************************************************
+ * Function: PWM_stateGet()
+*//**
+ *\b Description:
+ * This function is used to get the state of the PWM engine.
+ *
+ * PRE-CONDITION: The clock of DMA1 is enabled. <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @return PWM_RUNNING if a table is being played, otherwise PWM_IDLE.
+ *
+ * \b Example:
+ * @code
+ * if(PWM_stateGet() == PWM_IDLE)
+ * {
+ *     PWM_start(&Pwm);
+ * }
+ * @endcode
+ *
+ * @see PWM_start
+ * @see PWM_stop
+ * @see PWM_stateGet
+ * @see PWM_frameGet
+ *
+*****************************************************************************/
+PwmState_t PWM_stateGet(void)
+{
+    return ((DMA_streamStateGet(PWM_STREAM) == DMA_STREAM_ENABLED) ?
+        PWM_RUNNING : PWM_IDLE);
+}
+
+/*****************************************************************************
+ * Function: PWM_frameGet()
+*//**
+ *\b Description:
+ * This function is used to get the frame of the table on the outputs. The
+ * next frame is already on the preload registers, so the other frames can
+ * be rewritten while the table is played, e.g. to change a duty cycle from
+ * the next loop on.
+ *
+ * PRE-CONDITION: A table is being played (PWM_start). <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @return The index of the frame on the outputs.
+ *
+ * \b Example:
+ * @code
+ * uint32_t frame = (PWM_frameGet() + 2U) % 4U;
+ *
+ * duties[frame * 3U] = 450U;
+ * @endcode
+ *
+ * @see PWM_start
+ * @see PWM_stop
+ * @see PWM_stateGet
+ * @see PWM_frameGet
+ *
+*****************************************************************************/
+uint32_t PWM_frameGet(void)
+{
+    const uint32_t total = pwmChannels * pwmFrames;
+    uint32_t next;
+
+    /* Prevent to get the frame of a table that is not played */
+    assert(total > 0U);
+
+    /* The frame written by the next burst, two periods ahead */
+    next = (total - DMA_transferRemainingGet(PWM_STREAM)) / pwmChannels;
+
+    return (next + (2U * pwmFrames) - 2U) % pwmFrames;
+}
+
+/*****************************************************************************
+ * Function: PWM_burstWait()
+*//**
+ *\b Description:
+ * This function is used to wait for the end of the first burst of the
+ * table: the remaining data drop by one frame or, with a table of a single
+ * frame, the stream reloads (transfer complete).
+ *
+ * PRE-CONDITION: The first burst was requested. <br>
+ *
+ * POST-CONDITION: The first frame is on the preload registers. <br>
+ *
+ * @param[in]   total is the number of data of the table.
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void PWM_burstWait(const uint32_t total)
+{
+    while((DMA_transferRemainingGet(PWM_STREAM) > (total - pwmChannels)) &&
+          (DMA_eventClear(PWM_STREAM, DMA_INTERRUPT_TRANSFER_COMPLETE) == 0U))
+    {
+    }
+}
@@ -0,0 +1,422 @@
+/**
+ * @file scan.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the delimiter scanner. The data is compared
+ * against the delimiters one word (four bytes) at a time. On the Cortex-M4
+ * the comparison uses the SIMD instruction UQSUB8, which marks the bytes
+ * equal to a delimiter directly; on cores without the DSP extension a
+ * portable SWAR (SIMD within a register) expression is used instead.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "scan.h"       /*For this modules definitions*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the number of bytes compared at a time.
+*/
+#define SCAN_WORD_SIZE 4U
+
+/**
+ * Defines a word with the value 0x01 on each byte.
+*/
+#define SCAN_BYTES_ONE 0x01010101UL
+
+/**
+ * Defines a word with the most significant bit set on each byte.
+*/
+#define SCAN_BYTES_HIGH 0x80808080UL
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static uint32_t SCAN_wordMatch(const uint32_t word,
+const ScanDelimiters_t * const Delimiters);
+static uint8_t SCAN_byteMatch(const uint8_t data,
+const ScanDelimiters_t * const Delimiters);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: SCAN_delimitersInit()
+ *//**
+ * \b Description:
+ * This function is used to build a set of delimiters. Each delimiter is
+ * repeated on the four bytes of a word.
+ *
+ * PRE-CONDITION: 0 < count <= SCAN_DELIMITERS_MAX. <br>
+ *
+ * POST-CONDITION: The set can be used by SCAN_find and SCAN_lineGet. <br>
+ *
+ * @param[out]  Delimiters is the set to build.
+ * @param[in]   characters is the array of delimiters.
+ * @param[in]   count is the number of delimiters.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * ScanDelimiters_t LineEnd;
+ * SCAN_delimitersInit(&LineEnd, (const uint8_t *)"\r\n", 2U);
+ * @endcode
+ *
+ * @see SCAN_delimitersInit
+ * @see SCAN_ringInit
+ * @see SCAN_writeIndexGet
+ * @see SCAN_find
+ * @see SCAN_lineGet
+ *
+*****************************************************************************/
+void SCAN_delimitersInit(ScanDelimiters_t * const Delimiters,
+const uint8_t * const characters, uint8_t count)
+{
+    /*Review if the number of delimiters is correct*/
+    assert((count > 0U) && (count <= SCAN_DELIMITERS_MAX));
+
+    for(uint8_t i=0; i<count; i++)
+    {
+        Delimiters->pattern[i] = SCAN_BYTES_ONE * characters[i];
+    }
+    Delimiters->count = count;
+}
+
+/*****************************************************************************
+ * Function: SCAN_ringInit()
+ *//**
+ * \b Description:
+ * This function is used to initialize the scan state of a circular receive
+ * buffer. The buffer is the memory of a DMA stream in circular mode.
+ *
+ * PRE-CONDITION: size > 0. <br>
+ *
+ * POST-CONDITION: The next line starts at the beginning of the buffer. <br>
+ *
+ * @param[out]  Ring is the scan state to initialize.
+ * @param[in]   buffer is the circular buffer written by the DMA.
+ * @param[in]   size is the size of the buffer in bytes.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * static uint8_t rxRing[256];
+ * ScanRing_t RxScan;
+ * SCAN_ringInit(&RxScan, rxRing, sizeof(rxRing));
+ * @endcode
+ *
+ * @see SCAN_delimitersInit
+ * @see SCAN_ringInit
+ * @see SCAN_writeIndexGet
+ * @see SCAN_find
+ * @see SCAN_lineGet
+ *
+*****************************************************************************/
+void SCAN_ringInit(ScanRing_t * const Ring, const uint8_t * const buffer,
+uint32_t size)
+{
+    /*Review if the size of the buffer is correct*/
+    assert(size > 0U);
+
+    Ring->buffer = buffer;
+    Ring->size = size;
+    Ring->start = 0U;
+    Ring->scanned = 0U;
+}
+
+/*****************************************************************************
+ * Function: SCAN_writeIndexGet()
+ *//**
+ * \b Description:
+ * This function is used to take a snapshot of the position where the DMA
+ * writes the next byte of the circular buffer. The position is computed
+ * from the number of data items left on the stream (NDTR).
+ *
+ * PRE-CONDITION: The stream fills the buffer in circular mode. <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   Ring is the scan state of the buffer.
+ * @param[in]   Stream is the DMA stream that fills the buffer.
+ *
+ * @return The index of the next byte written by the DMA.
+ *
+ * \b Example:
+ * @code
+ * writeIndex = SCAN_writeIndexGet(&RxScan, DMA1_STREAM_5);
+ * @endcode
+ *
+ * @see SCAN_delimitersInit
+ * @see SCAN_ringInit
+ * @see SCAN_writeIndexGet
+ * @see SCAN_find
+ * @see SCAN_lineGet
+ *
+*****************************************************************************/
+uint32_t SCAN_writeIndexGet(const ScanRing_t * const Ring,
+const DmaStream_t Stream)
+{
+    const uint32_t remaining = DMA_transferRemainingGet(Stream);
+
+    /* NDTR is reloaded with the size when it reaches zero */
+    return (remaining == 0U) ? 0U : (Ring->size - remaining);
+}
+
+/*****************************************************************************
+ * Function: SCAN_find()
+ *//**
+ * \b Description:
+ * This function is used to search an array for the first byte that is one
+ * of the delimiters. The bytes before the first word boundary and after the
+ * last one are compared one at a time, and the words in between are
+ * compared four bytes at a time.
+ *
+ * PRE-CONDITION: The delimiters are initialized (SCAN_delimitersInit). <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   data is the array to search.
+ * @param[in]   length is the number of bytes of the array.
+ * @param[in]   Delimiters is the set of delimiters.
+ *
+ * @return The index of the first delimiter, or length if there is none.
+ *
+ * \b Example:
+ * @code
+ * index = SCAN_find(message, length, &LineEnd);
+ * @endcode
+ *
+ * @see SCAN_delimitersInit
+ * @see SCAN_ringInit
+ * @see SCAN_writeIndexGet
+ * @see SCAN_find
+ * @see SCAN_lineGet
+ *
+*****************************************************************************/
+uint32_t SCAN_find(const uint8_t * const data, uint32_t length,
+const ScanDelimiters_t * const Delimiters)
+{
+    uint32_t index = 0U;
+    uint32_t match;
+
+    /* Compare the bytes up to the first word boundary */
+    while((index < length) &&
+          ((((uintptr_t)&data[index]) % SCAN_WORD_SIZE) != 0U))
+    {
+        if(SCAN_byteMatch(data[index], Delimiters) != 0U)
+        {
+            return index;
+        }
+        index++;
+    }
+
+    /* Compare the aligned words. The data is little-endian, so the first
+     * matching byte is the lowest byte marked in the match.
+    */
+    while((length - index) >= SCAN_WORD_SIZE)
+    {
+        match = SCAN_wordMatch(*(const uint32_t *)&data[index], Delimiters);
+        if(match != 0U)
+        {
+            return index + (__CLZ(__RBIT(match)) / 8U);
+        }
+        index += SCAN_WORD_SIZE;
+    }
+
+    /* Compare the bytes after the last word boundary */
+    while(index < length)
+    {
+        if(SCAN_byteMatch(data[index], Delimiters) != 0U)
+        {
+            return index;
+        }
+        index++;
+    }
+
+    return length;
+}
+
+/*****************************************************************************
+ * Function: SCAN_lineGet()
+ *//**
+ * \b Description:
+ * This function is used to get the next complete line of a circular receive
+ * buffer. Only the bytes written since the last call are searched, so the
+ * work is proportional to the new data. The line is returned as a view of
+ * the buffer without its delimiter; the view stays valid until the DMA
+ * writes over it, so it must be processed before the buffer wraps again.
+ *
+ * PRE-CONDITION: The scan state is initialized (SCAN_ringInit). <br>
+ * PRE-CONDITION: The delimiters are initialized (SCAN_delimitersInit). <br>
+ * PRE-CONDITION: The lines are read before the DMA laps the reader. <br>
+ *
+ * POST-CONDITION: The next call searches from the end of the line, or from
+ * writeIndex if no line was found. <br>
+ *
+ * @param[in,out]   Ring is the scan state of the buffer.
+ * @param[in]       writeIndex is the snapshot of the DMA write position.
+ * @param[in]       Delimiters is the set of delimiters.
+ * @param[out]      Line is the view of the line if SCAN_FOUND is returned.
+ *
+ * @return SCAN_FOUND if a complete line was found, otherwise SCAN_NOT_FOUND.
+ *
+ * \b Example:
+ * @code
+ * writeIndex = SCAN_writeIndexGet(&RxScan, DMA1_STREAM_5);
+ * while(SCAN_lineGet(&RxScan, writeIndex, &LineEnd, &Line) == SCAN_FOUND)
+ * {
+ *     commandProcess(&Line);
+ * }
+ * @endcode
+ *
+ * @see SCAN_delimitersInit
+ * @see SCAN_ringInit
+ * @see SCAN_writeIndexGet
+ * @see SCAN_find
+ * @see SCAN_lineGet
+ *
+*****************************************************************************/
+ScanStatus_t SCAN_lineGet(ScanRing_t * const Ring, uint32_t writeIndex,
+const ScanDelimiters_t * const Delimiters, ScanView_t * const Line)
+{
+    uint32_t end = Ring->size;
+    uint32_t found;
+    uint32_t delimiter;
+
+    /*Review if the write position is within the buffer*/
+    assert(writeIndex < Ring->size);
+
+    /* The new data wraps when the write position is behind the scan */
+    if(writeIndex >= Ring->scanned)
+    {
+        end = writeIndex;
+    }
+
+    found = SCAN_find(&Ring->buffer[Ring->scanned], end - Ring->scanned,
+        Delimiters);
+    delimiter = Ring->scanned + found;
+
+    if((found == (end - Ring->scanned)) && (end != writeIndex))
+    {
+        /* Continue with the new data at the beginning of the buffer */
+        delimiter = SCAN_find(Ring->buffer, writeIndex, Delimiters);
+        end = writeIndex;
+    }
+
+    if(delimiter == end)
+    {
+        Ring->scanned = writeIndex;
+        return SCAN_NOT_FOUND;
+    }
+
+    /* Build the view from the start of the line to the delimiter */
+    Line->segment[0] = &Ring->buffer[Ring->start];
+    Line->segment[1] = Ring->buffer;
+    if(delimiter >= Ring->start)
+    {
+        Line->length[0] = delimiter - Ring->start;
+        Line->length[1] = 0U;
+    }
+    else
+    {
+        Line->length[0] = Ring->size - Ring->start;
+        Line->length[1] = delimiter;
+    }
+
+    /* The next line starts after the delimiter */
+    Ring->start = ((delimiter + 1U) == Ring->size) ? 0U : (delimiter + 1U);
+    Ring->scanned = Ring->start;
+
+    return SCAN_FOUND;
+}
+
+/*****************************************************************************
+ * Function: SCAN_wordMatch()
+ *//**
+ * \b Description:
+ * This function is used to mark the bytes of a word that are equal to one
+ * of the delimiters. The word is XORed with each delimiter pattern, which
+ * turns the matching bytes into zero. With the DSP extension, the saturated
+ * subtraction 0x01 - byte of UQSUB8 gives 0x01 for a zero byte and 0x00 for
+ * any other byte. Without it, the SWAR expression (x - 0x01) & ~x & 0x80
+ * marks the lowest zero byte exactly (a byte above it may be marked too,
+ * which does not change the first match).
+ *
+ * PRE-CONDITION: The delimiters are initialized (SCAN_delimitersInit). <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   word is four bytes of data.
+ * @param[in]   Delimiters is the set of delimiters.
+ *
+ * @return A word with a non-zero byte at the position of each match.
+ *
+*****************************************************************************/
+static uint32_t SCAN_wordMatch(const uint32_t word,
+const ScanDelimiters_t * const Delimiters)
+{
+    uint32_t match = 0U;
+    uint32_t difference;
+
+    for(uint8_t i=0; i<Delimiters->count; i++)
+    {
+        difference = word ^ Delimiters->pattern[i];
+#if defined(__ARM_FEATURE_SIMD32)
+        match |= __UQSUB8(SCAN_BYTES_ONE, difference);
+#else
+        match |= (difference - SCAN_BYTES_ONE) & ~difference & SCAN_BYTES_HIGH;
+#endif
+    }
+
+    return match;
+}
+
+/*****************************************************************************
+ * Function: SCAN_byteMatch()
+ *//**
+ * \b Description:
+ * This function is used to check if a byte is one of the delimiters.
+ *
+ * PRE-CONDITION: The delimiters are initialized (SCAN_delimitersInit). <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   data is the byte to check.
+ * @param[in]   Delimiters is the set of delimiters.
+ *
+ * @return 1 if the byte is a delimiter, otherwise 0.
+ *
+*****************************************************************************/
+static uint8_t SCAN_byteMatch(const uint8_t data,
+const ScanDelimiters_t * const Delimiters)
+{
+    for(uint8_t i=0; i<Delimiters->count; i++)
+    {
+        if(data == (uint8_t)Delimiters->pattern[i])
+        {
+            return 1U;
+        }
+    }
+
+    return 0U;
+}
@@ -0,0 +1,570 @@
+/**
+ * @file spi.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the SPI driver.
+ * @version 1.1
+ * @date 2025-03-25
+ * 
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ * 
+*/
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include "spi.h"          /*For this modules definitions*/
+#include "timebase.h"     /*For the timeout of the last frame*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the largest number of frames of a DMA transfer (NDTR). Longer 
+ * transfers are split.
+*/
+#define SPI_DMA_LENGTH_MAX 0xFFFFUL
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+/**
+ * Checks a setting of the SPI configuration table. Compiled out when the
+ * build defines CONFIG_TABLES_CHECKED (see scripts/config_check.py). The 
+ * port indexes the register tables, so it uses assert instead.
+*/
+#ifdef CONFIG_TABLES_CHECKED
+#define SPI_CONFIG_ASSERT(expression) ((void)0)
+#else
+#define SPI_CONFIG_ASSERT(expression) assert(expression)
+#endif
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/* Defines a array of pointers to the SPI control register 1*/
+static uint32_t volatile * const controlRegister1[SPI_PORTS_NUMBER] =
+{
+    (uint32_t*)&SPI1->CR1, (uint32_t*)&SPI2->CR1, (uint32_t*)&SPI3->CR1,
+    (uint32_t*)&SPI4->CR1
+};
+
+/* Defines a array of pointers to the SPI control register 2*/
+static uint32_t volatile * const controlRegister2[SPI_PORTS_NUMBER] =
+{
+    (uint32_t*)&SPI1->CR2, (uint32_t*)&SPI2->CR2, (uint32_t*)&SPI3->CR2,
+    (uint32_t*)&SPI4->CR2
+};
+
+/* Defines a array of pointers to the SPI status register*/
+static uint32_t volatile * const statusRegister[SPI_PORTS_NUMBER] =
+{
+    (uint32_t*)&SPI1->SR, (uint32_t*)&SPI2->SR, (uint32_t*)&SPI3->SR,
+    (uint32_t*)&SPI4->SR
+};
+
+/* Defines a array of pointers to the SPI data register*/
+static uint32_t volatile * const dataRegister[SPI_PORTS_NUMBER] =
+{
+    (uint32_t*)&SPI1->DR, (uint32_t*)&SPI2->DR, (uint32_t*)&SPI3->DR,
+    (uint32_t*)&SPI4->DR
+};
+
+/* Defines the word sent by the transfers without data to transmit*/
+static const uint16_t dummyWord = SPI_DUMMY_WORD;
+
+/* Defines the word written by the transfers without a receive buffer*/
+static uint16_t sinkWord;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: SPI_init()
+*//**
+    *\b Description:
+    * This function is used to initialize the SPI based on the configuration
+    * table defined in spi_cfg module. The port is enabled (SPE) once it is
+    * configured.
+    * 
+    * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
+    * PRE-CONDITION: Configuration table needs to be populated (sizeof>0) <br>
+    * PRE-CONDITION: The SPI_PORTS_NUMBER > 0 <br>
+    * PRE-CONDITION: The setting is within the maximum values (SPI_MAX). <br>
+    * 
+    * POST-CONDITION: The SPI peripheral is set up with the configuration
+    * table. <br>
+    * 
+    * @param[in]   Config is a pointer to the configuration table that contains
+    * the initialization for the peripheral.
+    * @param[in]   configSize is the size of the configuration table.
+    * 
+    * @return void
+    * 
+    * \b Example:
+    * @code
+    * const SpiConfig_t * const SpiConfig = SPI_configGet();
+    * size_t configSize = SPI_configSizeGet();
+    * 
+    * SPI_init(SpiConfig, configSize);
+    * @endcode
+    * 
+    * @see SPI_configGet
+    * @see SPI_configSizeGet
+    * @see SPI_init
+    * @see SPI_transfer
+    * @see SPI_transaction
+    * @see SPI_registerWrite
+    * @see SPI_registerRead
+    * 
+*****************************************************************************/
+void SPI_init(const SpiConfig_t * const Config, size_t configSize)
+{
+    /* Loop through all the elements of the configuration table. */
+    for(uint8_t i=0; i<configSize; i++)
+    {
+        /* Prevent to assign a value out of the range of the port.*/
+        assert(Config[i].Port < SPI_PORT_MAX);
+
+        /* The configuration is changed with the port disabled */
+        *controlRegister1[Config[i].Port] &= ~SPI_CR1_SPE;
+
+        /* Set the mode */
+        if(Config[i].Mode == SPI_MODE_MASTER)
+        {
+            *controlRegister1[Config[i].Port] |= SPI_CR1_MSTR;
+        }
+        else if(Config[i].Mode == SPI_MODE_SLAVE)
+        {
+            *controlRegister1[Config[i].Port] &= ~SPI_CR1_MSTR;
+        }
+        else
+        {
+            SPI_CONFIG_ASSERT(Config[i].Mode < SPI_MODE_MAX);
+        }
+
+        /* Set the clock polarity */
+        if(Config[i].ClockPolarity == SPI_CLOCK_POLARITY_HIGH)
+        {
+            *controlRegister1[Config[i].Port] |= SPI_CR1_CPOL;
+        }
+        else if(Config[i].ClockPolarity == SPI_CLOCK_POLARITY_LOW)
+        {
+            *controlRegister1[Config[i].Port] &= ~SPI_CR1_CPOL;
+        }
+        else
+        {
+            SPI_CONFIG_ASSERT(Config[i].ClockPolarity < SPI_CLOCK_POLARITY_MAX);
+        }
+
+        /* Set the clock phase */
+        if(Config[i].ClockPhase == SPI_CLOCK_PHASE_SECOND)
+        {
+            *controlRegister1[Config[i].Port] |= SPI_CR1_CPHA;
+        }
+        else if(Config[i].ClockPhase == SPI_CLOCK_PHASE_FIRST)
+        {
+            *controlRegister1[Config[i].Port] &= ~SPI_CR1_CPHA;
+        }
+        else
+        {
+            SPI_CONFIG_ASSERT(Config[i].ClockPhase < SPI_CLOCK_PHASE_MAX);
+        }
+
+        /* Set the baud rate. The settings of SpiBaudRate_t are the 
+         * encodings of the BR field.
+        */
+        SPI_CONFIG_ASSERT(Config[i].BaudRate < SPI_BAUD_RATE_MAX);
+        *controlRegister1[Config[i].Port] = 
+            (*controlRegister1[Config[i].Port] & ~SPI_CR1_BR) |
+            ((uint32_t)Config[i].BaudRate << SPI_CR1_BR_Pos);
+
+        /* Set the data frame format */
+        if(Config[i].DataSize == SPI_DATA_SIZE_16)
+        {
+            *controlRegister1[Config[i].Port] |= SPI_CR1_DFF;
+        }
+        else if(Config[i].DataSize == SPI_DATA_SIZE_8)
+        {
+            *controlRegister1[Config[i].Port] &= ~SPI_CR1_DFF;
+        }
+        else
+        {
+            SPI_CONFIG_ASSERT(Config[i].DataSize < SPI_DATA_SIZE_MAX);
+        }
+
+        /* Set the bit order */
+        if(Config[i].BitOrder == SPI_BIT_ORDER_LSB_FIRST)
+        {
+            *controlRegister1[Config[i].Port] |= SPI_CR1_LSBFIRST;
+        }
+        else if(Config[i].BitOrder == SPI_BIT_ORDER_MSB_FIRST)
+        {
+            *controlRegister1[Config[i].Port] &= ~SPI_CR1_LSBFIRST;
+        }
+        else
+        {
+            SPI_CONFIG_ASSERT(Config[i].BitOrder < SPI_BIT_ORDER_MAX);
+        }
+
+        /* Set the slave select. With the software management the internal
+         * NSS is high on a master and low on a slave, so the port is always
+         * selected, and the devices are selected with DIO pins.
+        */
+        if(Config[i].SlaveSelect == SPI_SLAVE_SELECT_SOFTWARE)
+        {
+            *controlRegister2[Config[i].Port] &= ~SPI_CR2_SSOE;
+            if(Config[i].Mode == SPI_MODE_MASTER)
+            {
+                *controlRegister1[Config[i].Port] |= 
+                    (SPI_CR1_SSM | SPI_CR1_SSI);
+            }
+            else
+            {
+                *controlRegister1[Config[i].Port] = 
+                    (*controlRegister1[Config[i].Port] & ~SPI_CR1_SSI) | 
+                    SPI_CR1_SSM;
+            }
+        }
+        else if(Config[i].SlaveSelect == SPI_SLAVE_SELECT_HARDWARE)
+        {
+            *controlRegister1[Config[i].Port] &= ~(SPI_CR1_SSM | SPI_CR1_SSI);
+            if(Config[i].Mode == SPI_MODE_MASTER)
+            {
+                *controlRegister2[Config[i].Port] |= SPI_CR2_SSOE;
+            }
+            else
+            {
+                *controlRegister2[Config[i].Port] &= ~SPI_CR2_SSOE;
+            }
+        }
+        else
+        {
+            SPI_CONFIG_ASSERT(Config[i].SlaveSelect < SPI_SLAVE_SELECT_MAX);
+        }
+
+        /* Set the enable, once the port is configured */
+        if(Config[i].Enable == SPI_ENABLED)
+        {
+            *controlRegister1[Config[i].Port] |= SPI_CR1_SPE;
+        }
+        else if(Config[i].Enable == SPI_DISABLED)
+        {
+            *controlRegister1[Config[i].Port] &= ~SPI_CR1_SPE;
+        }
+        else
+        {
+            SPI_CONFIG_ASSERT(Config[i].Enable < SPI_ENABLE_MAX);
+        }
+    }
+}
+
+/*****************************************************************************
+ * Function: SPI_transfer()
+ *//**
+    * \b Description:
+    * This function is used to transmit and receive a block of frames at the
+    * same time with the DMA. The RX stream is started first, then the TX 
+    * stream, and the function returns once the last frame was received, so
+    * the bus is idle. Without txData the dummy word is sent (e.g. to read a
+    * device), and without rxData the received frames are discarded (e.g. 
+    * to write a device): the stream moves a single word without memory 
+    * increment. Blocks longer than a DMA transfer are split. The processor
+    * sleeps during the transfer.
+    * 
+    * PRE-CONDITION: The SPI peripheral must be initialized (SPI_init). <br>
+    * PRE-CONDITION: The streams are initialized in normal mode for the SPI
+    *                TX and RX, with the data size of the frames. <br>
+    * PRE-CONDITION: The idle and the timebase must be initialized. <br>
+    * PRE-CONDITION: The Port is within the maximum SpiPort_t. <br>
+    * 
+    * POST-CONDITION: The frames are exchanged, or the streams are stopped 
+    *                 when the timeout elapsed. <br>
+    * 
+    * @param[in]   Config is a pointer to the transfer configuration.
+    * @param[in]   timeout is the time allowed for each DMA transfer, and 
+    *              for the last frame after it, in microseconds.
+    * 
+    * @return SPI_OK if the transfer completed, otherwise SPI_TIMEOUT.
+    * 
+    * \b Example:
+    * @code
+    * SpiTransferConfig_t Transfer =
+    * {
+    *     SPI_PORT_1, DMA2_STREAM_3, DMA2_STREAM_0, NULL, sample, 64U
+    * };
+    * if(SPI_transfer(&Transfer, 1000U) == SPI_TIMEOUT)
+    * {
+    *     //Handle the stalled bus
+    * }
+    * @endcode
+    * 
+    * @see SPI_configGet
+    * @see SPI_configSizeGet
+    * @see SPI_init
+    * @see SPI_transfer
+    * @see SPI_transaction
+    * @see SPI_registerWrite
+    * @see SPI_registerRead
+    * 
+*****************************************************************************/
+SpiStatus_t SPI_transfer(const SpiTransferConfig_t * const Config,
+const uint32_t timeout)
+{
+    SpiStatus_t Status = SPI_OK;
+    uint32_t remaining = Config->length;
+    uint32_t wordSize;
+    uint32_t deadline;
+
+    /*Prevent to assign a value out of the range of the port and streams.*/
+    assert(Config->Port < SPI_PORT_MAX);
+    assert(Config->TxStream < DMA_STREAM_MAX);
+    assert(Config->RxStream < DMA_STREAM_MAX);
+
+    DmaTransferConfig_t DmaTxConfig =
+    {
+        .Stream = Config->TxStream,
+        .peripheral = dataRegister[Config->Port],
+        .memory = (Config->txData != NULL) ? (uint32_t*)Config->txData : 
+            (uint32_t*)&dummyWord,
+        .length = 0U
+    };
+
+    DmaTransferConfig_t DmaRxConfig =
+    {
+        .Stream = Config->RxStream,
+        .peripheral = dataRegister[Config->Port],
+        .memory = (Config->rxData != NULL) ? (uint32_t*)Config->rxData : 
+            (uint32_t*)&sinkWord,
+        .length = 0U
+    };
+
+    wordSize = (*controlRegister1[Config->Port] & SPI_CR1_DFF) ? 2U : 1U;
+
+    DMA_memoryIncrementSet(Config->TxStream, (Config->txData != NULL) ? 
+        DMA_MEMORY_INCREMENT_ENABLED : DMA_MEMORY_INCREMENT_DISABLED);
+    DMA_memoryIncrementSet(Config->RxStream, (Config->rxData != NULL) ? 
+        DMA_MEMORY_INCREMENT_ENABLED : DMA_MEMORY_INCREMENT_DISABLED);
+
+    /* Discard the word left by a previous transfer (clears OVR) */
+    (void)*dataRegister[Config->Port];
+    (void)*statusRegister[Config->Port];
+
+    while((remaining > 0U) && (Status == SPI_OK))
+    {
+        DmaRxConfig.length = (remaining > SPI_DMA_LENGTH_MAX) ? 
+            SPI_DMA_LENGTH_MAX : remaining;
+        DmaTxConfig.length = DmaRxConfig.length;
+
+        /* The RX stream is started first, so no frame is lost */
+        DMA_transferConfig(&DmaRxConfig);
+        *controlRegister2[Config->Port] |= SPI_CR2_RXDMAEN;
+        DMA_transferConfig(&DmaTxConfig);
+        *controlRegister2[Config->Port] |= SPI_CR2_TXDMAEN;
+
+        /* The last frame is received once the last one was sent */
+        if(DMA_transferWaitTimeout(Config->RxStream, timeout) != DMA_OK)
+        {
+            DMA_transferStop(Config->TxStream);
+            DMA_transferStop(Config->RxStream);
+            Status = SPI_TIMEOUT;
+        }
+        *controlRegister2[Config->Port] &= 
+            ~(SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+
+        remaining -= DmaRxConfig.length;
+        if(Config->txData != NULL)
+        {
+            DmaTxConfig.memory = (uint32_t*)((uint8_t*)DmaTxConfig.memory + 
+                (DmaTxConfig.length * wordSize));
+        }
+        if(Config->rxData != NULL)
+        {
+            DmaRxConfig.memory = (uint32_t*)((uint8_t*)DmaRxConfig.memory + 
+                (DmaRxConfig.length * wordSize));
+        }
+    }
+
+    /* A master drives the clock until the end of the last frame */
+    deadline = TIMEBASE_deadlineGet(timeout);
+    while((Status == SPI_OK) && 
+          (*controlRegister1[Config->Port] & SPI_CR1_MSTR) &&
+          (*statusRegister[Config->Port] & SPI_SR_BSY))
+    {
+        if(TIMEBASE_deadlineCheck(deadline) == TIMEBASE_EXPIRED)
+        {
+            Status = SPI_TIMEOUT;
+        }
+    }
+
+    return Status;
+}
+
+/*****************************************************************************
+ * Function: SPI_transaction()
+ *//**
+    * \b Description:
+    * This function is used to run a transaction with a device: the chip 
+    * select pin is driven low, the segments are transferred one after the
+    * other (SPI_transfer), and the chip select pin is driven high once the
+    * last frame was received or a segment timed out. A segment without 
+    * frames is skipped.
+    * 
+    * PRE-CONDITION: The SPI peripheral must be initialized (SPI_init). <br>
+    * PRE-CONDITION: The chip select pin is a GPIO output (DIO_init), high
+    *                before the first transaction. <br>
+    * PRE-CONDITION: The streams are initialized as for SPI_transfer. <br>
+    * PRE-CONDITION: The Port is within the maximum SpiPort_t. <br>
+    * 
+    * POST-CONDITION: The segments are exchanged and the device is 
+    *                 deselected. <br>
+    * 
+    * @param[in]   Transaction is a pointer to the transaction.
+    * @param[in]   timeout is the time allowed for each DMA transfer in
+    *              microseconds.
+    * 
+    * @return SPI_OK if every segment completed, otherwise SPI_TIMEOUT.
+    * 
+    * \b Example:
+    * @code
+    * static const uint8_t readCommand[4] = {0x03U, 0x00U, 0x10U, 0x00U};
+    * const SpiSegment_t Segments[2] =
+    * {
+    *     {readCommand, NULL, 4U}, {NULL, page, 256U}
+    * };
+    * const SpiTransaction_t FlashRead =
+    * {
+    *     SPI_PORT_1, DMA2_STREAM_3, DMA2_STREAM_0, {DIO_PB, DIO_PB6},
+    *     Segments, 2U
+    * };
+    * (void)SPI_transaction(&FlashRead, 1000U);
+    * @endcode
+    * 
+    * @see SPI_configGet
+    * @see SPI_configSizeGet
+    * @see SPI_init
+    * @see SPI_transfer
+    * @see SPI_transaction
+    * @see SPI_registerWrite
+    * @see SPI_registerRead
+    * 
+*****************************************************************************/
+SpiStatus_t SPI_transaction(const SpiTransaction_t * const Transaction,
+const uint32_t timeout)
+{
+    SpiStatus_t Status = SPI_OK;
+    SpiTransferConfig_t Transfer =
+    {
+        .Port = Transaction->Port,
+        .TxStream = Transaction->TxStream,
+        .RxStream = Transaction->RxStream,
+        .txData = NULL,
+        .rxData = NULL,
+        .length = 0U
+    };
+
+    DIO_pinWrite(&Transaction->ChipSelect, DIO_LOW);
+
+    for(uint32_t i=0; (i<Transaction->segmentCount) && (Status == SPI_OK); 
+        i++)
+    {
+        if(Transaction->Segments[i].length > 0U)
+        {
+            Transfer.txData = Transaction->Segments[i].txData;
+            Transfer.rxData = Transaction->Segments[i].rxData;
+            Transfer.length = Transaction->Segments[i].length;
+            Status = SPI_transfer(&Transfer, timeout);
+        }
+    }
+
+    DIO_pinWrite(&Transaction->ChipSelect, DIO_HIGH);
+
+    return Status;
+}
+
+/*****************************************************************************
+ * Function: SPI_registerWrite()
+ *//**
+    * \b Description:
+    * This function is used to directly address and modify a SPI register.
+    * The function should be used to access specialized functionality in 
+    * the SPI peripheral that is not exposed by any other function of the
+    * interface.
+    * 
+    * PRE-CONDITION: The SPI peripheral must be initialized (SPI_init).<br>
+    * PRE-CONDITION: Address is within the boundaries of the SPI register
+    *                map. <br>
+    * 
+    * POST-CONDITION: The data is written to the address.<br>
+    * 
+    * @param[in]   address is the address of the register to write to.
+    * @param[in]   value is the value to write to the SPI register.
+    * 
+    * @return void
+    * 
+    * \b Example:
+    * @code
+    * SPI_registerWrite(0x40013004, 0x03);
+    * @endcode
+    * 
+    * @see SPI_configGet
+    * @see SPI_configSizeGet
+    * @see SPI_init
+    * @see SPI_transfer
+    * @see SPI_transaction
+    * @see SPI_registerWrite
+    * @see SPI_registerRead
+    * 
+*****************************************************************************/
+void SPI_registerWrite(const uint32_t address, const uint32_t value)
+{
+    /* Write the value to the address */
+    volatile uint32_t * const registerPointer = (uint32_t*)address;
+    *registerPointer = value;
+}
+
+/*****************************************************************************
+ * Function: SPI_registerRead()
+ *//**
+    * \b Description:
+    * This function is used to directly address and read a SPI register.
+    * The function should be used to access specialized functionality in 
+    * the SPI peripheral that is not exposed by any other function of the
+    * interface.
+    * 
+    * PRE-CONDITION: The SPI peripheral must be initialized (SPI_init). <br>
+    * PRE-CONDITION: Address is within the boundaries of the SPI register
+    *                map. <br>
+    * 
+    * POST-CONDITION: The data is read from the address. <br>
+    * 
+    * @param[in]   address is the address of the register to read from.
+    * 
+    * @return the value of the register.
+    * 
+    * \b Example:
+    * @code
+    * uint32_t value = SPI_registerRead(0x40013008);
+    * @endcode
+    * 
+    * @see SPI_configGet
+    * @see SPI_configSizeGet
+    * @see SPI_init
+    * @see SPI_transfer
+    * @see SPI_transaction
+    * @see SPI_registerWrite
+    * @see SPI_registerRead
+    * 
+*****************************************************************************/
+uint32_t SPI_registerRead(const uint32_t address)
+{
+    /* Read the value from the address */
+    volatile uint32_t * const registerPointer = (uint32_t*)address;
+    return *registerPointer;
+}
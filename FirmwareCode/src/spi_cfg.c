@@ -0,0 +1,134 @@
+/**
+ * @file spi_cfg.c
+ * @author Jose Luis Figueroa
+ * @brief This module contains the implementation for the Serial Peripheral
+ * Interface configuration.
+ * @version 1.1
+ * @date 2025-03-25
+ * 
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ * 
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "spi_cfg.h"
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/**
+ * The following array contains the configuration data for each SPI 
+ * peripheral. Each row represent a single SPI peripheral. Each column is 
+ * representing a member of the SpiConfig_t structure. This table is read 
+ * in by SPI_init, where each peripheral is then set up based on this table.
+ * The port is enabled once its pins (DioConfig) and its TX and RX streams 
+ * (DmaConfig) are configured: SPI1 is served by DMA2 stream 3 (TX) and 
+ * stream 0 or 2 (RX) on channel 3.
+ */
+const SpiConfig_t SpiConfig[] = 
+{
+/*                                                          
+ *  Port        Mode             ClockPolarity           ClockPhase
+ *  BaudRate             DataSize         BitOrder
+ *  SlaveSelect                SPI Enabler
+*/ 
+   {SPI_PORT_1, SPI_MODE_MASTER, SPI_CLOCK_POLARITY_LOW, SPI_CLOCK_PHASE_FIRST,
+   SPI_BAUD_RATE_DIV_16, SPI_DATA_SIZE_8, SPI_BIT_ORDER_MSB_FIRST,
+   SPI_SLAVE_SELECT_SOFTWARE, SPI_DISABLED},
+};
+
+/*****************************************************************************
+ * Function Prototypes
+*****************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: SPI_configGet()
+ */
+/**
+ * \b Description
+ * This function is used to initialize the SPI based on the configuration 
+ * table defined in spi_cfg module.
+ * 
+ * PRE-CONDITION: The configuration table needs to be populated (sizeof > 0) <br>
+ * 
+ * POST-CONDITION: A constant pointer to the first member of the configuration
+ * table is returned. <br>
+ * 
+ * @return A pointer to the configuration table. <br>
+ * 
+ * \b Example:
+ * @code
+ * const SpiConfig_t * const SpiConfig = SPI_configGet();
+ * size_t configSize = SPI_configSizeGet();
+ * 
+ * SPI_init(SpiConfig, configSize);
+ * @endcode
+ * 
+ * @see SPI_configGet
+ * @see SPI_configSizeGet
+ * @see SPI_init
+ * @see SPI_transfer
+ * @see SPI_transaction
+ * @see SPI_registerWrite
+ * @see SPI_registerRead
+ * 
+*****************************************************************************/
+const SpiConfig_t * const SPI_configGet(void)
+{
+    /* The cast is performed to ensure that the address of the first element 
+     * of configuration table is returned as a constant pointer and not a
+     * pointer that can be modified
+    */
+    return (const SpiConfig_t *)&SpiConfig[0];
+}
+
+/*****************************************************************************
+ * Function: SPI_configSizeGet()
+*/
+/**
+*\b Description:
+ * This function is used to get the size of the configuration table.
+ * 
+ * PRE-CONDITION: configuration table needs to be populated (sizeof > 0) <br>
+ * 
+ * POST-CONDITION: The size of the configuration table will be returned. <br>
+ * 
+ * @return The size of the configuration table.
+ * 
+ * \b Example: 
+ * @code
+ * const SpiConfig_t * const SpiConfig = SPI_configGet();
+ * size_t configSize = SPI_configSizeGet();
+ * 
+ * SPI_init(SpiConfig, configSize);
+ * @endcode
+ * 
+ * @see SPI_configGet
+ * @see SPI_configSizeGet
+ * @see SPI_init
+ * @see SPI_transfer
+ * @see SPI_transaction
+ * @see SPI_registerWrite
+ * @see SPI_registerRead
+ * 
+*****************************************************************************/
+size_t SPI_configSizeGet(void)
+{
+   return sizeof(SpiConfig)/sizeof(SpiConfig[0]);
+}
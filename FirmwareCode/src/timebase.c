@@ -0,0 +1,276 @@
+/**
+ * @file timebase.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the timebase. TIM2 counts the microseconds
+ * over its full 32-bit range and its capture/compare channel 1 is used as
+ * the alarm that wakes up the processor on a deadline.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "timebase.h"   /*For this modules definitions*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the auto-reload value of the counter, so it uses the full 32 bits.
+*/
+#define TIMEBASE_COUNTER_MAX 0xFFFFFFFFUL
+
+/**
+ * Defines the number of counts of the 16-bit prescaler.
+*/
+#define TIMEBASE_PRESCALER_COUNTS 65536UL
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: TIMEBASE_init()
+ *//**
+ * \b Description:
+ * This function is used to initialize the timebase. The TIM2 counter is
+ * prescaled to 1 MHz and counts up over its full 32-bit range.
+ *
+ * PRE-CONDITION: The TIM2 clock must be enabled. <br>
+ * PRE-CONDITION: The timer clock is a multiple of 1 MHz. <br>
+ *
+ * POST-CONDITION: The timebase counts the microseconds from zero. <br>
+ *
+ * @param[in]   timerClock is the clock of TIM2 in Hz.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+ * TIMEBASE_init(16000000UL);
+ * @endcode
+ *
+ * @see TIMEBASE_init
+ * @see TIMEBASE_now
+ * @see TIMEBASE_deadlineGet
+ * @see TIMEBASE_deadlineCheck
+ * @see TIMEBASE_alarmSet
+ * @see TIMEBASE_alarmClear
+ *
+*****************************************************************************/
+void TIMEBASE_init(const uint32_t timerClock)
+{
+    /*Review if the timer clock can be divided down to 1 MHz*/
+    assert((timerClock % TIMEBASE_FREQUENCY) == 0U);
+    assert((timerClock / TIMEBASE_FREQUENCY) <= TIMEBASE_PRESCALER_COUNTS);
+
+    TIM2->CR1 &= ~TIM_CR1_CEN;
+
+    TIM2->PSC = (timerClock / TIMEBASE_FREQUENCY) - 1U;
+    TIM2->ARR = TIMEBASE_COUNTER_MAX;
+    TIM2->CNT = 0U;
+
+    /* Load the prescaler and clear the update flag set by the load */
+    TIM2->EGR = TIM_EGR_UG;
+    TIM2->SR = 0U;
+
+    TIMEBASE_alarmClear();
+
+    TIM2->CR1 |= TIM_CR1_CEN;
+}
+
+/*****************************************************************************
+ * Function: TIMEBASE_now()
+ *//**
+ * \b Description:
+ * This function is used to read the current timestamp in microseconds.
+ *
+ * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @return The microseconds since TIMEBASE_init, modulo 2^32.
+ *
+ * \b Example:
+ * @code
+ * uint32_t start = TIMEBASE_now();
+ * DMA_transferWait(DMA1_STREAM_6);
+ * uint32_t duration = TIMEBASE_now() - start;
+ * @endcode
+ *
+ * @see TIMEBASE_init
+ * @see TIMEBASE_now
+ * @see TIMEBASE_deadlineGet
+ * @see TIMEBASE_deadlineCheck
+ * @see TIMEBASE_alarmSet
+ * @see TIMEBASE_alarmClear
+ *
+*****************************************************************************/
+uint32_t TIMEBASE_now(void)
+{
+    return TIM2->CNT;
+}
+
+/*****************************************************************************
+ * Function: TIMEBASE_deadlineGet()
+ *//**
+ * \b Description:
+ * This function is used to compute the deadline that is a timeout away
+ * from now.
+ *
+ * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+ * PRE-CONDITION: The timeout is below 2^31 microseconds. <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   timeout is the time to the deadline in microseconds.
+ *
+ * @return The timestamp of the deadline.
+ *
+ * \b Example:
+ * @code
+ * uint32_t deadline = TIMEBASE_deadlineGet(1000U);
+ * @endcode
+ *
+ * @see TIMEBASE_init
+ * @see TIMEBASE_now
+ * @see TIMEBASE_deadlineGet
+ * @see TIMEBASE_deadlineCheck
+ * @see TIMEBASE_alarmSet
+ * @see TIMEBASE_alarmClear
+ *
+*****************************************************************************/
+uint32_t TIMEBASE_deadlineGet(const uint32_t timeout)
+{
+    return TIMEBASE_now() + timeout;
+}
+
+/*****************************************************************************
+ * Function: TIMEBASE_deadlineCheck()
+ *//**
+ * \b Description:
+ * This function is used to check if a deadline has been reached. The
+ * difference between now and the deadline is read as a signed number, so
+ * the check is not affected by the wrap of the counter.
+ *
+ * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   deadline is the timestamp of the deadline.
+ *
+ * @return TIMEBASE_EXPIRED if the deadline has been reached, otherwise
+ *         TIMEBASE_PENDING.
+ *
+ * \b Example:
+ * @code
+ * while(TIMEBASE_deadlineCheck(deadline) == TIMEBASE_PENDING)
+ * {
+ * }
+ * @endcode
+ *
+ * @see TIMEBASE_init
+ * @see TIMEBASE_now
+ * @see TIMEBASE_deadlineGet
+ * @see TIMEBASE_deadlineCheck
+ * @see TIMEBASE_alarmSet
+ * @see TIMEBASE_alarmClear
+ *
+*****************************************************************************/
+TimebaseDeadline_t TIMEBASE_deadlineCheck(const uint32_t deadline)
+{
+    return (((int32_t)(TIMEBASE_now() - deadline)) >= 0) ?
+        TIMEBASE_EXPIRED : TIMEBASE_PENDING;
+}
+
+/*****************************************************************************
+ * Function: TIMEBASE_alarmSet()
+ *//**
+ * \b Description:
+ * This function is used to arm the alarm of the timebase. The compare
+ * interrupt of channel 1 becomes pending when the counter reaches the
+ * deadline, which wakes up the processor from IDLE_sleep. The interrupt
+ * stays disabled in the NVIC, so no handler is needed.
+ *
+ * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+ *
+ * POST-CONDITION: The alarm is armed. <br>
+ *
+ * @param[in]   deadline is the timestamp of the alarm.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * TIMEBASE_alarmSet(TIMEBASE_deadlineGet(500U));
+ * IDLE_sleep();
+ * TIMEBASE_alarmClear();
+ * @endcode
+ *
+ * @see TIMEBASE_init
+ * @see TIMEBASE_now
+ * @see TIMEBASE_deadlineGet
+ * @see TIMEBASE_deadlineCheck
+ * @see TIMEBASE_alarmSet
+ * @see TIMEBASE_alarmClear
+ *
+*****************************************************************************/
+void TIMEBASE_alarmSet(const uint32_t deadline)
+{
+    TIM2->CCR1 = deadline;
+    TIM2->SR = (uint32_t)~TIM_SR_CC1IF;
+    NVIC_ClearPendingIRQ(TIMEBASE_IRQ);
+    TIM2->DIER |= TIM_DIER_CC1IE;
+}
+
+/*****************************************************************************
+ * Function: TIMEBASE_alarmClear()
+ *//**
+ * \b Description:
+ * This function is used to disarm the alarm of the timebase.
+ *
+ * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+ *
+ * POST-CONDITION: The alarm is disarmed and its interrupt is not pending.
+ * <br>
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * TIMEBASE_alarmClear();
+ * @endcode
+ *
+ * @see TIMEBASE_init
+ * @see TIMEBASE_now
+ * @see TIMEBASE_deadlineGet
+ * @see TIMEBASE_deadlineCheck
+ * @see TIMEBASE_alarmSet
+ * @see TIMEBASE_alarmClear
+ *
+*****************************************************************************/
+void TIMEBASE_alarmClear(void)
+{
+    TIM2->DIER &= ~TIM_DIER_CC1IE;
+    TIM2->SR = (uint32_t)~TIM_SR_CC1IF;
+    NVIC_ClearPendingIRQ(TIMEBASE_IRQ);
+}
@@ -12,18 +12,77 @@
 * Includes
 *****************************************************************************/
 #include "usart.h"        /*For this modules definitions*/
+#include "idle.h"         /*For the event-driven waits*/
+#include "timebase.h"     /*For the timeouts and the timestamps*/
 
 /*****************************************************************************
 * Module Preprocessor Constants
 *****************************************************************************/
+/**
+ * Defines the bits of the control registers that are set by a UsartConfig_t
+ * row. The other bits (interrupt enables, modes) are kept on a 
+ * reconfiguration. The mute state (RWU) is changed by the hardware, so it
+ * is only set by the initialization.
+*/
+#define USART_CR1_CONFIG_MASK (USART_CR1_M | USART_CR1_PCE | USART_CR1_RE | \
+    USART_CR1_TE | USART_CR1_UE | USART_CR1_OVER8 | USART_CR1_WAKE)
+#define USART_CR2_CONFIG_MASK (USART_CR2_STOP | USART_CR2_CLKEN | \
+    USART_CR2_CPOL | USART_CR2_CPHA | USART_CR2_LBCL | USART_CR2_ADD)
+#define USART_CR3_CONFIG_MASK (USART_CR3_DMAR | USART_CR3_DMAT)
+
+/**
+ * Defines the bits of the frame format. They can not be changed while a 
+ * character is on the line, so the port is disabled to change them.
+*/
+#define USART_CR1_FRAME_MASK (USART_CR1_M | USART_CR1_PCE | USART_CR1_OVER8)
+
+/**
+ * Defines the length of the start bit and of the data bits of a frame, in
+ * half bit times, as the stop bits may be 0.5 or 1.5 bits long.
+*/
+#define USART_START_HALF_BITS   2U
+#define USART_DATA_HALF_BITS_8  16U
+#define USART_DATA_HALF_BITS_9  18U
+
+/**
+ * Defines the time allowed to the RX stream of a message to stop in the 
+ * interrupt handler (us). The stream only completes its current data item.
+*/
+#define USART_STOP_TIMEOUT      100U
 
 /*****************************************************************************
 * Module Preprocessor Macros
 *****************************************************************************/
+/**
+ * Checks a setting of the USART configuration table. It is removed from 
+ * USART_init when the build defines CONFIG_TABLES_CHECKED, as the table has
+ * already been validated by the build-time checker. The port indexes the
+ * register tables and is checked with assert.
+*/
+#ifdef CONFIG_TABLES_CHECKED
+#define USART_CONFIG_ASSERT(expression) ((void)0)
+#else
+#define USART_CONFIG_ASSERT(expression) assert(expression)
+#endif
 
 /*****************************************************************************
 * Module Typedefs
 *****************************************************************************/
+/**
+ * Defines the driver enable of a RS-485 port. The words drive the DE pin
+ * with a single store to the bit set/reset register of its port.
+*/
+typedef struct
+{
+    uint32_t volatile * bsrr;   /**< Bit set/reset register of the DE pin*/
+    uint32_t on;                /**< Word that enables the driver*/
+    uint32_t off;               /**< Word that disables the driver*/
+    DmaStream_t Stream;         /**< DMA stream of the USART TX*/
+    volatile uint32_t enabled;  /**< The driver is enabled*/
+    uint32_t length;            /**< Transfers of the last transmission*/
+    uint32_t start;             /**< Cycle counter at the stream start*/
+    volatile uint32_t end;      /**< Cycle counter at the driver release*/
+}UsartDriverEnable_t;
 
 /*****************************************************************************
 * Module Variable Definitions
@@ -64,11 +123,34 @@ static uint32_t volatile * const dataRegister[USART_PORTS_NUMBER] =
     (uint32_t*)&USART1->DR, (uint32_t*)&USART2->DR, (uint32_t*)&USART6->DR
 };
 
+/* Defines the interrupt of each USART, used to wake up the processor*/
+static const IRQn_Type usartIrq[USART_PORTS_NUMBER] =
+{
+    USART1_IRQn, USART2_IRQn, USART6_IRQn
+};
+
+/* Defines the receive-to-idle of each port (NULL when not receiving)*/
+static const UsartRxIdleConfig_t * rxIdleConfig[USART_PORTS_NUMBER] =
+{
+    NULL, NULL, NULL
+};
+
+/* Defines the ping-pong buffer being filled by the DMA on each port*/
+static uint8_t rxIdleBuffer[USART_PORTS_NUMBER] = {0U, 0U, 0U};
+
+/* Defines the driver enable of each port (bsrr is NULL when not used)*/
+static UsartDriverEnable_t driverEnable[USART_PORTS_NUMBER];
+
+/* Defines the length of the stop bits of each UsartStopBits_t, in half bit
+ * times
+*/
+static const uint8_t stopHalfBits[USART_STOP_BITS_MAX] = {2U, 1U, 4U, 3U};
+
 /*****************************************************************************
 * Function Prototypes
 *****************************************************************************/
 static uint16_t USART_baudRateCalculate(const uint32_t peripheralClock, 
-const uint32_t BaudRate);
+const uint32_t BaudRate, const UsartOversampling_t Oversampling);
 
 /*****************************************************************************
 * Function Definitions
@@ -111,6 +193,17 @@ const uint32_t BaudRate);
     * @see USART_init
     * @see USART_transmit
     * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
     * @see USART_registerWrite
     * @see USART_registerRead
     * 
@@ -136,7 +229,7 @@ void USART_init(const UsartConfig_t * const Config,
         }
         else 
         {
-            assert(Config[i].WordLength < USART_WORD_LENGTH_MAX);
+            USART_CONFIG_ASSERT(Config[i].WordLength < USART_WORD_LENGTH_MAX);
         }
 
         /* Set the number of stop bits */
@@ -162,9 +255,104 @@ void USART_init(const UsartConfig_t * const Config,
         }
         else
         {
-            assert(Config[i].StopBits < USART_STOP_BITS_MAX);
+            USART_CONFIG_ASSERT(Config[i].StopBits < USART_STOP_BITS_MAX);
+        }
+
+        /* Set the synchronous mode. The clock settings are written before
+         * the transmitter is enabled.
+        */
+        if(Config[i].Clock == USART_CLOCK_ENABLED)
+        {
+            *controlRegister2[Config[i].Port] |= USART_CR2_CLKEN;
+        }
+        else if(Config[i].Clock == USART_CLOCK_DISABLED)
+        {
+            *controlRegister2[Config[i].Port] &= ~USART_CR2_CLKEN;
+        }
+        else
+        {
+            USART_CONFIG_ASSERT(Config[i].Clock < USART_CLOCK_MAX);
+        }
+
+        /* Set the clock polarity */
+        if(Config[i].ClockPolarity == USART_CLOCK_POLARITY_HIGH)
+        {
+            *controlRegister2[Config[i].Port] |= USART_CR2_CPOL;
+        }
+        else if(Config[i].ClockPolarity == USART_CLOCK_POLARITY_LOW)
+        {
+            *controlRegister2[Config[i].Port] &= ~USART_CR2_CPOL;
+        }
+        else
+        {
+            USART_CONFIG_ASSERT(Config[i].ClockPolarity < 
+                USART_CLOCK_POLARITY_MAX);
+        }
+
+        /* Set the clock phase */
+        if(Config[i].ClockPhase == USART_CLOCK_PHASE_SECOND)
+        {
+            *controlRegister2[Config[i].Port] |= USART_CR2_CPHA;
+        }
+        else if(Config[i].ClockPhase == USART_CLOCK_PHASE_FIRST)
+        {
+            *controlRegister2[Config[i].Port] &= ~USART_CR2_CPHA;
+        }
+        else
+        {
+            USART_CONFIG_ASSERT(Config[i].ClockPhase < USART_CLOCK_PHASE_MAX);
+        }
+
+        /* Set the clock pulse of the last bit */
+        if(Config[i].LastBitClock == USART_LAST_BIT_CLOCK_ENABLED)
+        {
+            *controlRegister2[Config[i].Port] |= USART_CR2_LBCL;
+        }
+        else if(Config[i].LastBitClock == USART_LAST_BIT_CLOCK_DISABLED)
+        {
+            *controlRegister2[Config[i].Port] &= ~USART_CR2_LBCL;
+        }
+        else
+        {
+            USART_CONFIG_ASSERT(Config[i].LastBitClock < 
+                USART_LAST_BIT_CLOCK_MAX);
+        }
+
+        /* Set the oversampling */
+        if(Config[i].Oversampling == USART_OVERSAMPLING_8)
+        {
+            *controlRegister1[Config[i].Port] |= USART_CR1_OVER8;
+        }
+        else if(Config[i].Oversampling == USART_OVERSAMPLING_16)
+        {
+            *controlRegister1[Config[i].Port] &= ~USART_CR1_OVER8;
+        }
+        else
+        {
+            USART_CONFIG_ASSERT(Config[i].Oversampling < 
+                USART_OVERSAMPLING_MAX);
+        }
+
+        /* Set the wakeup event of the mute mode */
+        if(Config[i].Wakeup == USART_WAKEUP_ADDRESS_MARK)
+        {
+            *controlRegister1[Config[i].Port] |= USART_CR1_WAKE;
+        }
+        else if(Config[i].Wakeup == USART_WAKEUP_IDLE_LINE)
+        {
+            *controlRegister1[Config[i].Port] &= ~USART_CR1_WAKE;
+        }
+        else
+        {
+            USART_CONFIG_ASSERT(Config[i].Wakeup < USART_WAKEUP_MAX);
         }
 
+        /* Set the node address */
+        USART_CONFIG_ASSERT(Config[i].Address <= USART_ADDRESS_MAX);
+        *controlRegister2[Config[i].Port] = 
+            (*controlRegister2[Config[i].Port] & ~USART_CR2_ADD) |
+            ((uint32_t)Config[i].Address << USART_CR2_ADD_Pos);
+
         /* Set the parity */
         if(Config[i].Parity == USART_PARITY_ENABLED)
         {
@@ -176,7 +364,7 @@ void USART_init(const UsartConfig_t * const Config,
         }
         else
         {
-            assert(Config[i].Parity < USART_PARITY_MAX);
+            USART_CONFIG_ASSERT(Config[i].Parity < USART_PARITY_MAX);
         }
 
         /* Set the RX mode */
@@ -190,7 +378,7 @@ void USART_init(const UsartConfig_t * const Config,
         }
         else
         {
-            assert(Config[i].Rx < USART_RX_MAX);
+            USART_CONFIG_ASSERT(Config[i].Rx < USART_RX_MAX);
         }
 
         /* Set the TX mode */
@@ -204,7 +392,7 @@ void USART_init(const UsartConfig_t * const Config,
         }
         else
         {
-            assert(Config[i].Tx < USART_TX_MAX);
+            USART_CONFIG_ASSERT(Config[i].Tx < USART_TX_MAX);
         }
 
         /* Set the configuration of the USART on the control register 3*/
@@ -219,7 +407,7 @@ void USART_init(const UsartConfig_t * const Config,
         }
         else
         {
-            assert(Config[i].RxDma < USART_RX_DMA_MAX);
+            USART_CONFIG_ASSERT(Config[i].RxDma < USART_RX_DMA_MAX);
         }
 
         /* Set the TX DMA mode */
@@ -233,7 +421,7 @@ void USART_init(const UsartConfig_t * const Config,
         }
         else
         {
-            assert(Config[i].TxDma < USART_TX_DMA_MAX);
+            USART_CONFIG_ASSERT(Config[i].TxDma < USART_TX_DMA_MAX);
         }
 
         /* Set the enable */
@@ -247,37 +435,264 @@ void USART_init(const UsartConfig_t * const Config,
         }
         else
         {
-            assert(Config[i].Enable < USART_UE_MAX);
+            USART_CONFIG_ASSERT(Config[i].Enable < USART_UE_MAX);
         }
 
-        /* Set the configuration of the USART on the Baud Rate Register*/
-        /* Set the baud rate */
-        if(Config[i].BaudRate == USART_BAUD_RATE_9600)
-        {
-            *baudRateRegister[Config[i].Port] = USART_baudRateCalculate(peripheralClock, 9600);
-        }
-        else if(Config[i].BaudRate == USART_BAUD_RATE_19200)
-        {
-            *baudRateRegister[Config[i].Port] = USART_baudRateCalculate(peripheralClock, 19200);
-        }
-        else if(Config[i].BaudRate == USART_BAUD_RATE_38400)
+        /* Mute the receiver, once the port is enabled */
+        if(Config[i].Mute == USART_MUTE_ENABLED)
         {
-            *baudRateRegister[Config[i].Port] = USART_baudRateCalculate(peripheralClock, 38400);
+            *controlRegister1[Config[i].Port] |= USART_CR1_RWU;
         }
-        else if(Config[i].BaudRate == USART_BAUD_RATE_57600)
+        else
         {
-            *baudRateRegister[Config[i].Port] = USART_baudRateCalculate(peripheralClock, 57600);
+            USART_CONFIG_ASSERT(Config[i].Mute < USART_MUTE_MAX);
         }
-        else if(Config[i].BaudRate == USART_BAUD_RATE_115200)
+
+        /* Set the configuration of the USART on the Baud Rate Register*/
+        /* Set the baud rate. The settings of UsartBaudRate_t are the baud
+         * rates, and the divider depends on the oversampling.
+        */
+        USART_CONFIG_ASSERT(Config[i].BaudRate < USART_BAUD_RATE_MAX);
+        *baudRateRegister[Config[i].Port] = USART_baudRateCalculate(
+            peripheralClock, (uint32_t)Config[i].BaudRate, 
+            Config[i].Oversampling);
+    
+    }
+}
+
+/*****************************************************************************
+ * Function: USART_imageInit()
+*//**
+    *\b Description:
+    * This function is used to initialize the USART ports with the register
+    * images generated from the configuration table. Each register is written
+    * with a single store. Control register 1 is written last, so the port is
+    * enabled (UE) with the frame format and the baud rate already set. A
+    * muted receiver (RWU) is muted by a second store, once the port is
+    * enabled.
+    * 
+    * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
+    * PRE-CONDITION: The images are generated from the configuration table
+    *                with the bus clocks of the board (cfg_generate.py). <br>
+    * 
+    * POST-CONDITION: The USART ports are set up with the images. <br>
+    * 
+    * @param[in]   Image is a pointer to the register images of the ports.
+    * @param[in]   imageSize is the number of images.
+    * 
+    * @return void
+    * 
+    * \b Example:
+    * @code
+    * const UsartPortImage_t * const UsartImage = USART_imageGet();
+    * size_t imageSize = USART_imageSizeGet();
+    * 
+    * USART_imageInit(UsartImage, imageSize);
+    * @endcode
+    * 
+    * @see USART_configGet
+    * @see USART_configSizeGet
+    * @see USART_imageGet
+    * @see USART_imageSizeGet
+    * @see USART_init
+    * @see USART_imageInit
+    * 
+*****************************************************************************/
+void USART_imageInit(const UsartPortImage_t * const Image, size_t imageSize)
+{
+    for(size_t i=0; i<imageSize; i++)
+    {
+        /* Prevent to assign a value out of the range of the port.*/
+        assert(Image[i].Port < USART_PORT_MAX);
+
+        *controlRegister2[Image[i].Port] = Image[i].cr2;
+        *controlRegister3[Image[i].Port] = Image[i].cr3;
+        *baudRateRegister[Image[i].Port] = Image[i].brr;
+        *controlRegister1[Image[i].Port] = Image[i].cr1 & ~USART_CR1_RWU;
+        if(Image[i].cr1 & USART_CR1_RWU)
         {
-            *baudRateRegister[Config[i].Port] = USART_baudRateCalculate(peripheralClock, 115200);
+            *controlRegister1[Image[i].Port] = Image[i].cr1;
         }
-        else 
+    }
+}
+
+/*****************************************************************************
+ * Function: USART_imageCompose()
+*//**
+    *\b Description:
+    * This function is used to compose the register images of a 
+    * configuration row. The settings of UsartConfig_t are the encodings of 
+    * the register fields, so each field is placed with a shift.
+    * 
+    * PRE-CONDITION: The setting is within the maximum values (USART_MAX). 
+    * <br>
+    * 
+    * POST-CONDITION: Image holds the CR1, CR2, CR3 and BRR bits of the row.
+    * <br>
+    * 
+    * @param[in]   Config is a pointer to the configuration row.
+    * @param[in]   peripheralClock is the frequency of the bus of the port.
+    * @param[out]  Image is the register image of the port.
+    * 
+    * @return void
+    * 
+    * \b Example:
+    * @code
+    * UsartPortImage_t Image;
+    * USART_imageCompose(&UsartConfig[0], APB1_CLOCK, &Image);
+    * @endcode
+    * 
+    * @see USART_init
+    * @see USART_imageInit
+    * @see USART_imageCompose
+    * @see USART_reconfigure
+    * 
+*****************************************************************************/
+void USART_imageCompose(const UsartConfig_t * const Config, 
+    const uint32_t peripheralClock, UsartPortImage_t * const Image)
+{
+    /*Review if the settings are correct. The row can be built at run time,
+     *so it is checked whether or not the tables were checked at build time
+    */
+    assert(Config->Port < USART_PORT_MAX);
+    assert(Config->WordLength < USART_WORD_LENGTH_MAX);
+    assert(Config->StopBits < USART_STOP_BITS_MAX);
+    assert(Config->BaudRate < USART_BAUD_RATE_MAX);
+
+    Image->Port = Config->Port;
+    Image->cr1 = ((Config->WordLength == USART_WORD_LENGTH_9) ? 
+            USART_CR1_M : 0U) |
+        ((Config->Parity == USART_PARITY_ENABLED) ? USART_CR1_PCE : 0U) |
+        ((Config->Rx == USART_RX_ENABLED) ? USART_CR1_RE : 0U) |
+        ((Config->Tx == USART_TX_ENABLED) ? USART_CR1_TE : 0U) |
+        ((Config->Enable == USART_ENABLED) ? USART_CR1_UE : 0U) |
+        ((Config->Oversampling == USART_OVERSAMPLING_8) ? 
+            USART_CR1_OVER8 : 0U) |
+        ((Config->Wakeup == USART_WAKEUP_ADDRESS_MARK) ? 
+            USART_CR1_WAKE : 0U) |
+        ((Config->Mute == USART_MUTE_ENABLED) ? USART_CR1_RWU : 0U);
+    Image->cr2 = ((uint32_t)Config->StopBits << USART_CR2_STOP_Pos) |
+        ((Config->Clock == USART_CLOCK_ENABLED) ? USART_CR2_CLKEN : 0U) |
+        ((Config->ClockPolarity == USART_CLOCK_POLARITY_HIGH) ? 
+            USART_CR2_CPOL : 0U) |
+        ((Config->ClockPhase == USART_CLOCK_PHASE_SECOND) ? 
+            USART_CR2_CPHA : 0U) |
+        ((Config->LastBitClock == USART_LAST_BIT_CLOCK_ENABLED) ? 
+            USART_CR2_LBCL : 0U) |
+        (((uint32_t)Config->Address << USART_CR2_ADD_Pos) & USART_CR2_ADD);
+    Image->cr3 = ((Config->RxDma == USART_RX_DMA_ENABLED) ? 
+            USART_CR3_DMAR : 0U) |
+        ((Config->TxDma == USART_TX_DMA_ENABLED) ? USART_CR3_DMAT : 0U);
+    Image->brr = USART_baudRateCalculate(peripheralClock, 
+        (uint32_t)Config->BaudRate, Config->Oversampling);
+}
+
+/*****************************************************************************
+ * Function: USART_reconfigure()
+*//**
+    *\b Description:
+    * This function is used to switch a port to another configuration row, 
+    * e.g. to change the baud rate. The current registers are compared with
+    * the image of the row and only a register with different configuration
+    * bits is written, once. If the frame format or the baud rate changes
+    * while the port is enabled, the last character is transmitted (TC) and
+    * the port is disabled before the change and enabled after it. The 
+    * interrupt enables and the other modes of the port are kept. If the 
+    * last character does not leave the line within the timeout, e.g. the 
+    * synchronous clock is held, the port is left unchanged.
+    * 
+    * PRE-CONDITION: The MCU clocks must be configured and enabled. <br>
+    * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
+    * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+    * PRE-CONDITION: The setting is within the maximum values (USART_MAX). 
+    * <br>
+    * 
+    * POST-CONDITION: The port is set up with the row if USART_OK is 
+    *                 returned. <br>
+    * 
+    * @param[in]   Config is a pointer to the configuration row.
+    * @param[in]   peripheralClock is the frequency of the bus of the port.
+    * @param[in]   timeout is the time allowed to the last character in 
+    *              microseconds.
+    * 
+    * @return USART_OK if the port was set up, otherwise USART_TIMEOUT.
+    * 
+    * \b Example:
+    * @code
+    * if(USART_reconfigure(&UsartFastConfig, APB1_CLOCK, 2000U) != USART_OK)
+    * {
+    *     //The port keeps its previous configuration
+    * }
+    * @endcode
+    * 
+    * @see USART_init
+    * @see USART_imageInit
+    * @see USART_imageCompose
+    * @see USART_reconfigure
+    * 
+*****************************************************************************/
+UsartStatus_t USART_reconfigure(const UsartConfig_t * const Config, 
+    const uint32_t peripheralClock, const uint32_t timeout)
+{
+    UsartPortImage_t Image;
+    uint32_t cr1;
+    uint32_t cr2;
+    uint32_t cr3;
+    uint32_t frameChange;
+
+    USART_imageCompose(Config, peripheralClock, &Image);
+
+    cr1 = *controlRegister1[Config->Port];
+    cr2 = *controlRegister2[Config->Port];
+    cr3 = *controlRegister3[Config->Port];
+
+    frameChange = ((cr1 ^ Image.cr1) & USART_CR1_FRAME_MASK) | 
+        ((cr2 ^ Image.cr2) & USART_CR2_CONFIG_MASK) |
+        (*baudRateRegister[Config->Port] ^ Image.brr);
+
+    /* Let the last character leave the line and disable the port. The TC 
+     * interrupt wakes up the processor while the character is transmitted.
+    */
+    if((frameChange != 0U) && (cr1 & USART_CR1_UE))
+    {
+        *controlRegister1[Config->Port] = cr1 | USART_CR1_TCIE;
+        if(IDLE_waitForDeadline(statusRegister[Config->Port], USART_SR_TC, 
+            USART_SR_TC, usartIrq[Config->Port], 
+            TIMEBASE_deadlineGet(timeout)) == IDLE_TIMEOUT)
         {
-            assert(Config[i].BaudRate < USART_BAUD_RATE_MAX);
+            *controlRegister1[Config->Port] = cr1;
+            return USART_TIMEOUT;
         }
-    
+        cr1 &= ~USART_CR1_UE;
+        *controlRegister1[Config->Port] = cr1;
+    }
+
+    if((cr2 ^ Image.cr2) & USART_CR2_CONFIG_MASK)
+    {
+        *controlRegister2[Config->Port] = 
+            (cr2 & ~USART_CR2_CONFIG_MASK) | Image.cr2;
+    }
+
+    if((cr3 ^ Image.cr3) & USART_CR3_CONFIG_MASK)
+    {
+        *controlRegister3[Config->Port] = 
+            (cr3 & ~USART_CR3_CONFIG_MASK) | Image.cr3;
+    }
+
+    if(*baudRateRegister[Config->Port] != Image.brr)
+    {
+        *baudRateRegister[Config->Port] = Image.brr;
+    }
+
+    /* Control register 1 is written last, it enables the port */
+    if((cr1 ^ Image.cr1) & USART_CR1_CONFIG_MASK)
+    {
+        *controlRegister1[Config->Port] = 
+            (cr1 & ~USART_CR1_CONFIG_MASK) | 
+            (Image.cr1 & USART_CR1_CONFIG_MASK);
     }
+
+    return USART_OK;
 }
 
 /*****************************************************************************
@@ -287,9 +702,11 @@ void USART_init(const UsartConfig_t * const Config,
     * \b Description:
     * This function is used to transmit data over the USART bus. This function 
     * is used to send data specified by the UsartTransferConfig_t structure
-    * which contains the port and data.
+    * which contains the port and data. The processor sleeps while the 
+    * transmit buffer is full and is woken up by the TXE interrupt.
     * 
     * PRE-CONDITION: The USART peripheral must be initialized (USART_init). <br>
+    * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
     * PRE-CONDITION: The data must be populated. <br>
     * PRE-CONDITION: UsartPortConfig_t must be populated (sizeof > 0). <br>
     * PRE-CONDITION: The Port is within the maximum UsartPort_t. <br>
@@ -317,6 +734,17 @@ void USART_init(const UsartConfig_t * const Config,
     * @see USART_init
     * @see USART_transmit
     * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
     * @see USART_registerWrite
     * @see USART_registerRead
     * 
@@ -329,11 +757,13 @@ void USART_transmit(const UsartTransferConfig_t * const TransferConfig)
     const uint8_t *auxiliarPointer = TransferConfig->data;
     while(*auxiliarPointer != '\0')
     {
-        /* Wait for the transmit buffer to be empty */
-        while(!(*statusRegister[TransferConfig->Port] & USART_SR_TXE))
-        {
-            asm("nop");
-        }
+        /* Wait for the transmit buffer to be empty. The TXE interrupt wakes
+         * up the processor while the buffer is full.
+        */
+        *controlRegister1[TransferConfig->Port] |= USART_CR1_TXEIE;
+        IDLE_waitFor(statusRegister[TransferConfig->Port], USART_SR_TXE,
+            USART_SR_TXE, usartIrq[TransferConfig->Port]);
+        *controlRegister1[TransferConfig->Port] &= ~USART_CR1_TXEIE;
 
         /* Transmit the data */
         *dataRegister[TransferConfig->Port] = *auxiliarPointer;
@@ -348,13 +778,19 @@ void USART_transmit(const UsartTransferConfig_t * const TransferConfig)
     * This function is used to initialize a data reception on the USART bus. 
     * This function is used to receive data specified by the 
     * UsartTransferConfig_t structure, which contains the port and data.
+    * The processor sleeps until the data arrives and is woken up by the RXNE
+    * interrupt.
     * 
     * PRE-CONDITION: The USART peripheral must be initialized (USART_init). <br>
+    * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
     * PRE-CONDITION: The data must be populated. <br>
     * PRE-CONDITION: UsartPortConfig_t must be populated. (sizeof > 0) <br>
     * PRE-CONDITION: The Port is within the maximum UsartPort_t. <br>
+    * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init) if a
+    *                timestamp is requested. <br>
     * 
     * POST-CONDITION: The data is received over the USART bus.
+    * POST-CONDITION: The arrival time is stored in timestamp (if not NULL).
     * 
     * @param[in]   TransferConfig is a pointer to the configuration table that
     *            contains the data for the data reception.
@@ -377,6 +813,17 @@ void USART_transmit(const UsartTransferConfig_t * const TransferConfig)
     * @see USART_init
     * @see USART_transmit
     * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
     * @see USART_registerWrite
     * @see USART_registerRead
     * 
@@ -384,38 +831,52 @@ void USART_transmit(const UsartTransferConfig_t * const TransferConfig)
 void USART_receive(const UsartTransferConfig_t * const TransferConfig)
 {
     /* Wait for the receive buffer to be full */
-    while(!(*statusRegister[TransferConfig->Port] & USART_SR_RXNE))
+    *controlRegister1[TransferConfig->Port] |= USART_CR1_RXNEIE;
+    IDLE_waitFor(statusRegister[TransferConfig->Port], USART_SR_RXNE,
+        USART_SR_RXNE, usartIrq[TransferConfig->Port]);
+    *controlRegister1[TransferConfig->Port] &= ~USART_CR1_RXNEIE;
+
+    /* Stamp the arrival of the data */
+    if(TransferConfig->timestamp != NULL)
     {
-        asm("nop");
+        *TransferConfig->timestamp = TIMEBASE_now();
     }
 
-    /* Read the data */
-    *TransferConfig->data = *dataRegister[TransferConfig->Port];
+    /* Read the data without the parity bit */
+    *TransferConfig->data = (uint8_t)(*dataRegister[TransferConfig->Port] &
+        USART_dataMaskGet(TransferConfig->Port));
 }
 
 /*****************************************************************************
- * Function: USART_registerWrite()
+ * Function: USART_transmitTimeout()
  *//**
     * \b Description:
-    * This function is used to directly address and modify a USART register.
-    * The function should be used to access specialized functionality in 
-    * the SPI peripheral that is not exposed by any other function of the
-    * interface.
+    * This function is used to transmit data over the USART bus as 
+    * USART_transmit, but the transmission is abandoned if it does not 
+    * complete within the timeout. The data already written to the data 
+    * register is still sent.
     * 
-    * PRE-CONDITION: The USART peripheral must be initialized (USART_init).<br>
-    * PRE-CONDITION: Address is within the boundaries of the USART register
-    *                map. <br>
+    * PRE-CONDITION: The USART peripheral must be initialized (USART_init). <br>
+    * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
+    * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+    * PRE-CONDITION: The data must be populated. <br>
+    * PRE-CONDITION: The Port is within the maximum UsartPort_t. <br>
     * 
-    * POST-CONDITION: The data is written to the address.<br>
+    * POST-CONDITION: The data is transmitted or the timeout elapsed.
     * 
-    * @param[in]   address is the address of the register to write to.
-    * @param[in]   value is the value to write to the USART register.
+    * @param[in]   TransferConfig is a pointer to the configuration table that
+    *             contains the data for the data transfer.
+    * @param[in]   timeout is the time allowed for the transfer in 
+    *             microseconds.
     * 
-    * @return void
+    * @return USART_OK if all the data was written, otherwise USART_TIMEOUT.
     * 
     * \b Example:
     * @code
-    * USART_registerWrite(0x1000003, 0x01);
+    * if(USART_transmitTimeout(&TransferConfig, 5000U) == USART_TIMEOUT)
+    * {
+    *     //Handle the stalled transmitter
+    * }
     * @endcode
     * 
     * @see USART_configGet
@@ -423,39 +884,91 @@ void USART_receive(const UsartTransferConfig_t * const TransferConfig)
     * @see USART_init
     * @see USART_transmit
     * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
     * @see USART_registerWrite
     * @see USART_registerRead
-    *
+    * 
 *****************************************************************************/
-void USART_registerWrite(const uint32_t address, const uint32_t value)
+UsartStatus_t USART_transmitTimeout(
+const UsartTransferConfig_t * const TransferConfig, const uint32_t timeout)
 {
-    /* Write the value to the address */
-    volatile uint32_t * const registerPointer = (uint32_t*)address;
-    *registerPointer = value;
+    UsartStatus_t Status = USART_OK;
+    const uint32_t deadline = TIMEBASE_deadlineGet(timeout);
+
+    /*Prevent to assign a value out of the range of the port.*/
+    assert(TransferConfig->Port < USART_PORT_MAX);
+
+    const uint8_t *auxiliarPointer = TransferConfig->data;
+    while((*auxiliarPointer != '\0') && (Status == USART_OK))
+    {
+        /* Wait for the transmit buffer to be empty */
+        *controlRegister1[TransferConfig->Port] |= USART_CR1_TXEIE;
+        if(IDLE_waitForDeadline(statusRegister[TransferConfig->Port], 
+            USART_SR_TXE, USART_SR_TXE, usartIrq[TransferConfig->Port],
+            deadline) == IDLE_TIMEOUT)
+        {
+            Status = USART_TIMEOUT;
+        }
+        *controlRegister1[TransferConfig->Port] &= ~USART_CR1_TXEIE;
+
+        if(Status == USART_OK)
+        {
+            /* Transmit the data */
+            *dataRegister[TransferConfig->Port] = *auxiliarPointer;
+            auxiliarPointer++;
+        }
+    }
+
+    return Status;
 }
 
 /*****************************************************************************
- * Function: USART_registerRead()
+ * Function: USART_receiveTimeout()
  *//**
     * \b Description:
-    * This function is used to directly address and read a USART register.
-    * The function should be used to access specialized functionality in 
-    * the USART peripheral that is not exposed by any other function of the
-    * interface.
+    * This function is used to receive data over the USART bus as 
+    * USART_receive, but the reception is abandoned if no data arrives within
+    * the timeout.
     * 
     * PRE-CONDITION: The USART peripheral must be initialized (USART_init). <br>
-    * PRE-CONDITION: Address is within the boundaries of the USART register
-    *                map. <br>
+    * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
+    * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+    * PRE-CONDITION: The Port is within the maximum UsartPort_t. <br>
     * 
-    * POST-CONDITION: The data is read from the address. <br>
+    * POST-CONDITION: The data and its arrival time (if timestamp is not NULL)
+    *                 are stored if USART_OK is returned.
     * 
-    * @param[in]   address is the address of the register to read from.
+    * @param[in]   TransferConfig is a pointer to the configuration table that
+    *            contains the data for the data reception.
+    * @param[in]   timeout is the time allowed for the data to arrive in
+    *            microseconds.
     * 
-    * @return the value of the register.
+    * @return USART_OK if the data was received, otherwise USART_TIMEOUT.
     * 
     * \b Example:
     * @code
-    * uint32_t value = USART_registerRead(0x10000003);
+    * char rxBuffer;
+    * uint32_t arrival;
+    * UsartTransferConfig_t TransferConfig =
+    * {
+    *    .Port = USART_PORT_2,
+    *    .data = &rxBuffer,
+    *    .timestamp = &arrival
+    * };
+    * if(USART_receiveTimeout(&TransferConfig, 1000U) == USART_OK)
+    * {
+    *     latency = TIMEBASE_now() - arrival;
+    * }
     * @endcode
     * 
     * @see USART_configGet
@@ -463,23 +976,1028 @@ void USART_registerWrite(const uint32_t address, const uint32_t value)
     * @see USART_init
     * @see USART_transmit
     * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
     * @see USART_registerWrite
     * @see USART_registerRead
     * 
 *****************************************************************************/
-uint32_t USART_registerRead(const uint32_t address)
+UsartStatus_t USART_receiveTimeout(
+const UsartTransferConfig_t * const TransferConfig, const uint32_t timeout)
 {
-    /* Read the value from the address */
-    volatile uint32_t * const registerPointer = (uint32_t*)address;
-    return *registerPointer;
+    UsartStatus_t Status = USART_OK;
+
+    /*Prevent to assign a value out of the range of the port.*/
+    assert(TransferConfig->Port < USART_PORT_MAX);
+
+    /* Wait for the receive buffer to be full */
+    *controlRegister1[TransferConfig->Port] |= USART_CR1_RXNEIE;
+    if(IDLE_waitForDeadline(statusRegister[TransferConfig->Port], 
+        USART_SR_RXNE, USART_SR_RXNE, usartIrq[TransferConfig->Port],
+        TIMEBASE_deadlineGet(timeout)) == IDLE_TIMEOUT)
+    {
+        Status = USART_TIMEOUT;
+    }
+    *controlRegister1[TransferConfig->Port] &= ~USART_CR1_RXNEIE;
+
+    if(Status == USART_OK)
+    {
+        /* Stamp the arrival of the data */
+        if(TransferConfig->timestamp != NULL)
+        {
+            *TransferConfig->timestamp = TIMEBASE_now();
+        }
+
+        /* Read the data without the parity bit */
+        *TransferConfig->data = (uint8_t)(*dataRegister[TransferConfig->Port]
+            & USART_dataMaskGet(TransferConfig->Port));
+    }
+
+    return Status;
 }
 
 /*****************************************************************************
- * Function: USART_baudRateCalculate()
-*//**
-    *\b Description:
-    * This function is used to calculate the baud rate based on the peripheral. 
-    * 
+ * Function: USART_receiveToIdle()
+ *//**
+    * \b Description:
+    * This function is used to start the reception of variable-length 
+    * messages. The DMA stream of the port fills the first buffer, and a 
+    * message ends when the line goes idle for one frame or when the buffer
+    * is full. USART_irqHandler then stops the stream, reads the number of
+    * bytes received from the stream, restarts the stream on the other 
+    * buffer, and calls the callback with the message. The restart is a
+    * fixed sequence of register writes, and a byte that arrives meanwhile
+    * is held in the data register until the stream is enabled again, so
+    * the first byte of the next message is not lost.
+    * 
+    * PRE-CONDITION: The USART peripheral must be initialized with RX DMA. <br>
+    * PRE-CONDITION: The stream is initialized in normal mode for the USART 
+    *                RX (DMA_init). <br>
+    * PRE-CONDITION: The USART interrupt and the stream interrupt are enabled
+    *                in the NVIC with the same priority, and both handlers 
+    *                call USART_irqHandler. <br>
+    * PRE-CONDITION: The timebase must be initialized (TIMEBASE_init). <br>
+    * PRE-CONDITION: Config stays valid until USART_receiveToIdleStop. <br>
+    * 
+    * POST-CONDITION: The messages are passed to the callback. <br>
+    * 
+    * @param[in]   Config is a pointer to the receive-to-idle configuration.
+    * 
+    * @return void
+    * 
+    * \b Example:
+    * @code
+    * static uint8_t rxBuffer[2][64];
+    * static const UsartRxIdleConfig_t RxIdleConfig =
+    * {
+    *     USART_PORT_2, DMA1_STREAM_5, {rxBuffer[0], rxBuffer[1]}, 64U,
+    *     messageReceived
+    * };
+    * 
+    * void USART2_IRQHandler(void)
+    * {
+    *     USART_irqHandler(USART_PORT_2);
+    * }
+    * 
+    * void DMA1_Stream5_IRQHandler(void)
+    * {
+    *     USART_irqHandler(USART_PORT_2);
+    * }
+    * 
+    * USART_receiveToIdle(&RxIdleConfig);
+    * NVIC_EnableIRQ(USART2_IRQn);
+    * NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+    * @endcode
+    * 
+    * @see USART_configGet
+    * @see USART_configSizeGet
+    * @see USART_init
+    * @see USART_transmit
+    * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
+    * @see USART_registerWrite
+    * @see USART_registerRead
+    * 
+*****************************************************************************/
+void USART_receiveToIdle(const UsartRxIdleConfig_t * const Config)
+{
+    /*Prevent to assign a value out of the range of the port and stream.*/
+    assert(Config->Port < USART_PORT_MAX);
+    assert(Config->Stream < DMA_STREAM_MAX);
+
+    DmaTransferConfig_t DmaRxConfig =
+    {
+        .Stream = Config->Stream,
+        .peripheral = dataRegister[Config->Port],
+        .memory = (uint32_t*)Config->buffer[0],
+        .length = Config->length
+    };
+
+    rxIdleConfig[Config->Port] = Config;
+    rxIdleBuffer[Config->Port] = 0U;
+
+    /* Discard the idle event of the line before the reception */
+    (void)*statusRegister[Config->Port];
+    (void)*dataRegister[Config->Port];
+
+    DMA_transferConfig(&DmaRxConfig);
+    DMA_interruptEnable(Config->Stream, DMA_INTERRUPT_TRANSFER_COMPLETE);
+    *controlRegister1[Config->Port] |= USART_CR1_IDLEIE;
+}
+
+/*****************************************************************************
+ * Function: USART_receiveToIdleStop()
+ *//**
+    * \b Description:
+    * This function is used to stop the reception of variable-length messages
+    * on a port. The message being received is discarded.
+    * 
+    * PRE-CONDITION: The reception was started (USART_receiveToIdle). <br>
+    * PRE-CONDITION: The Port is within the maximum UsartPort_t. <br>
+    * 
+    * POST-CONDITION: The stream is stopped and the idle interrupt is 
+    *                 disabled. <br>
+    * 
+    * @param[in]   Port is the USART port.
+    * 
+    * @return void
+    * 
+    * \b Example:
+    * @code
+    * USART_receiveToIdleStop(USART_PORT_2);
+    * @endcode
+    * 
+    * @see USART_configGet
+    * @see USART_configSizeGet
+    * @see USART_init
+    * @see USART_transmit
+    * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
+    * @see USART_registerWrite
+    * @see USART_registerRead
+    * 
+*****************************************************************************/
+void USART_receiveToIdleStop(const UsartPort_t Port)
+{
+    const UsartRxIdleConfig_t * Config;
+
+    /*Prevent to assign a value out of the range of the port.*/
+    assert(Port < USART_PORT_MAX);
+
+    Config = rxIdleConfig[Port];
+    *controlRegister1[Port] &= ~USART_CR1_IDLEIE;
+
+    if(Config != NULL)
+    {
+        DMA_interruptDisable(Config->Stream, DMA_INTERRUPT_TRANSFER_COMPLETE);
+        DMA_transferStop(Config->Stream);
+        rxIdleConfig[Port] = NULL;
+    }
+}
+
+/*****************************************************************************
+ * Function: USART_exchange()
+ *//**
+    * \b Description:
+    * This function is used to transmit a block of data with the DMA and to
+    * receive a block of the same length at the same time. The reception is
+    * started first, and a word left in the data register is discarded, so
+    * the first word received is the one clocked by the first word sent. On
+    * a synchronous port (Clock enabled) this is a full-duplex transfer 
+    * driven by the CK output, like a SPI master. Without rxData, only the
+    * transmission is done, and the function returns once the last stop bit
+    * has left the line (TC). The processor sleeps during the transfer.
+    * 
+    * PRE-CONDITION: The USART peripheral must be initialized with TX DMA, 
+    *                and with RX DMA if rxData is not NULL. <br>
+    * PRE-CONDITION: The streams are initialized in normal mode for the 
+    *                USART TX and RX, with the data size of the words. <br>
+    * PRE-CONDITION: The idle and the timebase must be initialized. <br>
+    * PRE-CONDITION: The Port is within the maximum UsartPort_t. <br>
+    * 
+    * POST-CONDITION: The data is exchanged, or the streams are stopped when
+    *                 the timeout elapsed. <br>
+    * 
+    * @param[in]   Config is a pointer to the exchange configuration.
+    * @param[in]   timeout is the time allowed for the exchange in 
+    *             microseconds.
+    * 
+    * @return USART_OK if the exchange completed, otherwise USART_TIMEOUT.
+    * 
+    * \b Example:
+    * @code
+    * UsartExchangeConfig_t Exchange =
+    * {
+    *     USART_PORT_6, DMA2_STREAM_6, DMA2_STREAM_1, command, sample, 64U
+    * };
+    * if(USART_exchange(&Exchange, 1000U) == USART_TIMEOUT)
+    * {
+    *     //Handle the stalled link
+    * }
+    * @endcode
+    * 
+    * @see USART_configGet
+    * @see USART_configSizeGet
+    * @see USART_init
+    * @see USART_transmit
+    * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
+    * @see USART_registerWrite
+    * @see USART_registerRead
+    * 
+*****************************************************************************/
+UsartStatus_t USART_exchange(const UsartExchangeConfig_t * const Config,
+const uint32_t timeout)
+{
+    UsartStatus_t Status = USART_OK;
+    const uint32_t deadline = TIMEBASE_deadlineGet(timeout);
+
+    /*Prevent to assign a value out of the range of the port and streams.*/
+    assert(Config->Port < USART_PORT_MAX);
+    assert(Config->TxStream < DMA_STREAM_MAX);
+    assert(Config->RxStream < DMA_STREAM_MAX);
+
+    DmaTransferConfig_t DmaTxConfig =
+    {
+        .Stream = Config->TxStream,
+        .peripheral = dataRegister[Config->Port],
+        .memory = (uint32_t*)Config->txData,
+        .length = Config->length
+    };
+
+    DmaTransferConfig_t DmaRxConfig =
+    {
+        .Stream = Config->RxStream,
+        .peripheral = dataRegister[Config->Port],
+        .memory = (uint32_t*)Config->rxData,
+        .length = Config->length
+    };
+
+    if(Config->rxData != NULL)
+    {
+        /* Discard the word left by a previous transfer */
+        (void)*statusRegister[Config->Port];
+        (void)*dataRegister[Config->Port];
+        DMA_transferConfig(&DmaRxConfig);
+    }
+
+    /* TC is cleared (written 0), as the DMA writes to the data register
+     * do not clear it
+    */
+    *statusRegister[Config->Port] = (uint32_t)~USART_SR_TC;
+    DMA_transferConfig(&DmaTxConfig);
+
+    if(Config->rxData != NULL)
+    {
+        /* The last word is received after the last one was sent */
+        if(DMA_transferWaitTimeout(Config->RxStream, timeout) != DMA_OK)
+        {
+            Status = USART_TIMEOUT;
+        }
+    }
+    else
+    {
+        /* Wait for the last stop bit. The TC interrupt wakes up the 
+         * processor.
+        */
+        *controlRegister1[Config->Port] |= USART_CR1_TCIE;
+        if((DMA_transferWaitTimeout(Config->TxStream, timeout) != DMA_OK) ||
+           (IDLE_waitForDeadline(statusRegister[Config->Port], USART_SR_TC,
+            USART_SR_TC, usartIrq[Config->Port], deadline) == IDLE_TIMEOUT))
+        {
+            Status = USART_TIMEOUT;
+        }
+        *controlRegister1[Config->Port] &= ~USART_CR1_TCIE;
+    }
+
+    if(Status == USART_TIMEOUT)
+    {
+        DMA_transferStop(Config->TxStream);
+        if(Config->rxData != NULL)
+        {
+            DMA_transferStop(Config->RxStream);
+        }
+    }
+
+    return Status;
+}
+
+/*****************************************************************************
+ * Function: USART_driverEnableInit()
+ *//**
+    * \b Description:
+    * This function is used to couple the driver enable (DE) pin of a RS-485
+    * transceiver with the TX stream of a half-duplex port. The set/reset 
+    * words of the pin are kept, so USART_driverEnableTransmit asserts the 
+    * pin with a single store before the stream is started, and the TC 
+    * interrupt releases it with a single store once the last stop bit has
+    * left the shift register. The driver is released by this function.
+    * 
+    * PRE-CONDITION: The USART peripheral must be initialized with TX DMA. <br>
+    * PRE-CONDITION: The DE pin is configured as a GPIO output (DIO_init). <br>
+    * PRE-CONDITION: The Port is within the maximum UsartPort_t. <br>
+    * 
+    * POST-CONDITION: The transceiver driver is disabled. <br>
+    * 
+    * @param[in]   Config is a pointer to the driver enable configuration.
+    * 
+    * @return void
+    * 
+    * \b Example:
+    * @code
+    * static const UsartDriverEnableConfig_t Rs485 =
+    * {
+    *     USART_PORT_2, DMA1_STREAM_6, {DIO_PA, DIO_PA1}, DIO_HIGH
+    * };
+    * 
+    * void USART2_IRQHandler(void)
+    * {
+    *     USART_irqHandler(USART_PORT_2);
+    * }
+    * 
+    * USART_driverEnableInit(&Rs485);
+    * NVIC_EnableIRQ(USART2_IRQn);
+    * @endcode
+    * 
+    * @see USART_configGet
+    * @see USART_configSizeGet
+    * @see USART_init
+    * @see USART_transmit
+    * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
+    * @see USART_registerWrite
+    * @see USART_registerRead
+    * 
+*****************************************************************************/
+void USART_driverEnableInit(const UsartDriverEnableConfig_t * const Config)
+{
+    UsartDriverEnable_t * const DriverEnable = &driverEnable[Config->Port];
+    DioPinSetReset_t SetReset;
+
+    /*Prevent to assign a value out of the range of the port and stream.*/
+    assert(Config->Port < USART_PORT_MAX);
+    assert(Config->Stream < DMA_STREAM_MAX);
+    assert(Config->Active < DIO_PIN_STATE_MAX);
+
+    DIO_pinSetResetGet(&Config->DePin, &SetReset);
+
+    DriverEnable->bsrr = SetReset.bsrr;
+    DriverEnable->on = (Config->Active == DIO_HIGH) ? SetReset.set : 
+        SetReset.reset;
+    DriverEnable->off = (Config->Active == DIO_HIGH) ? SetReset.reset : 
+        SetReset.set;
+    DriverEnable->Stream = Config->Stream;
+    DriverEnable->enabled = 0U;
+    DriverEnable->length = 0U;
+
+    *DriverEnable->bsrr = DriverEnable->off;
+}
+
+/*****************************************************************************
+ * Function: USART_driverEnableTransmit()
+ *//**
+    * \b Description:
+    * This function is used to transmit a block of data on a half-duplex 
+    * RS-485 port. The driver enable pin is asserted before the TX stream is
+    * started, and it is released by the TC interrupt (USART_irqHandler) 
+    * once the last stop bit has left the line, not on the completion of the
+    * stream, which happens while the last two words are still shifted out.
+    * The processor sleeps until the release. The receiver of the port stays
+    * enabled, so a reply is received by USART_receiveToIdle without any 
+    * software turnaround. USART_turnaroundGet gives the delay of the
+    * release.
+    * 
+    * PRE-CONDITION: The driver enable is set up (USART_driverEnableInit). <br>
+    * PRE-CONDITION: The USART interrupt is enabled in the NVIC, and its 
+    *                handler calls USART_irqHandler. <br>
+    * PRE-CONDITION: The idle and the timebase must be initialized. <br>
+    * PRE-CONDITION: The Port is within the maximum UsartPort_t. <br>
+    * 
+    * POST-CONDITION: The data is transmitted and the driver is released, or
+    *                 the stream is stopped when the timeout elapsed. <br>
+    * 
+    * @param[in]   Port is the USART port.
+    * @param[in]   data is the data to be transmitted.
+    * @param[in]   length is the number of transfers.
+    * @param[in]   timeout is the time allowed for the transmission in 
+    *             microseconds.
+    * 
+    * @return USART_OK if the data was transmitted, otherwise USART_TIMEOUT.
+    * 
+    * \b Example:
+    * @code
+    * if(USART_driverEnableTransmit(USART_PORT_2, request, 8U, 1000U) == 
+    *    USART_OK)
+    * {
+    *     //The reply is passed to the callback of USART_receiveToIdle
+    * }
+    * @endcode
+    * 
+    * @see USART_configGet
+    * @see USART_configSizeGet
+    * @see USART_init
+    * @see USART_transmit
+    * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
+    * @see USART_registerWrite
+    * @see USART_registerRead
+    * 
+*****************************************************************************/
+UsartStatus_t USART_driverEnableTransmit(const UsartPort_t Port, 
+const uint8_t * const data, const uint32_t length, const uint32_t timeout)
+{
+    UsartDriverEnable_t * const DriverEnable = &driverEnable[Port];
+    UsartStatus_t Status = USART_OK;
+    const uint32_t deadline = TIMEBASE_deadlineGet(timeout);
+
+    /*Prevent to assign a value out of the range of the port.*/
+    assert(Port < USART_PORT_MAX);
+    assert(DriverEnable->bsrr != NULL);
+
+    DmaTransferConfig_t DmaTxConfig =
+    {
+        .Stream = DriverEnable->Stream,
+        .peripheral = dataRegister[Port],
+        .memory = (uint32_t*)data,
+        .length = length
+    };
+
+    /* The driver is enabled before the first start bit. TC is cleared 
+     * (written 0), as the DMA writes to the data register do not clear it,
+     * before the transmission is published to USART_irqHandler: another
+     * interrupt of the port (e.g. IDLE) must not see the stale TC and 
+     * release the driver before the frame starts.
+    */
+    *DriverEnable->bsrr = DriverEnable->on;
+    DriverEnable->length = length;
+    *statusRegister[Port] = (uint32_t)~USART_SR_TC;
+    *controlRegister1[Port] |= USART_CR1_TCIE;
+    DriverEnable->enabled = 1U;
+    DMA_transferConfig(&DmaTxConfig);
+    DriverEnable->start = DWT->CYCCNT;
+
+    if(IDLE_waitForDeadline(&DriverEnable->enabled, 1U, 0U, usartIrq[Port],
+        deadline) == IDLE_TIMEOUT)
+    {
+        DMA_transferStop(DriverEnable->Stream);
+        *controlRegister1[Port] &= ~USART_CR1_TCIE;
+        *DriverEnable->bsrr = DriverEnable->off;
+        DriverEnable->enabled = 0U;
+        DriverEnable->length = 0U;
+        Status = USART_TIMEOUT;
+    }
+
+    return Status;
+}
+
+/*****************************************************************************
+ * Function: USART_turnaroundGet()
+ *//**
+    * \b Description:
+    * This function is used to get the turnaround of the last transmission 
+    * of USART_driverEnableTransmit: the delay between the end of the last
+    * stop bit and the release of the driver enable pin, in bit times. It is
+    * the time measured with the cycle counter from the start of the stream
+    * to the release, less the time of the frames on the line (start bit, 
+    * data bits, and stop bits), which is computed from the baud rate 
+    * register and the bus prescaler of the port.
+    * 
+    * PRE-CONDITION: The idle must be initialized (IDLE_init). <br>
+    * PRE-CONDITION: The Port is within the maximum UsartPort_t. <br>
+    * 
+    * POST-CONDITION: None. <br>
+    * 
+    * @param[in]   Port is the USART port.
+    * 
+    * @return the turnaround in sixteenths of a bit time, or 0 if no block 
+    *         was transmitted.
+    * 
+    * \b Example:
+    * @code
+    * (void)USART_driverEnableTransmit(USART_PORT_2, request, 8U, 1000U);
+    * turnaround = USART_turnaroundGet(USART_PORT_2) / 16U;
+    * @endcode
+    * 
+    * @see USART_configGet
+    * @see USART_configSizeGet
+    * @see USART_init
+    * @see USART_transmit
+    * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
+    * @see USART_registerWrite
+    * @see USART_registerRead
+    * 
+*****************************************************************************/
+uint32_t USART_turnaroundGet(const UsartPort_t Port)
+{
+    const UsartDriverEnable_t * const DriverEnable = &driverEnable[Port];
+    uint32_t divider;
+    uint32_t prescaler;
+    uint32_t bitCycles;
+    uint32_t elapsed;
+    uint64_t frameCycles;
+    uint32_t turnaround = 0U;
+
+    /*Prevent to assign a value out of the range of the port.*/
+    assert(Port < USART_PORT_MAX);
+
+    /* The bit time is the divider of the baud rate register, in cycles of
+     * the bus clock. The fraction of the oversampling by 8 has three bits.
+    */
+    divider = *baudRateRegister[Port];
+    if(*controlRegister1[Port] & USART_CR1_OVER8)
+    {
+        divider = ((divider >> 1U) & ~0x7UL) | (divider & 0x7UL);
+    }
+    prescaler = (Port == USART_PORT_2) ? 
+        ((RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos) :
+        ((RCC->CFGR & RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos);
+    prescaler = (prescaler & 0x4UL) ? (2UL << (prescaler & 0x3UL)) : 1UL;
+    bitCycles = divider * prescaler;
+
+    if((DriverEnable->length > 0U) && (DriverEnable->enabled == 0U) && 
+       (bitCycles > 0U))
+    {
+        elapsed = DriverEnable->end - DriverEnable->start;
+        frameCycles = (uint64_t)DriverEnable->length * bitCycles *
+            (USART_START_HALF_BITS + 
+            ((*controlRegister1[Port] & USART_CR1_M) ? 
+                USART_DATA_HALF_BITS_9 : USART_DATA_HALF_BITS_8) +
+            stopHalfBits[(*controlRegister2[Port] & USART_CR2_STOP) >> 
+                USART_CR2_STOP_Pos]) / 2U;
+        if(elapsed > frameCycles)
+        {
+            turnaround = (uint32_t)(((elapsed - frameCycles) * 16U) / 
+                bitCycles);
+        }
+    }
+
+    return turnaround;
+}
+
+/*****************************************************************************
+ * Function: USART_irqHandler()
+ *//**
+    * \b Description:
+    * This function is used to service the interrupts of a USART port. It 
+    * must be called from the USART interrupt handler and from the interrupt
+    * handler of the RX stream of the port. A message received to idle is 
+    * completed when the line is idle or when the stream has filled the 
+    * buffer. The driver enable pin of a RS-485 port is released on TC. The
+    * interrupt enable bits set by the blocking transfers are cleared once 
+    * their event happened, as the waiting function checks the event itself.
+    * 
+    * PRE-CONDITION: The Port is within the maximum UsartPort_t. <br>
+    * 
+    * POST-CONDITION: The completed message is passed to the callback and 
+    *                 the stream is receiving the next message. <br>
+    * 
+    * @param[in]   Port is the USART port.
+    * 
+    * @return void
+    * 
+    * \b Example:
+    * @code
+    * void USART2_IRQHandler(void)
+    * {
+    *     USART_irqHandler(USART_PORT_2);
+    * }
+    * @endcode
+    * 
+    * @see USART_configGet
+    * @see USART_configSizeGet
+    * @see USART_init
+    * @see USART_transmit
+    * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
+    * @see USART_registerWrite
+    * @see USART_registerRead
+    * 
+*****************************************************************************/
+void USART_irqHandler(const UsartPort_t Port)
+{
+    const UsartRxIdleConfig_t * Config;
+    uint32_t status;
+    uint32_t received;
+    uint32_t timestamp;
+    uint8_t completed;
+    DmaStatus_t Stopped;
+
+    /*Prevent to assign a value out of the range of the port.*/
+    assert(Port < USART_PORT_MAX);
+
+    status = *statusRegister[Port];
+
+    /* The driver enable is released first, so the transceiver listens to
+     * the line as soon as the last stop bit has left
+    */
+    if((status & USART_SR_TC) && driverEnable[Port].enabled)
+    {
+        *driverEnable[Port].bsrr = driverEnable[Port].off;
+        driverEnable[Port].end = DWT->CYCCNT;
+        driverEnable[Port].enabled = 0U;
+    }
+
+    Config = rxIdleConfig[Port];
+
+    /* The events of USART_transmit, USART_receive and USART_reconfigure 
+     * are checked by them
+    */
+    if(status & USART_SR_TXE)
+    {
+        *controlRegister1[Port] &= ~USART_CR1_TXEIE;
+    }
+    if(status & USART_SR_RXNE)
+    {
+        *controlRegister1[Port] &= ~USART_CR1_RXNEIE;
+    }
+    if(status & USART_SR_TC)
+    {
+        *controlRegister1[Port] &= ~USART_CR1_TCIE;
+    }
+
+    if((Config != NULL) && ((status & USART_SR_IDLE) || 
+       (DMA_streamStateGet(Config->Stream) == DMA_STREAM_DISABLED)))
+    {
+        timestamp = TIMEBASE_now();
+
+        /* The stream is stopped first, so the data register only changes 
+         * with the line from now on
+        */
+        Stopped = DMA_transferStopTimeout(Config->Stream, USART_STOP_TIMEOUT);
+
+        /* The idle flag is cleared by reading the status and then the data
+         * register. A byte of the next message already in the data register
+         * (RXNE) is not read: it is left to the stream, whose read of the 
+         * data register clears the flag once the stream is restarted.
+        */
+        if((status & USART_SR_IDLE) && 
+           ((*statusRegister[Port] & USART_SR_RXNE) == 0U))
+        {
+            (void)*dataRegister[Port];
+        }
+
+        /* A stream that does not stop keeps its buffer until the next 
+         * event of the port
+        */
+        if(Stopped == DMA_OK)
+        {
+            received = Config->length - 
+                DMA_transferRemainingGet(Config->Stream);
+
+            /* Restart on the other buffer, unless the message is empty */
+            completed = rxIdleBuffer[Port];
+            if(received > 0U)
+            {
+                rxIdleBuffer[Port] ^= 1U;
+            }
+            DMA_transferRearm(Config->Stream, 
+                (uint32_t*)Config->buffer[rxIdleBuffer[Port]], Config->length);
+
+            if((received > 0U) && (Config->Callback != NULL))
+            {
+                Config->Callback(Port, Config->buffer[completed], received, 
+                    timestamp);
+            }
+        }
+    }
+}
+
+/*****************************************************************************
+ * Function: USART_dataMaskGet()
+ *//**
+    * \b Description:
+    * This function is used to get the data bits of a received word, from the
+    * frame format of the port. The parity bit is the most significant bit of
+    * the word: bit 7 with 8-bit words, bit 8 with 9-bit words. 9-bit words
+    * without parity carry 9 data bits, so they are received by a stream with
+    * 16-bit transfers (MemorySize and PeripheralSize 16). The mask is used 
+    * to strip the parity bit of the data received by the DMA (WORD_narrow,
+    * WORD_bytesMask).
+    * 
+    * PRE-CONDITION: The USART peripheral must be initialized (USART_init). <br>
+    * PRE-CONDITION: The Port is within the maximum UsartPort_t. <br>
+    * 
+    * POST-CONDITION: None. <br>
+    * 
+    * @param[in]   Port is the USART port.
+    * 
+    * @return 0x7F (8-bit words with parity), 0xFF (8-bit words, or 9-bit
+    *         words with parity) or 0x1FF (9-bit words).
+    * 
+    * \b Example:
+    * @code
+    * WORD_bytesMask(message, length, (uint8_t)USART_dataMaskGet(USART_PORT_2));
+    * @endcode
+    * 
+    * @see USART_configGet
+    * @see USART_configSizeGet
+    * @see USART_init
+    * @see USART_transmit
+    * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
+    * @see USART_registerWrite
+    * @see USART_registerRead
+    * 
+*****************************************************************************/
+uint16_t USART_dataMaskGet(const UsartPort_t Port)
+{
+    uint32_t frame;
+    uint16_t mask = 0xFFU;
+
+    /*Prevent to assign a value out of the range of the port.*/
+    assert(Port < USART_PORT_MAX);
+
+    frame = *controlRegister1[Port] & (USART_CR1_M | USART_CR1_PCE);
+    if(frame == USART_CR1_PCE)
+    {
+        mask = 0x7FU;
+    }
+    else if(frame == USART_CR1_M)
+    {
+        mask = 0x1FFU;
+    }
+
+    return mask;
+}
+
+/*****************************************************************************
+ * Function: USART_muteEnter()
+ *//**
+    * \b Description:
+    * This function is used to mute the receiver of a port. A muted receiver
+    * discards the frames of the line: RXNE is not set, so neither the RX DMA
+    * stream nor the processor are woken up. The wakeup event of the port 
+    * (Wakeup) clears the mute state:
+    * - USART_WAKEUP_IDLE_LINE: the next idle line. The receiver is muted 
+    *   again by this function, once the message of the node was received.
+    * - USART_WAKEUP_ADDRESS_MARK: a frame with the most significant bit set
+    *   (USART_ADDRESS_FRAME) and the node address (Address) on its 4 low 
+    *   bits. The address frame is received, as the first transfer of the 
+    *   message, and the address of another node mutes the receiver again, 
+    *   so the port is only muted once.
+    * The receive data register is emptied before the mute state is set. The
+    * DMA requests of the receiver are held meanwhile, so an RX stream being
+    * run (e.g. USART_receiveToIdle) does not race with the drain: it only
+    * gets the frames received after the wakeup.
+    * 
+    * PRE-CONDITION: The USART peripheral must be initialized (USART_init). <br>
+    * PRE-CONDITION: The receiver is enabled (USART_RX_ENABLED). <br>
+    * PRE-CONDITION: The Port is within the maximum UsartPort_t. <br>
+    * 
+    * POST-CONDITION: The receiver discards the frames until the wakeup. <br>
+    * 
+    * @param[in]   Port is the USART port.
+    * 
+    * @return void
+    * 
+    * \b Example:
+    * @code
+    * USART_receiveToIdle(&RxIdleConfig);
+    * USART_muteEnter(USART_PORT_2);
+    * @endcode
+    * 
+    * @see USART_configGet
+    * @see USART_configSizeGet
+    * @see USART_init
+    * @see USART_transmit
+    * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
+    * @see USART_registerWrite
+    * @see USART_registerRead
+    * 
+*****************************************************************************/
+void USART_muteEnter(const UsartPort_t Port)
+{
+    uint32_t cr3;
+
+    /*Prevent to assign a value out of the range of the port.*/
+    assert(Port < USART_PORT_MAX);
+
+    /* RWU is only set with an empty receive data register. The RX DMA
+     * requests are held, so the drain and the stream do not both read it.
+    */
+    cr3 = *controlRegister3[Port];
+    *controlRegister3[Port] = cr3 & ~USART_CR3_DMAR;
+    while(*statusRegister[Port] & USART_SR_RXNE)
+    {
+        (void)*dataRegister[Port];
+    }
+    *controlRegister1[Port] |= USART_CR1_RWU;
+    *controlRegister3[Port] = cr3;
+}
+
+/*****************************************************************************
+ * Function: USART_registerWrite()
+ *//**
+    * \b Description:
+    * This function is used to directly address and modify a USART register.
+    * The function should be used to access specialized functionality in 
+    * the SPI peripheral that is not exposed by any other function of the
+    * interface.
+    * 
+    * PRE-CONDITION: The USART peripheral must be initialized (USART_init).<br>
+    * PRE-CONDITION: Address is within the boundaries of the USART register
+    *                map. <br>
+    * 
+    * POST-CONDITION: The data is written to the address.<br>
+    * 
+    * @param[in]   address is the address of the register to write to.
+    * @param[in]   value is the value to write to the USART register.
+    * 
+    * @return void
+    * 
+    * \b Example:
+    * @code
+    * USART_registerWrite(0x1000003, 0x01);
+    * @endcode
+    * 
+    * @see USART_configGet
+    * @see USART_configSizeGet
+    * @see USART_init
+    * @see USART_transmit
+    * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
+    * @see USART_registerWrite
+    * @see USART_registerRead
+    *
+*****************************************************************************/
+void USART_registerWrite(const uint32_t address, const uint32_t value)
+{
+    /* Write the value to the address */
+    volatile uint32_t * const registerPointer = (uint32_t*)address;
+    *registerPointer = value;
+}
+
+/*****************************************************************************
+ * Function: USART_registerRead()
+ *//**
+    * \b Description:
+    * This function is used to directly address and read a USART register.
+    * The function should be used to access specialized functionality in 
+    * the USART peripheral that is not exposed by any other function of the
+    * interface.
+    * 
+    * PRE-CONDITION: The USART peripheral must be initialized (USART_init). <br>
+    * PRE-CONDITION: Address is within the boundaries of the USART register
+    *                map. <br>
+    * 
+    * POST-CONDITION: The data is read from the address. <br>
+    * 
+    * @param[in]   address is the address of the register to read from.
+    * 
+    * @return the value of the register.
+    * 
+    * \b Example:
+    * @code
+    * uint32_t value = USART_registerRead(0x10000003);
+    * @endcode
+    * 
+    * @see USART_configGet
+    * @see USART_configSizeGet
+    * @see USART_init
+    * @see USART_transmit
+    * @see USART_receive
+    * @see USART_transmitTimeout
+    * @see USART_receiveTimeout
+    * @see USART_receiveToIdle
+    * @see USART_receiveToIdleStop
+    * @see USART_exchange
+    * @see USART_driverEnableInit
+    * @see USART_driverEnableTransmit
+    * @see USART_turnaroundGet
+    * @see USART_irqHandler
+    * @see USART_dataMaskGet
+    * @see USART_muteEnter
+    * @see USART_registerWrite
+    * @see USART_registerRead
+    * 
+*****************************************************************************/
+uint32_t USART_registerRead(const uint32_t address)
+{
+    /* Read the value from the address */
+    volatile uint32_t * const registerPointer = (uint32_t*)address;
+    return *registerPointer;
+}
+
+/*****************************************************************************
+ * Function: USART_baudRateCalculate()
+*//**
+    *\b Description:
+    * This function is used to calculate the baud rate based on the peripheral. 
+    * The divider is rounded to the nearest 1/16 (oversampling by 16) or 1/8
+    * (oversampling by 8) of the bus clock. With oversampling by 8 the 
+    * fraction has three bits, and bit 3 of the register is kept clear.
+    * 
     * PRE-CONDITION: The peripheral clock must be configured and enabled.
     * PRE-CONDITION: The baud rate must be defined.
     * 
@@ -487,12 +2005,14 @@ uint32_t USART_registerRead(const uint32_t address)
     * 
     * @param[in]   peripheralClock is the frequency of the system clock.
     * @param[in]   BaudRate is the baud rate of the USART.
+    * @param[in]   Oversampling is the oversampling of the port.
     * 
     * @return the calculated baud rate.
     * 
     * \b Example:
     * @code
-    * uint16_t baudRate = USART_baudRateCalculate(peripheralClock, BaudRate);
+    * uint16_t baudRate = USART_baudRateCalculate(peripheralClock, BaudRate,
+    *     USART_OVERSAMPLING_16);
     * @endcode
     * 
     * @see USART_ConfigGet
@@ -504,7 +2024,15 @@ uint32_t USART_registerRead(const uint32_t address)
     * @see USART_registerRead
     *
 *****************************************************************************/
-static uint16_t USART_baudRateCalculate(const uint32_t peripheralClock, const uint32_t BaudRate)
+static uint16_t USART_baudRateCalculate(const uint32_t peripheralClock, 
+const uint32_t BaudRate, const UsartOversampling_t Oversampling)
 {
-    return ((peripheralClock + (BaudRate/2U))/BaudRate);
+    const uint32_t divider = (peripheralClock + (BaudRate/2U))/BaudRate;
+
+    if(Oversampling == USART_OVERSAMPLING_8)
+    {
+        return (uint16_t)(((divider & ~0x7UL) << 1) | (divider & 0x7UL));
+    }
+
+    return (uint16_t)divider;
 }
\ No newline at end of file
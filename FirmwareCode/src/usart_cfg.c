@@ -13,6 +13,7 @@
 * Module Includes
 *****************************************************************************/
 #include "usart_cfg.h"
+#include "stm32f4xx.h"  /*For the register bit definitions*/
 
 /*****************************************************************************
 * Module Preprocessor Constants
@@ -41,13 +42,36 @@ const UsartConfig_t UsartConfig[] =
  *  Port          WordLength        StopBits          Parity
  *  RxMode            TxMode                RxDma    
  *  TxDma                 USART Enabler     BaudRate 
- *                
+ *  Clock          ClockPolarity       ClockPhase
+ *  LastBitClock   Oversampling      Mute
+ *  Wakeup                 Address
 */ 
    {USART_PORT_2, USART_WORD_LENGTH_8, USART_STOP_BITS_1, USART_PARITY_DISABLED,
-   USART_RX_ENABLED, USART_TX_ENABLED, USART_RX_DMA_ENABLED, 
-   USART_TX_DMA_ENABLED, USART_ENABLED, USART_BAUD_RATE_9600},
+   USART_RX_ENABLED, USART_TX_ENABLED, USART_RX_DMA_ENABLED, USART_TX_DMA_ENABLED,
+   USART_ENABLED, USART_BAUD_RATE_9600, USART_CLOCK_DISABLED, USART_CLOCK_POLARITY_LOW,
+   USART_CLOCK_PHASE_FIRST, USART_LAST_BIT_CLOCK_DISABLED, USART_OVERSAMPLING_16,
+   USART_MUTE_DISABLED, USART_WAKEUP_IDLE_LINE, 0},
 };  
 
+/**
+ * The following array contains the register images of the UsartConfig 
+ * table. Each row represent a single USART peripheral. This table is read in
+ * by USART_imageInit, where each peripheral is written with plain stores. 
+ * Both tables are generated from board.json by scripts/cfg_generate.py.
+ */
+const UsartPortImage_t UsartImage[] = 
+{
+/*                                                          
+ *  Port          CR1
+ *  CR2
+ *  CR3
+ *  BRR
+ *                
+*/ 
+   {USART_PORT_2, USART_CR1_RE | USART_CR1_TE | USART_CR1_UE, 0U,
+   USART_CR3_DMAR | USART_CR3_DMAT, 0x0683U},
+};
+
 /*****************************************************************************
  * Function Prototypes
 *****************************************************************************/
@@ -136,4 +160,72 @@ const UsartConfig_t * const USART_configGet(void)
 size_t USART_configSizeGet(void)
 {
    return sizeof(UsartConfig)/sizeof(UsartConfig[0]);
-}
\ No newline at end of file
+}
+
+/*****************************************************************************
+ * Function: USART_imageGet()
+*/
+/**
+*\b Description:
+ * This function is used to get the register images generated from the 
+ * configuration table defined in usart_cfg module.
+ * 
+ * PRE-CONDITION: The image table must be populated (sizeof>0). <br>
+ * 
+ * POST-CONDITION: A constant pointer to the first member of the image table
+ * is returned. <br>
+ * 
+ * @return A pointer to the image table. <br>
+ * 
+ * \b Example:
+ * @code
+ * const UsartPortImage_t * const UsartImage = USART_imageGet();
+ * size_t imageSize = USART_imageSizeGet();
+ * 
+ * USART_imageInit(UsartImage, imageSize);
+ * @endcode
+ * 
+ * @see USART_configGet
+ * @see USART_configSizeGet
+ * @see USART_imageGet
+ * @see USART_imageSizeGet
+ * @see USART_imageInit
+ * 
+*****************************************************************************/
+const UsartPortImage_t * const USART_imageGet(void)
+{
+    return (const UsartPortImage_t *)&UsartImage[0];
+}
+
+/*****************************************************************************
+ * Function: USART_imageSizeGet()
+*/
+/**
+*\b Description:
+ * This function is used to get the size of the image table.
+ * 
+ * PRE-CONDITION: The image table needs to be populated (sizeof > 0) <br>
+ * 
+ * POST-CONDITION: The size of the image table will be returned. <br>
+ * 
+ * @return The size of the image table.
+ * 
+ * \b Example: 
+ * @code
+ * const UsartPortImage_t * const UsartImage = USART_imageGet();
+ * size_t imageSize = USART_imageSizeGet();
+ * 
+ * USART_imageInit(UsartImage, imageSize);
+ * @endcode
+ * 
+ * @see USART_configGet
+ * @see USART_configSizeGet
+ * @see USART_imageGet
+ * @see USART_imageSizeGet
+ * @see USART_imageInit
+ * 
+*****************************************************************************/
+size_t USART_imageSizeGet(void)
+{
+   return sizeof(UsartImage)/sizeof(UsartImage[0]);
+}
@@ -0,0 +1,469 @@
+/**
+ * @file wave.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the DMA-driven waveform engine. The update
+ * request of TIM1 triggers DMA2 stream 5 (channel 6), which writes one word
+ * of the pattern to the bit set/reset register (BSRR) of the port on every
+ * timer period.
+ * @version 1.1
+ * @date 2025-03-24
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "wave.h"       /*For this modules definitions*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the DMA stream mapped to the TIM1 update request.
+*/
+#define WAVE_STREAM DMA2_STREAM_5
+
+/**
+ * Defines the number of counts of the 16-bit prescaler and auto-reload
+ * registers of the waveform timer.
+*/
+#define WAVE_TIMER_COUNTS 65536UL
+
+/**
+ * Defines the offset of the reset bits inside the bit set/reset register.
+*/
+#define WAVE_RESET_OFFSET 16U
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/* Defines a array of pointers to the GPIO port bit set/reset register. */
+static uint32_t volatile * const bsrrRegister[NUMBER_OF_PORTS] =
+{
+    (uint32_t*)&GPIOA->BSRR, (uint32_t*)&GPIOB->BSRR,
+    (uint32_t*)&GPIOC->BSRR, (uint32_t*)&GPIOD->BSRR,
+    (uint32_t*)&GPIOH->BSRR
+};
+
+/**
+ * The following structure contains the configuration of the DMA stream used
+ * by the waveform engine. The words are moved from memory to the port one at
+ * a time, so the FIFO is bypassed (direct mode). The circular mode is
+ * selected on every start according to the waveform mode.
+ */
+static const DmaConfig_t WaveDmaConfig =
+{
+/*
+ *  Stream          Channel        Direction                MemorySize
+ *  PeripheralSize         MemoryIncrement              PeripheralIncrement
+ *  FifoMode                      FifoThreshold            CircularMode
+ *
+*/
+    WAVE_STREAM, DMA_CHANNEL_6, DMA_MEMORY_TO_PERIPHERAL, DMA_MEMORY_SIZE_32,
+    DMA_PERIPHERAL_SIZE_32, DMA_MEMORY_INCREMENT_ENABLED, DMA_PERIPHERAL_INCREMENT_DISABLED,
+    DMA_FIFO_DIRECT_MODE_ENABLED, DMA_FIFO_THRESHOLD_FULL, DMA_CIRCULAR_MODE_DISABLED
+};
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: WAVE_edgesBuild()
+*//**
+ *\b Description:
+ * This function is used to build a waveform pattern from a list of edges.
+ * Each word of the pattern is written to the bit set/reset register of the
+ * port on one tick, so every edge sets either the set bit or the reset bit
+ * of its pin on the word of its tick. Ticks without edges keep all the pins
+ * unchanged. When two edges of the same pin share a tick, the last edge of
+ * the list is kept.
+ *
+ * PRE-CONDITION: The edges are placed on pins of the same port. <br>
+ * PRE-CONDITION: The tick of every edge is lower than patternLength. <br>
+ * PRE-CONDITION: The Pin and State are within their maximum values. <br>
+ *
+ * POST-CONDITION: The pattern contains one word per tick. <br>
+ *
+ * @param[in]   Edges is a pointer to the list of edges of the waveform.
+ * @param[in]   edgeCount is the number of edges of the list.
+ * @param[out]  pattern is a pointer to the buffer that receives the words.
+ * @param[in]   patternLength is the number of words of the buffer.
+ *
+ * @return The number of ticks of the waveform (last tick + 1).
+ *
+ * \b Example:
+ * @code
+ * const WaveEdge_t Pulse[] =
+ * {
+ *      {DIO_PA5, DIO_HIGH, 0}, {DIO_PA5, DIO_LOW, 2},
+ *      {DIO_PA6, DIO_HIGH, 1}, {DIO_PA6, DIO_LOW, 3}
+ * };
+ * uint32_t pattern[4];
+ *
+ * size_t ticks = WAVE_edgesBuild(Pulse, 4, pattern, 4);
+ * @endcode
+ *
+ * @see WAVE_edgesBuild
+ * @see WAVE_busBuild
+ * @see WAVE_pinStateGet
+ * @see WAVE_start
+ * @see WAVE_stop
+ * @see WAVE_stateGet
+ *
+*****************************************************************************/
+size_t WAVE_edgesBuild(const WaveEdge_t * const Edges, size_t edgeCount,
+    uint32_t * const pattern, size_t patternLength)
+{
+    size_t ticks = 0U;
+
+    /* Start from a pattern that leaves the port unchanged */
+    for(size_t i=0; i<patternLength; i++)
+    {
+        pattern[i] = WAVE_IDLE_WORD;
+    }
+
+    /* Place every edge on the word of its tick */
+    for(size_t i=0; i<edgeCount; i++)
+    {
+        /* Prevent to write out of the buffer or out of the port */
+        assert(Edges[i].tick < patternLength);
+        assert(Edges[i].Pin < DIO_MAX_PIN);
+
+        const uint32_t setBit = (1UL<<Edges[i].Pin);
+        const uint32_t resetBit = (1UL<<(Edges[i].Pin + WAVE_RESET_OFFSET));
+
+        if(Edges[i].State == DIO_HIGH)
+        {
+            pattern[Edges[i].tick] &= ~resetBit;
+            pattern[Edges[i].tick] |= setBit;
+        }
+        else if(Edges[i].State == DIO_LOW)
+        {
+            pattern[Edges[i].tick] &= ~setBit;
+            pattern[Edges[i].tick] |= resetBit;
+        }
+        else
+        {
+            assert(Edges[i].State < DIO_PIN_STATE_MAX);
+        }
+
+        if(Edges[i].tick >= ticks)
+        {
+            ticks = Edges[i].tick + 1U;
+        }
+    }
+
+    return ticks;
+}
+
+/*****************************************************************************
+ * Function: WAVE_busBuild()
+*//**
+ *\b Description:
+ * This function is used to build a waveform pattern that drives a parallel
+ * bus. Each data value is presented on the bus pins during one tick. Bit 0
+ * of the data is driven on Pins[0], bit 1 on Pins[1] and so on. Every word
+ * drives all the bus pins, so no glitch is produced between values.
+ *
+ * PRE-CONDITION: The bus pins belong to the same port. <br>
+ * PRE-CONDITION: pinCount is lower or equal than DIO_MAX_PIN. <br>
+ * PRE-CONDITION: The pattern buffer holds at least dataLength words. <br>
+ *
+ * POST-CONDITION: The pattern contains one word per data value. <br>
+ *
+ * @param[in]   Pins is a pointer to the list of bus pins (LSB first).
+ * @param[in]   pinCount is the width of the bus.
+ * @param[in]   data is a pointer to the values presented on the bus.
+ * @param[in]   dataLength is the number of values.
+ * @param[out]  pattern is a pointer to the buffer that receives the words.
+ *
+ * @return The number of ticks of the waveform (dataLength).
+ *
+ * \b Example:
+ * @code
+ * const DioPin_t Bus[4] = {DIO_PC0, DIO_PC1, DIO_PC2, DIO_PC3};
+ * const uint16_t Counter[4] = {0x0, 0x1, 0x2, 0x3};
+ * uint32_t pattern[4];
+ *
+ * size_t ticks = WAVE_busBuild(Bus, 4, Counter, 4, pattern);
+ * @endcode
+ *
+ * @see WAVE_edgesBuild
+ * @see WAVE_busBuild
+ * @see WAVE_pinStateGet
+ * @see WAVE_start
+ * @see WAVE_stop
+ * @see WAVE_stateGet
+ *
+*****************************************************************************/
+size_t WAVE_busBuild(const DioPin_t * const Pins, size_t pinCount,
+    const uint16_t * const data, size_t dataLength, uint32_t * const pattern)
+{
+    /* Prevent to use a bus wider than the port */
+    assert(pinCount <= DIO_MAX_PIN);
+
+    for(size_t i=0; i<dataLength; i++)
+    {
+        uint32_t word = WAVE_IDLE_WORD;
+
+        for(size_t bit=0; bit<pinCount; bit++)
+        {
+            assert(Pins[bit] < DIO_MAX_PIN);
+
+            if(data[i] & (1U<<bit))
+            {
+                word |= (1UL<<Pins[bit]);
+            }
+            else
+            {
+                word |= (1UL<<(Pins[bit] + WAVE_RESET_OFFSET));
+            }
+        }
+
+        pattern[i] = word;
+    }
+
+    return dataLength;
+}
+
+/*****************************************************************************
+ * Function: WAVE_pinStateGet()
+*//**
+ *\b Description:
+ * This function is used to decode the state of a pin at a given tick of a
+ * pattern, as the port would show it once the word of that tick has been
+ * written. It applies the bit set/reset rules of the hardware (the set bit
+ * has priority over the reset bit), so it can be used to verify the exact
+ * pin timeline of a pattern without the hardware. A tick beyond the pattern
+ * returns the final state of a one shot waveform.
+ *
+ * PRE-CONDITION: The Pin is within the maximum DioPin_t. <br>
+ *
+ * POST-CONDITION: The state of the pin is returned. <br>
+ *
+ * @param[in]   pattern is a pointer to the pattern to decode.
+ * @param[in]   length is the number of words of the pattern.
+ * @param[in]   Pin is the pin to decode.
+ * @param[in]   tick is the tick to decode.
+ * @param[in]   InitialState is the state of the pin before the first tick.
+ *
+ * @return DioPinState_t The state of the pin (high or low).
+ *
+ * \b Example:
+ * @code
+ * size_t ticks = WAVE_edgesBuild(Pulse, 4, pattern, 4);
+ *
+ * assert(WAVE_pinStateGet(pattern, ticks, DIO_PA5, 1, DIO_LOW) == DIO_HIGH);
+ * assert(WAVE_pinStateGet(pattern, ticks, DIO_PA5, 2, DIO_LOW) == DIO_LOW);
+ * @endcode
+ *
+ * @see WAVE_edgesBuild
+ * @see WAVE_busBuild
+ * @see WAVE_pinStateGet
+ * @see WAVE_start
+ * @see WAVE_stop
+ * @see WAVE_stateGet
+ *
+*****************************************************************************/
+DioPinState_t WAVE_pinStateGet(const uint32_t * const pattern, size_t length,
+    DioPin_t Pin, uint32_t tick, DioPinState_t InitialState)
+{
+    /* Prevent to decode a pin out of the port */
+    assert(Pin < DIO_MAX_PIN);
+
+    DioPinState_t State = InitialState;
+
+    for(size_t i=0; (i<length) && (i<=tick); i++)
+    {
+        if(pattern[i] & (1UL<<Pin))
+        {
+            State = DIO_HIGH;
+        }
+        else if(pattern[i] & (1UL<<(Pin + WAVE_RESET_OFFSET)))
+        {
+            State = DIO_LOW;
+        }
+    }
+
+    return State;
+}
+
+/*****************************************************************************
+ * Function: WAVE_start()
+*//**
+ *\b Description:
+ * This function is used to play a waveform pattern on a port. TIM1 is set
+ * up to produce an update request every tickPeriod timer clock cycles and
+ * the DMA stream writes one word of the pattern to the port on every
+ * request. The first word is written at the end of the first tick. Any
+ * waveform being played is stopped first.
+ *
+ * PRE-CONDITION: The clocks of TIM1, DMA2 and the GPIO port are enabled. <br>
+ * PRE-CONDITION: The waveform pins are configured as outputs (DIO_init). <br>
+ * PRE-CONDITION: The pattern remains valid while the waveform is played. <br>
+ * PRE-CONDITION: tickPeriod is long enough for the DMA to write the port.
+ * Above 65536, it should be a multiple of the timer prescaler. <br>
+ *
+ * POST-CONDITION: The waveform is being played on the port. <br>
+ *
+ * @param[in]   TransferConfig is a pointer to the waveform to play.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * #define APB2_CLOCK      16000000
+ *
+ * WaveTransferConfig_t Waveform =
+ * {
+ *      .Port = DIO_PA,
+ *      .pattern = &pattern[0],
+ *      .length = ticks,
+ *      .tickPeriod = APB2_CLOCK/1000000,
+ *      .Mode = WAVE_CIRCULAR
+ * };
+ *
+ * WAVE_start(&Waveform);
+ * @endcode
+ *
+ * @see WAVE_edgesBuild
+ * @see WAVE_busBuild
+ * @see WAVE_pinStateGet
+ * @see WAVE_start
+ * @see WAVE_stop
+ * @see WAVE_stateGet
+ *
+*****************************************************************************/
+void WAVE_start(const WaveTransferConfig_t * const TransferConfig)
+{
+    /* Prevent to assign a value out of the range of the settings */
+    assert(TransferConfig->Port < DIO_MAX_PORT);
+    assert(TransferConfig->Mode < WAVE_MODE_MAX);
+    assert(TransferConfig->length > 0U);
+    assert(TransferConfig->tickPeriod > 0U);
+
+    /* Release the timer and the stream from a previous waveform */
+    WAVE_stop();
+
+    /* Set up the stream with the circular mode of the waveform */
+    DmaConfig_t StreamConfig = WaveDmaConfig;
+    if(TransferConfig->Mode == WAVE_CIRCULAR)
+    {
+        StreamConfig.CircularMode = DMA_CIRCULAR_MODE_ENABLED;
+    }
+    DMA_init(&StreamConfig, 1U);
+
+    /* Set the tick period. The prescaler is only used when the period does
+     * not fit on the auto-reload register.
+    */
+    const uint32_t prescaler = (TransferConfig->tickPeriod - 1UL)/WAVE_TIMER_COUNTS;
+    TIM1->PSC = prescaler;
+    TIM1->ARR = (TransferConfig->tickPeriod/(prescaler + 1UL)) - 1UL;
+    TIM1->CNT = 0U;
+
+    /* Load the prescaler with an update event before the DMA request is
+     * enabled, so no word is written by this event.
+    */
+    TIM1->EGR = TIM_EGR_UG;
+    TIM1->SR &= ~TIM_SR_UIF;
+
+    /* Set the transfer from the pattern to the port */
+    DmaTransferConfig_t DmaTransferConfig =
+    {
+        .Stream = WAVE_STREAM,
+        .peripheral = bsrrRegister[TransferConfig->Port],
+        .memory = (uint32_t*)TransferConfig->pattern,
+        .length = TransferConfig->length
+    };
+    DMA_transferConfig(&DmaTransferConfig);
+
+    /* Enable the update DMA request and start the timer */
+    TIM1->DIER |= TIM_DIER_UDE;
+    TIM1->CR1 |= TIM_CR1_CEN;
+}
+
+/*****************************************************************************
+ * Function: WAVE_stop()
+*//**
+ *\b Description:
+ * This function is used to stop the waveform being played. The timer is
+ * stopped and the DMA stream is disabled. The pins keep the state of the
+ * last word written.
+ *
+ * PRE-CONDITION: The clocks of TIM1 and DMA2 are enabled. <br>
+ *
+ * POST-CONDITION: No waveform is being played. <br>
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * WAVE_stop();
+ * @endcode
+ *
+ * @see WAVE_edgesBuild
+ * @see WAVE_busBuild
+ * @see WAVE_pinStateGet
+ * @see WAVE_start
+ * @see WAVE_stop
+ * @see WAVE_stateGet
+ *
+*****************************************************************************/
+void WAVE_stop(void)
+{
+    /* Stop the timer and its DMA request */
+    TIM1->CR1 &= ~TIM_CR1_CEN;
+    TIM1->DIER &= ~TIM_DIER_UDE;
+
+    /* Stop the stream */
+    DMA_transferStop(WAVE_STREAM);
+}
+
+/*****************************************************************************
+ * Function: WAVE_stateGet()
+*//**
+ *\b Description:
+ * This function is used to know if a waveform is being played. A one shot
+ * waveform becomes idle once its last word is written.
+ *
+ * PRE-CONDITION: The clock of DMA2 is enabled. <br>
+ *
+ * POST-CONDITION: The state of the waveform engine is returned. <br>
+ *
+ * @return WAVE_RUNNING while a waveform is being played, otherwise
+ *         WAVE_IDLE.
+ *
+ * \b Example:
+ * @code
+ * WAVE_start(&Waveform);
+ * while(WAVE_stateGet() == WAVE_RUNNING)
+ * {
+ * }
+ * @endcode
+ *
+ * @see WAVE_edgesBuild
+ * @see WAVE_busBuild
+ * @see WAVE_pinStateGet
+ * @see WAVE_start
+ * @see WAVE_stop
+ * @see WAVE_stateGet
+ *
+*****************************************************************************/
+WaveState_t WAVE_stateGet(void)
+{
+    return ((DMA_streamStateGet(WAVE_STREAM) == DMA_STREAM_ENABLED) ?
+        WAVE_RUNNING : WAVE_IDLE);
+}
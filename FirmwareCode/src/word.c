@@ -0,0 +1,434 @@
+/**
+ * @file word.c
+ * @author Jose Luis Figueroa
+ * @brief The implementation for the USART word conversions. Two half-words
+ * are held in a 32-bit register and converted together (SWAR, SIMD within
+ * a register); on the Cortex-M4 the bytes are spread to half-words with the
+ * SIMD instructions UXTB16 and PKHBT/PKHTB. The data is little-endian.
+ * @version 1.1
+ * @date 2025-03-25
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Module Includes
+*****************************************************************************/
+#include "word.h"       /*For this modules definitions*/
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the number of words converted at a time.
+*/
+#define WORD_BLOCK_SIZE 4U
+
+/**
+ * Defines the low byte of each half-word of a register.
+*/
+#define WORD_LOW_BYTES 0x00FF00FFUL
+
+/*****************************************************************************
+* Module Preprocessor Macros
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static uint32_t WORD_narrowBlock(const uint16_t * const words);
+static void WORD_widenBlock(const uint32_t data, uint16_t * const words,
+const uint32_t ninthFirst, const uint32_t ninthSecond);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/*****************************************************************************
+ * Function: WORD_bytesMask()
+ *//**
+ * \b Description:
+ * This function is used to clear the bits of the received bytes that are
+ * not data. With 8-bit words and parity, the parity bit is received on
+ * bit 7, so the mask is 0x7F. The bytes are masked four at a time.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: The bits not set in mask are cleared. <br>
+ *
+ * @param[in,out]   data is the array of bytes.
+ * @param[in]       length is the number of bytes.
+ * @param[in]       mask is the data bits of a byte.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * WORD_bytesMask(rxBuffer, length, 0x7FU);
+ * @endcode
+ *
+ * @see WORD_bytesMask
+ * @see WORD_narrow
+ * @see WORD_widen
+ * @see WORD_pack9
+ * @see WORD_unpack9
+ *
+*****************************************************************************/
+void WORD_bytesMask(uint8_t * const data, uint32_t length,
+const uint8_t mask)
+{
+    const uint32_t pattern = 0x01010101UL * mask;
+    uint32_t index = 0U;
+
+    while((length - index) >= WORD_BLOCK_SIZE)
+    {
+        __UNALIGNED_UINT32_WRITE(&data[index],
+            __UNALIGNED_UINT32_READ(&data[index]) & pattern);
+        index += WORD_BLOCK_SIZE;
+    }
+
+    while(index < length)
+    {
+        data[index] &= mask;
+        index++;
+    }
+}
+
+/*****************************************************************************
+ * Function: WORD_narrow()
+ *//**
+ * \b Description:
+ * This function is used to convert the half-words received by a 16-bit DMA
+ * stream to bytes. Bits 8 to 15 are dropped, which strips the parity bit
+ * of 9-bit words with parity; mask strips the parity bit of 8-bit words
+ * with parity (0x7F). Four words are converted at a time.
+ *
+ * PRE-CONDITION: bytes has room for count bytes. <br>
+ *
+ * POST-CONDITION: bytes holds the data bits of each word. <br>
+ *
+ * @param[in]   words is the array of half-words.
+ * @param[in]   count is the number of words.
+ * @param[out]  bytes is the array of bytes.
+ * @param[in]   mask is the data bits of a byte.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * WORD_narrow(rxWords, count, message, 0xFFU);
+ * @endcode
+ *
+ * @see WORD_bytesMask
+ * @see WORD_narrow
+ * @see WORD_widen
+ * @see WORD_pack9
+ * @see WORD_unpack9
+ *
+*****************************************************************************/
+void WORD_narrow(const uint16_t * const words, uint32_t count,
+uint8_t * const bytes, const uint8_t mask)
+{
+    const uint32_t pattern = 0x01010101UL * mask;
+    uint32_t index = 0U;
+
+    while((count - index) >= WORD_BLOCK_SIZE)
+    {
+        __UNALIGNED_UINT32_WRITE(&bytes[index],
+            WORD_narrowBlock(&words[index]) & pattern);
+        index += WORD_BLOCK_SIZE;
+    }
+
+    while(index < count)
+    {
+        bytes[index] = (uint8_t)words[index] & mask;
+        index++;
+    }
+}
+
+/*****************************************************************************
+ * Function: WORD_widen()
+ *//**
+ * \b Description:
+ * This function is used to convert bytes to the half-words transmitted by
+ * a 16-bit DMA stream. The ninth bit of every word is taken from ninth, so
+ * a block of data (0) or of addresses (WORD_NINTH_BIT) of a multiprocessor
+ * protocol is built in one call. Four bytes are converted at a time.
+ *
+ * PRE-CONDITION: ninth is 0 or WORD_NINTH_BIT. <br>
+ *
+ * POST-CONDITION: words holds one half-word for each byte. <br>
+ *
+ * @param[in]   bytes is the array of bytes.
+ * @param[in]   count is the number of bytes.
+ * @param[out]  words is the array of half-words.
+ * @param[in]   ninth is the ninth bit of the words.
+ *
+ * @return void
+ *
+ * \b Example:
+ * @code
+ * WORD_widen(&address, 1U, &txWords[0], WORD_NINTH_BIT);
+ * WORD_widen(message, length, &txWords[1], 0U);
+ * @endcode
+ *
+ * @see WORD_bytesMask
+ * @see WORD_narrow
+ * @see WORD_widen
+ * @see WORD_pack9
+ * @see WORD_unpack9
+ *
+*****************************************************************************/
+void WORD_widen(const uint8_t * const bytes, uint32_t count,
+uint16_t * const words, const uint16_t ninth)
+{
+    const uint32_t ninthPair = ((uint32_t)ninth << 16) | ninth;
+    uint32_t index = 0U;
+
+    /*Review if the ninth bit is correct*/
+    assert((ninth & ~WORD_NINTH_BIT) == 0U);
+
+    while((count - index) >= WORD_BLOCK_SIZE)
+    {
+        WORD_widenBlock(__UNALIGNED_UINT32_READ(&bytes[index]),
+            &words[index], ninthPair, ninthPair);
+        index += WORD_BLOCK_SIZE;
+    }
+
+    while(index < count)
+    {
+        words[index] = bytes[index] | ninth;
+        index++;
+    }
+}
+
+/*****************************************************************************
+ * Function: WORD_pack9()
+ *//**
+ * \b Description:
+ * This function is used to convert 9-bit words to a 9-bit byte stream
+ * (see word.h), so they can be stored or forwarded as bytes. Bits 9 to 15
+ * of the words are dropped.
+ *
+ * PRE-CONDITION: bytes has room for WORD_PACKED_SIZE(count) bytes. <br>
+ *
+ * POST-CONDITION: bytes holds the byte stream of the words. <br>
+ *
+ * @param[in]   words is the array of 9-bit words.
+ * @param[in]   count is the number of words.
+ * @param[out]  bytes is the byte stream.
+ *
+ * @return The number of bytes written.
+ *
+ * \b Example:
+ * @code
+ * uint8_t packed[WORD_PACKED_SIZE(64U)];
+ * size = WORD_pack9(rxWords, 64U, packed);
+ * @endcode
+ *
+ * @see WORD_bytesMask
+ * @see WORD_narrow
+ * @see WORD_widen
+ * @see WORD_pack9
+ * @see WORD_unpack9
+ *
+*****************************************************************************/
+uint32_t WORD_pack9(const uint16_t * const words, uint32_t count,
+uint8_t * const bytes)
+{
+    uint32_t index = 0U;
+    uint32_t size = 0U;
+    uint32_t group;
+    uint32_t pair;
+    uint8_t ninth;
+
+    while(index < count)
+    {
+        group = ((count - index) < WORD_GROUP_SIZE) ?
+            (count - index) : WORD_GROUP_SIZE;
+        ninth = 0U;
+
+        if(group == WORD_GROUP_SIZE)
+        {
+            /* The low bytes are narrowed four at a time, and the ninth
+             * bits are taken two at a time (bits 8 and 24 of each pair).
+            */
+            __UNALIGNED_UINT32_WRITE(&bytes[size],
+                WORD_narrowBlock(&words[index]));
+            __UNALIGNED_UINT32_WRITE(&bytes[size + WORD_BLOCK_SIZE],
+                WORD_narrowBlock(&words[index + WORD_BLOCK_SIZE]));
+            for(uint32_t i=0; i<WORD_GROUP_SIZE; i+=2U)
+            {
+                pair = __UNALIGNED_UINT32_READ(&words[index + i]);
+                ninth |= (uint8_t)((((pair >> 8) & 0x01U) |
+                    ((pair >> 23) & 0x02U)) << i);
+            }
+        }
+        else
+        {
+            for(uint32_t i=0; i<group; i++)
+            {
+                bytes[size + i] = (uint8_t)words[index + i];
+                ninth |= (uint8_t)(((words[index + i] >> 8) & 0x01U) << i);
+            }
+        }
+
+        bytes[size + group] = ninth;
+        size += group + 1U;
+        index += group;
+    }
+
+    return size;
+}
+
+/*****************************************************************************
+ * Function: WORD_unpack9()
+ *//**
+ * \b Description:
+ * This function is used to convert a 9-bit byte stream (see word.h) to the
+ * 9-bit words transmitted by a 16-bit DMA stream.
+ *
+ * PRE-CONDITION: bytes holds WORD_PACKED_SIZE(count) bytes. <br>
+ *
+ * POST-CONDITION: words holds count 9-bit words. <br>
+ *
+ * @param[in]   bytes is the byte stream.
+ * @param[in]   count is the number of words.
+ * @param[out]  words is the array of 9-bit words.
+ *
+ * @return The number of bytes read.
+ *
+ * \b Example:
+ * @code
+ * WORD_unpack9(packed, 64U, txWords);
+ * @endcode
+ *
+ * @see WORD_bytesMask
+ * @see WORD_narrow
+ * @see WORD_widen
+ * @see WORD_pack9
+ * @see WORD_unpack9
+ *
+*****************************************************************************/
+uint32_t WORD_unpack9(const uint8_t * const bytes, uint32_t count,
+uint16_t * const words)
+{
+    uint32_t index = 0U;
+    uint32_t size = 0U;
+    uint32_t group;
+    uint32_t ninth;
+    uint32_t bits;
+
+    while(index < count)
+    {
+        group = ((count - index) < WORD_GROUP_SIZE) ?
+            (count - index) : WORD_GROUP_SIZE;
+        ninth = bytes[size + group];
+
+        if(group == WORD_GROUP_SIZE)
+        {
+            /* The ninth bits of four words are moved to bits 8 and 24 of
+             * the two pairs, and added while widening.
+            */
+            for(uint32_t i=0; i<WORD_GROUP_SIZE; i+=WORD_BLOCK_SIZE)
+            {
+                bits = ninth >> i;
+                WORD_widenBlock(__UNALIGNED_UINT32_READ(&bytes[size + i]),
+                    &words[index + i],
+                    ((bits & 0x01U) << 8) | ((bits & 0x02U) << 23),
+                    ((bits & 0x04U) << 6) | ((bits & 0x08U) << 21));
+            }
+        }
+        else
+        {
+            for(uint32_t i=0; i<group; i++)
+            {
+                words[index + i] = (uint16_t)(bytes[size + i] |
+                    (((ninth >> i) & 0x01U) << 8));
+            }
+        }
+
+        size += group + 1U;
+        index += group;
+    }
+
+    return size;
+}
+
+/*****************************************************************************
+ * Function: WORD_narrowBlock()
+ *//**
+ * \b Description:
+ * This function is used to take the low byte of four half-words. The two
+ * low bytes of a pair are moved next to each other by OR-ing the pair with
+ * itself shifted by one byte.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: None. <br>
+ *
+ * @param[in]   words is the array of four half-words.
+ *
+ * @return The four low bytes, the first one on bits 0 to 7.
+ *
+*****************************************************************************/
+static uint32_t WORD_narrowBlock(const uint16_t * const words)
+{
+    uint32_t low = __UNALIGNED_UINT32_READ(&words[0]) & WORD_LOW_BYTES;
+    uint32_t high = __UNALIGNED_UINT32_READ(&words[2]) & WORD_LOW_BYTES;
+
+    low = (low | (low >> 8)) & 0x0000FFFFUL;
+    high = (high | (high >> 8)) & 0x0000FFFFUL;
+
+    return low | (high << 16);
+}
+
+/*****************************************************************************
+ * Function: WORD_widenBlock()
+ *//**
+ * \b Description:
+ * This function is used to spread four bytes to four half-words. On the
+ * Cortex-M4, UXTB16 takes bytes 0 and 2 (and 1 and 3 of the rotated word)
+ * to half-words, and PKHBT/PKHTB put them back in order.
+ *
+ * PRE-CONDITION: None. <br>
+ *
+ * POST-CONDITION: words holds the four half-words. <br>
+ *
+ * @param[in]   data is four bytes, the first one on bits 0 to 7.
+ * @param[out]  words is the array of four half-words.
+ * @param[in]   ninthFirst is the ninth bits of words 0 and 1 (bits 8 and
+ *              24).
+ * @param[in]   ninthSecond is the ninth bits of words 2 and 3 (bits 8 and
+ *              24).
+ *
+ * @return void
+ *
+*****************************************************************************/
+static void WORD_widenBlock(const uint32_t data, uint16_t * const words,
+const uint32_t ninthFirst, const uint32_t ninthSecond)
+{
+    uint32_t first;
+    uint32_t second;
+
+#if defined(__ARM_FEATURE_SIMD32)
+    const uint32_t even = __UXTB16(data);
+    const uint32_t odd = __UXTB16(__ROR(data, 8));
+
+    first = __PKHBT(even, odd, 16);
+    second = __PKHTB(odd, even, 16);
+#else
+    first = (data & 0x000000FFUL) | ((data & 0x0000FF00UL) << 8);
+    second = ((data >> 16) & 0x000000FFUL) | ((data >> 8) & 0x00FF0000UL);
+#endif
+
+    __UNALIGNED_UINT32_WRITE(&words[0], first | ninthFirst);
+    __UNALIGNED_UINT32_WRITE(&words[2], second | ninthSecond);
+}
@@ -0,0 +1,67 @@
+/**
+ * @file stm32f4xx.h
+ * @author Jose Luis Figueroa
+ * @brief Host stand-in for the CMSIS device header, used by the native
+ * tests only. The modules built for the host use no registers, only the
+ * barrier intrinsics, which are mapped to the C11 fence of the same
+ * strength, and the SIMD intrinsics of the filter, which are modelled lane
+ * by lane as the Cortex-M4 executes them.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+#ifndef STM32F4XX_H_
+#define STM32F4XX_H_
+
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+/*****************************************************************************
+* Macros
+*****************************************************************************/
+/**
+ * Defines the memory barriers of the Cortex-M4 (DMB, DSB and ISB).
+*/
+#define __DMB() atomic_thread_fence(memory_order_seq_cst)
+#define __DSB() atomic_thread_fence(memory_order_seq_cst)
+#define __ISB() atomic_thread_fence(memory_order_seq_cst)
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+/* Reads a word from any address, as the Cortex-M4 LDR does */
+static inline uint32_t __UNALIGNED_UINT32_READ(const void *address)
+{
+    uint32_t value;
+
+    memcpy(&value, address, sizeof(value));
+    return value;
+}
+
+/* Adds the signed halfwords lane by lane, the carries are not propagated */
+static inline uint32_t __SADD16(uint32_t op1, uint32_t op2)
+{
+    const uint16_t low = (uint16_t)((int16_t)op1 + (int16_t)op2);
+    const uint16_t high =
+        (uint16_t)((int16_t)(op1 >> 16) + (int16_t)(op2 >> 16));
+
+    return ((uint32_t)high << 16) | low;
+}
+
+/* Multiplies the signed halfwords lane by lane and adds both products */
+static inline uint32_t __SMLAD(uint32_t op1, uint32_t op2, uint32_t op3)
+{
+    const int32_t low = (int32_t)(int16_t)op1 * (int16_t)op2;
+    const int32_t high =
+        (int32_t)(int16_t)(op1 >> 16) * (int16_t)(op2 >> 16);
+
+    return op3 + (uint32_t)low + (uint32_t)high;
+}
+
+#endif /*STM32F4XX_H_*/
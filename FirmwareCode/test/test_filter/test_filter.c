@@ -0,0 +1,234 @@
+/**
+ * @file test_filter.c
+ * @author Jose Luis Figueroa
+ * @brief Host tests of the decimation filter (pio test -e native). The
+ * SIMD paths (SMLAD for one channel, SADD16 for channel pairs) run on the
+ * intrinsic models of test/shim and the odd channel counts on the scalar
+ * path. Every output is compared with a plain average of the same window,
+ * for full-scale 12-bit samples, odd factors and samples left after the
+ * last window.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <unity.h>
+#include "filter.h"
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the room for the samples and the averages of a test.
+*/
+#define TEST_SAMPLES            8192U
+
+/**
+ * Defines the largest decimation factor of the sweep.
+*/
+#define TEST_FACTOR_MAX         40U
+
+/**
+ * Defines the value written past the averages, which must be kept.
+*/
+#define TEST_GUARD              0xA5A5U
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/* One more sample, so the samples can also start on an odd halfword */
+static uint16_t samples[TEST_SAMPLES + 1U];
+static uint16_t output[TEST_SAMPLES + 1U];
+static uint16_t expected[TEST_SAMPLES];
+static uint32_t seed;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static uint16_t TEST_sampleGet(void);
+static uint32_t TEST_reference(const FilterDecimation_t * const Decimation,
+const uint16_t * const data, const uint32_t count);
+static void TEST_compare(const FilterDecimation_t * const Decimation,
+const uint16_t * const data, const uint32_t count);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+void setUp(void)
+{
+    seed = 12345U;
+}
+
+void tearDown(void)
+{
+}
+
+/* Gives a 12-bit sample from a linear congruential generator */
+static uint16_t TEST_sampleGet(void)
+{
+    seed = (seed * 1103515245U) + 12345U;
+    return (uint16_t)((seed >> 16) & FILTER_SAMPLE_MAX);
+}
+
+/* Averages each window one sample at a time, rounding halves up */
+static uint32_t TEST_reference(const FilterDecimation_t * const Decimation,
+const uint16_t * const data, const uint32_t count)
+{
+    const uint32_t channels = Decimation->channels;
+    const uint32_t factor = Decimation->factor;
+    const uint32_t windows = count / (channels * factor);
+    uint32_t sum;
+
+    for(uint32_t i=0; i<windows; i++)
+    {
+        for(uint32_t channel=0; channel<channels; channel++)
+        {
+            sum = 0U;
+            for(uint32_t frame=0; frame<factor; frame++)
+            {
+                sum += data[(((i * factor) + frame) * channels) + channel];
+            }
+            expected[(i * channels) + channel] =
+                (uint16_t)((sum + (factor / 2U)) / factor);
+        }
+    }
+
+    return windows * channels;
+}
+
+/* The filter gives the averages of the reference and nothing past them */
+static void TEST_compare(const FilterDecimation_t * const Decimation,
+const uint16_t * const data, const uint32_t count)
+{
+    const uint32_t size = TEST_reference(Decimation, data, count);
+
+    for(uint32_t i=0; i<(TEST_SAMPLES + 1U); i++)
+    {
+        output[i] = TEST_GUARD;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(size, FILTER_decimate(Decimation, data, count,
+        output));
+    TEST_ASSERT_EQUAL_UINT32(FILTER_OUTPUT_SIZE(count, Decimation->channels,
+        Decimation->factor), size);
+    if(size > 0U)
+    {
+        TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, output, size);
+    }
+    TEST_ASSERT_EQUAL_UINT16(TEST_GUARD, output[size]);
+}
+
+/* Full-scale samples do not overflow the halfword lanes */
+static void test_filter_full_scale(void)
+{
+    static const uint16_t factor[] =
+    {
+        1U, 2U, 7U, 8U, 9U, 15U, 16U, 17U, 255U, 511U
+    };
+    FilterDecimation_t Decimation;
+
+    for(uint32_t i=0; i<TEST_SAMPLES; i++)
+    {
+        samples[i] = FILTER_SAMPLE_MAX;
+    }
+
+    for(uint8_t channels=1U; channels<=FILTER_CHANNELS_MAX; channels++)
+    {
+        for(uint32_t i=0; i<(sizeof(factor) / sizeof(factor[0])); i++)
+        {
+            Decimation.channels = channels;
+            Decimation.factor = factor[i];
+            if(((uint32_t)channels * factor[i]) > TEST_SAMPLES)
+            {
+                continue;
+            }
+
+            TEST_compare(&Decimation, samples,
+                ((TEST_SAMPLES / (channels * factor[i])) *
+                 channels * factor[i]));
+        }
+    }
+}
+
+/* Every channel count and factor, with a tail after the last window */
+static void test_filter_sweep(void)
+{
+    FilterDecimation_t Decimation;
+    uint32_t window;
+
+    for(uint32_t i=0; i<(TEST_SAMPLES + 1U); i++)
+    {
+        samples[i] = TEST_sampleGet();
+    }
+
+    for(uint8_t channels=1U; channels<=FILTER_CHANNELS_MAX; channels++)
+    {
+        for(uint16_t factor=1U; factor<=TEST_FACTOR_MAX; factor++)
+        {
+            Decimation.channels = channels;
+            Decimation.factor = factor;
+            window = (uint32_t)channels * factor;
+
+            /* Three windows and a partial one, from an even and odd start */
+            TEST_compare(&Decimation, &samples[0], (3U * window) +
+                (window / 2U));
+            TEST_compare(&Decimation, &samples[1], (3U * window) + 1U);
+        }
+    }
+}
+
+/* Fewer samples than a window give no averages */
+static void test_filter_short(void)
+{
+    const FilterDecimation_t Decimation = {2U, 16U};
+
+    for(uint32_t i=0; i<TEST_SAMPLES; i++)
+    {
+        samples[i] = FILTER_SAMPLE_MAX;
+    }
+
+    TEST_compare(&Decimation, samples, 0U);
+    TEST_compare(&Decimation, samples, 31U);
+}
+
+/* The averages round to the nearest integer, halves up */
+static void test_filter_rounding(void)
+{
+    const FilterDecimation_t Single = {1U, 2U};
+    const FilterDecimation_t Pair = {2U, 3U};
+    static const uint16_t data[] =
+    {
+        0U, 1U, 4094U, 4095U, 0U, 0U, 1U, 1U
+    };
+    static const uint16_t pairData[] =
+    {
+        0U, 1U, 1U, 1U, 0U, 0U
+    };
+
+    TEST_ASSERT_EQUAL_UINT32(4U, FILTER_decimate(&Single, data, 8U,
+        output));
+    TEST_ASSERT_EQUAL_UINT16(1U, output[0]);
+    TEST_ASSERT_EQUAL_UINT16(4095U, output[1]);
+    TEST_ASSERT_EQUAL_UINT16(0U, output[2]);
+    TEST_ASSERT_EQUAL_UINT16(1U, output[3]);
+
+    /* 1/3 rounds down and 2/3 rounds up */
+    TEST_ASSERT_EQUAL_UINT32(2U, FILTER_decimate(&Pair, pairData, 6U,
+        output));
+    TEST_ASSERT_EQUAL_UINT16(0U, output[0]);
+    TEST_ASSERT_EQUAL_UINT16(1U, output[1]);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_filter_full_scale);
+    RUN_TEST(test_filter_sweep);
+    RUN_TEST(test_filter_short);
+    RUN_TEST(test_filter_rounding);
+    return UNITY_END();
+}
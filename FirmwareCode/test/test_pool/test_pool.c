@@ -0,0 +1,203 @@
+/**
+ * @file test_pool.c
+ * @author Jose Luis Figueroa
+ * @brief Host tests of the DMA buffer pool (pio test -e native). Several
+ * threads allocate and free blocks of every class at the same time, as the
+ * interrupt handlers and the main loop do on the target. A block given to
+ * two users at once is found by the pattern each user writes in it, and
+ * the statistics must come back to an empty pool.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <unity.h>
+#include "pool.h"
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the threads of the contention test, the allocations of each one
+ * and the blocks each one holds at a time.
+*/
+#define TEST_THREADS            4U
+#define TEST_ROUNDS             200000UL
+#define TEST_HELD               3U
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+/* Defines the sizes requested, so every class is used and exhausted */
+static const uint16_t testSize[] =
+{
+    1U, 17U, 32U, 33U, 100U, 128U, 300U, 512U
+};
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static void *TEST_poolUser(void *argument);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+void setUp(void)
+{
+    POOL_init(POOL_configGet(), POOL_configSizeGet());
+}
+
+void tearDown(void)
+{
+}
+
+/* Holds a few blocks at a time, each filled with a pattern of its own */
+static void *TEST_poolUser(void *argument)
+{
+    const uint32_t thread = (uint32_t)(uintptr_t)argument;
+    uint8_t *block[TEST_HELD] = {NULL};
+    uint16_t size[TEST_HELD] = {0U};
+    uint8_t pattern[TEST_HELD] = {0U};
+    uintptr_t errors = 0U;
+    uint32_t slot;
+
+    for(uint32_t round=0; round<TEST_ROUNDS; round++)
+    {
+        slot = round % TEST_HELD;
+
+        /* Check and release the oldest block of the slot */
+        if(block[slot] != NULL)
+        {
+            for(uint16_t i=0; i<size[slot]; i++)
+            {
+                errors += (block[slot][i] != pattern[slot]) ? 1U : 0U;
+            }
+            errors += (POOL_ownerGet(block[slot]) != POOL_OWNER_CPU) ?
+                1U : 0U;
+            POOL_free(block[slot]);
+            block[slot] = NULL;
+        }
+
+        size[slot] = testSize[(round + thread) %
+            (sizeof(testSize) / sizeof(testSize[0]))];
+        block[slot] = POOL_alloc(size[slot]);
+        if(block[slot] == NULL)
+        {
+            /* Every class that fits is exhausted, let the others free */
+            sched_yield();
+            continue;
+        }
+
+        errors += (((uintptr_t)block[slot] % POOL_ALIGNMENT) != 0U) ?
+            1U : 0U;
+        pattern[slot] = (uint8_t)((thread << 5) + round);
+        memset(block[slot], pattern[slot], size[slot]);
+
+        /* Hand the block to the DMA and back, as the drivers do */
+        POOL_ownerSet(block[slot], POOL_OWNER_DMA);
+        if((round % 7U) == 0U)
+        {
+            sched_yield();
+        }
+        POOL_ownerSet(block[slot], POOL_OWNER_CPU);
+    }
+
+    for(slot=0; slot<TEST_HELD; slot++)
+    {
+        if(block[slot] != NULL)
+        {
+            POOL_free(block[slot]);
+        }
+    }
+
+    return (void*)errors;
+}
+
+/* Every block is taken from the smallest class that fits, then larger */
+static void test_pool_exhaustion(void)
+{
+    const PoolConfig_t * const Config = POOL_configGet();
+    void *block[64];
+    uint32_t count = 0U;
+    uint32_t expected = 0U;
+    PoolStats_t Stats;
+
+    for(uint8_t i=0; i<POOL_configSizeGet(); i++)
+    {
+        expected += Config[i].blockCount;
+    }
+
+    while((count < (sizeof(block) / sizeof(block[0]))) &&
+          ((block[count] = POOL_alloc(1U)) != NULL))
+    {
+        count++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(expected, count);
+    TEST_ASSERT_NULL(POOL_alloc(1U));
+
+    /* The two refusals are counted on the class that fits the size */
+    POOL_statsGet(0U, &Stats);
+    TEST_ASSERT_EQUAL_UINT32(Config[0].blockCount, Stats.used);
+    TEST_ASSERT_EQUAL_UINT32(2U, Stats.failures);
+
+    for(uint32_t i=0; i<count; i++)
+    {
+        POOL_free(block[i]);
+    }
+    POOL_statsGet(0U, &Stats);
+    TEST_ASSERT_EQUAL_UINT32(0U, Stats.used);
+}
+
+/* No block is given to two threads, and no block is lost */
+static void test_pool_contention(void)
+{
+    const PoolConfig_t * const Config = POOL_configGet();
+    pthread_t user[TEST_THREADS];
+    void *errors;
+    PoolStats_t Stats;
+    uint32_t expected = 0U;
+    uint32_t count = 0U;
+
+    for(uint32_t t=0; t<TEST_THREADS; t++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&user[t], NULL,
+            TEST_poolUser, (void*)(uintptr_t)t));
+    }
+
+    for(uint32_t t=0; t<TEST_THREADS; t++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(user[t], &errors));
+        TEST_ASSERT_EQUAL_UINT32(0U, (uint32_t)(uintptr_t)errors);
+    }
+
+    for(uint8_t i=0; i<POOL_configSizeGet(); i++)
+    {
+        POOL_statsGet(i, &Stats);
+        TEST_ASSERT_EQUAL_UINT32(0U, Stats.used);
+        TEST_ASSERT_EQUAL_UINT32(0U, Stats.requestedBytes);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(Config[i].blockCount, Stats.peak);
+        expected += Config[i].blockCount;
+    }
+
+    /* Every block is back on the free lists */
+    while(POOL_alloc(1U) != NULL)
+    {
+        count++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(expected, count);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_pool_exhaustion);
+    RUN_TEST(test_pool_contention);
+    return UNITY_END();
+}
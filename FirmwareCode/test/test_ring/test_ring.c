@@ -0,0 +1,332 @@
+/**
+ * @file test_ring.c
+ * @author Jose Luis Figueroa
+ * @brief Host tests of the lock-free ring buffers (pio test -e native).
+ * The producers run on their own threads, as the interrupt handlers do on
+ * the target, and the consumer on the main thread. Every byte is checked
+ * against a counter, and the records of each producer must be read in the
+ * order they were committed.
+ * @version 1.1
+ * @date 2025-03-26
+ *
+ * @copyright Copyright (c) 2025 Jose Luis Figueroa. MIT License.
+ *
+ */
+/*****************************************************************************
+* Includes
+*****************************************************************************/
+#include <pthread.h>
+#include <sched.h>
+#include <unity.h>
+#include "ring.h"
+
+/*****************************************************************************
+* Module Preprocessor Constants
+*****************************************************************************/
+/**
+ * Defines the size of the rings (bytes).
+*/
+#define TEST_SPSC_SIZE          256U
+#define TEST_MPSC_SIZE          1024U
+
+/**
+ * Defines the bytes moved through the SPSC ring and the largest batch.
+*/
+#define TEST_SPSC_BYTES         4000000UL
+#define TEST_SPSC_BATCH         97U
+
+/**
+ * Defines the producers of the MPSC ring, the records of each one and the
+ * largest record (bytes).
+*/
+#define TEST_MPSC_PRODUCERS     3U
+#define TEST_MPSC_RECORDS       200000UL
+#define TEST_MPSC_RECORD_MAX    61U
+
+/*****************************************************************************
+* Module Typedefs
+*****************************************************************************/
+/**
+ * Defines the head of a record of the MPSC stress test, followed by bytes
+ * derived from the producer and the sequence.
+*/
+typedef struct
+{
+    uint32_t producer;          /**< Producer of the record */
+    uint32_t sequence;          /**< Records committed before by it */
+}TestRecord_t;
+
+/*****************************************************************************
+* Module Variable Definitions
+*****************************************************************************/
+static uint8_t spscStorage[TEST_SPSC_SIZE];
+static uint8_t mpscStorage[TEST_MPSC_SIZE] __attribute__((aligned(4)));
+static RingSpsc_t SpscRing;
+static RingMpsc_t MpscRing;
+
+/*****************************************************************************
+* Function Prototypes
+*****************************************************************************/
+static uint8_t TEST_byteGet(const uint32_t producer, const uint32_t sequence,
+const uint32_t index);
+static uint32_t TEST_lengthGet(const uint32_t sequence);
+static void *TEST_spscProducer(void *argument);
+static void *TEST_mpscProducer(void *argument);
+
+/*****************************************************************************
+* Function Definitions
+*****************************************************************************/
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* Gives the byte at index of a record of the MPSC stress test */
+static uint8_t TEST_byteGet(const uint32_t producer, const uint32_t sequence,
+const uint32_t index)
+{
+    return (uint8_t)((producer * 131U) + (sequence * 7U) + index);
+}
+
+/* Gives the length of a record of the MPSC stress test */
+static uint32_t TEST_lengthGet(const uint32_t sequence)
+{
+    return sizeof(TestRecord_t) +
+        ((sequence * 13U) % (TEST_MPSC_RECORD_MAX - sizeof(TestRecord_t)));
+}
+
+/* Writes the byte counter in batches of every size, in place */
+static void *TEST_spscProducer(void *argument)
+{
+    uint32_t written = 0U;
+    uint32_t batch;
+    uint32_t length;
+    uint8_t *region;
+
+    (void)argument;
+    for(uint32_t round=0; written < TEST_SPSC_BYTES; round++)
+    {
+        batch = 1U + (round % TEST_SPSC_BATCH);
+        length = RING_spscWriteReserve(&SpscRing, &region);
+        if(length == 0U)
+        {
+            sched_yield();
+            continue;
+        }
+
+        length = (length < batch) ? length : batch;
+        length = ((TEST_SPSC_BYTES - written) < length) ?
+            (TEST_SPSC_BYTES - written) : length;
+        for(uint32_t i=0; i<length; i++)
+        {
+            region[i] = (uint8_t)(written + i);
+        }
+        RING_spscWriteCommit(&SpscRing, length);
+        written += length;
+    }
+
+    return NULL;
+}
+
+/* Commits records of every length, tagged with the producer */
+static void *TEST_mpscProducer(void *argument)
+{
+    const uint32_t producer = (uint32_t)(uintptr_t)argument;
+    TestRecord_t Record;
+    uint32_t length;
+    uint8_t *data;
+
+    for(uint32_t sequence=0; sequence<TEST_MPSC_RECORDS; sequence++)
+    {
+        length = TEST_lengthGet(sequence);
+        while((data = RING_mpscReserve(&MpscRing, length)) == NULL)
+        {
+            sched_yield();
+        }
+
+        Record.producer = producer;
+        Record.sequence = sequence;
+        memcpy(data, &Record, sizeof(Record));
+        for(uint32_t i=sizeof(Record); i<length; i++)
+        {
+            data[i] = TEST_byteGet(producer, sequence, i);
+        }
+        RING_mpscCommit(&MpscRing, data);
+    }
+
+    return NULL;
+}
+
+/* The consumer reads the counter in the order it was written */
+static void test_spsc_threads(void)
+{
+    pthread_t producer;
+    uint32_t read = 0U;
+    uint32_t errors = 0U;
+    uint32_t length;
+    uint8_t *region;
+
+    RING_spscInit(&SpscRing, spscStorage, sizeof(spscStorage));
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL,
+        TEST_spscProducer, NULL));
+
+    while(read < TEST_SPSC_BYTES)
+    {
+        length = RING_spscReadPeek(&SpscRing, &region);
+        if(length == 0U)
+        {
+            sched_yield();
+            continue;
+        }
+
+        /* Release part of the region, so the reads split anywhere */
+        length = (length > 1U) ? (length - (read % 2U)) : length;
+        for(uint32_t i=0; i<length; i++)
+        {
+            errors += (region[i] != (uint8_t)(read + i)) ? 1U : 0U;
+        }
+        RING_spscReadRelease(&SpscRing, length);
+        read += length;
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(producer, NULL));
+    TEST_ASSERT_EQUAL_UINT32(0U, errors);
+    TEST_ASSERT_EQUAL_UINT32(TEST_SPSC_BYTES, read);
+    TEST_ASSERT_EQUAL_UINT32(0U, RING_spscUsedGet(&SpscRing));
+}
+
+/* The copies split at the end of the storage and stop when full */
+static void test_spsc_copy_wraps(void)
+{
+    uint8_t data[TEST_SPSC_SIZE];
+    uint8_t copy[TEST_SPSC_SIZE];
+
+    for(uint32_t i=0; i<sizeof(data); i++)
+    {
+        data[i] = (uint8_t)(i * 3U);
+    }
+
+    RING_spscInit(&SpscRing, spscStorage, sizeof(spscStorage));
+    TEST_ASSERT_EQUAL_UINT32(200U, RING_spscWrite(&SpscRing, data, 200U));
+    TEST_ASSERT_EQUAL_UINT32(200U, RING_spscRead(&SpscRing, copy, 200U));
+
+    TEST_ASSERT_EQUAL_UINT32(TEST_SPSC_SIZE,
+        RING_spscWrite(&SpscRing, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_UINT32(0U, RING_spscWrite(&SpscRing, data, 1U));
+    TEST_ASSERT_EQUAL_UINT32(TEST_SPSC_SIZE,
+        RING_spscRead(&SpscRing, copy, sizeof(copy)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, copy, sizeof(data));
+    TEST_ASSERT_EQUAL_UINT32(0U, RING_spscRead(&SpscRing, copy, 1U));
+}
+
+/* A committed record waits for the older records of other producers */
+static void test_mpsc_commit_order(void)
+{
+    uint8_t *first;
+    uint8_t *second;
+    uint8_t *record;
+
+    RING_mpscInit(&MpscRing, mpscStorage, sizeof(mpscStorage));
+    first = RING_mpscReserve(&MpscRing, 5U);
+    second = RING_mpscReserve(&MpscRing, 9U);
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_NOT_NULL(second);
+    TEST_ASSERT_EQUAL_UINT32(0U, ((uintptr_t)first) % 4U);
+
+    RING_mpscCommit(&MpscRing, second);
+    TEST_ASSERT_EQUAL_UINT32(0U, RING_mpscPeek(&MpscRing, &record));
+
+    RING_mpscCommit(&MpscRing, first);
+    TEST_ASSERT_EQUAL_UINT32(5U, RING_mpscPeek(&MpscRing, &record));
+    TEST_ASSERT_EQUAL_PTR(first, record);
+    RING_mpscRelease(&MpscRing);
+    TEST_ASSERT_EQUAL_UINT32(9U, RING_mpscPeek(&MpscRing, &record));
+    TEST_ASSERT_EQUAL_PTR(second, record);
+    RING_mpscRelease(&MpscRing);
+    TEST_ASSERT_EQUAL_UINT32(0U, RING_mpscPeek(&MpscRing, &record));
+}
+
+/* A record that does not fit is refused, and fits once the ring drains */
+static void test_mpsc_full(void)
+{
+    uint32_t reserved = 0U;
+    uint8_t *record;
+
+    RING_mpscInit(&MpscRing, mpscStorage, sizeof(mpscStorage));
+    while((record = RING_mpscReserve(&MpscRing, 60U)) != NULL)
+    {
+        RING_mpscCommit(&MpscRing, record);
+        reserved++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(TEST_MPSC_SIZE / RING_RECORD_SIZE(60U),
+        reserved);
+
+    TEST_ASSERT_EQUAL_UINT32(60U, RING_mpscPeek(&MpscRing, &record));
+    RING_mpscRelease(&MpscRing);
+    record = RING_mpscReserve(&MpscRing, 60U);
+    TEST_ASSERT_NOT_NULL(record);
+}
+
+/* The records of each producer arrive whole and in the order committed */
+static void test_mpsc_threads(void)
+{
+    pthread_t producer[TEST_MPSC_PRODUCERS];
+    uint32_t expected[TEST_MPSC_PRODUCERS] = {0U};
+    uint32_t records = 0U;
+    uint32_t errors = 0U;
+    TestRecord_t Record;
+    uint32_t length;
+    uint8_t *data;
+
+    RING_mpscInit(&MpscRing, mpscStorage, sizeof(mpscStorage));
+    for(uint32_t p=0; p<TEST_MPSC_PRODUCERS; p++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer[p], NULL,
+            TEST_mpscProducer, (void*)(uintptr_t)p));
+    }
+
+    while(records < (TEST_MPSC_PRODUCERS * TEST_MPSC_RECORDS))
+    {
+        length = RING_mpscPeek(&MpscRing, &data);
+        if(length == 0U)
+        {
+            sched_yield();
+            continue;
+        }
+
+        memcpy(&Record, data, sizeof(Record));
+        TEST_ASSERT_LESS_THAN_UINT32(TEST_MPSC_PRODUCERS, Record.producer);
+        TEST_ASSERT_EQUAL_UINT32(expected[Record.producer], Record.sequence);
+        TEST_ASSERT_EQUAL_UINT32(TEST_lengthGet(Record.sequence), length);
+        for(uint32_t i=sizeof(Record); i<length; i++)
+        {
+            errors += (data[i] !=
+                TEST_byteGet(Record.producer, Record.sequence, i)) ? 1U : 0U;
+        }
+        RING_mpscRelease(&MpscRing);
+        expected[Record.producer]++;
+        records++;
+    }
+
+    for(uint32_t p=0; p<TEST_MPSC_PRODUCERS; p++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(producer[p], NULL));
+        TEST_ASSERT_EQUAL_UINT32(TEST_MPSC_RECORDS, expected[p]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0U, errors);
+    TEST_ASSERT_EQUAL_UINT32(0U, RING_mpscPeek(&MpscRing, &data));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_spsc_threads);
+    RUN_TEST(test_spsc_copy_wraps);
+    RUN_TEST(test_mpsc_commit_order);
+    RUN_TEST(test_mpsc_full);
+    RUN_TEST(test_mpsc_threads);
+    return UNITY_END();
+}